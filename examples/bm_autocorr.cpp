@@ -0,0 +1,96 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <vector>
+#include <ctime>
+#include <random>
+#include <o2scl/vec_stats.h>
+
+/*
+  This program compares the performance of the direct computation
+  of autocorrelation coefficients (one call to vector_lagk_autocorr()
+  for each lag, as was done previously in mcmc_para_table::ac_coeffs())
+  with the FFT-based computation in vector_autocorr_vector_fft() for
+  an AR(1) process.
+*/
+
+using namespace std;
+using namespace o2scl;
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  double phi=0.9;
+  std::mt19937 gen(10);
+  std::normal_distribution<double> gauss;
+  
+  cout << "N             direct (s)    FFT (s)       max diff      "
+       << "tau_int       ESS" << endl;
+  
+  for(size_t N=1000;N<=1000000;N*=10) {
+    
+    std::vector<double> data(N), ac_fft;
+    data[0]=gauss(gen);
+    for(size_t i=1;i<N;i++) data[i]=phi*data[i-1]+gauss(gen);
+
+    // The direct method is only used for smaller chains because 
+    // it requires O(N^2) operations
+    double t_direct=0.0;
+    std::vector<double> ac_direct;
+    if (N<=30000) {
+      clock_t t1=clock();
+      ac_direct.resize(N/2);
+      ac_direct[0]=1.0;
+      for(size_t ell=1;ell<N/2;ell++) {
+	double mean=vector_mean(data);
+	ac_direct[ell]=vector_lagk_autocorr(N,data,ell,mean);
+      }
+      t_direct=((double)(clock()-t1))/CLOCKS_PER_SEC;
+    }
+
+    clock_t t1=clock();
+    vector_autocorr_vector_fft(data,ac_fft);
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac_fft.size(),ac_fft,window);
+    double t_fft=((double)(clock()-t1))/CLOCKS_PER_SEC;
+
+    double max_diff=0.0;
+    for(size_t k=0;k<ac_direct.size();k++) {
+      double diff=fabs(ac_direct[k]-ac_fft[k]);
+      if (diff>max_diff) max_diff=diff;
+    }
+
+    cout.width(13);
+    cout << N << " ";
+    if (ac_direct.size()>0) {
+      cout << t_direct << " ";
+    } else {
+      cout << "             ";
+    }
+    cout << t_fft << " " << max_diff << " " << tau << " "
+	 << ((double)N)/tau << endl;
+  }
+  
+  return 0;
+}
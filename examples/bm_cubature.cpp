@@ -0,0 +1,103 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <functional>
+#include <boost/numeric/ublas/vector.hpp>
+#include <o2scl/cubature.h>
+
+/*
+  This program measures the scaling of inte_hcubature in parallel
+  mode with the number of OpenMP threads, using an integrand which
+  is artificially made expensive to evaluate. The results from all
+  thread counts should be identical. Without OpenMP, all of the
+  runs are performed with one thread.
+*/
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+typedef std::function<int(size_t,size_t,const double *,size_t,
+			  double *)> cub_funct_arr;
+
+/** \brief A Gaussian peak in \c ndim dimensions, each point 
+    requiring several hundred transcendental function evaluations
+*/
+int expensive(size_t ndim, size_t npt, const double *x, size_t fdim,
+	      double *fval) {
+  for(size_t i=0;i<npt;i++) {
+    const double *xi=x+i*ndim;
+    double r2=0.0;
+    for(size_t j=0;j<ndim;j++) {
+      r2+=(xi[j]-0.4)*(xi[j]-0.4);
+    }
+    // Compute exp(-r2/0.02) the slow way
+    double sum=0.0;
+    for(size_t k=0;k<200;k++) {
+      sum+=sin(r2+k)*sin(r2+k)+cos(r2+k)*cos(r2+k);
+    }
+    fval[i]=exp(-r2/0.02)*sum/200.0;
+  }
+  return 0;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  inte_hcubature<cub_funct_arr> hc;
+  cub_funct_arr f=expensive;
+  hc.use_parallel=1;
+
+  size_t ndim=4;
+  ubvector xmin(ndim), xmax(ndim), val(1), err(1);
+  for(size_t j=0;j<ndim;j++) {
+    xmin[j]=0.0;
+    xmax[j]=1.0;
+  }
+  
+  cout << "threads       time (s)      speedup       integral      "
+       << "error" << endl;
+
+  double t_one=0.0;
+  for(size_t nt=1;nt<=32;nt*=2) {
+    
+    hc.n_threads=nt;
+    std::chrono::steady_clock::time_point t1=
+      std::chrono::steady_clock::now();
+    hc.integ(1,f,ndim,xmin,xmax,0,0.0,1.0e-5,
+	     inte_cubature_base::ERROR_INDIVIDUAL,val,err);
+    std::chrono::steady_clock::time_point t2=
+      std::chrono::steady_clock::now();
+    double t=std::chrono::duration<double>(t2-t1).count();
+    if (nt==1) t_one=t;
+
+    cout.width(13);
+    cout << nt << " " << t << " " << t_one/t << " "
+	 << val[0] << " " << err[0] << endl;
+  }
+  
+  return 0;
+}
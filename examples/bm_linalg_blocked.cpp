@@ -0,0 +1,135 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <o2scl/lu.h>
+#include <o2scl/cholesky.h>
+#include <o2scl/qr.h>
+
+/*
+  This program compares the time required for the unblocked LU,
+  Cholesky, and QR decompositions in o2scl_linalg with the blocked
+  versions for a range of matrix sizes. The last column gives
+  the largest absolute difference between the two results.
+*/
+
+using namespace std;
+using namespace o2scl;
+using namespace o2scl_linalg;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
+typedef std::chrono::steady_clock::time_point time_point;
+
+/** \brief Return the time in seconds since \c t1
+ */
+double elapsed(time_point t1) {
+  time_point t2=std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t2-t1).count();
+}
+
+/** \brief Return the maximum absolute difference between 
+    two matrices
+*/
+double max_diff(const ubmatrix &a, const ubmatrix &b) {
+  double ret=0.0;
+  for(size_t i=0;i<a.size1();i++) {
+    for(size_t j=0;j<a.size2();j++) {
+      if (fabs(a(i,j)-b(i,j))>ret) ret=fabs(a(i,j)-b(i,j));
+    }
+  }
+  return ret;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+  cout.precision(4);
+
+  cout << "          n  unblocked (s)    blocked (s)    speedup"
+       << "        max. diff." << endl;
+  
+  for(size_t n=250;n<=2000;n*=2) {
+
+    // A symmetric positive-definite matrix which resembles a
+    // covariance matrix
+    ubmatrix a(n,n), a1(n,n), a2(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	double x=(((double)i)-((double)j))/20.0;
+	a(i,j)=exp(-x*x);
+	if (i==j) a(i,j)+=1.0e-2;
+      }
+    }
+
+    // LU decomposition
+    permutation p1(n), p2(n);
+    int sig1, sig2;
+    a1=a;
+    a2=a;
+    time_point t1=std::chrono::steady_clock::now();
+    LU_decomp(n,a1,p1,sig1);
+    double tu=elapsed(t1);
+    t1=std::chrono::steady_clock::now();
+    LU_decomp_blocked(n,a2,p2,sig2);
+    double tb=elapsed(t1);
+    cout << "LU       ";
+    cout.width(6);
+    cout << n << " " << tu << " " << tb << " " << tu/tb << " "
+	 << max_diff(a1,a2) << endl;
+    
+    // Cholesky decomposition
+    a1=a;
+    a2=a;
+    t1=std::chrono::steady_clock::now();
+    cholesky_decomp(n,a1);
+    tu=elapsed(t1);
+    t1=std::chrono::steady_clock::now();
+    cholesky_decomp_blocked(n,a2);
+    tb=elapsed(t1);
+    cout << "Cholesky ";
+    cout.width(6);
+    cout << n << " " << tu << " " << tb << " " << tu/tb << " "
+	 << max_diff(a1,a2) << endl;
+
+    // QR decomposition
+    ubvector tau1(n), tau2(n);
+    a1=a;
+    a2=a;
+    t1=std::chrono::steady_clock::now();
+    QR_decomp(n,n,a1,tau1);
+    tu=elapsed(t1);
+    t1=std::chrono::steady_clock::now();
+    QR_decomp_blocked(n,n,a2,tau2);
+    tb=elapsed(t1);
+    cout << "QR       ";
+    cout.width(6);
+    cout << n << " " << tu << " " << tb << " " << tu/tb << " "
+	 << max_diff(a1,a2) << endl;
+  }
+  
+  return 0;
+}
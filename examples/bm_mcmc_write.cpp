@@ -0,0 +1,137 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <array>
+#include <functional>
+#include <boost/numeric/ublas/vector.hpp>
+#include <o2scl/mcmc_para.h>
+
+/*
+  This program measures the throughput of mcmc_para_table when the
+  output file is updated frequently, comparing synchronous file
+  updates with those performed by the separate I/O thread (see
+  mcmc_para_table::async_write), both with and without
+  mcmc_para_table::append_output. Each point has a large number of
+  auxillary columns so that the file updates are expensive. The
+  I/O thread only improves the throughput if a processor core is
+  available for it, and the asynchronous writer is only used when
+  OpenMP support is enabled.
+*/
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+typedef std::array<double,1> data_t;
+typedef std::function<int(size_t,const ubvector &,double &,
+			  data_t &)> point_funct;
+typedef std::function<int(const ubvector &,double,std::vector<double> &,
+			  data_t &)> fill_funct;
+
+/// Number of auxillary columns
+static const size_t n_aux=100;
+
+/** \brief A Gaussian in each parameter, with a small amount
+    of additional work for each point
+*/
+int point_func(size_t nv, const ubvector &pars, double &ret, data_t &dat) {
+  ret=0.0;
+  for(size_t i=0;i<nv;i++) ret-=pars[i]*pars[i]/2.0;
+  double sum=0.0;
+  for(size_t k=0;k<2000;k++) sum+=sin(ret+k)*sin(ret+k);
+  dat[0]=sum;
+  return 0;
+}
+
+int fill_func(const ubvector &pars, double log_weight,
+	      std::vector<double> &line, data_t &dat) {
+  for(size_t i=0;i<n_aux;i++) {
+    line.push_back(dat[0]*i);
+  }
+  return 0;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  size_t n_params=4;
+  ubvector low(n_params), high(n_params);
+  for(size_t i=0;i<n_params;i++) {
+    low[i]=-5.0;
+    high[i]=5.0;
+  }
+  vector<string> names, units;
+  for(size_t i=0;i<n_params;i++) {
+    names.push_back(((string)"x")+szttos(i));
+    units.push_back("");
+  }
+  for(size_t i=0;i<n_aux;i++) {
+    names.push_back(((string)"aux")+szttos(i));
+    units.push_back("");
+  }
+
+  vector<point_funct> vpf(1);
+  vector<fill_funct> vff(1);
+  vpf[0]=point_func;
+  vff[0]=fill_func;
+
+  cout << "append  async    time (s)      iters/s       speedup" << endl;
+
+  for(size_t append=0;append<2;append++) {
+    double t_sync=0.0;
+    for(size_t async=0;async<2;async++) {
+
+      mcmc_para_table<point_funct,fill_funct,data_t,ubvector> mct;
+      mct.set_names_units(names,units);
+      mct.aff_inv=true;
+      mct.n_walk=20;
+      mct.step_fac=2.0;
+      mct.user_seed=1;
+      mct.max_iters=20000;
+      mct.file_update_iters=100;
+      mct.append_output=(append==1);
+      mct.async_write=(async==1);
+      mct.prefix="bm_mcmc_write";
+
+      std::chrono::steady_clock::time_point t1=
+	std::chrono::steady_clock::now();
+      mct.mcmc(n_params,low,high,vpf,vff);
+      std::chrono::steady_clock::time_point t2=
+	std::chrono::steady_clock::now();
+      double t=std::chrono::duration<double>(t2-t1).count();
+      if (async==0) t_sync=t;
+
+      size_t n_iters=mct.n_accept[0]+mct.n_reject[0];
+      cout.width(6);
+      cout << append << " ";
+      cout.width(6);
+      cout << async << " " << t << " " << n_iters/t << " "
+	   << t_sync/t << endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <o2scl/ode_it_solve.h>
+
+/*
+  This program compares the time required by ode_it_solve to
+  solve a simple boundary value problem with the dense linear
+  solver and with the band solver for a range of grid sizes. The
+  dense solver is only used for the smaller grids. The last
+  column gives the largest absolute difference between the two
+  solutions.
+*/
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
+typedef boost::numeric::ublas::matrix_row<ubmatrix> ubmatrix_row;
+typedef std::chrono::steady_clock::time_point time_point;
+
+/** \brief Return the time in seconds since \c t1
+ */
+double elapsed(time_point t1) {
+  time_point t2=std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t2-t1).count();
+}
+
+/// Left boundary condition, \f$ y_1(0)=1 \f$
+double bc_left(size_t ieq, double x, ubmatrix_row &y) {
+  return y[1]-1.0;
+}
+
+/// Right boundary condition, \f$ y_0(1)=2 \f$
+double bc_right(size_t ieq, double x, ubmatrix_row &y) {
+  return y[0]-2.0;
+}
+
+/// The differential equations
+double derivs(size_t ieq, double x, ubmatrix_row &y) {
+  if (ieq==0) return y[0]+y[1];
+  return y[0];
+}
+
+/// Fill the grid and the initial guess
+void init(size_t ng, ubvector &x, ubmatrix &y) {
+  x.resize(ng);
+  y.resize(ng,2);
+  for(size_t i=0;i<ng;i++) {
+    x[i]=((double)i)/((double)(ng-1));
+    y(i,0)=2.0*x[i];
+    y(i,1)=1.0+x[i]/2.0;
+  }
+  return;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  ode_it_funct f_derivs=derivs;
+  ode_it_funct f_left=bc_left;
+  ode_it_funct f_right=bc_right;
+
+  cout << "  n_grid     dense (s)     band (s)      speedup       "
+       << "max. diff." << endl;
+
+  for(size_t ng=100;ng<=100000;ng*=10) {
+    for(size_t im=1;im<=4;im*=2) {
+      size_t n=ng*im;
+      if (n>100000) break;
+
+      ode_it_solve<> oit;
+      ubvector x, rhs(2*n), dy(2*n);
+      ubmatrix y;
+
+      init(n,x,y);
+      time_point t1=std::chrono::steady_clock::now();
+      oit.solve(n,2,1,x,y,f_derivs,f_left,f_right,rhs,dy);
+      double t_band=elapsed(t1);
+
+      cout.width(8);
+      cout << n << " ";
+      if (n<=400) {
+	ubvector x2;
+	ubmatrix y2, A(2*n,2*n);
+	init(n,x2,y2);
+	t1=std::chrono::steady_clock::now();
+	oit.solve(n,2,1,x2,y2,f_derivs,f_left,f_right,A,rhs,dy);
+	double t_dense=elapsed(t1);
+	double diff=0.0;
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<2;j++) {
+	    if (fabs(y(i,j)-y2(i,j))>diff) diff=fabs(y(i,j)-y2(i,j));
+	  }
+	}
+	cout << t_dense << " " << t_band << " " << t_dense/t_band << " "
+	     << diff << endl;
+      } else {
+	cout << "             " << t_band << endl;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,434 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <functional>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <o2scl/bench_mgr.h>
+#include <o2scl/interp.h>
+#include <o2scl/table.h>
+#include <o2scl/table3d.h>
+#include <o2scl/tensor_grid.h>
+#include <o2scl/cubature.h>
+#include <o2scl/lu.h>
+#include <o2scl/cholesky.h>
+#include <o2scl/qr.h>
+#ifdef O2SCL_EOS
+#include <o2scl/fermion_rel.h>
+#include <o2scl/tov_solve.h>
+#include <o2scl/nstar_rot.h>
+#include <o2scl/eos_sn.h>
+#endif
+#ifdef O2SCL_HDF
+#include <o2scl/hdf_file.h>
+#include <o2scl/hdf_io.h>
+#endif
+
+/*
+  This program times the functions which are most important for
+  the performance of typical applications using bench_mgr. It is
+  run by 'make o2scl-bench' in this directory, which writes the
+  results to $(BENCH_OUT) (bm_suite.json by default).
+
+  Usage:
+
+  bm_suite [-r reps] [-w warmup] [-t min_time] [-f filter] [-o file]
+
+  runs the benchmarks, optionally only those whose names contain
+  'filter', and writes the results to 'file' (bm_suite.json by
+  default), and
+
+  bm_suite -c <old file> <new file> [tolerance]
+
+  compares two result files and returns a non-zero value if any
+  benchmark in the new file is slower than in the old file by more
+  than the relative tolerance (default 0.1).
+
+  The fermion_rel, tov_solve, nstar_rot and eos_sn benchmarks require
+  the particle and EOS libraries and the HDF5 benchmark requires HDF5
+  support.
+*/
+
+using namespace std;
+using namespace o2scl;
+using namespace o2scl_linalg;
+#ifdef O2SCL_HDF
+using namespace o2scl_hdf;
+#endif
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
+typedef std::function<int(size_t,size_t,const double *,size_t,
+			  double *)> cub_funct_arr;
+
+/// Accumulated results, used to ensure the work is not optimized away
+double sink=0.0;
+
+/** \brief A Gaussian peak in \c ndim dimensions for the
+    cubature benchmark
+*/
+int gauss_peak(size_t ndim, size_t npt, const double *x, size_t fdim,
+	       double *fval) {
+  for(size_t i=0;i<npt;i++) {
+    const double *xi=x+i*ndim;
+    double r2=0.0;
+    for(size_t j=0;j<ndim;j++) {
+      r2+=(xi[j]-0.4)*(xi[j]-0.4);
+    }
+    fval[i]=exp(-r2/0.05);
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+  cout.setf(ios::scientific);
+
+  bench_mgr bm;
+  string out_file="bm_suite.json";
+
+  // ----------------------------------------------------------------
+  // Parse the command-line
+
+  for(int i=1;i<argc;i++) {
+    string opt=argv[i];
+    if (opt=="-c") {
+      if (i+2>=argc) {
+	cerr << "Option -c requires two file names." << endl;
+	return 2;
+      }
+      double tol=0.1;
+      if (i+3<argc) tol=o2scl::stod(argv[i+3]);
+      vector<bench_result> res_old, res_new;
+      bench_mgr::read_json(argv[i+1],res_old);
+      bench_mgr::read_json(argv[i+2],res_new);
+      size_t n_regress=bench_mgr::compare(res_old,res_new,tol);
+      if (n_regress>0) return 1;
+      return 0;
+    } else if (i+1<argc && opt=="-r") {
+      bm.n_reps=o2scl::stoszt(argv[++i]);
+    } else if (i+1<argc && opt=="-w") {
+      bm.n_warmup=o2scl::stoszt(argv[++i]);
+    } else if (i+1<argc && opt=="-t") {
+      bm.min_time=o2scl::stod(argv[++i]);
+    } else if (i+1<argc && opt=="-f") {
+      bm.filter=argv[++i];
+    } else if (i+1<argc && opt=="-o") {
+      out_file=argv[++i];
+    } else {
+      cerr << "Unknown or incomplete option '" << opt << "'." << endl;
+      return 2;
+    }
+  }
+
+  // ----------------------------------------------------------------
+  // One-dimensional interpolation
+
+  size_t n_itp=1000;
+  vector<double> ix(n_itp), iy(n_itp), ieval(n_itp);
+  for(size_t i=0;i<n_itp;i++) {
+    ix[i]=((double)i)/((double)(n_itp-1))*10.0;
+    iy[i]=sin(ix[i])+ix[i]/10.0;
+    // Evaluation points which are not ordered, so that the
+    // interpolation object cannot always reuse the last bracket
+    ieval[i]=fmod(((double)i)*7.31,10.0);
+  }
+
+  vector<size_t> itp_types={itp_linear,itp_cspline,itp_akima,
+			    itp_monotonic,itp_steffen};
+  vector<string> itp_names={"linear","cspline","akima",
+			    "monotonic","steffen"};
+  vector<interp_vec<vector<double> > > itps(itp_types.size());
+  for(size_t k=0;k<itp_types.size();k++) {
+    itps[k].set(n_itp,ix,iy,itp_types[k]);
+    interp_vec<vector<double> > &itp=itps[k];
+    bm.add("interp_"+itp_names[k]+"_eval",[&itp,&ieval]() {
+	for(size_t i=0;i<ieval.size();i++) sink+=itp.eval(ieval[i]);
+      });
+    size_t type=itp_types[k];
+    bm.add("interp_"+itp_names[k]+"_set",[&itp,&ix,&iy,type]() {
+	itp.set(ix.size(),ix,iy,type);
+      });
+  }
+
+  // ----------------------------------------------------------------
+  // Tables
+
+  table<> tab;
+  tab.line_of_names("x y");
+  for(size_t i=0;i<10000;i++) {
+    double x=((double)i)/1.0e3;
+    double line[2]={x,sin(x)};
+    tab.line_of_data(2,line);
+  }
+  bm.add("table_interp",[&tab,&ieval]() {
+      for(size_t i=0;i<ieval.size();i++) {
+	sink+=tab.interp("x",ieval[i],"y");
+      }
+    });
+  bm.add("table_function_column",[&tab]() {
+      tab.function_column("sin(x)*exp(-x/3)+y^2","z");
+      sink+=tab.get("z",tab.get_nlines()-1);
+    });
+
+  size_t n3=100;
+  vector<double> gx(n3), gy(n3);
+  for(size_t i=0;i<n3;i++) {
+    gx[i]=((double)i)/((double)(n3-1));
+    gy[i]=((double)i)/((double)(n3-1))*2.0;
+  }
+  table3d t3d;
+  t3d.set_xy("x",n3,gx,"y",n3,gy);
+  t3d.new_slice("z");
+  for(size_t i=0;i<n3;i++) {
+    for(size_t j=0;j<n3;j++) {
+      t3d.set(i,j,"z",sin(gx[i]*3.0)*cos(gy[j]));
+    }
+  }
+  bm.add("table3d_interp",[&t3d]() {
+      for(size_t i=0;i<100;i++) {
+	sink+=t3d.interp(fmod(i*0.0731,1.0),fmod(i*0.1173,2.0),"z");
+      }
+    });
+
+  tensor_grid<> tg;
+  size_t tsize[3]={30,30,30};
+  tg.resize(3,tsize);
+  vector<double> tgrid;
+  for(size_t k=0;k<3;k++) {
+    for(size_t i=0;i<tsize[k];i++) {
+      tgrid.push_back(((double)i)/((double)(tsize[k]-1)));
+    }
+  }
+  tg.set_grid_packed(tgrid);
+  for(size_t i=0;i<tsize[0];i++) {
+    for(size_t j=0;j<tsize[1];j++) {
+      for(size_t k=0;k<tsize[2];k++) {
+	size_t ix3[3]={i,j,k};
+	tg.set(ix3,tg.get_grid(0,i)*tg.get_grid(1,j)+
+	       sin(tg.get_grid(2,k)));
+      }
+    }
+  }
+  bm.add("tensor_grid_interp_linear",[&tg]() {
+      vector<double> v(3);
+      for(size_t i=0;i<1000;i++) {
+	v[0]=fmod(i*0.0731,1.0);
+	v[1]=fmod(i*0.1173,1.0);
+	v[2]=fmod(i*0.0519,1.0);
+	sink+=tg.interp_linear(v);
+      }
+    });
+
+  // ----------------------------------------------------------------
+  // Cubature
+
+  inte_hcubature<cub_funct_arr> hc;
+  cub_funct_arr cf=gauss_peak;
+  bm.add("inte_hcubature_3d",[&hc,&cf]() {
+      ubvector xmin(3), xmax(3), val(1), err(1);
+      for(size_t j=0;j<3;j++) {
+	xmin[j]=0.0;
+	xmax[j]=1.0;
+      }
+      hc.integ(1,cf,3,xmin,xmax,0,0.0,1.0e-6,
+	       inte_cubature_base::ERROR_INDIVIDUAL,val,err);
+      sink+=val[0];
+    });
+
+  // ----------------------------------------------------------------
+  // Linear algebra
+
+  size_t nla=200;
+  ubmatrix amat(nla,nla), awork(nla,nla);
+  for(size_t i=0;i<nla;i++) {
+    for(size_t j=0;j<nla;j++) {
+      double x=(((double)i)-((double)j))/20.0;
+      amat(i,j)=exp(-x*x);
+      if (i==j) amat(i,j)+=1.0e-2;
+    }
+  }
+  bm.add("linalg_LU_decomp",[&]() {
+      awork=amat;
+      permutation p(nla);
+      int sig;
+      LU_decomp(nla,awork,p,sig);
+      sink+=awork(nla-1,nla-1);
+    });
+  bm.add("linalg_cholesky_decomp",[&]() {
+      awork=amat;
+      cholesky_decomp(nla,awork);
+      sink+=awork(nla-1,nla-1);
+    });
+  bm.add("linalg_QR_decomp",[&]() {
+      awork=amat;
+      ubvector tau(nla);
+      QR_decomp(nla,nla,awork,tau);
+      sink+=awork(nla-1,nla-1);
+    });
+
+#ifdef O2SCL_EOS
+
+  // ----------------------------------------------------------------
+  // Particles and neutron stars
+
+  // Nucleons from degenerate to nondegenerate, in units of fm^{-1}
+  fermion_rel fr;
+  fermion nuc(939.0/197.33,2.0);
+  bm.add("fermion_rel_calc_density",[&fr,&nuc]() {
+      for(double T=0.1;T<101.0;T*=10.0) {
+	for(double n=1.0e-6;n<1.01;n*=10.0) {
+	  nuc.n=n;
+	  nuc.mu=nuc.m;
+	  fr.calc_density(nuc,T/197.33);
+	  sink+=nuc.mu;
+	}
+      }
+    });
+
+  // A tabulated polytrope, P = K eps^2, in units of Msun/km^3
+  size_t n_eos=400;
+  vector<double> ted(n_eos), tpr(n_eos);
+  for(size_t i=0;i<n_eos;i++) {
+    ted[i]=1.0e-14*pow(2.0e-2/1.0e-14,((double)i)/((double)(n_eos-1)));
+    tpr[i]=300.0*ted[i]*ted[i];
+  }
+  eos_tov_vectors<vector<double> > etv;
+  etv.read_vectors_copy(n_eos,ted,tpr);
+  tov_solve ts;
+  ts.verbose=0;
+  ts.set_eos(etv);
+  bm.add("tov_solve_mvsr",[&ts]() {
+      ts.mvsr();
+      sink+=ts.get_results()->max("gm");
+    });
+
+  // Rotating stars at the default resolution and on a grid with
+  // twice as many points in each direction
+  eos_nstar_rot_C enr(true);
+  nstar_rot nr, nr2;
+  nr.verbose=0;
+  nr.constants_rns();
+  nr.set_eos(enr);
+  nr2.verbose=0;
+  nr2.constants_rns();
+  nr2.set_eos(enr);
+  nr2.resize(129,257,10,900);
+  bm.add("nstar_rot_axis_rat",[&nr]() {
+      nr.fix_cent_eden_axis_rat(2.0e15,0.59);
+      sink+=nr.Mass;
+    });
+  bm.add("nstar_rot_axis_rat_fine",[&nr2]() {
+      nr2.fix_cent_eden_axis_rat(2.0e15,0.59);
+      sink+=nr2.Mass;
+    });
+
+  // Supernova EOS lookups with all 16 base quantities on a synthetic
+  // table, for 100 points in the order of the zones of a hydro code
+  eos_sn_base esb;
+  esb.verbose=0;
+  size_t esz[3]={60,30,40};
+  vector<double> egrid;
+  for(size_t i=0;i<esz[0];i++) egrid.push_back(1.0e-8*pow(10.0,i/6.0));
+  for(size_t i=0;i<esz[1];i++) egrid.push_back(0.01+0.02*i);
+  for(size_t i=0;i<esz[2];i++) egrid.push_back(0.1*pow(10.0,i/15.0));
+  for(size_t iq=0;iq<eos_sn_base::n_base;iq++) {
+    tensor_grid3<> &tq=*esb.arr[iq];
+    tq.resize(3,esz);
+    tq.set_grid_packed(egrid);
+    for(size_t i=0;i<esz[0];i++) {
+      for(size_t j=0;j<esz[1];j++) {
+	for(size_t k=0;k<esz[2];k++) {
+	  tq.set(i,j,k,sin(i*0.1+j*0.2+k*0.3+iq));
+	}
+      }
+    }
+  }
+  esb.pack_data();
+  size_t n_zone=100;
+  vector<double> znb(n_zone), zye(n_zone), zt(n_zone);
+  for(size_t i=0;i<n_zone;i++) {
+    znb[i]=1.0e-7*pow(10.0,6.0*i/((double)n_zone));
+    zye[i]=0.05+0.4*i/((double)n_zone);
+    zt[i]=0.2+20.0*i/((double)n_zone);
+  }
+  bm.add("eos_sn_interp_linear",[&]() {
+      for(size_t i=0;i<n_zone;i++) {
+	for(size_t iq=0;iq<eos_sn_base::n_base;iq++) {
+	  sink+=esb.arr[iq]->interp_linear(znb[i],zye[i],zt[i]);
+	}
+      }
+    });
+  vector<double> zres(n_zone*eos_sn_base::n_base);
+  bm.add("eos_sn_interp_packed_vec",[&]() {
+      esb.interp_packed_vec(n_zone,&znb[0],&zye[0],&zt[0],&zres[0]);
+      sink+=zres[0];
+    });
+
+#endif
+
+#ifdef O2SCL_HDF
+
+  // ----------------------------------------------------------------
+  // HDF5 input and output
+
+  vector<double> hv(100000);
+  for(size_t i=0;i<hv.size();i++) hv[i]=sin((double)i);
+  {
+    hdf_file hf;
+    hf.open_or_create("bm_suite_read.o2");
+    hf.setd_vec("v",hv);
+    hdf_output(hf,tab,"tab");
+    hf.close();
+  }
+  bm.add("hdf_write",[&tab,&hv]() {
+      std::remove("bm_suite_write.o2");
+      hdf_file hf;
+      hf.open_or_create("bm_suite_write.o2");
+      hf.setd_vec("v",hv);
+      hdf_output(hf,tab,"tab");
+      hf.close();
+    });
+  bm.add("hdf_read",[]() {
+      hdf_file hf;
+      hf.open("bm_suite_read.o2");
+      vector<double> v;
+      hf.getd_vec("v",v);
+      table<> t;
+      hdf_input(hf,t,"tab");
+      hf.close();
+      sink+=v[v.size()-1]+t.get("y",0);
+    });
+
+#endif
+
+  bm.run();
+  bm.write_json(out_file);
+  cout << "Wrote results to " << out_file << "." << endl;
+
+  return 0;
+}
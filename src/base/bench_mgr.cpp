@@ -0,0 +1,340 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include <o2scl/bench_mgr.h>
+#include <o2scl/err_hnd.h>
+#include <o2scl/string_conv.h>
+#include <o2scl/lib_settings.h>
+
+using namespace std;
+using namespace o2scl;
+
+bench_mgr::bench_mgr() {
+  n_warmup=2;
+  n_reps=10;
+  min_time=0.01;
+  verbose=1;
+}
+
+void bench_mgr::add(std::string name, bench_funct f) {
+  names.push_back(name);
+  funcs.push_back(f);
+  return;
+}
+
+double bench_mgr::time_calls(bench_funct &f, size_t n) {
+  std::chrono::steady_clock::time_point t1=
+    std::chrono::steady_clock::now();
+  for(size_t i=0;i<n;i++) f();
+  std::chrono::steady_clock::time_point t2=
+    std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t2-t1).count();
+}
+
+void bench_mgr::run() {
+
+  if (n_reps==0) {
+    O2SCL_ERR("Number of repetitions zero in bench_mgr::run().",
+	      exc_einval);
+  }
+
+  results.clear();
+
+  if (verbose>0) {
+    cout << "name                            calls median (s)   "
+	 << "min (s)      std. dev." << endl;
+  }
+
+  for(size_t ib=0;ib<funcs.size();ib++) {
+
+    if (filter.length()>0 && names[ib].find(filter)==string::npos) {
+      continue;
+    }
+
+    // Warm up and determine the number of calls per repetition
+    // from the fastest warm-up call
+    double t_call=0.0;
+    for(size_t i=0;i<n_warmup;i++) {
+      double t=time_calls(funcs[ib],1);
+      if (i==0 || t<t_call) t_call=t;
+    }
+    size_t n_inner=1;
+    if (n_warmup>0 && t_call<min_time) {
+      if (t_call>0.0) n_inner=((size_t)(min_time/t_call))+1;
+      else n_inner=1000;
+    }
+
+    // Time the repetitions
+    vector<double> times(n_reps);
+    for(size_t i=0;i<n_reps;i++) {
+      times[i]=time_calls(funcs[ib],n_inner)/((double)n_inner);
+    }
+
+    bench_result br;
+    br.name=names[ib];
+    br.n_reps=n_reps;
+    br.n_inner=n_inner;
+    br.mean=0.0;
+    for(size_t i=0;i<n_reps;i++) br.mean+=times[i];
+    br.mean/=((double)n_reps);
+    br.std_dev=0.0;
+    if (n_reps>1) {
+      for(size_t i=0;i<n_reps;i++) {
+	br.std_dev+=(times[i]-br.mean)*(times[i]-br.mean);
+      }
+      br.std_dev=sqrt(br.std_dev/((double)(n_reps-1)));
+    }
+    std::sort(times.begin(),times.end());
+    br.min=times[0];
+    br.max=times[n_reps-1];
+    if (n_reps%2==0) {
+      br.median=(times[n_reps/2-1]+times[n_reps/2])/2.0;
+    } else {
+      br.median=times[n_reps/2];
+    }
+    results.push_back(br);
+
+    if (verbose>0) {
+      string name=br.name;
+      if (name.length()<30) name+=string(30-name.length(),' ');
+      cout << name << " ";
+      cout.width(6);
+      cout << n_inner << " " << br.median << " " << br.min << " "
+	   << br.std_dev << endl;
+    }
+  }
+
+  return;
+}
+
+void bench_mgr::write_json(std::string fname) const {
+
+  ofstream fout(fname.c_str());
+  if (!fout) {
+    O2SCL_ERR((((string)"Could not open file '")+fname+
+	       "' in bench_mgr::write_json().").c_str(),exc_efilenotfound);
+  }
+  fout.precision(10);
+  fout.setf(ios::scientific);
+
+  fout << "{" << endl;
+  fout << "  \"o2scl_version\": \"" << o2scl_settings.o2scl_version()
+       << "\"," << endl;
+  fout << "  \"n_warmup\": " << n_warmup << "," << endl;
+  fout << "  \"n_reps\": " << n_reps << "," << endl;
+  fout << "  \"min_time\": " << min_time << "," << endl;
+  fout << "  \"results\": [" << endl;
+  for(size_t i=0;i<results.size();i++) {
+    const bench_result &br=results[i];
+    // Escape quotes and backslashes in the name
+    string name;
+    for(size_t j=0;j<br.name.length();j++) {
+      if (br.name[j]=='\"' || br.name[j]=='\\') name+='\\';
+      name+=br.name[j];
+    }
+    fout << "    {\"name\": \"" << name << "\", "
+	 << "\"n_reps\": " << br.n_reps << ", "
+	 << "\"n_inner\": " << br.n_inner << "," << endl;
+    fout << "     \"min\": " << br.min << ", "
+	 << "\"median\": " << br.median << ", "
+	 << "\"mean\": " << br.mean << "," << endl;
+    fout << "     \"max\": " << br.max << ", "
+	 << "\"std_dev\": " << br.std_dev << "}";
+    if (i+1<results.size()) fout << ",";
+    fout << endl;
+  }
+  fout << "  ]" << endl;
+  fout << "}" << endl;
+
+  fout.close();
+
+  return;
+}
+
+void bench_mgr::read_json(std::string fname,
+			  std::vector<bench_result> &res) {
+
+  res.clear();
+
+  ifstream fin(fname.c_str());
+  if (!fin) {
+    O2SCL_ERR((((string)"Could not open file '")+fname+
+	       "' in bench_mgr::read_json().").c_str(),exc_efilenotfound);
+  }
+  stringstream ss;
+  ss << fin.rdbuf();
+  string s=ss.str();
+  fin.close();
+
+  // Only the objects in the "results" array are read, everything
+  // else in the file is ignored
+  size_t pos=s.find("\"results\"");
+  if (pos==string::npos) {
+    O2SCL_ERR((((string)"No results found in file '")+fname+
+	       "' in bench_mgr::read_json().").c_str(),exc_efailed);
+  }
+  pos=s.find('[',pos);
+  if (pos==string::npos) {
+    O2SCL_ERR((((string)"Results not an array in file '")+fname+
+	       "' in bench_mgr::read_json().").c_str(),exc_efailed);
+  }
+  pos++;
+
+  while (pos<s.length()) {
+
+    // Find the next object or the end of the array
+    while (pos<s.length() && s[pos]!='{' && s[pos]!=']') pos++;
+    if (pos>=s.length() || s[pos]==']') break;
+    pos++;
+
+    bench_result br;
+    bool done=false;
+    while (!done) {
+
+      // Read the key
+      while (pos<s.length() && s[pos]!='\"' && s[pos]!='}') pos++;
+      if (pos>=s.length()) {
+	O2SCL_ERR((((string)"Unterminated object in file '")+fname+
+		   "' in bench_mgr::read_json().").c_str(),exc_efailed);
+      }
+      if (s[pos]=='}') {
+	pos++;
+	break;
+      }
+      size_t end=s.find('\"',pos+1);
+      if (end==string::npos) {
+	O2SCL_ERR((((string)"Unterminated key in file '")+fname+
+		   "' in bench_mgr::read_json().").c_str(),exc_efailed);
+      }
+      string key=s.substr(pos+1,end-pos-1);
+      pos=s.find(':',end);
+      if (pos==string::npos) {
+	O2SCL_ERR((((string)"Missing value in file '")+fname+
+		   "' in bench_mgr::read_json().").c_str(),exc_efailed);
+      }
+      pos++;
+      while (pos<s.length() && isspace(s[pos])) pos++;
+
+      // Read the value, either a string or a number
+      if (pos<s.length() && s[pos]=='\"') {
+	string val;
+	pos++;
+	while (pos<s.length() && s[pos]!='\"') {
+	  if (s[pos]=='\\' && pos+1<s.length()) pos++;
+	  val+=s[pos];
+	  pos++;
+	}
+	pos++;
+	if (key=="name") br.name=val;
+      } else {
+	end=pos;
+	while (end<s.length() && s[end]!=',' && s[end]!='}' &&
+	       !isspace(s[end])) end++;
+	double val=o2scl::stod(s.substr(pos,end-pos));
+	pos=end;
+	if (key=="n_reps") br.n_reps=((size_t)val);
+	else if (key=="n_inner") br.n_inner=((size_t)val);
+	else if (key=="min") br.min=val;
+	else if (key=="median") br.median=val;
+	else if (key=="mean") br.mean=val;
+	else if (key=="max") br.max=val;
+	else if (key=="std_dev") br.std_dev=val;
+      }
+
+      while (pos<s.length() && isspace(s[pos])) pos++;
+      if (pos<s.length() && s[pos]=='}') {
+	pos++;
+	done=true;
+      }
+    }
+
+    res.push_back(br);
+  }
+
+  return;
+}
+
+size_t bench_mgr::compare(const std::vector<bench_result> &res_old,
+			  const std::vector<bench_result> &res_new,
+			  double tol, std::ostream &out) {
+
+  size_t n_regress=0;
+
+  out << "name                           old (s)      new (s)      "
+      << "ratio" << endl;
+
+  for(size_t i=0;i<res_new.size();i++) {
+
+    string name=res_new[i].name;
+    if (name.length()<30) name+=string(30-name.length(),' ');
+    out << name << " ";
+
+    bool found=false;
+    for(size_t j=0;j<res_old.size() && found==false;j++) {
+      if (res_old[j].name==res_new[i].name) {
+	found=true;
+	double ratio=0.0;
+	if (res_old[j].median>0.0) {
+	  ratio=res_new[i].median/res_old[j].median;
+	}
+	out << dtos(res_old[j].median) << " "
+	    << dtos(res_new[i].median) << " " << dtos(ratio);
+	if (ratio>1.0+tol) {
+	  out << " REGRESSION";
+	  n_regress++;
+	} else if (ratio>0.0 && ratio<1.0/(1.0+tol)) {
+	  out << " improved";
+	}
+	out << endl;
+      }
+    }
+    if (found==false) {
+      out << "(new)" << endl;
+    }
+  }
+
+  for(size_t j=0;j<res_old.size();j++) {
+    bool found=false;
+    for(size_t i=0;i<res_new.size() && found==false;i++) {
+      if (res_old[j].name==res_new[i].name) found=true;
+    }
+    if (found==false) {
+      string name=res_old[j].name;
+      if (name.length()<30) name+=string(30-name.length(),' ');
+      out << name << " (removed)" << endl;
+    }
+  }
+
+  out << n_regress << " regression(s) with tolerance " << tol << "." << endl;
+
+  return n_regress;
+}
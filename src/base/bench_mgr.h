@@ -0,0 +1,190 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_BENCH_MGR_H
+#define O2SCL_BENCH_MGR_H
+
+/** \file bench_mgr.h
+    \brief File defining \ref o2scl::bench_mgr
+*/
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <functional>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief The timing results for one benchmark from
+      \ref bench_mgr
+
+      All times are in seconds for a single call of the
+      benchmark function.
+  */
+  class bench_result {
+
+  public:
+
+    bench_result() {
+      n_reps=0;
+      n_inner=0;
+      min=0.0;
+      median=0.0;
+      mean=0.0;
+      max=0.0;
+      std_dev=0.0;
+    }
+
+    /// The benchmark name
+    std::string name;
+    /// The number of timed repetitions
+    size_t n_reps;
+    /// The number of calls in each repetition
+    size_t n_inner;
+    /// \name Statistics over the repetitions
+    //@{
+    /// Minimum time
+    double min;
+    /// Median time
+    double median;
+    /// Mean time
+    double mean;
+    /// Maximum time
+    double max;
+    /// Standard deviation
+    double std_dev;
+    //@}
+
+  };
+
+  /** \brief A class to manage a set of micro-benchmarks
+
+      Benchmarks are registered with \ref add() and timed with
+      \ref run(). Each benchmark is first called \ref n_warmup
+      times without being timed. The warm-up calls are also used to
+      determine the number of calls in each repetition, which is
+      chosen so that each repetition takes at least \ref min_time
+      seconds. The benchmark is then timed for \ref n_reps
+      repetitions and the time per call is summarized by the
+      minimum, median, mean, maximum, and standard deviation over
+      the repetitions.
+
+      The results can be written to a JSON file with \ref
+      write_json() and read back with \ref read_json(), and the
+      function \ref compare() compares two sets of results and
+      reports the benchmarks which have become slower. The
+      comparison uses the median, which is less sensitive to
+      occasional interruptions than the mean.
+
+      The benchmark functions should store their results somewhere
+      visible outside the function (for example in a member of a
+      class or a global variable) so that the compiler cannot
+      remove the work being timed.
+  */
+  class bench_mgr {
+
+  public:
+
+    typedef std::function<void()> bench_funct;
+
+    bench_mgr();
+
+    /// \name Parameters
+    //@{
+    /// Number of untimed calls before timing (default 2)
+    size_t n_warmup;
+    /// Number of timed repetitions (default 10)
+    size_t n_reps;
+    /// Minimum time in seconds for each repetition (default 0.01)
+    double min_time;
+    /** \brief If not empty, only run the benchmarks whose names
+	contain this string (default empty)
+    */
+    std::string filter;
+    /// Verbosity parameter (default 1)
+    int verbose;
+    //@}
+
+    /** \brief Add a benchmark named \c name which calls \c f
+     */
+    void add(std::string name, bench_funct f);
+
+    /** \brief Run all of the benchmarks which match
+	\ref filter
+    */
+    void run();
+
+    /** \brief Return the results from the last call to \ref run()
+     */
+    const std::vector<bench_result> &get_results() const {
+      return results;
+    }
+
+    /** \brief Write the results to the JSON file \c fname
+     */
+    void write_json(std::string fname) const;
+
+    /** \brief Read results written by \ref write_json()
+	from \c fname into \c res
+    */
+    static void read_json(std::string fname,
+			  std::vector<bench_result> &res);
+
+    /** \brief Compare the results in \c res_new to those in
+	\c res_old and return the number of regressions
+
+	A benchmark which is present in both sets is a regression
+	if the ratio of the new to the old median time is larger
+	than <tt>1+tol</tt>. A summary of all benchmarks is written
+	to \c out.
+    */
+    static size_t compare(const std::vector<bench_result> &res_old,
+			  const std::vector<bench_result> &res_new,
+			  double tol, std::ostream &out=std::cout);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The benchmark names
+    std::vector<std::string> names;
+
+    /// The benchmark functions
+    std::vector<bench_funct> funcs;
+
+    /// The results
+    std::vector<bench_result> results;
+
+    /// Time \c n calls of \c f and return the total time in seconds
+    double time_calls(bench_funct &f, size_t n);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
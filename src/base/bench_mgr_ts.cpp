@@ -0,0 +1,105 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <cmath>
+#include <sstream>
+
+#include <o2scl/bench_mgr.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+double sink=0.0;
+
+void short_func() {
+  for(size_t i=0;i<100;i++) sink+=sin(sink+i);
+  return;
+}
+
+void long_func() {
+  for(size_t i=0;i<10000;i++) sink+=sin(sink+i);
+  return;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(2);
+
+  bench_mgr bm;
+  bm.n_reps=5;
+  bm.min_time=1.0e-3;
+  bm.add("short",short_func);
+  bm.add("long",long_func);
+  bm.add("skipped \"x\"",short_func);
+  bm.filter="o";
+  bm.run();
+
+  const vector<bench_result> &res=bm.get_results();
+  t.test_gen(res.size()==2,"filter");
+  for(size_t i=0;i<res.size();i++) {
+    t.test_gen(res[i].n_reps==5,"n_reps");
+    t.test_gen(res[i].min<=res[i].median && res[i].median<=res[i].max,
+	       "ordering");
+    t.test_gen(res[i].n_inner*res[i].median>=bm.min_time/2.0,"n_inner");
+  }
+  t.test_gen(res[1].median>res[0].median,"timing");
+
+  // Write and read the results, including a name which
+  // requires escaping
+  bm.filter="";
+  bm.n_reps=3;
+  bm.run();
+  bm.write_json("bench_mgr_ts.json");
+  vector<bench_result> res2;
+  bench_mgr::read_json("bench_mgr_ts.json",res2);
+  t.test_gen(res2.size()==3,"read size");
+  for(size_t i=0;i<res2.size();i++) {
+    t.test_str(res2[i].name,bm.get_results()[i].name,"read name");
+    t.test_gen(res2[i].n_inner==bm.get_results()[i].n_inner,"read n_inner");
+    t.test_rel(res2[i].median,bm.get_results()[i].median,1.0e-8,
+	       "read median");
+    t.test_rel(res2[i].std_dev,bm.get_results()[i].std_dev,1.0e-8,
+	       "read std_dev");
+  }
+
+  // Identical results have no regressions
+  ostringstream out;
+  t.test_gen(bench_mgr::compare(res2,res2,0.1,out)==0,"compare same");
+
+  // A benchmark which is twice as slow is a regression, one which
+  // is slightly slower is not, and new or removed benchmarks
+  // are ignored
+  vector<bench_result> res3=res2;
+  res3[0].median*=2.0;
+  res3[1].median*=1.05;
+  res3[2].name="new";
+  t.test_gen(bench_mgr::compare(res2,res3,0.1,out)==1,"compare slower");
+  t.test_gen(bench_mgr::compare(res3,res2,0.1,out)==0,"compare faster");
+  cout << out.str();
+
+  t.report();
+  return 0;
+}
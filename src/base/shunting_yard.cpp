@@ -55,6 +55,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
 
 #include <o2scl/shunting_yard.h>
 
@@ -508,3 +509,219 @@ std::string calculator::RPN_to_string() {
   ss << " ] }";
   return ss.str();
 }
+
+const size_t calculator_compiled::block_size;
+
+calculator_compiled::opcode
+calculator_compiled::string_to_op(const std::string &str) {
+  if (str=="sin") return op_sin;
+  if (str=="cos") return op_cos;
+  if (str=="tan") return op_tan;
+  if (str=="sqrt") return op_sqrt;
+  if (str=="log") return op_log;
+  if (str=="exp") return op_exp;
+  if (str=="abs") return op_abs;
+  if (str=="log10") return op_log10;
+  if (str=="asin") return op_asin;
+  if (str=="acos") return op_acos;
+  if (str=="atan") return op_atan;
+  if (str=="sinh") return op_sinh;
+  if (str=="cosh") return op_cosh;
+  if (str=="tanh") return op_tanh;
+  if (str=="asinh") return op_asinh;
+  if (str=="acosh") return op_acosh;
+  if (str=="atanh") return op_atanh;
+  if (str=="+") return op_add;
+  if (str=="-") return op_sub;
+  if (str=="*") return op_mul;
+  if (str=="/") return op_div;
+  if (str=="^") return op_pow;
+  if (str=="<<") return op_shl;
+  if (str==">>") return op_shr;
+  if (str=="%") return op_mod;
+  if (str=="<") return op_lt;
+  if (str==">") return op_gt;
+  if (str=="<=") return op_leq;
+  if (str==">=") return op_geq;
+  if (str=="==") return op_eq;
+  if (str=="!=") return op_neq;
+  if (str=="&&") return op_and;
+  if (str=="||") return op_or;
+  throw std::domain_error("Unknown operator: '" + str + "'.");
+  return op_num;
+}
+
+void calculator_compiled::compile(const calculator &calc,
+				  const std::vector<std::string> &names) {
+
+  code.clear();
+  var_indices.clear();
+  max_depth=0;
+
+  // Map from variable name to index
+  std::map<std::string,size_t> name_map;
+  for(size_t i=0;i<names.size();i++) {
+    name_map.insert(std::make_pair(names[i],i));
+  }
+  
+  // Keep track of the stack depth to ensure the expression is valid
+  size_t depth=0;
+  
+  TokenQueue_t rpn=calc.RPN;
+  while (rpn.size()) {
+    TokenBase* base=rpn.front();
+    rpn.pop();
+    instr in;
+    in.index=0;
+    in.val=0.0;
+    if (base->type==NUM) {
+      in.op=op_num;
+      in.val=static_cast<Token<double>*>(base)->val;
+      depth++;
+    } else if (base->type==VAR) {
+      std::string key=static_cast<Token<std::string>*>(base)->val;
+      std::map<std::string,size_t>::iterator it=name_map.find(key);
+      if (it==name_map.end()) {
+	code.clear();
+        throw std::domain_error("Unable to find the variable '" + key + "'.");
+      }
+      in.op=op_var;
+      in.index=it->second;
+      var_indices.push_back(in.index);
+      depth++;
+    } else if (base->type==OP) {
+      in.op=string_to_op(static_cast<Token<std::string>*>(base)->val);
+      size_t nargs=(in.op<op_add) ? 1 : 2;
+      if (depth<nargs) {
+	code.clear();
+	throw std::domain_error("Invalid equation.");
+      }
+      depth-=nargs-1;
+    } else {
+      code.clear();
+      throw std::domain_error("Invalid token.");
+    }
+    if (depth>max_depth) max_depth=depth;
+    code.push_back(in);
+  }
+  
+  if (depth!=1) {
+    code.clear();
+    throw std::domain_error("Invalid equation.");
+  }
+
+  // Sort and remove duplicates from the list of variable indices
+  std::sort(var_indices.begin(),var_indices.end());
+  var_indices.erase(std::unique(var_indices.begin(),var_indices.end()),
+		    var_indices.end());
+  
+  return;
+}
+
+double calculator_compiled::eval(const double *vals) const {
+  double res;
+  // Use eval_block() with a single set of variables by
+  // pointing each variable to its value
+  std::vector<const double *> ptrs(var_indices.size()==0 ? 1 :
+				   var_indices.back()+1,(const double *)0);
+  for(size_t i=0;i<var_indices.size();i++) {
+    ptrs[var_indices[i]]=&vals[var_indices[i]];
+  }
+  eval_block(1,&ptrs[0],&res);
+  return res;
+}
+
+void calculator_compiled::eval_block(size_t n, const double * const *cols,
+				     double *res) const {
+  
+  if (code.size()==0) {
+    throw std::domain_error("No expression compiled in eval_block().");
+  }
+  
+  // Storage for the evaluation stack, one block of values for
+  // each level
+  std::vector<double> stack(max_depth*block_size);
+  double *st=&stack[0];
+  
+  for(size_t start=0;start<n;start+=block_size) {
+    
+    size_t nb=std::min(block_size,n-start);
+
+    // The current stack top
+    double *top=st-block_size;
+    
+    for(size_t ic=0;ic<code.size();ic++) {
+      const instr &in=code[ic];
+      
+      if (in.op==op_num) {
+	top+=block_size;
+	double val=in.val;
+	for(size_t k=0;k<nb;k++) top[k]=val;
+      } else if (in.op==op_var) {
+	top+=block_size;
+	const double *src=cols[in.index]+start;
+	for(size_t k=0;k<nb;k++) top[k]=src[k];
+      } else if (in.op<op_add) {
+	double *r=top;
+	switch (in.op) {
+	case op_sin: for(size_t k=0;k<nb;k++) r[k]=sin(r[k]); break;
+	case op_cos: for(size_t k=0;k<nb;k++) r[k]=cos(r[k]); break;
+	case op_tan: for(size_t k=0;k<nb;k++) r[k]=tan(r[k]); break;
+	case op_sqrt: for(size_t k=0;k<nb;k++) r[k]=sqrt(r[k]); break;
+	case op_log: for(size_t k=0;k<nb;k++) r[k]=log(r[k]); break;
+	case op_exp: for(size_t k=0;k<nb;k++) r[k]=exp(r[k]); break;
+	case op_abs: for(size_t k=0;k<nb;k++) r[k]=fabs(r[k]); break;
+	case op_log10: for(size_t k=0;k<nb;k++) r[k]=log10(r[k]); break;
+	case op_asin: for(size_t k=0;k<nb;k++) r[k]=asin(r[k]); break;
+	case op_acos: for(size_t k=0;k<nb;k++) r[k]=acos(r[k]); break;
+	case op_atan: for(size_t k=0;k<nb;k++) r[k]=atan(r[k]); break;
+	case op_sinh: for(size_t k=0;k<nb;k++) r[k]=sinh(r[k]); break;
+	case op_cosh: for(size_t k=0;k<nb;k++) r[k]=cosh(r[k]); break;
+	case op_tanh: for(size_t k=0;k<nb;k++) r[k]=tanh(r[k]); break;
+	case op_asinh: for(size_t k=0;k<nb;k++) r[k]=asinh(r[k]); break;
+	case op_acosh: for(size_t k=0;k<nb;k++) r[k]=acosh(r[k]); break;
+	case op_atanh: for(size_t k=0;k<nb;k++) r[k]=atanh(r[k]); break;
+	default: break;
+	}
+      } else {
+	const double *r=top;
+	top-=block_size;
+	double *l=top;
+	switch (in.op) {
+	case op_add: for(size_t k=0;k<nb;k++) l[k]=l[k]+r[k]; break;
+	case op_sub: for(size_t k=0;k<nb;k++) l[k]=l[k]-r[k]; break;
+	case op_mul: for(size_t k=0;k<nb;k++) l[k]=l[k]*r[k]; break;
+	case op_div: for(size_t k=0;k<nb;k++) l[k]=l[k]/r[k]; break;
+	case op_pow: for(size_t k=0;k<nb;k++) l[k]=pow(l[k],r[k]); break;
+	case op_shl:
+	  for(size_t k=0;k<nb;k++) l[k]=(int)l[k] << (int)r[k];
+	  break;
+	case op_shr:
+	  for(size_t k=0;k<nb;k++) l[k]=(int)l[k] >> (int)r[k];
+	  break;
+	case op_mod:
+	  for(size_t k=0;k<nb;k++) l[k]=(int)l[k] % (int)r[k];
+	  break;
+	case op_lt: for(size_t k=0;k<nb;k++) l[k]=l[k]<r[k]; break;
+	case op_gt: for(size_t k=0;k<nb;k++) l[k]=l[k]>r[k]; break;
+	case op_leq: for(size_t k=0;k<nb;k++) l[k]=l[k]<=r[k]; break;
+	case op_geq: for(size_t k=0;k<nb;k++) l[k]=l[k]>=r[k]; break;
+	case op_eq: for(size_t k=0;k<nb;k++) l[k]=l[k]==r[k]; break;
+	case op_neq: for(size_t k=0;k<nb;k++) l[k]=l[k]!=r[k]; break;
+	case op_and:
+	  for(size_t k=0;k<nb;k++) l[k]=(int)l[k] && (int)r[k];
+	  break;
+	case op_or:
+	  for(size_t k=0;k<nb;k++) l[k]=(int)l[k] || (int)r[k];
+	  break;
+	default: break;
+	}
+      }
+    }
+
+    // Copy the result from the bottom of the stack
+    for(size_t k=0;k<nb;k++) res[start+k]=st[k];
+  }
+  
+  return;
+}
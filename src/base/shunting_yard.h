@@ -60,9 +60,12 @@
 #include <stack>
 #include <string>
 #include <queue>
+#include <vector>
 
 namespace o2scl {
 
+  class calculator_compiled;
+
   /** \brief Token list for \ref o2scl::calculator
    */
   enum tokType {NONE,OP,VAR,NUM};
@@ -164,6 +167,9 @@ namespace o2scl {
      */
     TokenQueue_t RPN;
 
+    /// Allow the compiled form to read the RPN token queue
+    friend class o2scl::calculator_compiled;
+    
   public:
 
     ~calculator();
@@ -200,6 +206,120 @@ namespace o2scl {
     std::string RPN_to_string();
   };
 
+  /** \brief A compiled, vectorizable form of a \ref o2scl::calculator
+      expression
+
+      This class lowers the RPN token queue of a \ref calculator into
+      a flat list of instructions, resolving each variable name to an
+      index in a user-specified list of names. This allows repeated
+      evaluations without any string comparisons or map lookups, and
+      is used by \ref o2scl::table to compute columns from
+      functions.
+
+      The function \ref eval_block() evaluates the expression for
+      many sets of variables at once, operating on blocks of
+      \ref block_size values so that each instruction is a simple
+      loop over contiguous memory which the compiler can vectorize.
+      Both \ref eval() and \ref eval_block() are const and use only
+      local storage, so a single object may be shared between
+      threads.
+
+      The results are identical to those from \ref calculator::eval()
+      (including the integer casts in the <tt>%</tt>, <tt><<</tt>,
+      <tt>>></tt>, <tt>&&</tt> and <tt>||</tt> operators). Unlike
+      \ref calculator::eval(), unknown variables and operators are
+      reported when the expression is compiled rather than when 
+      it is evaluated.
+  */
+  class calculator_compiled {
+
+  public:
+
+    /// Instruction codes
+    enum opcode {op_num,op_var,
+		 op_sin,op_cos,op_tan,op_sqrt,op_log,op_exp,op_abs,
+		 op_log10,op_asin,op_acos,op_atan,op_sinh,op_cosh,
+		 op_tanh,op_asinh,op_acosh,op_atanh,
+		 op_add,op_sub,op_mul,op_div,op_pow,op_shl,op_shr,
+		 op_mod,op_lt,op_gt,op_leq,op_geq,op_eq,op_neq,
+		 op_and,op_or};
+
+    /// A single instruction
+    typedef struct {
+      /// The instruction code
+      opcode op;
+      /// Variable index (for \ref op_var only)
+      size_t index;
+      /// Constant value (for \ref op_num only)
+      double val;
+    } instr;
+
+    /// The number of values processed at once in \ref eval_block()
+    static const size_t block_size=256;
+
+    calculator_compiled() {
+      max_depth=0;
+    }
+
+    /** \brief Compile the expression in \c calc, resolving
+	variables to their indices in \c names
+
+	If a variable in the expression is not present in \c names,
+	or if the expression contains an unknown operator, then
+	<tt>std::domain_error</tt> is thrown.
+    */
+    void compile(const calculator &calc,
+		 const std::vector<std::string> &names);
+
+    /** \brief Evaluate the expression using the variable
+	values in \c vals
+
+	The array \c vals is indexed in the same way as the
+	list of names given to \ref compile(). Only the entries
+	listed in \ref get_var_indices() are accessed.
+    */
+    double eval(const double *vals) const;
+
+    /** \brief Evaluate the expression for \c n sets of variables
+
+	The value of variable \c i for set \c k is taken from
+	<tt>cols[i][k]</tt>, and the result is stored in
+	<tt>res[k]</tt>. Only the pointers listed in 
+	\ref get_var_indices() are accessed, so the others 
+	may be null.
+    */
+    void eval_block(size_t n, const double * const *cols,
+		    double *res) const;
+
+    /** \brief Return the sorted list of distinct variable indices
+	used by the expression
+    */
+    const std::vector<size_t> &get_var_indices() const {
+      return var_indices;
+    }
+
+    /** \brief Return true if an expression has been compiled
+     */
+    bool is_compiled() const {
+      return code.size()>0;
+    }
+
+  protected:
+
+    /// The instruction list
+    std::vector<instr> code;
+
+    /// The variable indices used
+    std::vector<size_t> var_indices;
+    
+    /// The maximum stack depth required for evaluation
+    size_t max_depth;
+
+    /// Convert an operator string to an instruction code
+    static opcode string_to_op(const std::string &str);
+
+  };
+
 }
 
 // End of "#ifndef O2SCL_SHUNTING_YARD_H"
@@ -149,6 +149,47 @@ int main(void) {
   cout << calc.RPN_to_string() << endl;
   t.test_rel(calc.eval(0),0.5,1.0e-14,"calc34");
 
+  // Test the compiled form with variables
+  {
+    std::map<std::string,double> vars;
+    vars["x"]=0.5;
+    vars["y"]=3.0;
+    std::vector<std::string> names={"y","x"};
+    calc.compile("-exp(x+sin(4*y))/(x^2+1)+(y>x)+(7%y)",0);
+    calculator_compiled cc;
+    cc.compile(calc,names);
+    t.test_gen(cc.get_var_indices().size()==2,"compiled 1");
+    double vals[2]={3.0,0.5};
+    t.test_rel(cc.eval(vals),calc.eval(&vars),1.0e-15,"compiled 2");
+
+    // Evaluate a block larger than block_size and compare
+    size_t n=calculator_compiled::block_size*2+5;
+    std::vector<double> xv(n), yv(n), res(n);
+    for(size_t i=0;i<n;i++) {
+      xv[i]=((double)i)/100.0;
+      yv[i]=sqrt((double)i)+1.0;
+    }
+    const double *cols[2]={&yv[0],&xv[0]};
+    cc.eval_block(n,cols,&res[0]);
+    bool match=true;
+    for(size_t i=0;i<n;i++) {
+      vars["x"]=xv[i];
+      vars["y"]=yv[i];
+      if (res[i]!=calc.eval(&vars)) match=false;
+    }
+    t.test_gen(match,"compiled 3");
+
+    // Unknown variables are reported at compile time
+    calc.compile("x+z",0);
+    bool thrown=false;
+    try {
+      cc.compile(calc,names);
+    } catch (std::domain_error &e) {
+      thrown=true;
+    }
+    t.test_gen(thrown,"compiled 4");
+  }
+
   t.report();
   return 0;
 }
@@ -0,0 +1,128 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#include <o2scl/sort_perm.h>
+
+using namespace std;
+using namespace o2scl;
+
+sort_perm::sort_perm() {
+  n_threads=1;
+}
+
+void sort_perm::add_key(const double *x, bool descending) {
+  keys.push_back(x);
+  desc.push_back(descending);
+  return;
+}
+
+void sort_perm::clear_keys() {
+  keys.clear();
+  desc.clear();
+  return;
+}
+
+bool sort_perm::less(size_t i, size_t j) const {
+  for(size_t k=0;k<keys.size();k++) {
+    double a=keys[k][i], b=keys[k][j];
+    bool a_nan=std::isnan(a), b_nan=std::isnan(b);
+    if (a_nan || b_nan) {
+      if (a_nan && b_nan) continue;
+      return b_nan;
+    }
+    if (a!=b) {
+      if (desc[k]) return a>b;
+      return a<b;
+    }
+  }
+  return false;
+}
+
+void sort_perm::merge(const std::vector<size_t> &src,
+		      std::vector<size_t> &dest,
+		      size_t lo, size_t mid, size_t hi) const {
+  // Take from the left range when the keys are equal so that
+  // the merge is stable
+  size_t i=lo, j=mid, k=lo;
+  while (i<mid && j<hi) {
+    if (less(src[j],src[i])) dest[k++]=src[j++];
+    else dest[k++]=src[i++];
+  }
+  while (i<mid) dest[k++]=src[i++];
+  while (j<hi) dest[k++]=src[j++];
+  return;
+}
+
+void sort_perm::compute(size_t n, std::vector<size_t> &order) const {
+
+  order.resize(n);
+  for(size_t j=0;j<n;j++) order[j]=j;
+  if (n<2 || keys.size()==0) return;
+
+  // Use at most one block for every 1024 rows, since small
+  // blocks are not worth the overhead
+  size_t nt=n_threads;
+  if (nt<1) nt=1;
+  if (nt>n/1024+1) nt=n/1024+1;
+
+  // The block boundaries
+  std::vector<size_t> bound(nt+1);
+  for(size_t ib=0;ib<=nt;ib++) bound[ib]=n*ib/nt;
+
+  // Sort each block
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(static)
+#endif
+  for(size_t ib=0;ib<nt;ib++) {
+    std::stable_sort(order.begin()+bound[ib],order.begin()+bound[ib+1],
+		     [this](size_t i, size_t j) { return less(i,j); });
+  }
+
+  // Merge pairs of neighboring blocks until one block remains
+  std::vector<size_t> tmp(n);
+  for(size_t width=1;width<nt;width*=2) {
+    size_t n_merge=(nt+2*width-1)/(2*width);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+    for(size_t im=0;im<n_merge;im++) {
+      size_t lo=bound[2*width*im];
+      size_t mid=bound[std::min(2*width*im+width,nt)];
+      size_t hi=bound[std::min(2*width*(im+1),nt)];
+      merge(order,tmp,lo,mid,hi);
+    }
+    std::swap(order,tmp);
+  }
+
+  return;
+}
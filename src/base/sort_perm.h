@@ -0,0 +1,133 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_SORT_PERM_H
+#define O2SCL_SORT_PERM_H
+
+/** \file sort_perm.h
+    \brief File defining \ref o2scl::sort_perm
+*/
+
+#include <vector>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Compute and apply a sorting permutation for several
+      columns of data
+
+      This class is used by \ref table::sort_table() and \ref
+      table3d::sort_grid() to sort data stored in columns without
+      making a copy of the entire object. The sort keys are
+      specified with \ref add_key() and compared in the order in
+      which they were added, so that the second key is used only
+      when the first key is equal, and so on. Each key may be sorted
+      in ascending or descending order. Values which are not a
+      number are placed after all other values for either order.
+
+      The permutation is computed by \ref compute() with a stable
+      sort, so rows for which all of the keys are equal keep their
+      original order. If OpenMP support is enabled and \ref n_threads
+      is larger than one, the rows are divided into blocks which are
+      sorted in parallel and then merged in parallel. The result
+      does not depend on the number of threads. The permutation is
+      then applied to each column with \ref apply(), which requires
+      only a single scratch column.
+  */
+  class sort_perm {
+
+  public:
+
+    sort_perm();
+
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+
+    /** \brief Add a key given by the \c n values in \c x (for
+	the \c n given in the call to \ref compute())
+    */
+    void add_key(const double *x, bool descending=false);
+
+    /// Remove all keys
+    void clear_keys();
+
+    /// The number of keys
+    size_t n_keys() const {
+      return keys.size();
+    }
+
+    /** \brief Compute the permutation which sorts the first \c n
+	values of each key
+
+	After this function, element \c j of the sorted data is
+	element <tt>order[j]</tt> of the unsorted data.
+    */
+    void compute(size_t n, std::vector<size_t> &order) const;
+
+    /** \brief Apply the permutation \c order to the first \c n
+	elements of the vector \c v
+
+	The vector \c scratch is resized if necessary so that it can
+	be reused for several columns.
+    */
+    template<class vec_t, class data_t=double>
+    static void apply(size_t n, const std::vector<size_t> &order,
+		      vec_t &v, std::vector<data_t> &scratch) {
+      if (scratch.size()<n) scratch.resize(n);
+      for(size_t j=0;j<n;j++) {
+	scratch[j]=v[order[j]];
+      }
+      for(size_t j=0;j<n;j++) {
+	v[j]=scratch[j];
+      }
+      return;
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The data for each key
+    std::vector<const double *> keys;
+
+    /// If true, the corresponding key is sorted in descending order
+    std::vector<bool> desc;
+
+    /// Return true if row \c i should be placed before row \c j
+    bool less(size_t i, size_t j) const;
+
+    /** \brief Merge the sorted ranges <tt>[lo,mid)</tt> and
+	<tt>[mid,hi)</tt> of \c src into \c dest
+    */
+    void merge(const std::vector<size_t> &src, std::vector<size_t> &dest,
+	       size_t lo, size_t mid, size_t hi) const;
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <o2scl/sort_perm.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(2);
+
+  // A small example with a tie and a value which is not a number
+  double nan=std::numeric_limits<double>::quiet_NaN();
+  double x[6]={3.0,1.0,nan,2.0,1.0,0.0};
+  double y[6]={0.0,5.0,0.0,0.0,6.0,0.0};
+  sort_perm sp;
+  sp.add_key(x);
+  vector<size_t> order;
+  sp.compute(6,order);
+  size_t exp1[6]={5,1,4,3,0,2};
+  t.test_gen(std::equal(order.begin(),order.end(),exp1),"ascending");
+
+  sp.clear_keys();
+  sp.add_key(x,true);
+  sp.compute(6,order);
+  size_t exp2[6]={0,3,1,4,5,2};
+  t.test_gen(std::equal(order.begin(),order.end(),exp2),"descending");
+
+  // The second key is used for the tie
+  sp.clear_keys();
+  sp.add_key(x);
+  sp.add_key(y,true);
+  sp.compute(6,order);
+  size_t exp3[6]={5,4,1,3,0,2};
+  t.test_gen(std::equal(order.begin(),order.end(),exp3),"two keys");
+
+  vector<double> scratch;
+  sort_perm::apply(6,order,y,scratch);
+  t.test_gen(y[1]==6.0 && y[2]==5.0,"apply");
+
+  // A larger example with many ties. The permutation should be the
+  // same as that from std::stable_sort() for any number of threads.
+  size_t n=100000;
+  vector<double> a(n), b(n);
+  for(size_t i=0;i<n;i++) {
+    a[i]=((double)((i*7919)%100));
+    b[i]=floor(10.0*sin(((double)i)));
+  }
+  vector<size_t> ref(n);
+  for(size_t i=0;i<n;i++) ref[i]=i;
+  std::stable_sort(ref.begin(),ref.end(),[&](size_t i, size_t j) {
+      if (a[i]!=a[j]) return a[i]<a[j];
+      return b[i]>b[j];
+    });
+  sp.clear_keys();
+  sp.add_key(&a[0]);
+  sp.add_key(&b[0],true);
+  for(size_t nt=1;nt<=5;nt+=2) {
+    sp.n_threads=nt;
+    sp.compute(n,order);
+    t.test_gen(order==ref,"stable sort");
+  }
+
+  t.report();
+  return 0;
+}
@@ -38,6 +38,8 @@
 #include <boost/numeric/ublas/matrix.hpp>
 
 #include <o2scl/misc.h>
+#include <o2scl/text_mmap.h>
+#include <o2scl/sort_perm.h>
 #include <o2scl/interp.h>
 
 #include <o2scl/shunting_yard.h>
@@ -59,8 +61,16 @@ namespace o2scl_hdf {
 		  std::string name);
   template<class vec_t>
     void hdf_input_data(hdf_file &hf, o2scl::table<vec_t> &t);
+  template<class vec_t>
+    void hdf_input_data_slice(hdf_file &hf, o2scl::table<vec_t> &t,
+			      const std::vector<std::string> &cols,
+			      size_t row_start, size_t n_rows,
+			      std::vector<size_t> &col_index);
   void hdf_output_data(hdf_file &hf, 
 		       o2scl::table<std::vector<double> > &t);
+  void hdf_output_data_append(hdf_file &hf, 
+			      o2scl::table<std::vector<double> > &t,
+			      size_t row_start, size_t file_offset);
 }
 
 #endif
@@ -117,7 +127,7 @@ namespace o2scl {
       The columns are automatically sorted by name for speed, the
       results can be accessed from \ref get_sorted_name(). Individual
       columns can be sorted (\ref sort_column() ), or the entire table
-      can be sorted by one column (\ref sort_table() ).
+      can be sorted by one or more columns (\ref sort_table() ).
 
       <B> Data representation </b> \n
 
@@ -2194,29 +2204,64 @@ namespace o2scl {
 
   /** \brief Sort the entire table by the column \c scol
 
-      \note This function works by allocating space for an entirely
-      new chunk of memory for the data in the table.
+      This function calls \ref sort_table(const std::vector<std::string>
+      &, const std::vector<bool> &, size_t) with a single
+      key in ascending order.
   */
   void sort_table(std::string scol) {
+    std::vector<std::string> cols(1,scol);
+    sort_table(cols,std::vector<bool>());
+    return;
+  }
 
-    size_t ncols=get_ncolumns(), nlins=get_nlines();
+  /** \brief Sort the entire table by the columns in \c cols
 
-    // Make a copy of the table
-    boost::numeric::ublas::matrix<double> data_copy(ncols,nlins);
-    for(size_t i=0;i<ncols;i++) {
-      for(size_t j=0;j<nlins;j++) {
-	data_copy(i,j)=get(i,j);
+      The table is sorted by the first column in \c cols, rows with
+      equal values in the first column are sorted by the second
+      column, and so on. If <tt>descending[i]</tt> is true, the
+      column <tt>cols[i]</tt> is sorted in descending order. If \c
+      descending has fewer entries than \c cols, then the remaining
+      columns are sorted in ascending order. Rows with equal values
+      in all of the specified columns keep their original order.
+      Values which are not a number are placed last.
+
+      The sorting permutation is computed with \ref sort_perm using
+      \c n_threads OpenMP threads, and then applied to each column
+      in place using one scratch column. This requires
+      that the column storage type \c vec_t stores its elements
+      contiguously.
+  */
+  void sort_table(const std::vector<std::string> &cols,
+		  const std::vector<bool> &descending, size_t n_threads=1) {
+
+    if (cols.size()==0) {
+      O2SCL_ERR("No columns specified in table::sort_table().",
+		exc_einval);
+    }
+    for(size_t i=0;i<cols.size();i++) {
+      if (atree.find(cols[i])==atree.end()) {
+	O2SCL_ERR((((std::string)"Column '")+cols[i]+
+		   "' not found in table::sort_table().").c_str(),
+		  exc_enotfound);
       }
     }
 
-    permutation order(nlins);
-    aiter it=atree.find(scol);
-    vec_t &data=it->second.dat;
-    vector_sort_index(nlins,data,order);
-    for(size_t i=0;i<ncols;i++) {
-      for(size_t j=0;j<nlins;j++) {
-	set(i,j,data_copy(i,order[j]));
-      }
+    size_t nlins=get_nlines();
+    if (nlins<2) return;
+
+    sort_perm sp;
+    sp.n_threads=n_threads;
+    for(size_t i=0;i<cols.size();i++) {
+      bool desc=false;
+      if (i<descending.size()) desc=descending[i];
+      sp.add_key(&(atree.find(cols[i])->second.dat[0]),desc);
+    }
+    std::vector<size_t> order;
+    sp.compute(nlins,order);
+
+    std::vector<double> scratch(nlins);
+    for(aiter it=atree.begin();it!=atree.end();it++) {
+      sort_perm::apply(nlins,order,it->second.dat,scratch);
     }
   
     if (intp_set) {
@@ -2485,6 +2530,102 @@ namespace o2scl {
     return 0;
   }
 
+  /** \brief Clear the current table and read from a generic data
+      file named \c fname
+
+      This function reads the same file format as \ref
+      read_generic() and gives the same table (except that the
+      remainder of an incomplete last row is always set to zero),
+      but is much faster for large files. As in \ref
+      read_generic(), reading stops at the first entry which is not
+      a plain decimal number, including <tt>nan</tt>, <tt>inf</tt>,
+      and hexadecimal numbers. The file is read with \ref
+      text_mmap, which maps the file into memory, divides it into
+      chunks which are processed with \c n_threads OpenMP threads,
+      and converts the numbers without the overhead of the C++
+      streams. The data is stored directly in the columns, which
+      are allocated once after the number of entries in the file
+      is determined. If \c verbose is greater than zero, the size
+      of the file and an estimate of the number of lines is output
+      before the data is read.
+
+      \note This function requires that the column type \c vec_t
+      store its elements contiguously.
+  */
+  virtual int read_generic_file(std::string fname, int verbose=0,
+				size_t n_threads=1) {
+
+    text_mmap tm;
+    tm.n_threads=n_threads;
+    tm.open(fname);
+    if (verbose>0) {
+      std::cout << "File '" << fname << "' has " << tm.size()
+		<< " bytes and approximately " << tm.estimate_lines()
+		<< " lines." << std::endl;
+    }
+
+    clear_table();
+
+    // Read first line and into list
+    std::string line, cname;
+    std::vector<std::string> onames, nnames;
+    size_t pos=tm.get_line(0,line);
+    std::istringstream is(line);
+    while (is >> cname) {
+      onames.push_back(cname);
+      if (verbose>2) {
+	std::cout << "Read possible column name: " << cname << std::endl;
+      }
+    }
+
+    // Count number of likely numbers in the first row
+    size_t n_nums=0;
+    for(size_t i=0;i<onames.size();i++) {
+      if (is_number(onames[i])) n_nums++;
+    }
+
+    if (n_nums==onames.size()) {
+
+      if (verbose>0) {
+	std::cout << "First row looks like it contains numerical values." 
+		  << std::endl;
+	std::cout << "Creating generic column names: ";
+      }
+      for(size_t i=0;i<onames.size();i++) {
+	nnames.push_back(((std::string)"c")+szttos(i+1));
+	if (verbose>0) std::cout << nnames[i] << " ";
+      }
+      if (verbose>0) std::cout << std::endl;
+
+      // The first row is data
+      pos=0;
+
+    } else {
+
+      // Ensure good column names
+      for(size_t i=0;i<onames.size();i++) {
+	std::string temps=onames[i];
+	make_fp_varname(temps);
+	make_unique_name(temps,nnames);
+	nnames.push_back(temps);
+	if (temps!=onames[i] && verbose>0) {
+	  std::cout << "Converted column named '" << onames[i] << "' to '" 
+		    << temps << "'." << std::endl;
+	}
+      }
+
+    }
+
+    // Make columns
+    for(size_t i=0;i<nnames.size();i++) {
+      new_column(nnames[i]);
+    }
+
+    read_generic_data(tm,pos,verbose);
+
+    return 0;
+  }
+
   /** \brief Return 0 if the tree and list are properly synchronized
    */
   void check_synchro() const {
@@ -2565,32 +2706,18 @@ namespace o2scl {
       }
     }
 
-    std::map<std::string,double> vars;
-    std::map<std::string,double>::const_iterator mit;
-    for(mit=constants.begin();mit!=constants.end();mit++) {
-      vars[mit->first]=mit->second;
-    }
-    
-    std::vector<calculator> calcs(funcs.size());
+    // Compile all of the functions before any columns are modified
+    std::vector<calculator_compiled> ccs(funcs.size());
     std::vector<vec_t> newcols(funcs.size());
     
     for(size_t j=0;j<funcs.size();j++) {
-      calcs[j].compile(funcs[j].c_str(),&vars);
+      compile_function(funcs[j],ccs[j]);
       newcols[j].resize(maxlines);
     }
     
     // Calculate all of the columns in the newcols list:
-    for(size_t i=0;i<nlines;i++) {
-      
-      // Record the values of the variables for this line:
-      for(size_t j=0;j<atree.size();j++) {
-	vars[get_column_name(j)]=(*this)[j][i];
-      }
-      
-      // Evaluate the new columns
-      for(size_t j=0;j<funcs.size();j++) {
-	newcols[j][i]=calcs[j].eval(&vars);
-      }
+    for(size_t j=0;j<funcs.size();j++) {
+      eval_compiled(ccs[j],newcols[j]);
     }
 
     for(size_t j=0;j<funcs.size();j++) {
@@ -2647,28 +2774,15 @@ namespace o2scl {
   int function_vector(std::string function, resize_vec_t &vec,
 		      bool throw_on_err=true) {
     
-    // Parse function
-    calculator calc;
-    std::map<std::string,double> vars;
-    std::map<std::string,double>::const_iterator mit;
-    for(mit=constants.begin();mit!=constants.end();mit++) {
-      vars[mit->first]=mit->second;
-    }
-    calc.compile(function.c_str(),&vars);
+    // Parse function and resolve column names
+    calculator_compiled cc;
+    compile_function(function,cc);
 
     // Resize vector if necessary
     if (vec.size()<nlines) vec.resize(nlines);
 
-    // Create space for column values
-    std::vector<double> vals(atree.size());
-  
     // Create column from function
-    for(size_t j=0;j<nlines;j++) {
-      for(aciter it=atree.begin();it!=atree.end();it++) {
-	vars[it->first]=it->second.dat[j];
-      }
-      vec[j]=calc.eval(&vars);
-    }
+    eval_compiled(cc,vec);
 
     return 0;
   }
@@ -2677,20 +2791,18 @@ namespace o2scl {
    */
   double row_function(std::string function, size_t row) const {
 
-    // Parse function
-    calculator calc;
-    std::map<std::string,double> vars;
-    std::map<std::string,double>::const_iterator mit;
-    for(mit=constants.begin();mit!=constants.end();mit++) {
-      vars[mit->first]=mit->second;
-    }
-    calc.compile(function.c_str(),&vars);
+    // Parse function and resolve column names
+    calculator_compiled cc;
+    compile_function(function,cc);
 
-    for(aciter it=atree.begin();it!=atree.end();it++) {
-      vars[it->first]=it->second.dat[row];
+    // Collect the values of the columns which are used
+    std::vector<double> vals(atree.size());
+    const std::vector<size_t> &vix=cc.get_var_indices();
+    for(size_t k=0;k<vix.size();k++) {
+      vals[vix[k]]=alist[vix[k]]->second.dat[row];
     }
 
-    double dret=calc.eval(&vars);
+    double dret=cc.eval(vals.size()>0 ? &vals[0] : 0);
     return dret;
   }
 
@@ -2698,22 +2810,19 @@ namespace o2scl {
   */
   size_t function_find_row(std::string function) const {
 
-    // Parse function
-    calculator calc;
-    std::map<std::string,double> vars;
-    std::map<std::string,double>::const_iterator mit;
-    for(mit=constants.begin();mit!=constants.end();mit++) {
-      vars[mit->first]=mit->second;
-    }
-    calc.compile(function.c_str(),&vars);
+    // Parse function and resolve column names
+    calculator_compiled cc;
+    compile_function(function,cc);
 
+    if (nlines==0) return 0;
+    
+    std::vector<double> fvals(nlines);
+    eval_compiled(cc,fvals);
+    
     double best_val=0.0;
     size_t best_row=0;
     for(size_t row=0;row<nlines-1;row++) {
-      for(aciter it=atree.begin();it!=atree.end();it++) {
-	vars[it->first]=it->second.dat[row];
-      }
-      double dtemp=calc.eval(&vars);
+      double dtemp=fvals[row];
       if (row==0) {
 	best_val=dtemp;
       } else {
@@ -2726,6 +2835,81 @@ namespace o2scl {
   
     return best_row;
   }
+
+  /** \brief Compile the function specified in \c function
+      into \c cc, resolving the column names to column indices
+
+      Constants in the table are substituted into the
+      expression. The object \c cc can then be used with
+      \ref eval_compiled() as long as columns are not added,
+      deleted or renamed.
+  */
+  void compile_function(std::string function,
+			calculator_compiled &cc) const {
+
+    calculator calc;
+    std::map<std::string,double> vars;
+    std::map<std::string,double>::const_iterator mit;
+    for(mit=constants.begin();mit!=constants.end();mit++) {
+      vars[mit->first]=mit->second;
+    }
+    calc.compile(function.c_str(),&vars);
+
+    std::vector<std::string> names(atree.size());
+    for(size_t i=0;i<atree.size();i++) {
+      names[i]=alist[i]->first;
+    }
+    cc.compile(calc,names);
+    
+    return;
+  }
+
+  /** \brief Evaluate a compiled function for every row, storing
+      the result in \c vec
+
+      The rows are processed in chunks: the columns which are used
+      by the function are copied into contiguous blocks which are
+      then evaluated with \ref calculator_compiled::eval_block().
+      If \c O2SCL_OPENMP is defined, the chunks are distributed
+      over the available threads. The vector \c vec must already
+      have at least \ref get_nlines() elements.
+  */
+  template<class vec2_t>
+  void eval_compiled(const calculator_compiled &cc, vec2_t &vec) const {
+
+    const std::vector<size_t> &vix=cc.get_var_indices();
+    const size_t chunk=16*calculator_compiled::block_size;
+    int nchunks=(int)((nlines+chunk-1)/chunk);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared)
+#endif
+    {
+      // Thread-local storage for the column blocks and results
+      std::vector<double> buf(vix.size()*chunk), res(chunk);
+      std::vector<const double *> ptrs(atree.size(),(const double *)0);
+      for(size_t k=0;k<vix.size();k++) {
+	ptrs[vix[k]]=&buf[k*chunk];
+      }
+      
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(int ic=0;ic<nchunks;ic++) {
+	size_t row0=((size_t)ic)*chunk;
+	size_t n=std::min(chunk,nlines-row0);
+	for(size_t k=0;k<vix.size();k++) {
+	  const vec_t &dat=alist[vix[k]]->second.dat;
+	  double *b=&buf[k*chunk];
+	  for(size_t j=0;j<n;j++) b[j]=dat[row0+j];
+	}
+	cc.eval_block(n,ptrs.size()>0 ? &ptrs[0] : 0,&res[0]);
+	for(size_t j=0;j<n;j++) vec[row0+j]=res[j];
+      }
+    }
+    
+    return;
+  }
   //@}
 
   // ---------
@@ -2739,9 +2923,18 @@ namespace o2scl {
   friend void o2scl_hdf::hdf_output_data
   (o2scl_hdf::hdf_file &hf, table<> &t);
   
+  friend void o2scl_hdf::hdf_output_data_append
+  (o2scl_hdf::hdf_file &hf, table<> &t, size_t row_start,
+   size_t file_offset);
+  
   template<class vecf_t> friend void o2scl_hdf::hdf_input_data
   (o2scl_hdf::hdf_file &hf, table<vecf_t> &t);
   
+  template<class vecf_t> friend void o2scl_hdf::hdf_input_data_slice
+  (o2scl_hdf::hdf_file &hf, table<vecf_t> &t,
+   const std::vector<std::string> &cols, size_t row_start,
+   size_t n_rows, std::vector<size_t> &col_index);
+  
   // ---------
   
 #ifndef DOXYGEN_INTERNAL
@@ -2752,6 +2945,48 @@ namespace o2scl {
    */
   std::map<std::string,double> constants;
 
+  /** \brief Read the data after byte \c pos in the file opened
+      in \c tm into the current columns
+
+      This is used by \ref read_generic_file() . As in \ref
+      read_generic(), reading stops at the first entry which is not
+      a number. The remainder of an incomplete last row is set to
+      zero.
+  */
+  void read_generic_data(text_mmap &tm, size_t pos, int verbose) {
+
+    size_t ncols=get_ncolumns();
+    if (ncols==0) return;
+
+    // Allocate space for all of the rows at once
+    size_t n_words=tm.count_words(pos);
+    size_t n_rows=(n_words+ncols-1)/ncols;
+    if (n_rows==0) {
+      set_nlines(0);
+      return;
+    }
+    set_maxlines(n_rows);
+
+    std::vector<double *> ptrs(ncols);
+    for(size_t i=0;i<ncols;i++) {
+      ptrs[i]=&(alist[i]->second.dat[0]);
+    }
+    size_t n_good=tm.parse_words(ncols,ptrs);
+
+    n_rows=(n_good+ncols-1)/ncols;
+    for(size_t k=n_good;k<n_rows*ncols;k++) {
+      ptrs[k%ncols][k/ncols]=0.0;
+    }
+    set_nlines(n_rows);
+
+    if (verbose>0) {
+      std::cout << "Read " << n_rows << " rows and " << ncols
+		<< " columns." << std::endl;
+    }
+
+    return;
+  }
+
   /** \brief Set the elements of alist with the appropriate 
       iterators from atree. \f$ {\cal O}(C) \f$
 
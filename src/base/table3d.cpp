@@ -34,6 +34,7 @@ table3d::table3d() {
   size_set=false;
   has_slice=false;
   itype=itp_cspline;
+  intp_cache=true;
 }
 
 table3d::~table3d() {
@@ -56,6 +57,7 @@ table3d::table3d(table_units<> &t, std::string colx, std::string coly) {
   size_set=false;
   has_slice=false;
   itype=itp_cspline;
+  intp_cache=true;
   
   // Create grid vectors
 
@@ -303,6 +305,7 @@ void table3d::set_size(size_t nx, size_t ny) {
   numx=nx;
   numy=ny;
   size_set=true;
+  clear_interp_cache();
   return;
 }
 
@@ -313,12 +316,14 @@ void table3d::set_slice_all(std::string name, double val) {
       (list[z])(i,j)=val;
     }
   }
+  reset_cache(z);
   return;
 }
 
 void table3d::set(size_t ix, size_t iy, std::string name, double val) {
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
 
@@ -329,6 +334,7 @@ void table3d::set_val(double x, double y, std::string name, double val) {
   
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
     
@@ -341,11 +347,13 @@ void table3d::set_val_ret(double &x, double &y, std::string name, double val) {
 
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
     
 void table3d::set(size_t ix, size_t iy, size_t z, double val) {
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
 
@@ -357,6 +365,7 @@ void table3d::set_val(double x, double y, size_t z, double val) {
   y=yval[iy];
   
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
     
@@ -366,11 +375,13 @@ void table3d::set_val_ret(double &x, double &y, size_t z, double val) {
   lookup_y(y,iy);
 
   (list[z])(ix,iy)=val;
+  reset_cache(z);
   return;
 }
     
 double &table3d::get(size_t ix, size_t iy, std::string name) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -386,6 +397,7 @@ double &table3d::get_val_ret(double &x, double &y, std::string name) {
   x=xval[ix];
   y=yval[iy];
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -405,6 +417,7 @@ double &table3d::get_val(double x, double y, std::string name) {
   lookup_x(x,ix);
   lookup_y(y,iy);
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
     
@@ -417,6 +430,7 @@ const double &table3d::get_val(double x, double y, std::string name) const {
 }
     
 double &table3d::get(size_t ix, size_t iy, size_t z) {
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -430,6 +444,7 @@ double &table3d::get_val_ret(double &x, double &y, size_t z) {
   lookup_y(y,iy);
   x=xval[ix];
   y=yval[iy];
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -446,6 +461,7 @@ double &table3d::get_val(double x, double y, size_t z) {
   size_t ix=0, iy=0;
   lookup_x(x,ix);
   lookup_y(y,iy);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -459,6 +475,7 @@ const double &table3d::get_val(double x, double y, size_t z) const {
 void table3d::set_grid_x(size_t ix, double val) {
   if (ix<numx) {
     (xval)[ix]=val;
+    clear_interp_cache();
     return;
   }
   O2SCL_ERR((((string)"Index '")+itos(ix)+"' out of range ('"+itos(numx)+
@@ -469,6 +486,7 @@ void table3d::set_grid_x(size_t ix, double val) {
 void table3d::set_grid_y(size_t iy, double val) {
   if (iy<numy) {
     (yval)[iy]=val;
+    clear_interp_cache();
     return;
   }
   O2SCL_ERR((((string)"Index '")+itos(iy)+"' out of range ('"+itos(numy)+
@@ -476,6 +494,49 @@ void table3d::set_grid_y(size_t iy, double val) {
   return;
 }
     
+void table3d::sort_grid(bool x_desc, bool y_desc, size_t n_threads) {
+
+  if (!xy_set) {
+    O2SCL_ERR("Grid not set in table3d::sort_grid().",exc_einval);
+  }
+
+  std::vector<size_t> order;
+  std::vector<double> scratch;
+  sort_perm sp;
+  sp.n_threads=n_threads;
+
+  // Sort the x grid and the rows of each slice
+  if (numx>1) {
+    sp.add_key(&xval[0],x_desc);
+    sp.compute(numx,order);
+    sort_perm::apply(numx,order,xval,scratch);
+    for(size_t z=0;z<list.size();z++) {
+      for(size_t iy=0;iy<numy;iy++) {
+	boost::numeric::ublas::matrix_column<ubmatrix> col(list[z],iy);
+	sort_perm::apply(numx,order,col,scratch);
+      }
+    }
+  }
+
+  // Sort the y grid and the columns of each slice
+  if (numy>1) {
+    sp.clear_keys();
+    sp.add_key(&yval[0],y_desc);
+    sp.compute(numy,order);
+    sort_perm::apply(numy,order,yval,scratch);
+    for(size_t z=0;z<list.size();z++) {
+      for(size_t ix=0;ix<numx;ix++) {
+	boost::numeric::ublas::matrix_row<ubmatrix> row(list[z],ix);
+	sort_perm::apply(numy,order,row,scratch);
+      }
+    }
+  }
+
+  clear_interp_cache();
+  
+  return;
+}
+
 double table3d::get_grid_x(size_t ix) {
   if (ix<numx) {
     return (xval)[ix];
@@ -612,6 +673,7 @@ void table3d::init_slice(std::string scol, double val) {
       (list[sl1])(i,j)=val;
     }
   }
+  reset_cache(sl1);
   return;
 }
   
@@ -670,9 +732,169 @@ void table3d::lookup(double val, std::string slice, size_t &ix,
 
 void table3d::set_interp_type(size_t interp_type) {
   itype=interp_type;
+  clear_interp_cache();
+  return;
+}
+
+void table3d::set_interp_cache(bool cache) {
+  intp_cache=cache;
+  clear_interp_cache();
+  return;
+}
+
+void table3d::clear_interp_cache() {
+  intp_coeffs.clear();
+  return;
+}
+
+bool table3d::cache_usable() const {
+  if (!intp_cache || !xy_set) return false;
+  if (itype==itp_linear && numx>=2 && numy>=2) return true;
+  if (itype==itp_cspline && numx>=3 && numy>=3) return true;
+  return false;
+}
+
+void table3d::build_cache(size_t z) const {
+  
+  if (intp_coeffs.size()<list.size()) intp_coeffs.resize(list.size());
+  std::vector<double> &co=intp_coeffs[z];
+  co.resize(16*(numx-1)*(numy-1));
+  for(size_t k=0;k<co.size();k++) co[k]=0.0;
+  
+  const ubmatrix &f=list[z];
+  
+  if (itype==itp_linear) {
+
+    // Bilinear coefficients in the scaled coordinates t and u
+    for(size_t i=0;i<numx-1;i++) {
+      for(size_t j=0;j<numy-1;j++) {
+	double *a=&co[16*(i*(numy-1)+j)];
+	a[0]=f(i,j);
+	a[4]=f(i+1,j)-f(i,j);
+	a[1]=f(i,j+1)-f(i,j);
+	a[5]=f(i+1,j+1)-f(i+1,j)-f(i,j+1)+f(i,j);
+      }
+    }
+
+    return;
+  }
+
+  // For cubic splines, compute the derivatives of the tensor-product
+  // spline at the grid points. The x derivatives are obtained from
+  // the splines in x for each fixed y, the y derivatives from the
+  // splines in y for each fixed x, and the mixed derivatives from
+  // the splines in y of the x derivatives.
+  ubmatrix fx(numx,numy), fy(numx,numy), fxy(numx,numy);
+
+  interp_vec<ubvector,ubmatrix_column> itpx;
+  for(size_t j=0;j<numy;j++) {
+    ubmatrix_column col(f,j);
+    itpx.set(numx,xval,col,itype);
+    for(size_t i=0;i<numx;i++) {
+      fx(i,j)=itpx.deriv(xval[i]);
+    }
+  }
+
+  interp_vec<ubvector,ubmatrix_row> itpy;
+  for(size_t i=0;i<numx;i++) {
+    ubmatrix_row row(f,i);
+    itpy.set(numy,yval,row,itype);
+    for(size_t j=0;j<numy;j++) {
+      fy(i,j)=itpy.deriv(yval[j]);
+    }
+    ubmatrix_row rowx(fx,i);
+    itpy.set(numy,yval,rowx,itype);
+    for(size_t j=0;j<numy;j++) {
+      fxy(i,j)=itpy.deriv(yval[j]);
+    }
+  }
+
+  // The bicubic coefficients are given by a = M F M^{T}, where F
+  // contains the values and the scaled derivatives at the four
+  // corners of the rectangle
+  static const double M[4][4]={{1.0,0.0,0.0,0.0},{0.0,0.0,1.0,0.0},
+			       {-3.0,3.0,-2.0,-1.0},{2.0,-2.0,1.0,1.0}};
+  
+  for(size_t i=0;i<numx-1;i++) {
+    double dx=xval[i+1]-xval[i];
+    for(size_t j=0;j<numy-1;j++) {
+      double dy=yval[j+1]-yval[j];
+      
+      double F[4][4];
+      for(size_t ci=0;ci<2;ci++) {
+	for(size_t cj=0;cj<2;cj++) {
+	  F[ci][cj]=f(i+ci,j+cj);
+	  F[ci][cj+2]=fy(i+ci,j+cj)*dy;
+	  F[ci+2][cj]=fx(i+ci,j+cj)*dx;
+	  F[ci+2][cj+2]=fxy(i+ci,j+cj)*dx*dy;
+	}
+      }
+
+      // Compute MF = M F
+      double MF[4][4];
+      for(size_t p=0;p<4;p++) {
+	for(size_t q=0;q<4;q++) {
+	  MF[p][q]=0.0;
+	  for(size_t k=0;k<4;k++) MF[p][q]+=M[p][k]*F[k][q];
+	}
+      }
+      
+      // Compute a = MF M^{T}
+      double *a=&co[16*(i*(numy-1)+j)];
+      for(size_t p=0;p<4;p++) {
+	for(size_t q=0;q<4;q++) {
+	  a[p*4+q]=0.0;
+	  for(size_t k=0;k<4;k++) a[p*4+q]+=MF[p][k]*M[q][k];
+	}
+      }
+    }
+  }
+  
+  return;
+}
+
+void table3d::cache_patch(double x, double y, size_t &ix, size_t &iy,
+			  double &t, double &u) const {
+  // Use the same extrapolation as the one-dimensional interpolation
+  // objects, i.e. points off the grid use the closest rectangle
+  ix=vector_bsearch<ubvector,double>(x,xval,0,numx-1);
+  iy=vector_bsearch<ubvector,double>(y,yval,0,numy-1);
+  t=(x-xval[ix])/(xval[ix+1]-xval[ix]);
+  u=(y-yval[iy])/(yval[iy+1]-yval[iy]);
   return;
 }
 
+double table3d::cache_eval(size_t z, size_t ix, size_t iy, double t,
+			   double u, size_t nx, size_t ny) const {
+
+  if (z>=intp_coeffs.size() || intp_coeffs[z].size()==0) {
+    build_cache(z);
+  }
+  const double *a=&intp_coeffs[z][16*(ix*(numy-1)+iy)];
+  
+  // Powers of t and u, or their derivatives
+  double tp[4], up[4];
+  if (nx==0) {
+    tp[0]=1.0; tp[1]=t; tp[2]=t*t; tp[3]=t*t*t;
+  } else {
+    double dx=xval[ix+1]-xval[ix];
+    tp[0]=0.0; tp[1]=1.0/dx; tp[2]=2.0*t/dx; tp[3]=3.0*t*t/dx;
+  }
+  if (ny==0) {
+    up[0]=1.0; up[1]=u; up[2]=u*u; up[3]=u*u*u;
+  } else {
+    double dy=yval[iy+1]-yval[iy];
+    up[0]=0.0; up[1]=1.0/dy; up[2]=2.0*u/dy; up[3]=3.0*u*u/dy;
+  }
+
+  double res=0.0;
+  for(size_t p=0;p<4;p++) {
+    res+=tp[p]*(a[p*4]*up[0]+a[p*4+1]*up[1]+a[p*4+2]*up[2]+
+		a[p*4+3]*up[3]);
+  }
+  return res;
+}
+
 size_t table3d::get_interp_type() const {
   return itype;
 }
@@ -681,6 +903,13 @@ double table3d::interp(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    size_t ix, iy;
+    double t, u;
+    cache_patch(x,y,ix,iy,t,u);
+    return cache_eval(z,ix,iy,t,u,0,0);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
   
@@ -754,6 +983,13 @@ double table3d::deriv_x(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    size_t ix, iy;
+    double t, u;
+    cache_patch(x,y,ix,iy,t,u);
+    return cache_eval(z,ix,iy,t,u,1,0);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -774,6 +1010,13 @@ double table3d::deriv_y(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    size_t ix, iy;
+    double t, u;
+    cache_patch(x,y,ix,iy,t,u);
+    return cache_eval(z,ix,iy,t,u,0,1);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -836,6 +1079,13 @@ double table3d::deriv_xy(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    size_t ix, iy;
+    double t, u;
+    cache_patch(x,y,ix,iy,t,u);
+    return cache_eval(z,ix,iy,t,u,1,1);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -860,6 +1110,7 @@ void table3d::zero_table() {
       }
     }
   }
+  clear_interp_cache();
   return;
 }
 
@@ -881,6 +1132,7 @@ void table3d::clear_data() {
     list[i].clear();
   }
   list.clear();
+  clear_interp_cache();
       
   has_slice=false;
   return;
@@ -1073,10 +1325,12 @@ const boost::numeric::ublas::matrix<double> &table3d::get_slice
 boost::numeric::ublas::matrix<double> &table3d::get_slice
 (std::string name) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return list[z];
 }
 
 boost::numeric::ublas::matrix<double> &table3d::get_slice(size_t iz) {
+  reset_cache(iz);
   return list[iz];
 }
 
@@ -1090,6 +1344,7 @@ void table3d::function_slice(string function, string scol) {
   size_t ic=lookup_slice(scol);
 
   function_matrix(function,list[ic]);
+  reset_cache(ic);
 
   return;
 }
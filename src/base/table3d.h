@@ -45,6 +45,7 @@
 #include <o2scl/uniform_grid.h>
 #include <o2scl/interp.h>
 #include <o2scl/table_units.h>
+#include <o2scl/sort_perm.h>
 #include <o2scl/contour.h>
 
 #include <o2scl/shunting_yard.h>
@@ -68,6 +69,33 @@ namespace o2scl {
   /** \brief A data structure containing many slices of two-dimensional
       data points defined on a grid
 
+      \b Interpolation \n
+
+      For linear and cubic spline interpolation (\ref itp_linear and
+      \ref itp_cspline), the two-dimensional interpolant is the
+      tensor product of the one-dimensional interpolants, and it is a
+      bilinear or bicubic polynomial on each grid rectangle. By
+      default, the coefficients of these polynomials are computed
+      for a slice the first time it is interpolated and stored, so
+      that subsequent calls to \ref interp(), \ref deriv_x(), \ref
+      deriv_y(), \ref deriv_xy() and \ref interp_slices() require
+      only a binary search in each direction and the evaluation of
+      one polynomial. The stored coefficients are discarded when the
+      slice or the grid is modified through the member functions of
+      this class (including functions which return a non-const
+      reference to the data). If the data is modified through a
+      reference obtained before the last interpolation, then \ref
+      clear_interp_cache() must be called. The cache can be disabled
+      with \ref set_interp_cache(). Other interpolation types
+      always recompute the one-dimensional interpolants for each
+      call.
+
+      Because the cache is computed during the first interpolation
+      of each slice, the interpolation functions are only safe to
+      call from several threads simultaneously once the cache has
+      been computed (e.g. by one call to \ref interp() for each
+      slice) or when the cache is disabled.
+
       \future Improve interpolation and derivative caching, possibly
       through non-const versions of the interpolation functions.
       \future Should there be a clear_grid() function separate from
@@ -148,6 +176,7 @@ namespace o2scl {
       for(size_t i=0;i<ny;i++) (yval)[i]=y[i];
       size_set=true;
       xy_set=true;
+      clear_interp_cache();
       return;
     }
 
@@ -185,6 +214,7 @@ namespace o2scl {
       gy.vector(yval);
       size_set=true;
       xy_set=true;
+      clear_interp_cache();
     }
 
     /** \brief Initialize \table size
@@ -284,6 +314,7 @@ namespace o2scl {
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
+      clear_interp_cache();
       return;
     }
     
@@ -390,6 +421,7 @@ namespace o2scl {
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
+      clear_interp_cache();
       return;
     }
 
@@ -457,6 +489,19 @@ namespace o2scl {
     /// Get a const reference to the full y grid
     const ubvector &get_y_data() const { return yval; }
 
+    /** \brief Sort the x and y grids, rearranging the slices
+	accordingly
+
+	The x grid is sorted in descending order if \c x_desc is
+	true and in ascending order otherwise, and similarly for the
+	y grid. Grid points with equal values keep their original
+	order. The sorting permutations are computed with \ref
+	sort_perm using \c n_threads OpenMP threads and are applied
+	to each slice in place.
+    */
+    void sort_grid(bool x_desc=false, bool y_desc=false,
+		   size_t n_threads=1);
+
     //@}
 
     // --------------------------------------------------------
@@ -628,6 +673,17 @@ namespace o2scl {
      */
     template<class vec_t>
       void interp_slices(double x, double y, size_t nv, vec_t &v) {
+
+      if (cache_usable()) {
+	// Perform the grid search only once for all slices
+	size_t ix, iy;
+	double t, u;
+	cache_patch(x,y,ix,iy,t,u);
+	for (size_t i=0;i<list.size();i++) {
+	  v[i]=cache_eval(i,ix,iy,t,u,0,0);
+	}
+	return;
+      }
       
       for (size_t i=0;i<list.size();i++) {
 	std::string name=get_slice_name(i);
@@ -637,6 +693,15 @@ namespace o2scl {
       return;
     }
 
+    /** \brief Specify whether or not interpolation coefficients
+	are cached (default true)
+    */
+    void set_interp_cache(bool cache);
+    
+    /** \brief Discard all cached interpolation coefficients
+     */
+    void clear_interp_cache();
+
     /** \brief Create a new slice, named \c fpname, containing the 
 	derivative of \c fname with respect to the x coordinate
      */
@@ -908,6 +973,45 @@ namespace o2scl {
 
     size_t itype;
 
+    /// \name Interpolation cache
+    //@{
+    /// If true, cache interpolation coefficients (default true)
+    bool intp_cache;
+    
+    /** \brief For each slice, the bilinear or bicubic coefficients
+	for all grid rectangles (empty if not yet computed)
+    */
+    mutable std::vector<std::vector<double> > intp_coeffs;
+
+    /** \brief Return true if the interpolation cache can be used
+	for the current interpolation type and grid
+    */
+    bool cache_usable() const;
+
+    /// Discard the cached coefficients for slice \c z
+    void reset_cache(size_t z) {
+      if (z<intp_coeffs.size()) intp_coeffs[z].clear();
+      return;
+    }
+
+    /// Compute the coefficients for slice \c z
+    void build_cache(size_t z) const;
+
+    /** \brief Find the grid rectangle <tt>(ix,iy)</tt> containing
+	the point <tt>(x,y)</tt> and the corresponding 
+	scaled coordinates \c t and \c u
+    */
+    void cache_patch(double x, double y, size_t &ix, size_t &iy,
+		     double &t, double &u) const;
+    
+    /** \brief Evaluate the polynomial for slice \c z in rectangle
+	<tt>(ix,iy)</tt>, or its derivative of order \c nx in x 
+	and order \c ny in y (each order must be 0 or 1)
+    */
+    double cache_eval(size_t z, size_t ix, size_t iy, double t,
+		      double u, size_t nx, size_t ny) const;
+    //@}
+
 #endif
 
   };
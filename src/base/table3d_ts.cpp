@@ -216,6 +216,61 @@ int main(void) {
     cout << endl;
   }
 
+  // Compare cached and uncached interpolation
+  {
+    table3d ct, ct2;
+    ubvector x(7), y(6);
+    for(size_t i=0;i<7;i++) x[i]=((double)i)+0.1*((double)(i*i));
+    // A decreasing y grid
+    for(size_t j=0;j<6;j++) y[j]=3.0-0.5*((double)j)-0.05*((double)(j*j));
+    ct.set_xy("x",7,x,"y",6,y);
+    ct.new_slice("z1");
+    ct.new_slice("z2");
+    for(size_t i=0;i<7;i++) {
+      for(size_t j=0;j<6;j++) {
+	ct.set(i,j,"z1",sin(x[i])*cos(y[j]));
+	ct.set(i,j,"z2",x[i]*x[i]*y[j]+exp(-y[j]));
+      }
+    }
+    ct2=ct;
+    ct2.set_interp_cache(false);
+
+    for(size_t k=0;k<2;k++) {
+      if (k==1) {
+	ct.set_interp_type(itp_linear);
+	ct2.set_interp_type(itp_linear);
+      }
+      double pts[4][2]={{1.3,2.2},{0.2,0.1},{6.5,-0.4},{-0.2,3.2}};
+      for(size_t ip=0;ip<4;ip++) {
+	double px=pts[ip][0], py=pts[ip][1];
+	t.test_rel(ct.interp(px,py,"z1"),ct2.interp(px,py,"z1"),
+		   1.0e-10,"cache interp");
+	t.test_rel(ct.deriv_x(px,py,"z2"),ct2.deriv_x(px,py,"z2"),
+		   1.0e-10,"cache deriv_x");
+	t.test_rel(ct.deriv_y(px,py,"z2"),ct2.deriv_y(px,py,"z2"),
+		   1.0e-10,"cache deriv_y");
+	t.test_rel(ct.deriv_xy(px,py,"z1"),ct2.deriv_xy(px,py,"z1"),
+		   1.0e-10,"cache deriv_xy");
+	ubvector v(2), v2(2);
+	ct.interp_slices(px,py,2,v);
+	ct2.interp_slices(px,py,2,v2);
+	t.test_rel(v[1],v2[1],1.0e-10,"cache interp_slices");
+      }
+    }
+
+    // Ensure the cache is updated when the data changes
+    double val1=ct.interp(1.3,2.2,"z1");
+    ct.set(2,1,"z1",10.0);
+    ct2.set(2,1,"z1",10.0);
+    t.test_gen(ct.interp(1.3,2.2,"z1")!=val1,"cache reset 1");
+    t.test_rel(ct.interp(1.3,2.2,"z1"),ct2.interp(1.3,2.2,"z1"),
+	       1.0e-10,"cache reset 2");
+    ct.get(2,1,"z1")=-10.0;
+    ct2.get(2,1,"z1")=-10.0;
+    t.test_rel(ct.interp(1.3,2.2,"z1"),ct2.interp(1.3,2.2,"z1"),
+	       1.0e-10,"cache reset 3");
+  }
+
   /*
     12/4/15: This was old code for testing gen3_list. It just
     needs to be rewritten not to depend on separate text
@@ -246,6 +301,33 @@ int main(void) {
     }
   */
 
+  // Test sorting the grid
+  {
+    table3d ts;
+    double xs[3]={2,0,1};
+    double ys[4]={1,3,0,2};
+    ts.set_xy<double *>("x",3,xs,"y",4,ys);
+    ts.new_slice("z");
+    for(size_t i=0;i<3;i++) {
+      for(size_t j=0;j<4;j++) {
+	ts.set(i,j,"z",xs[i]*10.0+ys[j]);
+      }
+    }
+    ts.sort_grid();
+    bool sorted=true;
+    for(size_t i=0;i<3;i++) {
+      if (ts.get_grid_x(i)!=((double)i)) sorted=false;
+      for(size_t j=0;j<4;j++) {
+	if (i==0 && ts.get_grid_y(j)!=((double)j)) sorted=false;
+	if (ts.get(i,j,"z")!=((double)(i*10+j))) sorted=false;
+      }
+    }
+    t.test_gen(sorted,"sort_grid");
+    ts.sort_grid(true,false);
+    t.test_gen(ts.get_grid_x(0)==2.0 && ts.get(0,3,"z")==23.0,
+	       "sort_grid desc");
+  }
+
   t.report();
 
   return 0;
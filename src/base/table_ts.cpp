@@ -74,6 +74,29 @@ int main(void) {
 		 at.get("m1",ii),1.0e-12,"fc2");
     }
 
+    // Test row_function(), function_find_row() and
+    // function_column() with a table larger than one chunk
+    t.test_rel(at.row_function("col1*m2",1),3.0*10.5,1.0e-12,"rf1");
+    t.test_gen(at.function_find_row("col2")==1,"ffr1");
+    {
+      table<> at_big;
+      at_big.line_of_names("x y");
+      for(size_t ii=0;ii<10000;ii++) {
+	double line[2]={((double)ii)/1000.0,sin(((double)ii))};
+	at_big.line_of_data(2,line);
+      }
+      at_big.function_column("exp(-x)*y+x^2","z");
+      bool match=true;
+      for(size_t ii=0;ii<at_big.get_nlines();ii++) {
+	double x=at_big.get("x",ii), y=at_big.get("y",ii);
+	double exact=exp(-x)*y+pow(x,2.0);
+	if (fabs(at_big.get("z",ii)-exact)>1.0e-12*fabs(exact)) {
+	  match=false;
+	}
+      }
+      t.test_gen(match,"fc3");
+    }
+
     // -------------------------------------------------------------
     // Test constants
 
@@ -199,6 +222,113 @@ int main(void) {
 
   }
 
+  {
+    // read_generic_file() should give the same table as
+    // read_generic(), with and without column names and with an
+    // incomplete last row
+    for(size_t k=0;k<2;k++) {
+      ofstream fout("table_ts_gen.txt");
+      fout.precision(17);
+      if (k==0) fout << "x y z" << endl;
+      for(size_t i=0;i<100;i++) {
+	fout << sin(((double)i)) << " " << ((double)i)/3.0 << " "
+	     << exp(((double)i)/5.0) << endl;
+      }
+      fout << "1.5 2.5" << endl;
+      fout.close();
+
+      table<> tg1, tg2, tg3;
+      ifstream fin("table_ts_gen.txt");
+      tg1.read_generic(fin);
+      fin.close();
+      tg2.read_generic_file("table_ts_gen.txt");
+      tg3.read_generic_file("table_ts_gen.txt",0,3);
+      t.test_gen(tg1.get_nlines()==101,"read_generic nlines");
+      t.test_gen(tg2.get_nlines()==tg1.get_nlines(),"rgf nlines");
+      t.test_gen(tg3.get_nlines()==tg1.get_nlines(),"rgf nlines 2");
+      t.test_gen(tg2.get_ncolumns()==3,"rgf ncolumns");
+      // The incomplete last row is filled with zeros by
+      // read_generic_file(), and not necessarily by read_generic()
+      bool same=true;
+      for(size_t j=0;j<3;j++) {
+	if (tg2.get_column_name(j)!=tg1.get_column_name(j)) same=false;
+	for(size_t i=0;i<tg1.get_nlines();i++) {
+	  if (i<100 || j<2) {
+	    if (tg2.get(j,i)!=tg1.get(j,i)) same=false;
+	    if (tg3.get(j,i)!=tg1.get(j,i)) same=false;
+	  }
+	}
+      }
+      t.test_gen(same,"rgf same");
+      t.test_gen(tg2.get(2,100)==0.0,"rgf last row");
+    }
+
+    // Both functions stop reading at special values like 'nan', even
+    // when they follow a number which requires strtod()
+    {
+      ofstream fout("table_ts_gen.txt");
+      fout << "x y z" << endl;
+      fout << "1.2345678901234567890123 2 3" << endl;
+      fout << "4 nan 6" << endl;
+      fout << "7 8 9" << endl;
+      fout.close();
+
+      table<> tg1, tg2;
+      ifstream fin("table_ts_gen.txt");
+      tg1.read_generic(fin);
+      fin.close();
+      tg2.read_generic_file("table_ts_gen.txt");
+      t.test_gen(tg2.get_nlines()==tg1.get_nlines(),"rgf nan nlines");
+      t.test_gen(tg2.get_nlines()==2,"rgf nan nlines 2");
+      t.test_gen(tg2.get(0,0)==tg1.get(0,0),"rgf nan first");
+      t.test_gen(tg2.get(0,1)==4.0 && tg1.get(0,1)==4.0,"rgf nan second");
+    }
+  }
+
+  // Test sorting by several columns
+  {
+    table<> ts[2];
+    for(size_t k=0;k<2;k++) {
+      ts[k].line_of_names("a b c");
+      for(size_t i=0;i<5000;i++) {
+	double line[3]={((double)((i*7)%10)),sin(((double)i)),
+			((double)i)};
+	ts[k].line_of_data(3,line);
+      }
+    }
+    std::vector<std::string> cols={"a","b"};
+    std::vector<bool> desc={false,true};
+    ts[0].sort_table(cols,desc);
+    ts[1].sort_table(cols,desc,3);
+    bool sorted=true, same=true, rows=true;
+    for(size_t i=0;i<5000;i++) {
+      if (i>0) {
+	double a0=ts[0].get("a",i-1), a1=ts[0].get("a",i);
+	if (a1<a0 || (a1==a0 && ts[0].get("b",i)>ts[0].get("b",i-1))) {
+	  sorted=false;
+	}
+      }
+      for(size_t j=0;j<3;j++) {
+	if (ts[0].get(j,i)!=ts[1].get(j,i)) same=false;
+      }
+      double c=ts[0].get("c",i);
+      if (ts[0].get("b",i)!=sin(c) ||
+	  ts[0].get("a",i)!=((double)((((size_t)c)*7)%10))) {
+	rows=false;
+      }
+    }
+    t.test_gen(sorted,"sort_table order");
+    t.test_gen(same,"sort_table threads");
+    t.test_gen(rows,"sort_table rows");
+
+    ts[0].sort_table("c");
+    bool orig=true;
+    for(size_t i=0;i<5000;i++) {
+      if (ts[0].get("c",i)!=((double)i)) orig=false;
+    }
+    t.test_gen(orig,"sort_table single");
+  }
+
   t.report();
 
   return 0;
@@ -764,6 +764,137 @@ namespace o2scl {
       return 0;
     }
     
+    /** \brief Clear the current table and read from a generic data
+	file named \c fname
+
+	This function reads the same file format as \ref
+	read_generic(), including the optional row of units, using
+	the faster method described in \ref
+	table::read_generic_file() .
+    */
+    virtual int read_generic_file(std::string fname, int verbose=0,
+				  size_t n_threads=1) {
+
+      text_mmap tm;
+      tm.n_threads=n_threads;
+      tm.open(fname);
+      if (verbose>0) {
+	std::cout << "File '" << fname << "' has " << tm.size()
+		  << " bytes and approximately " << tm.estimate_lines()
+		  << " lines." << std::endl;
+      }
+
+      this->clear_table();
+      utree.clear();
+
+      // Read first line and into list
+      std::string line, stemp;
+      std::vector<std::string> onames, nnames;
+      size_t pos=tm.get_line(0,line);
+      std::istringstream is(line);
+      while (is >> stemp) {
+	onames.push_back(stemp);
+	if (verbose>2) {
+	  std::cout << "Read possible column name: " << stemp << std::endl;
+	}
+      }
+
+      // Count number of likely numbers in the first row
+      size_t n_nums=0;
+      for(size_t i=0;i<onames.size();i++) {
+	if (is_number(onames[i])) n_nums++;
+      }
+
+      if (n_nums==onames.size()) {
+
+	if (verbose>0) {
+	  std::cout << "First row looks like it contains numerical values." 
+		    << std::endl;
+	  std::cout << "Creating generic column names: ";
+	}
+	for(size_t i=0;i<onames.size();i++) {
+	  nnames.push_back(((std::string)"c")+szttos(i+1));
+	  if (verbose>0) std::cout << nnames[i] << " ";
+	}
+	if (verbose>0) std::cout << std::endl;
+
+	// Make columns
+	for(size_t i=0;i<nnames.size();i++) {
+	  this->new_column(nnames[i]);
+	}
+
+	// The first row is data
+	pos=0;
+
+      } else {
+
+	// Ensure good column names
+	for(size_t i=0;i<onames.size();i++) {
+	  std::string temps=onames[i];
+	  this->make_fp_varname(temps);
+	  this->make_unique_name(temps,nnames);
+	  nnames.push_back(temps);
+	  if (temps!=onames[i] && verbose>0) {
+	    std::cout << "Converted column named '" << onames[i] << "' to '" 
+		      << temps << "'." << std::endl;
+	  }
+	}
+
+	// Make columns
+	for(size_t i=0;i<nnames.size();i++) {
+	  this->new_column(nnames[i]);
+	}
+
+	// Read another line, and see if it looks like units
+	std::vector<std::string> units;
+	size_t pos2=tm.get_line(pos,line);
+	std::istringstream is2(line);
+	int num_units=0;
+	while (is2 >> stemp) {
+	  units.push_back(stemp);
+	  if (stemp[0]=='[') num_units++;
+	  if (verbose>2) {
+	    std::cout << "Read word in second row: " << stemp << std::endl;
+	  }
+	}
+
+	if (units.size()!=nnames.size()) {
+	  std::cout << "Second row appears not to have same number of "
+		    << "entries as the first." << std::endl;
+	  std::cout << "Aborting." << std::endl;
+	  return -1;
+	}
+
+	if (num_units==((int)units.size()) || num_units>2) {
+	  if (verbose>2) {
+	    std::cout << "Looks like second row contains units." << std::endl;
+	  }
+	  for(size_t i=0;i<units.size();i++) {
+	    // Remove brackets
+	    stemp=units[i];
+	    if (stemp[0]=='[') stemp=stemp.substr(1,stemp.length()-1);
+	    if (stemp[stemp.length()-1]==']') {
+	      stemp=stemp.substr(0,stemp.length()-1);
+	    }
+	    // Set the units
+	    set_unit(nnames[i],stemp);
+	    if (verbose>2) {
+	      std::cout << "Name,unit: " << nnames[i] << " [" << stemp << "]" 
+			<< std::endl;
+	    }
+	  }
+	  pos=pos2;
+	}
+	
+	// Otherwise, the second row is data
+
+      }
+
+      this->read_generic_data(tm,pos,verbose);
+
+      return 0;
+    }
+    
     /** \brief Insert columns from a source table into the new
 	table by interpolation (or extrapolation)
     */
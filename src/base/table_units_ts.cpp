@@ -74,6 +74,28 @@ int main(void) {
   t.test_gen(at5.get_nlines()==at.get_nlines(),"cc 3");
   t.test_gen(at5.get_ncolumns()==at.get_ncolumns(),"cc 4");
 
+  // -------------------------------------------------------------
+  // Test read_generic_file() with a row of units
+
+  fout.open("table_units_ts_gen.txt");
+  fout << "ed pr nb" << endl;
+  fout << "[1/fm^4] [1/fm^4] [1/fm^3]" << endl;
+  for(size_t i=0;i<20;i++) {
+    fout << ((double)i)/7.0 << " " << ((double)i)/11.0 << " "
+	 << ((double)i)/13.0 << endl;
+  }
+  fout.close();
+  table_units<> tg1, tg2;
+  ifstream fin("table_units_ts_gen.txt");
+  tg1.read_generic(fin);
+  fin.close();
+  tg2.read_generic_file("table_units_ts_gen.txt");
+  t.test_gen(tg2.get_nlines()==20,"rgf nlines");
+  t.test_gen(tg1.get_nlines()==tg2.get_nlines(),"rgf nlines 2");
+  t.test_str(tg2.get_unit("pr"),"1/fm^4","rgf unit");
+  t.test_str(tg2.get_unit("nb"),tg1.get_unit("nb"),"rgf unit 2");
+  t.test_gen(tg2.get("nb",19)==tg1.get("nb",19),"rgf value");
+
   t.report();
 
   return 0;
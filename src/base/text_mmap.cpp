@@ -0,0 +1,424 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#include <o2scl/text_mmap.h>
+#include <o2scl/err_hnd.h>
+
+using namespace std;
+using namespace o2scl;
+
+namespace {
+
+  /// Return true if \c c is whitespace in the "C" locale
+  inline bool is_ws(char c) {
+    return (c==' ' || c=='\n' || c=='\t' || c=='\r' || c=='\v' || c=='\f');
+  }
+
+  /// Powers of ten which are exactly representable as doubles
+  const double exact_pow10[23]={1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,
+				1.0e6,1.0e7,1.0e8,1.0e9,1.0e10,1.0e11,
+				1.0e12,1.0e13,1.0e14,1.0e15,1.0e16,1.0e17,
+				1.0e18,1.0e19,1.0e20,1.0e21,1.0e22};
+
+}
+
+text_mmap::text_mmap() {
+  n_threads=1;
+  verbose=0;
+  buf=0;
+  len=0;
+  open_flag=false;
+  mapped=false;
+}
+
+text_mmap::~text_mmap() {
+  close();
+}
+
+int text_mmap::open(std::string fname, bool err_on_fail) {
+
+  close();
+
+#ifdef HAVE_MMAP
+
+  int fd=::open(fname.c_str(),O_RDONLY);
+  if (fd<0) {
+    if (err_on_fail) {
+      O2SCL_ERR((((string)"Could not open file '")+fname+
+		 "' in text_mmap::open().").c_str(),exc_efilenotfound);
+    }
+    return exc_efilenotfound;
+  }
+  struct stat st;
+  if (fstat(fd,&st)!=0) {
+    ::close(fd);
+    if (err_on_fail) {
+      O2SCL_ERR((((string)"Could not determine size of file '")+fname+
+		 "' in text_mmap::open().").c_str(),exc_efailed);
+    }
+    return exc_efailed;
+  }
+  len=((size_t)st.st_size);
+
+  // A zero-length mapping is not allowed, so empty files
+  // are handled separately
+  if (len>0) {
+    void *ptr=mmap(0,len,PROT_READ,MAP_PRIVATE,fd,0);
+    if (ptr==MAP_FAILED) {
+      ::close(fd);
+      len=0;
+      if (err_on_fail) {
+	O2SCL_ERR((((string)"Could not map file '")+fname+
+		   "' in text_mmap::open().").c_str(),exc_efailed);
+      }
+      return exc_efailed;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(ptr,len,MADV_SEQUENTIAL);
+#endif
+    buf=(const char *)ptr;
+    mapped=true;
+  }
+  // The mapping remains valid after the file is closed
+  ::close(fd);
+
+#else
+
+  ifstream fin(fname.c_str(),ios::binary);
+  if (!fin) {
+    if (err_on_fail) {
+      O2SCL_ERR((((string)"Could not open file '")+fname+
+		 "' in text_mmap::open().").c_str(),exc_efilenotfound);
+    }
+    return exc_efilenotfound;
+  }
+  fin.seekg(0,ios::end);
+  len=((size_t)fin.tellg());
+  fin.seekg(0,ios::beg);
+  copy.resize(len);
+  if (len>0) {
+    fin.read(&copy[0],len);
+    buf=&copy[0];
+  }
+  fin.close();
+
+#endif
+
+  open_flag=true;
+
+  if (verbose>0) {
+    cout << "text_mmap::open(): File '" << fname << "' has " << len
+	 << " bytes and approximately " << estimate_lines()
+	 << " lines." << endl;
+  }
+
+  return 0;
+}
+
+void text_mmap::close() {
+#ifdef HAVE_MMAP
+  if (mapped) {
+    munmap((void *)buf,len);
+  }
+#endif
+  copy.clear();
+  buf=0;
+  len=0;
+  open_flag=false;
+  mapped=false;
+  chunk_start.clear();
+  chunk_end.clear();
+  chunk_word.clear();
+  return;
+}
+
+size_t text_mmap::estimate_lines(size_t n_sample) const {
+  if (len==0) return 0;
+  size_t n=len;
+  if (n_sample>0 && n_sample<len) n=n_sample;
+  size_t count=0;
+  for(size_t i=0;i<n;i++) {
+    if (buf[i]=='\n') count++;
+  }
+  if (n==len) {
+    if (buf[len-1]!='\n') count++;
+    return count;
+  }
+  return ((size_t)(((double)count)*((double)len)/((double)n)));
+}
+
+size_t text_mmap::get_line(size_t pos, std::string &line) const {
+  size_t end=pos;
+  while (end<len && buf[end]!='\n') end++;
+  size_t next=end;
+  if (next<len) next++;
+  if (end>pos && buf[end-1]=='\r') end--;
+  if (end>pos) line.assign(buf+pos,end-pos);
+  else line.clear();
+  return next;
+}
+
+size_t text_mmap::count_words(size_t pos) {
+
+  if (pos>len) pos=len;
+
+  // Divide the remainder of the file into chunks. There are several
+  // chunks per thread so that the work is balanced when the lines
+  // have different lengths, but each chunk is at least 64 kB.
+  size_t nt=n_threads;
+  if (nt<1) nt=1;
+  size_t n_chunks=nt*4;
+  size_t min_chunk=65536;
+  if ((len-pos)/min_chunk+1<n_chunks) n_chunks=(len-pos)/min_chunk+1;
+
+  chunk_start.resize(n_chunks);
+  chunk_end.resize(n_chunks);
+  chunk_word.resize(n_chunks+1);
+
+  // Each chunk ends at whitespace (or the end of the file) so that
+  // no word is split between two chunks
+  size_t start=pos;
+  for(size_t ic=0;ic<n_chunks;ic++) {
+    chunk_start[ic]=start;
+    size_t end=pos+(len-pos)/n_chunks*(ic+1);
+    if (ic==n_chunks-1) end=len;
+    if (end<start) end=start;
+    while (end<len && !is_ws(buf[end])) end++;
+    chunk_end[ic]=end;
+    start=end;
+  }
+
+  // Count the words in each chunk
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+  for(size_t ic=0;ic<n_chunks;ic++) {
+    size_t count=0;
+    bool in_word=false;
+    const char *end=buf+chunk_end[ic];
+    for(const char *p=buf+chunk_start[ic];p<end;p++) {
+      if (is_ws(*p)) {
+	in_word=false;
+      } else if (in_word==false) {
+	in_word=true;
+	count++;
+      }
+    }
+    chunk_word[ic+1]=count;
+  }
+
+  // Convert the counts to the index of the first word in each chunk
+  chunk_word[0]=0;
+  for(size_t ic=0;ic<n_chunks;ic++) {
+    chunk_word[ic+1]+=chunk_word[ic];
+  }
+
+  if (verbose>0) {
+    cout << "text_mmap::count_words(): " << chunk_word[n_chunks]
+	 << " words in " << n_chunks << " chunks." << endl;
+  }
+
+  return chunk_word[n_chunks];
+}
+
+size_t text_mmap::parse_words(size_t ncols,
+			      const std::vector<double *> &cols) {
+
+  size_t n_chunks=chunk_start.size();
+  if (n_chunks==0) return 0;
+  size_t n_words=chunk_word[n_chunks];
+  if (n_words==0) return 0;
+
+  if (ncols==0 || cols.size()<ncols) {
+    O2SCL_ERR("Not enough columns in text_mmap::parse_words().",
+	      exc_einval);
+  }
+
+  // The index of the first word in each chunk which could not be
+  // converted, stored separately for each chunk so that the error
+  // handler is not called inside the parallel region
+  std::vector<size_t> first_bad(n_chunks,n_words);
+
+  size_t nt=n_threads;
+  if (nt<1) nt=1;
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+  for(size_t ic=0;ic<n_chunks;ic++) {
+    size_t k=chunk_word[ic];
+    size_t row=k/ncols, col=k%ncols;
+    const char *p=buf+chunk_start[ic];
+    const char *end=buf+chunk_end[ic];
+    while (p<end) {
+      while (p<end && is_ws(*p)) p++;
+      if (p==end) break;
+      const char *wend=p;
+      while (wend<end && !is_ws(*wend)) wend++;
+      double x;
+      if (parse_double(p,wend,x)==false) {
+	first_bad[ic]=k;
+	break;
+      }
+      cols[col][row]=x;
+      k++;
+      col++;
+      if (col==ncols) {
+	col=0;
+	row++;
+      }
+      p=wend;
+    }
+  }
+
+  size_t n_good=n_words;
+  for(size_t ic=0;ic<n_chunks;ic++) {
+    if (first_bad[ic]<n_good) n_good=first_bad[ic];
+  }
+
+  if (verbose>0) {
+    cout << "text_mmap::parse_words(): Converted " << n_good
+	 << " of " << n_words << " words." << endl;
+  }
+
+  return n_good;
+}
+
+bool text_mmap::parse_double_slow(const char *start, const char *end,
+				  double &x) {
+
+  // Only accept plain decimal numbers. This rejects 'nan', 'inf'
+  // and hexadecimal numbers, which strtod() would otherwise accept
+  // but which cannot be read by table::read_generic().
+  for(const char *p=start;p<end;p++) {
+    if ((*p<'0' || *p>'9') && *p!='.' && *p!='-' && *p!='+' &&
+	*p!='e' && *p!='E') {
+      return false;
+    }
+  }
+
+  // Copy the word so that it is null-terminated
+  std::string s(start,end-start);
+  char *endptr;
+  errno=0;
+  x=strtod(s.c_str(),&endptr);
+  if (endptr!=s.c_str()+s.length() || s.length()==0) return false;
+  if (errno==ERANGE && std::isinf(x)) return false;
+  return true;
+}
+
+bool text_mmap::parse_double(const char *start, const char *end,
+			     double &x) {
+
+  const char *p=start;
+  bool neg=false;
+  if (p<end && (*p=='-' || *p=='+')) {
+    neg=(*p=='-');
+    p++;
+  }
+
+  // The significant digits (at most 19, which always fit in 64
+  // bits) and the power of ten
+  unsigned long long mant=0;
+  int n_dig=0, exp10=0;
+  bool digits=false;
+
+  while (p<end && *p>='0' && *p<='9') {
+    digits=true;
+    if (mant!=0 || *p!='0') {
+      if (n_dig==19) return parse_double_slow(start,end,x);
+      mant=mant*10+(*p-'0');
+      n_dig++;
+    }
+    p++;
+  }
+  if (p<end && *p=='.') {
+    p++;
+    while (p<end && *p>='0' && *p<='9') {
+      digits=true;
+      if (mant!=0 || *p!='0') {
+	if (n_dig==19) return parse_double_slow(start,end,x);
+	mant=mant*10+(*p-'0');
+	n_dig++;
+      }
+      exp10--;
+      p++;
+    }
+  }
+  if (digits==false) return parse_double_slow(start,end,x);
+
+  if (p<end && (*p=='e' || *p=='E')) {
+    p++;
+    bool eneg=false;
+    if (p<end && (*p=='-' || *p=='+')) {
+      eneg=(*p=='-');
+      p++;
+    }
+    if (p==end || *p<'0' || *p>'9') return false;
+    int e=0;
+    while (p<end && *p>='0' && *p<='9') {
+      if (e<100000) e=e*10+(*p-'0');
+      p++;
+    }
+    if (eneg) exp10-=e;
+    else exp10+=e;
+  }
+
+  if (p!=end) return parse_double_slow(start,end,x);
+
+  if (mant==0) {
+    x=neg ? -0.0 : 0.0;
+    return true;
+  }
+
+  // If both the significand and the power of ten are exactly
+  // representable, then a single multiplication or division gives
+  // the correctly-rounded result
+  if (mant>(1ULL << 53) || exp10<-22 || exp10>22) {
+    return parse_double_slow(start,end,x);
+  }
+  double d=((double)mant);
+  if (exp10<0) d/=exact_pow10[-exp10];
+  else d*=exact_pow10[exp10];
+  x=neg ? -d : d;
+  return true;
+}
@@ -0,0 +1,197 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_TEXT_MMAP_H
+#define O2SCL_TEXT_MMAP_H
+
+/** \file text_mmap.h
+    \brief File defining \ref o2scl::text_mmap
+*/
+
+#include <string>
+#include <vector>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Fast reading of numbers from a text file
+
+      This class maps a text file into memory (using
+      <tt>mmap()</tt> if it was found when O2scl was configured and
+      otherwise by reading the entire file) and reads the
+      whitespace-separated words in the file as numbers. It is
+      used by \ref table::read_generic_file() and
+      \ref table_units::read_generic_file() .
+
+      After the file is opened with \ref open(), the size of the
+      file and an estimate of the number of lines (\ref size() and
+      \ref estimate_lines()) are available immediately. The header
+      lines can be read with \ref get_line(). The numbers are then
+      read in two passes: \ref count_words() divides the remainder
+      of the file into chunks which end at whitespace and counts the
+      words in each chunk, and \ref parse_words() converts the words
+      to numbers and stores them directly in the user-specified
+      column buffers. If OpenMP support is enabled, both passes are
+      distributed over \ref n_threads threads.
+
+      The numbers are converted with \ref parse_double(), which does
+      not depend on the locale. Most numbers are converted exactly
+      with a single floating-point multiplication or division. The
+      remaining numbers (those with more than 19 significant digits
+      or large exponents) are converted with <tt>strtod()</tt>, so
+      the result is the correctly-rounded value in both cases.
+      Numbers which overflow are not accepted. Unlike
+      <tt>strtod()</tt>, words like <tt>nan</tt> and <tt>inf</tt>
+      and hexadecimal numbers are also not accepted, since they
+      cannot be read with <tt>operator>>()</tt>.
+  */
+  class text_mmap {
+
+  public:
+
+    text_mmap();
+
+    virtual ~text_mmap();
+
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+
+    /// Verbosity parameter (default 0)
+    int verbose;
+
+    /** \brief Open the file named \c fname
+
+	If the file cannot be opened and \c err_on_fail is true then
+	the error handler is called, otherwise a nonzero value is
+	returned. Any previously opened file is closed.
+    */
+    int open(std::string fname, bool err_on_fail=true);
+
+    /// Close the file
+    void close();
+
+    /// Return true if a file is open
+    bool is_open() const {
+      return open_flag;
+    }
+
+    /// The size of the file in bytes
+    size_t size() const {
+      return len;
+    }
+
+    /** \brief Estimate the number of lines in the file
+
+	If the file is larger than \c n_sample bytes, then
+	the number of lines is estimated from the number of
+	newlines in the first \c n_sample bytes. Otherwise
+	the exact number of lines is returned.
+    */
+    size_t estimate_lines(size_t n_sample=1048576) const;
+
+    /** \brief Store the line beginning at byte \c pos in \c line
+	and return the position of the following line
+
+	The newline (and a carriage return before the newline,
+	if present) are not included in \c line.
+    */
+    size_t get_line(size_t pos, std::string &line) const;
+
+    /** \brief Count the whitespace-separated words after byte
+	\c pos and return the total
+    */
+    size_t count_words(size_t pos);
+
+    /** \brief Convert the words counted by the last call to
+	\ref count_words() to numbers
+
+	Word \c k is stored in <tt>cols[k%ncols][k/ncols]</tt>,
+	so each column must have space for the number of words
+	returned by \ref count_words() divided by \c ncols (rounded
+	up). The return value is the number of words before the first
+	word which could not be converted to a number (or the total
+	number of words if all were converted). Some of the words
+	following a word which could not be converted may also be
+	stored.
+    */
+    size_t parse_words(size_t ncols, const std::vector<double *> &cols);
+
+    /** \brief Convert the characters from \c start up to (but
+	not including) \c end to a number, returning true on
+	success
+    */
+    static bool parse_double(const char *start, const char *end,
+			     double &x);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The file contents
+    const char *buf;
+
+    /// The file size
+    size_t len;
+
+    /// True if a file is open
+    bool open_flag;
+
+    /// True if the file was mapped with <tt>mmap()</tt>
+    bool mapped;
+
+    /// The file contents if <tt>mmap()</tt> was not used
+    std::vector<char> copy;
+
+    /// \name Chunks from the last call to count_words()
+    //@{
+    /// Beginning of each chunk
+    std::vector<size_t> chunk_start;
+    /// End of each chunk
+    std::vector<size_t> chunk_end;
+    /// Index of the first word in each chunk
+    std::vector<size_t> chunk_word;
+    //@}
+
+    /** \brief Convert using <tt>strtod()</tt> when \ref parse_double()
+	cannot convert the number exactly
+    */
+    static bool parse_double_slow(const char *start, const char *end,
+				  double &x);
+
+#endif
+#ifndef DOXYGEN_NO_O2NS
+
+  private:
+
+    text_mmap(const text_mmap &);
+    text_mmap& operator=(const text_mmap&);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
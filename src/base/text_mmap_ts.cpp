@@ -0,0 +1,121 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <random>
+
+#include <o2scl/text_mmap.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+bool parse(string s, double &x) {
+  return text_mmap::parse_double(s.c_str(),s.c_str()+s.length(),x);
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(2);
+
+  // Simple conversions
+  double x;
+  t.test_gen(parse("1",x) && x==1.0,"parse 1");
+  t.test_gen(parse("-2.5e-3",x) && x==-2.5e-3,"parse 2");
+  t.test_gen(parse("+.5",x) && x==0.5,"parse 3");
+  t.test_gen(parse("3.",x) && x==3.0,"parse 4");
+  t.test_gen(parse("1E+300",x) && x==1.0e300,"parse 5");
+  t.test_gen(parse("0.000000000000000000000000001234",x) &&
+	     x==1.234e-27,"parse 6");
+  t.test_gen(parse("nan",x)==false,"parse nan");
+  t.test_gen(parse("-inf",x)==false,"parse inf");
+  t.test_gen(parse("0x1p3",x)==false,"parse hex");
+  t.test_gen(parse("abc",x)==false,"parse fail 1");
+  t.test_gen(parse("1.0e",x)==false,"parse fail 2");
+  t.test_gen(parse("1.0x",x)==false,"parse fail 3");
+  t.test_gen(parse("-",x)==false,"parse fail 4");
+  t.test_gen(parse("1e400",x)==false,"parse overflow");
+
+  // The conversions should be correctly rounded, and thus
+  // identical to those from strtod()
+  std::mt19937 gen(10);
+  std::uniform_real_distribution<double> dist(0.0,1.0);
+  bool same=true;
+  for(size_t i=0;i<100000;i++) {
+    ostringstream oss;
+    oss.precision(1+i%20);
+    if (i%2==0) oss.setf(ios::scientific);
+    double y=(dist(gen)-0.5)*pow(10.0,((double)(i%61))-30.0);
+    oss << y;
+    string s=oss.str();
+    if (!parse(s,x) || x!=strtod(s.c_str(),0)) {
+      if (same) cout << "Conversion of " << s << " failed." << endl;
+      same=false;
+    }
+  }
+  t.test_gen(same,"correctly rounded");
+
+  // Write a file with a header line which is large enough to be
+  // divided into several chunks
+  ofstream fout("text_mmap_ts.txt");
+  fout.precision(12);
+  fout << "a b" << endl;
+  for(size_t i=0;i<20000;i++) {
+    fout << ((double)i)/3.0 << " " << sqrt((double)i) << endl;
+  }
+  fout << "1.0 end" << endl;
+  fout.close();
+
+  for(size_t nt=1;nt<=3;nt+=2) {
+
+    text_mmap tm;
+    tm.n_threads=nt;
+    tm.open("text_mmap_ts.txt");
+    t.test_gen(tm.estimate_lines()==20002,"estimate_lines");
+    t.test_gen(tm.estimate_lines(10000)>10000 &&
+	       tm.estimate_lines(10000)<40000,
+	       "estimate_lines 2");
+    string line;
+    size_t pos=tm.get_line(0,line);
+    t.test_str(line,"a b","get_line");
+
+    size_t n_words=tm.count_words(pos);
+    t.test_gen(n_words==40002,"count_words");
+
+    vector<double> a(20001), b(20001);
+    vector<double *> cols={&a[0],&b[0]};
+    size_t n_good=tm.parse_words(2,cols);
+    t.test_gen(n_good==40001,"parse_words");
+    t.test_rel(a[19999],19999.0/3.0,1.0e-11,"parse_words a");
+    t.test_rel(b[19999],sqrt(19999.0),1.0e-11,"parse_words b");
+    t.test_gen(a[20000]==1.0,"parse_words last");
+  }
+
+  t.report();
+  return 0;
+}
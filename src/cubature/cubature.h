@@ -364,6 +364,7 @@ namespace o2scl {
       pts=e.pts;
       vals_ix=e.vals_ix;
     }
+    return *this;
   }
       
   /** \brief The dimensionality */
@@ -412,8 +413,16 @@ namespace o2scl {
     return;
   }
 
-  /** \brief Desc
+  /** \brief Evaluate the rule in the first \c nR regions of \c R
 
+      If \ref use_parallel is nonzero, \ref n_threads is larger
+      than one, and OpenMP support is enabled, the regions are
+      divided into contiguous blocks which are evaluated
+      simultaneously, each with its own copy of the rule from
+      \ref thread_rules or \ref thread_rules_1d. The results for
+      each region do not depend on how the regions are divided, so
+      the final result is independent of the number of threads.
+      
       \note All regions must have same fdim 
   */
   int eval_regions(size_t nR, std::vector<region> &R, func_t &f, rule &r) {
@@ -423,7 +432,33 @@ namespace o2scl {
       /* nothing to evaluate */
       return o2scl::success;
     }
+#ifdef O2SCL_OPENMP
+    size_t nt=n_threads;
+    if (nt>nR) nt=nR;
+    if (use_parallel && nt>1) {
+      
+      std::vector<int> ret(nt);
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+      for(size_t it=0;it<nt;it++) {
+	// The regions for this thread are [iR0,iR0+nRt)
+	size_t iR0=(nR*it)/nt;
+	size_t nRt=(nR*(it+1))/nt-iR0;
+	if (r.dim==1) {
+	  ret[it]=rule15gauss_evalError(thread_rules_1d[it],R[0].fdim,
+					f,nRt,R,iR0);
+	} else {
+	  ret[it]=rule75genzmalik_evalError(thread_rules[it],R[0].fdim,
+					    f,nRt,R,iR0);
+	}
+      }
+      for(size_t it=0;it<nt;it++) {
+	if (ret[it]!=0) return o2scl::gsl_failure;
+      }
+      
+    } else if (r.dim==1) {
+#else
     if (r.dim==1) {
+#endif
       if (rule15gauss_evalError(r, R[0].fdim, f, nR, R)) {
 	return o2scl::gsl_failure;
       }
@@ -641,6 +676,7 @@ namespace o2scl {
       weightE1=e.weightE1;
       weightE3=e.weightE3;
     }
+    return *this;
   }
 
   /** \brief Desc */
@@ -662,11 +698,12 @@ namespace o2scl {
   }{
 #endif
     
-    /** \brief Desc
+    /** \brief Evaluate the Genz-Malik rule in the \c nR regions
+	of \c R beginning with index \c iR0
      */
     int rule75genzmalik_evalError
       (rule &runder, size_t fdim, func_t &f, size_t nR,
-       std::vector<region> &R) {
+       std::vector<region> &R, size_t iR0=0) {
     
       /* lambda2 = sqrt(9/70), lambda4 = sqrt(9/10), lambda5 = sqrt(9/19) */
       const double lambda2 = 0.3585685828003180919906451539079374954541;
@@ -688,7 +725,7 @@ namespace o2scl {
       vals = &(runder.pts[runder.vals_ix]);
 
       for (iR = 0; iR < nR; ++iR) {
-	std::vector<double> &center2=R[iR].h.data;
+	std::vector<double> &center2=R[iR0+iR].h.data;
           
 	for (i = 0; i < dim; ++i) {
 	  r->p[i] = center2[i];
@@ -773,14 +810,14 @@ namespace o2scl {
 	  }
     
 	  /* Calculate fifth and seventh order results */
-	  result = R[iR].h.vol * (r->weight1 * val0 + weight2 * sum2 +
+	  result = R[iR0+iR].h.vol * (r->weight1 * val0 + weight2 * sum2 +
 				  r->weight3 * sum3 + weight4 * sum4 +
 				  r->weight5 * sum5);
-	  res5th = R[iR].h.vol * (r->weightE1 * val0 + weightE2 * sum2 +
+	  res5th = R[iR0+iR].h.vol * (r->weightE1 * val0 + weightE2 * sum2 +
 				  r->weightE3 * sum3 + weightE4 * sum4);
     
-	  R[iR].ee[j].val = result;
-	  R[iR].ee[j].err = fabs(res5th - result);
+	  R[iR0+iR].ee[j].val = result;
+	  R[iR0+iR].ee[j].err = fabs(res5th - result);
     
 	  v += runder.num_points * fdim;
 	}
@@ -797,7 +834,7 @@ namespace o2scl {
 	    dimDiffMax = i;
 	  }
 	}
-	R[iR].splitDim = dimDiffMax;
+	R[iR0+iR].splitDim = dimDiffMax;
       }
       return o2scl::success;
     }
@@ -843,9 +880,13 @@ namespace o2scl {
 
     /** \brief 1d 15-point Gaussian quadrature rule, based on qk15.c
 	and qk.c in GNU GSL (which in turn is based on QUADPACK).
+
+	The rule is evaluated in the \c nR regions of \c R
+	beginning with index \c iR0.
     */
     int rule15gauss_evalError
-      (rule &r, size_t fdim, func_t &f, size_t nR, std::vector<region> &R) {
+      (rule &r, size_t fdim, func_t &f, size_t nR, std::vector<region> &R,
+       size_t iR0=0) {
 
       static const double cub_dbl_min=std::numeric_limits<double>::min();
       static const double cub_dbl_eps=std::numeric_limits<double>::epsilon();
@@ -891,8 +932,8 @@ namespace o2scl {
       vals = &(r.pts[r.vals_ix]);
 
       for (iR = 0; iR < nR; ++iR) {
-	const double center = R[iR].h.data[0];
-	const double halfwidth = R[iR].h.data[1];
+	const double center = R[iR0+iR].h.data[0];
+	const double halfwidth = R[iR0+iR].h.data[1];
 
 	pts[npts++] = center;
 
@@ -909,7 +950,7 @@ namespace o2scl {
 	  pts[npts++] = center + w;
 	}
 
-	R[iR].splitDim = 0; /* no choice but to divide 0th dimension */
+	R[iR0+iR].splitDim = 0; /* no choice but to divide 0th dimension */
       }
 
       if (f(1, npts, pts, fdim, vals)) {
@@ -919,7 +960,7 @@ namespace o2scl {
       for (k = 0; k < fdim; ++k) {
 	const double *vk = vals + k;
 	for (iR = 0; iR < nR; ++iR) {
-	  const double halfwidth = R[iR].h.data[1];
+	  const double halfwidth = R[iR0+iR].h.data[1];
 	  double result_gauss = vk[0] * wg[n/2 - 1];
 	  double result_kronrod = vk[0] * wgk[n - 1];
 	  double result_abs = fabs(result_kronrod);
@@ -946,7 +987,7 @@ namespace o2scl {
 	  }
                
 	  /* integration result */
-	  R[iR].ee[k].val = result_kronrod * halfwidth;
+	  R[iR0+iR].ee[k].val = result_kronrod * halfwidth;
 
 	  /* error estimate 
 	     (from GSL, probably dates back to QUADPACK
@@ -978,7 +1019,7 @@ namespace o2scl {
 	    double min_err = 50 * cub_dbl_eps * result_abs;
 	    if (min_err > err) err = min_err;
 	  }
-	  R[iR].ee[k].err = err;
+	  R[iR0+iR].ee[k].err = err;
                
 	  /* increment vk to point to next batch of results */
 	  vk += 15*fdim;
@@ -1340,6 +1381,10 @@ namespace o2scl {
 	    }
 	    R[nR] = heap_pop(regions);
 	    for (j = 0; j < fdim; ++j) ee[j].err -= R[nR].ee[j].err;
+	    if (cut_region(R[nR], R[nR+1])) {
+	      heap_free(regions);
+	      return o2scl::gsl_failure;
+	    }
 	    numEval += r.num_points * 2;
 	    nR += 2;
 	    if (converged(fdim, ee, reqAbsError, reqRelError, norm)) {
@@ -1420,12 +1465,20 @@ namespace o2scl {
       if (dim==1) {
 	rule r;
 	make_rule15gauss(dim,fdim,r);
+	if (parallel && n_threads>1) {
+	  thread_rules_1d.resize(n_threads);
+	  for(size_t i=0;i<n_threads;i++) thread_rules_1d[i]=r;
+	}
 	make_hypercube_range(dim,xmin,xmax,h);
 	status = rulecubature(r,fdim,f,h,maxEval,reqAbsError,
 			      reqRelError,norm,val,err,parallel);
       } else {
 	rule75genzmalik r;
 	make_rule75genzmalik(dim,fdim,r);
+	if (parallel && n_threads>1) {
+	  thread_rules.resize(n_threads);
+	  for(size_t i=0;i<n_threads;i++) thread_rules[i]=r;
+	}
 	make_hypercube_range(dim,xmin,xmax,h);
 	status = rulecubature(r,fdim,f,h,maxEval,reqAbsError,
 			      reqRelError,norm,val,err,parallel);
@@ -1435,13 +1488,42 @@ namespace o2scl {
       return status;
     }
     
+    /// \name Rule copies for each thread in parallel mode
+    //@{
+    /// For multidimensional integrals
+    std::vector<rule75genzmalik> thread_rules;
+    /// For one-dimensional integrals
+    std::vector<rule> thread_rules_1d;
+    //@}
+    
   public:
 
-    /// Desc
+    /** \brief If nonzero, evaluate all of the regions required to
+	reduce the error below the tolerance at once (default 0)
+
+	In this mode, the integrand is called once for each batch
+	of regions with all of the points for that batch (or for
+	each thread's share of the batch, see \ref n_threads), so a
+	vectorized integrand can process them together. This
+	typically requires more function evaluations than the
+	default mode.
+    */
     int use_parallel;
+
+    /** \brief The number of OpenMP threads used to evaluate the
+	regions when \ref use_parallel is nonzero (default 1)
+
+	If this is larger than one, the integrand is called
+	simultaneously from several threads and thus must be
+	thread-safe. The results do not depend on the number of
+	threads. This value is ignored if OpenMP support was not
+	enabled during compilation.
+    */
+    size_t n_threads;
     
     inte_hcubature() {
       use_parallel=0;
+      n_threads=1;
     }
 
     /** \brief Desc
@@ -145,6 +145,9 @@ double morokoff(size_t dim, const double *x) {
 int f_test(size_t dim, const double *x, size_t fdim, double *retval) {
   
   double val;
+#ifdef O2SCL_OPENMP
+#pragma omp atomic
+#endif
   ++cub_count;
 
   double fdata;
@@ -415,52 +418,48 @@ int main(void) {
     
   }
 
-  // With parallelism for hcubature
+  // With parallelism for hcubature. The number of function
+  // evaluations is different, so we compare with the exact result,
+  // and then ensure that several threads give the same result as
+  // one thread.
   hc.use_parallel=1;
 
-  if (false) {
-
-    tcnt=0;
-    for(size_t test_iand=0;test_iand<8;test_iand++) {
-
-      double tol;
-      size_t maxEval;
-      ubvector vval(1), verr(1);
-
-      tol=1.0e-2;
-      maxEval=0;
-    
-      which_integrand = test_iand; 
+  for(size_t test_iand=0;test_iand<8;test_iand++) {
     
-      if (test_iand!=2) {
-
-	cub_count=0;
-	hc.integ(1,cfa,dim,xmin,xmax,maxEval,0,tol,en,vval,verr);
-	       
-	cout << "# " << which_integrand << " " 
-	     << "integral " << vval[0] << " "
-	     << "est. error " << verr[0] << " " 
-	     << "true error " 
-	     << fabs(vval[0]-exact_integral(which_integrand,dim,xmax)) << endl;
-	cout << "evals " << cub_count << endl;
-
-	tmgr.test_gen(fabs(vval[0]-exact_integral(which_integrand,dim,xmax))<
-		      verr[0]*2.0,"hcub 2");
-	tmgr.test_gen(test_n[tcnt]==cub_count,"cub_count");
-	tmgr.test_rel(vval[0],test_vals[tcnt][0],5.0e-6,"val");
-	tmgr.test_rel(verr[0],test_vals[tcnt][1],5.0e-6,"err");
-	tmgr.test_rel(fabs(vval[0]-exact_integral(which_integrand,dim,xmax)),
-		      test_vals[tcnt][2],5.0e-6,"diff w/ exact");
-	tcnt++;
-      }
+    double tol=1.0e-2;
+    size_t maxEval=0;
+    ubvector vval(1), verr(1), vval2(1), verr2(1);
     
-      if (test_iand!=3) {
-	tcnt++;
-      }
+    which_integrand = test_iand; 
     
-    }
+    if (test_iand!=2) {
+      
+      hc.n_threads=1;
+      cub_count=0;
+      hc.integ(1,cfa,dim,xmin,xmax,maxEval,0,tol,en,vval,verr);
+      int count1=cub_count;
+      
+      cout << "# " << which_integrand << " " 
+	   << "integral " << vval[0] << " "
+	   << "est. error " << verr[0] << " " 
+	   << "true error " 
+	   << fabs(vval[0]-exact_integral(which_integrand,dim,xmax)) << endl;
+      cout << "evals " << cub_count << endl;
+      
+      tmgr.test_gen(fabs(vval[0]-exact_integral(which_integrand,dim,xmax))<
+		    verr[0]*2.0,"hcub parallel");
 
+      hc.n_threads=4;
+      cub_count=0;
+      hc.integ(1,cfa,dim,xmin,xmax,maxEval,0,tol,en,vval2,verr2);
+      
+      tmgr.test_gen(count1==cub_count,"hcub threads count");
+      tmgr.test_rel(vval[0],vval2[0],1.0e-14,"hcub threads val");
+      tmgr.test_rel(verr[0],verr2[0],1.0e-14,"hcub threads err");
+    }
+    
   }
+  hc.n_threads=1;
 
   // Now run with dim=1 (without parallelism)
 
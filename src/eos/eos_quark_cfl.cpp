@@ -109,40 +109,23 @@ int eos_quark_cfl::test_integration(test_mgr &t) {
   return 0;
 }
 
+int eos_quark_cfl::integrands_batch(size_t np, const double *p, size_t nr,
+				    double *res) {
+  for(size_t i=0;i<np;i++) {
+    integrands(p[i],res+i*nr);
+  }
+  return 0;
+}
+
 int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 			    ubvector &res, double &err2) {
 
-  //double fval1[nr], fval2[nr], fval[nr];
   double fv1[5], fv2[5], fv3[5], fv4[5];
-  //double savfun[21][nr];  
-  //double res10[nr], res21[nr], res43[nr], res87[nr];    
-  //double result_kronrod[nr];
   double err;
   double resabs; 
   double resasc; 
 
-  double *fval1=new double[nr];
-  double *fval2=new double[nr];
-  double *fval=new double[nr];
-  double **savfun=new double *[21];
-  for(size_t i=0;i<21;i++) savfun[i]=new double[nr];
-  double *res10=new double[nr];
-  double *res21=new double[nr];
-  double *res43=new double[nr];
-  double *res87=new double[nr];
-  double *result_kronrod=new double[nr];
-  double *f_center=new double[nr];
-
-  const double half_length= 0.5*(b-a);
-  const double abs_half_length=fabs (half_length);
-  const double center=0.5*(b+a);
-
-  //double f_center[nr];
-  integrands(center,f_center);
-    
-  int k;
-  
-      double dbl_eps=std::numeric_limits<double>::epsilon();
+  double dbl_eps=std::numeric_limits<double>::epsilon();
 
   if (inte_epsabs<=0 && (inte_epsrel<50*dbl_eps || 
 			 inte_epsrel<0.5e-28)) {
@@ -152,6 +135,36 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 		   " in eos_quark_cfl::integ_err().",exc_ebadtol);
   };
   
+  std::vector<double> fval(nr), f_center(nr);
+  std::vector<double> res10(nr), res21(nr), res43(nr), res87(nr);
+  std::vector<double> result_kronrod(nr);
+  std::vector<std::vector<double> > savfun(21,std::vector<double>(nr));
+
+  const double half_length= 0.5*(b-a);
+  const double abs_half_length=fabs (half_length);
+  const double center=0.5*(b+a);
+
+  // The momenta for each set of quadrature nodes are computed
+  // first, so that all of the integrands in the set can be
+  // computed together by integrands_batch(). Each pair of nodes
+  // center+abscissa and center-abscissa is stored consecutively.
+  double nodes[44];
+  std::vector<double> fn(44*nr);
+  
+  int k;
+  
+  // The 21-point rule
+  
+  nodes[0]=center;
+  for (k=0;k<5;k++) {
+    nodes[1+2*k]=center+half_length*o2scl_inte_qng_coeffs::x1[k];
+    nodes[2+2*k]=center-half_length*o2scl_inte_qng_coeffs::x1[k];
+    nodes[11+2*k]=center+half_length*o2scl_inte_qng_coeffs::x2[k];
+    nodes[12+2*k]=center-half_length*o2scl_inte_qng_coeffs::x2[k];
+  }
+  integrands_batch(21,nodes,nr,&fn[0]);
+  for(size_t j=0;j<nr;j++) f_center[j]=fn[j];
+    
   for (size_t j=0;j<nr;j++) {
     res10[j]=0;
     res21[j]=o2scl_inte_qng_coeffs::w21b[5]*f_center[j];
@@ -159,9 +172,8 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
   resabs=o2scl_inte_qng_coeffs::w21b[5]*fabs(f_center[0]);
     
   for (k=0;k<5;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x1[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fn[(1+2*k)*nr];
+    const double *fval2=&fn[(2+2*k)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res10[j]+=o2scl_inte_qng_coeffs::w10[k]*fval[j];
@@ -174,9 +186,8 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
   }
     
   for (k=0;k<5;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x2[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fn[(11+2*k)*nr];
+    const double *fval2=&fn[(12+2*k)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res21[j]+=o2scl_inte_qng_coeffs::w21b[k]*fval[j];
@@ -205,34 +216,27 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
     for(size_t j=0;j<nr;j++) res[j]=result_kronrod[j];
     err2=err;
     inte_npoints=21;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
-      
+
+  // The 43-point rule
+  
   for(size_t j=0;j<nr;j++) {
     res43[j]=o2scl_inte_qng_coeffs::w43b[11]*f_center[j];
     for (k=0;k<10;k++) {
       res43[j]+=savfun[k][j]*o2scl_inte_qng_coeffs::w43a[k];
     }
   }
-      
+
+  for (k=0; k < 11; k++) {
+    nodes[2*k]=center+half_length*o2scl_inte_qng_coeffs::x3[k];
+    nodes[2*k+1]=center-half_length*o2scl_inte_qng_coeffs::x3[k];
+  }
+  integrands_batch(22,nodes,nr,&fn[0]);
+  
   for (k=0; k < 11; k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x3[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fn[2*k*nr];
+    const double *fval2=&fn[(2*k+1)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res43[j]+=fval[j]*o2scl_inte_qng_coeffs::w43b[k];
@@ -249,34 +253,27 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
     for(size_t j=0;j<nr;j++) res[j]=result_kronrod[j];
     err2=err;
     inte_npoints=43;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
-      
+
+  // The 87-point rule
+  
   for(size_t j=0;j<nr;j++) {
     res87[j]=o2scl_inte_qng_coeffs::w87b[22]*f_center[j];
     for (k=0;k<21;k++) {
       res87[j]+=savfun[k][j]*o2scl_inte_qng_coeffs::w87a[k];
     }
   }
+
+  for (k=0;k<22;k++) {
+    nodes[2*k]=center+half_length*o2scl_inte_qng_coeffs::x4[k];
+    nodes[2*k+1]=center-half_length*o2scl_inte_qng_coeffs::x4[k];
+  }
+  integrands_batch(44,nodes,nr,&fn[0]);
   
   for (k=0;k<22;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x4[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fn[2*k*nr];
+    const double *fval2=&fn[(2*k+1)*nr];
     for(size_t j=0;j<nr;j++) {
       res87[j]+=o2scl_inte_qng_coeffs::w87b[k]*(fval1[j]+fval2[j]);
     }
@@ -290,36 +287,9 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 
   if (err < inte_epsabs || err < inte_epsrel*fabs (result_kronrod[0])) {
     inte_npoints=87;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
       
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
   inte_npoints=88;
   O2SCL_ERR("failed to reach tolerance with highest-order rule",
 	    exc_etol);
@@ -405,6 +405,18 @@ namespace o2scl {
 	- res[12] is \f$ d \Omega / d \mu_8 \f$
     */
     virtual int integrands(double p, double res[]);
+
+    /** \brief Compute the integrands at the \c np momenta in \c p
+
+	The \c nr integrands for momentum <tt>p[i]</tt> are stored in
+	<tt>res[i*nr]</tt> through <tt>res[i*nr+nr-1]</tt>. This
+	function is called by \ref integ_err() once for each set of
+	quadrature nodes, and this default version just calls
+	\ref integrands() for each momentum. Children may override
+	this function to compute the integrands concurrently.
+    */
+    virtual int integrands_batch(size_t np, const double *p, size_t nr,
+				 double *res);
     
     /// Compute ungapped eigenvalues and the appropriate derivatives
     int normal_eigenvalues(double m, double lmom, double mu, 
@@ -26,13 +26,15 @@
 
 #include <o2scl/eos_quark_cfl6.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
 
-eos_quark_cfl6::eos_quark_cfl6() {
-  KD=0.0;
-  
+eos_quark_cfl6::eig6_workspace::eig6_workspace() {
   iprop6=gsl_matrix_complex_alloc(mat_size,mat_size);
   eivec6=gsl_matrix_complex_alloc(mat_size,mat_size);
   dipdgapu.resize(mat_size,mat_size);
@@ -43,16 +45,29 @@ eos_quark_cfl6::eos_quark_cfl6() {
   dipdqqs.resize(mat_size,mat_size);
   eval6=gsl_vector_alloc(mat_size);
   w6=gsl_eigen_hermv_alloc(mat_size);
-  
-  kdlimit=1.0e-6;
 }
 
-eos_quark_cfl6::~eos_quark_cfl6() {
+eos_quark_cfl6::eig6_workspace::~eig6_workspace() {
   gsl_matrix_complex_free(iprop6);
   gsl_matrix_complex_free(eivec6);
   gsl_vector_free(eval6);
   gsl_eigen_hermv_free(w6);
+}
+
+eos_quark_cfl6::eos_quark_cfl6() {
+  KD=0.0;
+  n_threads=1;
+  
+  ws6.push_back(new eig6_workspace);
+  
+  kdlimit=1.0e-6;
+}
 
+eos_quark_cfl6::~eos_quark_cfl6() {
+  for(size_t i=0;i<ws6.size();i++) {
+    delete ws6[i];
+  }
+  ws6.clear();
 }
 
 int eos_quark_cfl6::set_masses() {
@@ -169,14 +184,49 @@ int eos_quark_cfl6::integrands(double p, double res[]) {
     return 0;
   }
 
+  return integrands_ws(p,res,*ws6[0]);
+}
+
+int eos_quark_cfl6::integrands_batch(size_t np, const double *p,
+				     size_t nr, double *res) {
+
+  size_t nt=n_threads;
+  if (nt>np) nt=np;
+  
+#ifdef O2SCL_OPENMP
+
+  if (nt>1 && fabs(KD)>=kdlimit && !integ_test) {
+
+    // Allocate the workspaces outside of the parallel region
+    while (ws6.size()<nt) ws6.push_back(new eig6_workspace);
+
+    int ret=0;
+#pragma omp parallel for num_threads(nt) schedule(dynamic) \
+  reduction(+:ret)
+    for(size_t i=0;i<np;i++) {
+      size_t it=omp_get_thread_num();
+      if (integrands_ws(p[i],res+i*nr,*ws6[it])!=0) ret++;
+    }
+    if (ret!=0) return exc_efailed;
+    return 0;
+  }
+  
+#endif
+  
+  return eos_quark_cfl::integrands_batch(np,p,nr,res);
+}
+
+int eos_quark_cfl6::integrands_ws(double p, double res[],
+				  eig6_workspace &ws) {
+  
   int k;
   double egv[36];
   double dedmuu[36], dedmud[36], dedmus[36];
   double dedqqu[36], dedqqd[36], dedqqs[36], deds[36];
   double dedd[36], dedu[36], dedmu3[36], dedmu8[36];
   
-  eigenvalues6(p,smu3,smu8,egv,dedmuu,dedmud,dedmus,dedqqu,dedqqd,dedqqs,
-	       dedu,dedd,deds,dedmu3,dedmu8);
+  eigenvalues6_ws(ws,p,smu3,smu8,egv,dedmuu,dedmud,dedmus,dedqqu,dedqqd,
+		  dedqqs,dedu,dedd,deds,dedmu3,dedmu8);
   
   res[0]=0.0;
   res[1]=0.0;
@@ -294,6 +344,12 @@ int eos_quark_cfl6::test_derivatives(double lmom, double mu3, double mu8,
   double dedd[36], dedu[36], dedmu3[36], dedmu8[36];
   double h=1.0e-7;
   double d1[36], d2[36], tmpt[36];
+
+  // The matrices from make_matrices()
+  gsl_matrix_complex *iprop6=ws6[0]->iprop6;
+  ubmatrix_complex &dipdgapu=ws6[0]->dipdgapu;
+  ubmatrix_complex &dipdgapd=ws6[0]->dipdgapd;
+  ubmatrix_complex &dipdgaps=ws6[0]->dipdgaps;
   
   set_masses();
 
@@ -710,7 +766,31 @@ int eos_quark_cfl6::eigenvalues6(double lmom, double mu3,
 			    double dedu[36], double dedd[36],
 			    double deds[36], double dedmu3[36],
 			    double dedmu8[36]) {
-  
+  return eigenvalues6_ws(*ws6[0],lmom,mu3,mu8,egv,dedmuu,dedmud,dedmus,
+			 dedqqu,dedqqd,dedqqs,dedu,dedd,deds,dedmu3,dedmu8);
+}
+
+int eos_quark_cfl6::eigenvalues6_ws(eig6_workspace &ws, double lmom,
+				    double mu3, double mu8, double egv[36],
+				    double dedmuu[36], double dedmud[36],
+				    double dedmus[36], double dedqqu[36], 
+				    double dedqqd[36], double dedqqs[36],
+				    double dedu[36], double dedd[36],
+				    double deds[36], double dedmu3[36],
+				    double dedmu8[36]) const {
+  
+  // The matrices in the workspace
+  gsl_matrix_complex *iprop6=ws.iprop6;
+  gsl_matrix_complex *eivec6=ws.eivec6;
+  gsl_vector *eval6=ws.eval6;
+  gsl_eigen_hermv_workspace *w6=ws.w6;
+  ubmatrix_complex &dipdgapu=ws.dipdgapu;
+  ubmatrix_complex &dipdgapd=ws.dipdgapd;
+  ubmatrix_complex &dipdgaps=ws.dipdgaps;
+  ubmatrix_complex &dipdqqu=ws.dipdqqu;
+  ubmatrix_complex &dipdqqd=ws.dipdqqd;
+  ubmatrix_complex &dipdqqs=ws.dipdqqs;
+
   int k;
   const double mu=up->ms, md=down->ms, ms=strange->ms;
   const double muu=up->mu, mud=down->mu, mus=strange->mu;
@@ -1951,6 +2031,16 @@ int eos_quark_cfl6::make_matrices(double lmom, double mu3,
 			     double deds[36], double dedmu3[36],
 			     double dedmu8[36]) {
   
+  eig6_workspace &ws=*ws6[0];
+  // The matrices in the workspace
+  gsl_matrix_complex *iprop6=ws.iprop6;
+  ubmatrix_complex &dipdgapu=ws.dipdgapu;
+  ubmatrix_complex &dipdgapd=ws.dipdgapd;
+  ubmatrix_complex &dipdgaps=ws.dipdgaps;
+  ubmatrix_complex &dipdqqu=ws.dipdqqu;
+  ubmatrix_complex &dipdqqd=ws.dipdqqd;
+  ubmatrix_complex &dipdqqs=ws.dipdqqs;
+
   int k;
   const double mu=up->ms, md=down->ms, ms=strange->ms;
   const double muu=up->mu, mud=down->mu, mus=strange->mu;
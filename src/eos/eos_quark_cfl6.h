@@ -27,6 +27,7 @@
 #define CFL6_EOS_H
 
 #include <iostream>
+#include <vector>
 #include <o2scl/test_mgr.h>
 #include <o2scl/eos_quark_cfl.h>
 
@@ -219,6 +220,18 @@ namespace o2scl {
 
     /// The momentum integrands
     virtual int integrands(double p, double res[]);
+
+    /** \brief Compute the momentum integrands for a set of
+	quadrature nodes
+
+	If \ref n_threads is larger than one and OpenMP support is
+	enabled, then the matrices for the different momenta are
+	diagonalized concurrently, each thread using its own
+	workspace. Otherwise, this calls \ref integrands() for each
+	momentum.
+    */
+    virtual int integrands_batch(size_t np, const double *p, size_t nr,
+				 double *res);
     
     /// Check the derivatives specified by eigenvalues()
     virtual int test_derivatives(double lmom, double mu3, double mu8,
@@ -261,6 +274,11 @@ namespace o2scl {
     /// The color superconducting 't Hooft coupling (default 0)
     double KD;
 
+    /** \brief The number of OpenMP threads used for the momentum 
+	integrals (default 1)
+    */
+    size_t n_threads;
+
     /// Return string denoting type ("eos_quark_cfl6")
     virtual const char *type() { return "eos_quark_cfl6"; };
 
@@ -283,36 +301,81 @@ namespace o2scl {
     
     /// The size of the matrix to be diagonalized
     static const int mat_size=36;
-    
-    /// Storage for the inverse propagator
-    gsl_matrix_complex *iprop6;
 
-    /// The eigenvectors
-    gsl_matrix_complex *eivec6;
+    /** \brief Storage for the diagonalization of the inverse
+	propagator at one momentum
+    */
+    class eig6_workspace {
+      
+    public:
+      
+      eig6_workspace();
+      
+      ~eig6_workspace();
+      
+      /// Storage for the inverse propagator
+      gsl_matrix_complex *iprop6;
+
+      /// The eigenvectors
+      gsl_matrix_complex *eivec6;
 
-    /// The derivative wrt the ds gap
-    ubmatrix_complex dipdgapu;
+      /// The derivative wrt the ds gap
+      ubmatrix_complex dipdgapu;
 
-    /// The derivative wrt the us gap
-    ubmatrix_complex dipdgapd;
+      /// The derivative wrt the us gap
+      ubmatrix_complex dipdgapd;
 
-    /// The derivative wrt the ud gap
-    ubmatrix_complex dipdgaps;
+      /// The derivative wrt the ud gap
+      ubmatrix_complex dipdgaps;
 
-    /// The derivative wrt the up quark condensate
-    ubmatrix_complex dipdqqu;
+      /// The derivative wrt the up quark condensate
+      ubmatrix_complex dipdqqu;
 
-    /// The derivative wrt the down quark condensate
-    ubmatrix_complex dipdqqd;
+      /// The derivative wrt the down quark condensate
+      ubmatrix_complex dipdqqd;
 
-    /// The derivative wrt the strange quark condensate
-    ubmatrix_complex dipdqqs;
+      /// The derivative wrt the strange quark condensate
+      ubmatrix_complex dipdqqs;
 
-    /// Storage for the eigenvalues
-    gsl_vector *eval6;
+      /// Storage for the eigenvalues
+      gsl_vector *eval6;
 
-    /// GSL workspace for the eigenvalue computation
-    gsl_eigen_hermv_workspace *w6;
+      /// GSL workspace for the eigenvalue computation
+      gsl_eigen_hermv_workspace *w6;
+
+    private:
+
+      eig6_workspace(const eig6_workspace &);
+      eig6_workspace& operator=(const eig6_workspace&);
+      
+    };
+
+    /** \brief The workspaces, one for each thread
+
+	The first workspace is used by \ref eigenvalues6() and \ref
+	make_matrices(). The workspaces are kept between calls to
+	\ref calc_eq_temp_p() so that they are allocated only once.
+    */
+    std::vector<eig6_workspace *> ws6;
+
+    /** \brief Compute the integrands at momentum \c p using
+	the workspace \c ws
+    */
+    int integrands_ws(double p, double res[], eig6_workspace &ws);
+
+    /** \brief Compute the eigenvalues and their derivatives
+	using the workspace \c ws
+
+	This function does not modify the class and can be called
+	by several threads at once with different workspaces.
+    */
+    int eigenvalues6_ws(eig6_workspace &ws, double lmom, double mu3,
+			double mu8, double egv[36], double dedmuu[36], 
+			double dedmud[36], double dedmus[36], 
+			double dedmu[36], double dedmd[36], 
+			double dedms[36], double dedu[36], 
+			double dedd[36], double deds[36], 
+			double dedmu3[36], double dedmu8[36]) const;
 
   private:
 
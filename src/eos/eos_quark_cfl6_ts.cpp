@@ -182,6 +182,18 @@ int main(void) {
 
     cfl2.calc_eq_temp_p(u2,d2,s2,ss12,ss22,ss32,gap12,gap22,gap32,
 			0.0,0.0,n32,n82,th2,2.0/hc_mev_fm);
+
+    // -----------------------------
+    // The results should not depend on the number of threads
+    
+    cfl2.n_threads=3;
+    cfl2.calc_eq_temp_p(u2,d2,s2,ss1,ss2,ss3,gap1,gap2,gap3,
+			0.0,0.0,n3,n8,th,2.0/hc_mev_fm);
+    t.test_gen(th.pr==th2.pr,"threads pr");
+    t.test_gen(ss1==ss12 && ss2==ss22 && ss3==ss32,"threads qq");
+    t.test_gen(gap1==gap12 && gap2==gap22 && gap3==gap32,"threads gap");
+    t.test_gen(n3==n32 && n8==n82,"threads n3 n8");
+    cfl2.n_threads=1;
   }
 
   t.report();
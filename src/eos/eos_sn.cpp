@@ -20,6 +20,8 @@
 
   -------------------------------------------------------------------
 */
+#include <algorithm>
+
 #include <o2scl/eos_sn.h>
 #include <o2scl/test_mgr.h>
 #include <o2scl/hdf_file.h>
@@ -62,6 +64,7 @@ eos_sn_base::eos_sn_base() : cu(o2scl_settings.get_convert_units()) {
   include_muons=false;
 
   verbose=1;
+  packed_interp_type=packed_linear;
 
   loaded=false;
   with_leptons_loaded=false;
@@ -267,6 +270,9 @@ void eos_sn_base::free() {
   loaded=false;
   oth_names.clear();
   oth_units.clear();
+  packed_list.clear();
+  packed.clear();
+  for(size_t k=0;k<3;k++) packed_grid[k].clear();
   return;
 }
 
@@ -281,6 +287,165 @@ void eos_sn_base::set_interp_type(size_t interp_type) {
   return;
 }
 
+void eos_sn_base::pack_data(const std::vector<size_t> &list) {
+
+  if (list.size()==0) {
+    O2SCL_ERR("No data sets specified in eos_sn_base::pack_data().",
+	      exc_einval);
+  }
+  for(size_t i=0;i<list.size();i++) {
+    if (list[i]>=n_base+30 || arr[list[i]]->get_rank()!=3) {
+      O2SCL_ERR2("Data set not loaded or invalid index in ",
+		 "eos_sn_base::pack_data().",exc_einval);
+    }
+  }
+  
+  tensor_grid3<> &t0=*arr[list[0]];
+  size_t n[3];
+  for(size_t k=0;k<3;k++) {
+    n[k]=t0.get_size(k);
+    if (n[k]<2) {
+      O2SCL_ERR2("Grid too small in ",
+		 "eos_sn_base::pack_data().",exc_einval);
+    }
+    packed_grid[k].resize(n[k]);
+    for(size_t i=0;i<n[k];i++) {
+      packed_grid[k][i]=t0.get_grid(k,i);
+    }
+  }
+  for(size_t i=1;i<list.size();i++) {
+    for(size_t k=0;k<3;k++) {
+      if (arr[list[i]]->get_size(k)!=n[k]) {
+	O2SCL_ERR2("Data sets have different sizes in ",
+		   "eos_sn_base::pack_data().",exc_einval);
+      }
+    }
+  }
+  
+  size_t np=list.size();
+  packed_list=list;
+  packed.resize(n[0]*n[1]*n[2]*np);
+  for(size_t iq=0;iq<np;iq++) {
+    const tensor_grid3<> &tq=*arr[list[iq]];
+    for(size_t i=0;i<n[0];i++) {
+      for(size_t j=0;j<n[1];j++) {
+	for(size_t k=0;k<n[2];k++) {
+	  packed[((i*n[1]+j)*n[2]+k)*np+iq]=tq.get(i,j,k);
+	}
+      }
+    }
+  }
+  
+  return;
+}
+
+void eos_sn_base::pack_data() {
+  std::vector<size_t> list;
+  for(size_t i=0;i<n_base+n_oth;i++) {
+    if (arr[i]->total_size()>0) list.push_back(i);
+  }
+  pack_data(list);
+  return;
+}
+
+size_t eos_sn_base::packed_weights(size_t k, double x, size_t &i0,
+				   double w[4]) const {
+  
+  const std::vector<double> &g=packed_grid[k];
+  size_t n=g.size();
+  
+  // Find the interval [g[i],g[i+1]] containing x, starting
+  // with the guess and clamping to the edges of the grid
+  size_t i=i0;
+  if (i>n-2 || x<g[i] || x>=g[i+1]) {
+    i=std::upper_bound(g.begin(),g.end(),x)-g.begin();
+    if (i>0) i--;
+    if (i>n-2) i=n-2;
+  }
+  
+  if (packed_interp_type==packed_cubic && n>=4) {
+
+    // Lagrange weights on four points around the interval
+    if (i==0) i0=0;
+    else if (i+2>=n) i0=n-4;
+    else i0=i-1;
+    for(size_t a=0;a<4;a++) {
+      w[a]=1.0;
+      for(size_t b=0;b<4;b++) {
+	if (a!=b) {
+	  w[a]*=(x-g[i0+b])/(g[i0+a]-g[i0+b]);
+	}
+      }
+    }
+    return 4;
+  }
+
+  i0=i;
+  double frac=(x-g[i])/(g[i+1]-g[i]);
+  w[0]=1.0-frac;
+  w[1]=frac;
+  return 2;
+}
+
+void eos_sn_base::packed_sum(size_t i0[3], size_t nw[3], double w[3][4],
+			     double *res) const {
+  
+  size_t np=packed_list.size();
+  size_t n1=packed_grid[1].size();
+  size_t n2=packed_grid[2].size();
+
+  for(size_t iq=0;iq<np;iq++) res[iq]=0.0;
+  
+  for(size_t a=0;a<nw[0];a++) {
+    for(size_t b=0;b<nw[1];b++) {
+      double wab=w[0][a]*w[1][b];
+      for(size_t c=0;c<nw[2];c++) {
+	double wabc=wab*w[2][c];
+	const double *p=&packed[(((i0[0]+a)*n1+i0[1]+b)*n2+i0[2]+c)*np];
+	for(size_t iq=0;iq<np;iq++) {
+	  res[iq]+=wabc*p[iq];
+	}
+      }
+    }
+  }
+  
+  return;
+}
+
+void eos_sn_base::interp_packed(double nB, double Ye, double T,
+				double *res) const {
+  interp_packed_vec(1,&nB,&Ye,&T,res);
+  return;
+}
+
+void eos_sn_base::interp_packed_vec(size_t n, const double *nB,
+				    const double *Ye, const double *T,
+				    double *res) const {
+  
+  if (packed_list.size()==0) {
+    O2SCL_ERR2("No packed data in ",
+	       "eos_sn_base::interp_packed_vec().",exc_einval);
+  }
+
+  size_t np=packed_list.size();
+  size_t guess[3]={0,0,0}, i0[3], nw[3];
+  double w[3][4];
+  
+  for(size_t ip=0;ip<n;ip++) {
+    double x[3]={nB[ip],Ye[ip],T[ip]};
+    for(size_t k=0;k<3;k++) {
+      i0[k]=guess[k];
+      nw[k]=packed_weights(k,x[k],i0[k],w[k]);
+      // For the cubic stencil, the interval is one past the
+      // first point, except at the lower edge
+      guess[k]=(nw[k]==4 && i0[k]>0) ? i0[k]+1 : i0[k];
+    }
+    packed_sum(i0,nw,w,res+ip*np);
+  }
+  
+  return;
+}
+
 void eos_sn_base::compute_eg_point(double nB, double Ye, double T,
 				   thermo &th) {
   
@@ -210,6 +210,81 @@ namespace o2scl {
     void set_interp_type(size_t interp_type);
     //@}
 
+    /// \name Packed interpolation
+    //@{
+    /** \brief Copy the data sets with indices \c list in
+	\ref arr into a single interleaved array for use
+	by \ref interp_packed()
+
+	The values of all of the quantities at each grid point are
+	stored next to each other, so that all of the quantities can
+	be interpolated with only one grid search and one set of
+	interpolation weights. The grid is taken from the first
+	data set in the list. The packed array must be recreated
+	with this function if the data is modified.
+    */
+    void pack_data(const std::vector<size_t> &list);
+
+    /** \brief Copy all of the data sets which have been loaded
+	into a single interleaved array
+	
+	This packs every data set in \ref arr with a nonzero size
+	(including the first \ref n_oth entries in \ref other) in
+	the same order as in \ref arr. The indices of the packed
+	data sets can be obtained with \ref get_packed_list().
+    */
+    void pack_data();
+
+    /// Return the indices in \ref arr of the packed data sets
+    const std::vector<size_t> &get_packed_list() const {
+      return packed_list;
+    }
+
+    /// \name Packed interpolation types
+    //@{
+    /// Trilinear interpolation (the default)
+    static const size_t packed_linear=1;
+    /** \brief Tricubic Lagrange interpolation using a 
+	\f$ 4 \times 4 \times 4 \f$ set of grid points
+    */
+    static const size_t packed_cubic=2;
+    //@}
+
+    /** \brief The interpolation type for \ref interp_packed()
+	(default \ref packed_linear)
+
+	For \ref packed_cubic, the set of grid points is shifted at
+	the edges of the grid so that it remains inside the table,
+	and linear interpolation is used in any direction which
+	has fewer than four grid points. Outside the grid, the
+	values are extrapolated from the nearest interval.
+    */
+    size_t packed_interp_type;
+
+    /** \brief Interpolate all of the packed data sets at the
+	point \c (nB,Ye,T), storing the results in \c res
+
+	The array \c res must have space for one value for each
+	entry in \ref get_packed_list(), and the results are stored
+	in the same order. This function does not modify the class
+	and may be called simultaneously from several threads.
+    */
+    void interp_packed(double nB, double Ye, double T, double *res) const;
+    
+    /** \brief Interpolate all of the packed data sets at the
+	\c n points in the arrays \c nB, \c Ye, and \c T
+
+	The results for point \c i are stored in 
+	<tt>res[i*m]</tt> through <tt>res[i*m+m-1]</tt> where
+	\c m is the size of \ref get_packed_list(). When nearby
+	points are given in sequence (as in a loop over the zones of
+	a hydrodynamics code), the grid search begins with the
+	interval used for the previous point.
+    */
+    void interp_packed_vec(size_t n, const double *nB, const double *Ye,
+			   const double *T, double *res) const;
+    //@}
+
     /// \name Nucleon masses
     //@{
     /** \brief Neutron mass in \f$ \mathrm{MeV} \f$ 
@@ -450,6 +525,32 @@ namespace o2scl {
     void alloc();
     //@}
 
+    /// \name Packed data for interp_packed()
+    //@{
+    /// The indices in \ref arr of the packed data sets
+    std::vector<size_t> packed_list;
+    /// The interleaved data
+    std::vector<double> packed;
+    /// The grids for the packed data
+    std::vector<double> packed_grid[3];
+    //@}
+
+    /** \brief Compute the first grid index \c i0 and the
+	interpolation weights \c w for the point \c x in grid \c k,
+	returning the number of weights
+
+	The value of \c i0 on entry is used as a guess for the
+	location of \c x in the grid.
+    */
+    size_t packed_weights(size_t k, double x, size_t &i0,
+			  double w[4]) const;
+
+    /** \brief Interpolate using the weights computed by
+	\ref packed_weights()
+    */
+    void packed_sum(size_t i0[3], size_t nw[3], double w[3][4],
+		    double *res) const;
+
 
   };
 
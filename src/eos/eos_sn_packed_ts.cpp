@@ -0,0 +1,146 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <o2scl/test_mgr.h>
+#include <o2scl/eos_sn.h>
+
+/*
+  This tests the packed interpolation in eos_sn_base using synthetic
+  data, since the full eos_sn test requires the EOS tables.
+*/
+
+using namespace std;
+using namespace o2scl;
+
+/// A function which is cubic in each variable
+double cubic(double x, double y, double z) {
+  return 1.0+x*x*x-2.0*x*y*y+y*z*z*z+x*y*z+0.5*z*z;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(2);
+
+  eos_sn_base es;
+  es.verbose=0;
+
+  // Unevenly spaced grids
+  size_t sz[3]={8,6,5};
+  vector<double> grid;
+  for(size_t i=0;i<sz[0];i++) grid.push_back(0.01*pow(1.6,(double)i));
+  for(size_t i=0;i<sz[1];i++) grid.push_back(0.05+0.1*i+0.01*i*i);
+  for(size_t i=0;i<sz[2];i++) grid.push_back(0.5*i*i+0.1);
+
+  // Fill four data sets, with the cubic function stored in P
+  tensor_grid3<> *tp[4]={&es.E,&es.P,&es.S,&es.mun};
+  for(size_t iq=0;iq<4;iq++) {
+    tp[iq]->resize(3,sz);
+    tp[iq]->set_grid_packed(grid);
+  }
+  for(size_t i=0;i<sz[0];i++) {
+    double x=es.E.get_grid(0,i);
+    for(size_t j=0;j<sz[1];j++) {
+      double y=es.E.get_grid(1,j);
+      for(size_t k=0;k<sz[2];k++) {
+	double z=es.E.get_grid(2,k);
+	es.E.set(i,j,k,2.0+sin(10.0*x)+y*z);
+	es.P.set(i,j,k,cubic(x,y,z));
+	es.S.set(i,j,k,exp(-x)*(2.0+cos(y+z)));
+	es.mun.set(i,j,k,((double)(i*31+j*7+k*3)));
+      }
+    }
+  }
+
+  // Points inside the grid, including points near the edges
+  size_t np=40;
+  vector<double> nB(np), Ye(np), T(np);
+  for(size_t ip=0;ip<np;ip++) {
+    double f=((double)ip)/((double)(np-1));
+    nB[ip]=0.0101+f*(0.01*pow(1.6,7.0)-0.0102);
+    Ye[ip]=0.051+fmod(f*3.7,1.0)*0.74;
+    T[ip]=0.101+fmod(f*2.3,1.0)*7.9;
+  }
+
+  // Pack all of the data sets which were set above
+  es.pack_data();
+  const vector<size_t> &list=es.get_packed_list();
+  t.test_gen(list.size()==4,"pack_data() size");
+  t.test_gen(list[0]==2 && list[1]==4 && list[2]==6 && list[3]==8,
+	     "pack_data() list");
+
+  // Trilinear interpolation, compared with interp_linear()
+  double res[4];
+  for(size_t ip=0;ip<np;ip++) {
+    es.interp_packed(nB[ip],Ye[ip],T[ip],res);
+    for(size_t iq=0;iq<4;iq++) {
+      t.test_rel(res[iq],tp[iq]->interp_linear(nB[ip],Ye[ip],T[ip]),
+		 1.0e-12,"packed_linear");
+    }
+  }
+
+  // The array version gives the same results as the single point
+  // version
+  vector<double> vres(np*4);
+  es.interp_packed_vec(np,&nB[0],&Ye[0],&T[0],&vres[0]);
+  for(size_t ip=0;ip<np;ip++) {
+    es.interp_packed(nB[ip],Ye[ip],T[ip],res);
+    for(size_t iq=0;iq<4;iq++) {
+      t.test_rel(vres[ip*4+iq],res[iq],1.0e-14,"interp_packed_vec linear");
+    }
+  }
+
+  // Tricubic interpolation reproduces the cubic function exactly
+  es.packed_interp_type=eos_sn_base::packed_cubic;
+  for(size_t ip=0;ip<np;ip++) {
+    es.interp_packed(nB[ip],Ye[ip],T[ip],res);
+    t.test_rel(res[1],cubic(nB[ip],Ye[ip],T[ip]),1.0e-10,"packed_cubic");
+  }
+  es.interp_packed_vec(np,&nB[0],&Ye[0],&T[0],&vres[0]);
+  for(size_t ip=0;ip<np;ip++) {
+    es.interp_packed(nB[ip],Ye[ip],T[ip],res);
+    for(size_t iq=0;iq<4;iq++) {
+      t.test_rel(vres[ip*4+iq],res[iq],1.0e-14,"interp_packed_vec cubic");
+    }
+  }
+
+  // Pack a subset in a different order
+  vector<size_t> sub={6,4};
+  es.pack_data(sub);
+  t.test_gen(es.get_packed_list()==sub,"pack_data(list) list");
+  es.packed_interp_type=eos_sn_base::packed_linear;
+  for(size_t ip=0;ip<np;ip++) {
+    es.interp_packed(nB[ip],Ye[ip],T[ip],res);
+    t.test_rel(res[0],es.S.interp_linear(nB[ip],Ye[ip],T[ip]),
+	       1.0e-12,"pack_data(list) S");
+    t.test_rel(res[1],es.P.interp_linear(nB[ip],Ye[ip],T[ip]),
+	       1.0e-12,"pack_data(list) P");
+  }
+
+  t.report();
+  return 0;
+}
@@ -370,6 +370,10 @@ eos_nstar_rot_L::eos_nstar_rot_L(bool rns_constants) {
 
 nstar_rot::nstar_rot() {
   verbose=1;
+  err_nonconv=true;
+  n_threads=1;
+  iter_count=0;
+  guess_dr=0.02;
 
   RDIV=900;
   MDIV=65;
@@ -932,6 +936,80 @@ void nstar_rot::comp_f_P() {
     }
   }
 
+  // Simpson's rule weights in the angular direction, including
+  // the factor DM/3
+
+  std::vector<double> w_m(MDIV+1,0.0);
+  for(int m=1;m<=MDIV-2;m+=2) {
+    w_m[m]+=DM/3.0;
+    w_m[m+1]+=4.0*DM/3.0;
+    w_m[m+2]+=DM/3.0;
+  }
+
+  // Weights for the angular integrals. The n=0 terms for gamma
+  // and omega are not used.
+
+  w_ang_rho.resize((LMAX+1)*(MDIV+1));
+  w_ang_gamma.resize((LMAX+1)*(MDIV+1));
+  w_ang_omega.resize((LMAX+1)*(MDIV+1));
+  for(n=0;n<=LMAX;n++) {
+    w_ang_rho[n*(MDIV+1)]=0.0;
+    w_ang_gamma[n*(MDIV+1)]=0.0;
+    w_ang_omega[n*(MDIV+1)]=0.0;
+    for(int m=1;m<=MDIV;m++) {
+      w_ang_rho[n*(MDIV+1)+m]=w_m[m]*P_2n(m,n);
+      if (n==0) {
+	w_ang_gamma[m]=0.0;
+	w_ang_omega[m]=0.0;
+      } else {
+	w_ang_gamma[n*(MDIV+1)+m]=w_m[m]*sin((2.0*n-1.0)*theta[m]);
+	w_ang_omega[n*(MDIV+1)+m]=w_m[m]*sin_theta[m]*P1_2n_1(m,n);
+      }
+    }
+  }
+
+  // Simpson's rule weights in the radial direction, including
+  // the factor DS/3
+
+  w_rad.resize(SDIV+1);
+  for(k=0;k<=SDIV;k++) w_rad[k]=0.0;
+  for(k=1;k<=SDIV-2;k+=2) {
+    w_rad[k]+=DS/3.0;
+    w_rad[k+1]+=4.0*DS/3.0;
+    w_rad[k+2]+=DS/3.0;
+  }
+
+  // Coefficients for the summation over n. The n=0 terms for gamma
+  // and omega are not used.
+
+  c_sum_rho.resize((MDIV+1)*(LMAX+1));
+  c_sum_gamma.resize((MDIV+1)*(LMAX+1));
+  c_sum_omega.resize((MDIV+1)*(LMAX+1));
+  for(int m=0;m<=MDIV;m++) {
+    for(n=0;n<=LMAX;n++) {
+      size_t ix=m*(LMAX+1)+n;
+      if (m==0) {
+	c_sum_rho[ix]=0.0;
+	c_sum_gamma[ix]=0.0;
+	c_sum_omega[ix]=0.0;
+      } else {
+	c_sum_rho[ix]=P_2n(m,n);
+	if (n==0) {
+	  c_sum_gamma[ix]=0.0;
+	  c_sum_omega[ix]=0.0;
+	} else if (m==MDIV) {
+	  c_sum_gamma[ix]=1.0;
+	  c_sum_omega[ix]=-0.5;
+	} else {
+	  c_sum_gamma[ix]=sin((2.0*n-1.0)*theta[m])/
+	    ((2.0*n-1.0)*sin_theta[m]);
+	  c_sum_omega[ix]=P1_2n_1(m,n)/(2.0*n*(2.0*n-1.0)*sin_theta[m]);
+	}
+      }
+    }
+  }
+
+  return;
 }
 
 void nstar_rot::make_center(double e_center_loc) {
@@ -2584,12 +2662,29 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 
   r_e=r_e_guess;
 
+#ifdef O2SCL_OPENMP
+  int nt=((int)n_threads);
+#endif
+
+  // Contiguous storage for the integrations, the ublas matrices
+  // are stored in row-major order
+  size_t nm=MDIV+1, ns=SDIV+1, nl=LMAX+1;
+  const double *S_r=&S_rho(0,0), *S_g=&S_gamma(0,0), *S_o=&S_omega(0,0);
+  double *D1_r=&D1_rho(0,0), *D1_g=&D1_gamma(0,0), *D1_o=&D1_omega(0,0);
+  double *D2_r=&D2_rho(0,0), *D2_g=&D2_gamma(0,0), *D2_o=&D2_omega(0,0);
+  const double *f_r=&(f_rho.get_data()[0]);
+  const double *f_g=&(f_gamma.get_data()[0]);
+  const double *f_o=&(f_omega.get_data()[0]);
+  std::vector<double> e_rho(nl*ns), e_gamma(nl*ns), e_omega(nl*ns);
+
   int n_of_it=0;
   // Difference | r_e_old -r_e |
   double r_e_diff=1.0;
 
   while (r_e_diff>tol_rel || n_of_it<2) { 
 
+    iter_count++;
+
     /* Rescale potentials and construct arrays with the potentials
        along the equatorial and polar directions.
     */        
@@ -2691,17 +2786,18 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 
     // Evaluation of source terms (Eqs. 30-33 of Cook, et al. (1992))
 
-    int s;
     if (SMAX==1.0) {
-      s=SDIV;
       for(int m=1;m<=MDIV;m++) {
-	S_rho(s,m)=0.0;
-	S_gamma(s,m)=0.0;
-	S_omega(s,m)=0.0;
+	S_rho(SDIV,m)=0.0;
+	S_gamma(SDIV,m)=0.0;
+	S_omega(SDIV,m)=0.0;
       }
     }
 
-    for(s=1;s<=s_temp;s++) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+    for(int s=1;s<=s_temp;s++) {
       for(int m=1;m<=MDIV;m++) {
 	double rsm=rho(s,m);
 	double gsm=gamma(s,m);
@@ -2773,94 +2869,97 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
       }
     }
     
-    // Angular integration (see Eqs. 27-29 of Cook, et al. (1992))
-  
-    int n=0;
-    for(int k=1;k<=SDIV;k++) {      
-
-      // Intermediate sum in eqn for rho
-      double sum_rho=0.0;
-      for(int m=1;m<=MDIV-2;m+=2) {
-	sum_rho+=(DM/3.0)*(P_2n(m,n)*S_rho(k,m)
-			   +4.0*P_2n(m+1,n)*S_rho(k,m+1) 
-			   +P_2n(m+2,n)*S_rho(k,m+2));
-      }
+    // Angular integration (see Eqs. 27-29 of Cook, et al. (1992)).
+    // The Simpson's rule sums over m are computed as the product of
+    // the source terms with the weights from comp_f_P().
 
-      D1_rho(n,k)=sum_rho;
-      D1_gamma(n,k)=0.0;
-      D1_omega(n,k)=0.0;
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+    for(int k=1;k<=SDIV;k++) {
 
-    }
+      const double *sr=S_r+k*nm;
+      const double *sg=S_g+k*nm;
+      const double *so=S_o+k*nm;
 
-    for(n=1;n<=LMAX;n++) {
-      for(int k=1;k<=SDIV;k++) {
-	// Intermediate sums in eqns for rho, gamma, omega
-	double sum_rho=0.0, sum_gamma=0.0, sum_omega=0.0;
-	for(int m=1;m<=MDIV-2;m+=2) {
-
-	  sum_rho+=(DM/3.0)*(P_2n(m,n)*S_rho(k,m)
-			     +4.0*P_2n(m+1,n)*S_rho(k,m+1) 
-			     +P_2n(m+2,n)*S_rho(k,m+2));
-                       
-	  sum_gamma+=(DM/3.0)*(sin((2.0*n-1.0)*theta[m])*S_gamma(k,m)
-			       +4.0*sin((2.0*n-1.0)*theta[m+1])*
-			       S_gamma(k,m+1)
-			       +sin((2.0*n-1.0)*theta[m+2])*S_gamma(k,m+2));
-  
-	  sum_omega+=(DM/3.0)*(sin_theta[m]*P1_2n_1(m,n)*S_omega(k,m)
-			       +4.0*sin_theta[m+1]*P1_2n_1(m+1,n)*
-			       S_omega(k,m+1)
-			       +sin_theta[m+2]*P1_2n_1(m+2,n)*
-			       S_omega(k,m+2));
+      double sum_rho=0.0;
+      for(int m=1;m<=MDIV;m++) sum_rho+=w_ang_rho[m]*sr[m];
+      D1_r[k]=sum_rho;
+      D1_g[k]=0.0;
+      D1_o[k]=0.0;
+
+      for(int n=1;n<=LMAX;n++) {
+	const double *wr=&w_ang_rho[n*nm];
+	const double *wg=&w_ang_gamma[n*nm];
+	const double *wo=&w_ang_omega[n*nm];
+	double sum_gamma=0.0, sum_omega=0.0;
+	sum_rho=0.0;
+	for(int m=1;m<=MDIV;m++) {
+	  sum_rho+=wr[m]*sr[m];
+	  sum_gamma+=wg[m]*sg[m];
+	  sum_omega+=wo[m]*so[m];
 	}
-	D1_rho(n,k)=sum_rho;
-	D1_gamma(n,k)=sum_gamma;
-	D1_omega(n,k)=sum_omega;
+	D1_r[n*ns+k]=sum_rho;
+	D1_g[n*ns+k]=sum_gamma;
+	D1_o[n*ns+k]=sum_omega;
       }
     }
 
-    // Radial integration
+    // Radial integration. The Simpson's rule weights are applied
+    // to D1 first so that the sums over k are products with the
+    // two-point functions.
 
-    n=0;
-    for(s=1;s<=SDIV;s++) {
-      // Intermediate sum in eqn for rho
-      double sum_rho=0.0;
-      for(int k=1;k<=SDIV-2;k+=2) { 
-	sum_rho+=(DS/3.0)*(f_rho.get(s,n,k)*D1_rho(n,k)+
-			   4.0*f_rho.get(s,n,k+1)*D1_rho(n,k+1)+
-			   f_rho.get(s,n,k+2)*D1_rho(n,k+2));
+    for(int n=0;n<=LMAX;n++) {
+      for(int k=1;k<=SDIV;k++) {
+	e_rho[n*ns+k]=w_rad[k]*D1_r[n*ns+k];
+	e_gamma[n*ns+k]=w_rad[k]*D1_g[n*ns+k];
+	e_omega[n*ns+k]=w_rad[k]*D1_o[n*ns+k];
       }
-      D2_rho(s,n)=sum_rho;
-      D2_gamma(s,n)=0.0;
-      D2_omega(s,n)=0.0;
     }
 
-    for(s=1;s<=SDIV;s++) {
-      for(n=1;n<=LMAX;n++) {
-	// Intermediate sums in eqns for rho, gamma, omega
-	double sum_rho=0.0, sum_gamma=0.0, sum_omega=0.0;
-	for(int k=1;k<=SDIV-2;k+=2) { 
-	  sum_rho+=(DS/3.0)*(f_rho.get(s,n,k)*D1_rho(n,k) 
-			     +4.0*f_rho.get(s,n,k+1)*D1_rho(n,k+1)
-			     +f_rho.get(s,n,k+2)*D1_rho(n,k+2));
-	  
-	  sum_gamma+=(DS/3.0)*(f_gamma.get(s,n,k)*D1_gamma(n,k) 
-			       + 4.0*f_gamma.get(s,n,k+1)*D1_gamma(n,k+1)
-			       + f_gamma.get(s,n,k+2)*D1_gamma(n,k+2));
-	  
-	  sum_omega+=(DS/3.0)*(f_omega.get(s,n,k)*D1_omega(n,k) 
-			       +4.0*f_omega.get(s,n,k+1)*D1_omega(n,k+1)
-			       +f_omega.get(s,n,k+2)*D1_omega(n,k+2));
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+    for(int s=1;s<=SDIV;s++) {
+
+      const double *fr=f_r+s*nl*ns;
+      double sum_rho=0.0;
+      for(int k=1;k<=SDIV;k++) sum_rho+=fr[k]*e_rho[k];
+      D2_r[s*nl]=sum_rho;
+      D2_g[s*nl]=0.0;
+      D2_o[s*nl]=0.0;
+
+      for(int n=1;n<=LMAX;n++) {
+	fr=f_r+(s*nl+n)*ns;
+	const double *fg=f_g+(s*nl+n)*ns;
+	const double *fo=f_o+(s*nl+n)*ns;
+	const double *er=&e_rho[n*ns];
+	const double *eg=&e_gamma[n*ns];
+	const double *eo=&e_omega[n*ns];
+	double sum_gamma=0.0, sum_omega=0.0;
+	sum_rho=0.0;
+	for(int k=1;k<=SDIV;k++) {
+	  sum_rho+=fr[k]*er[k];
+	  sum_gamma+=fg[k]*eg[k];
+	  sum_omega+=fo[k]*eo[k];
 	}
-	D2_rho(s,n)=sum_rho;
-	D2_gamma(s,n)=sum_gamma;
-	D2_omega(s,n)=sum_omega;
+	D2_r[s*nl+n]=sum_rho;
+	D2_g[s*nl+n]=sum_gamma;
+	D2_o[s*nl+n]=sum_omega;
       }
     }
 
     // Summation of coefficients
 
-    for(s=1;s<=SDIV;s++) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+    for(int s=1;s<=SDIV;s++) {
+
+      const double *d2r=D2_r+s*nl;
+      const double *d2g=D2_g+s*nl;
+      const double *d2o=D2_o+s*nl;
+
       for(int m=1;m<=MDIV;m++) {
 
 	double gsm=gamma(s,m);
@@ -2868,28 +2967,23 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 	double omsm=omega(s,m);             
 	double e_gsm=exp(-0.5*gsm);
 	double e_rsm=exp(rsm);
-	double temp1=sin_theta[m];
+
+	const double *cr=&c_sum_rho[m*nl];
+	const double *cg=&c_sum_gamma[m*nl];
+	const double *co=&c_sum_omega[m*nl];
 
 	// Intermediate sums in eqns for rho, gamma, omega
-	double sum_rho=-e_gsm*P_2n(m,0)*D2_rho(s,0);
-	double sum_omega=0.0;
+	double sum_rho=cr[0]*d2r[0];
 	double sum_gamma=0.0;
-
-	for(n=1;n<=LMAX;n++) {
-
-	  sum_rho+=-e_gsm*P_2n(m,n)*D2_rho(s,n); 
-
-	  if (m==MDIV) {             
-	    sum_omega+=0.5*e_rsm*e_gsm*D2_omega(s,n); 
-	    sum_gamma+=-(2.0/PI)*e_gsm*D2_gamma(s,n);   
-	  } else { 
-	    sum_omega+=-e_rsm*e_gsm*(P1_2n_1(m,n)/
-				     (2.0*n*(2.0*n-1.0)
-				      *temp1))*D2_omega(s,n);  
-	    sum_gamma+=-(2.0/PI)*e_gsm*(sin((2.0*n-1.0)*theta[m])
-					/((2.0*n-1.0)*temp1))*D2_gamma(s,n);
-	  }
+	double sum_omega=0.0;
+	for(int n=1;n<=LMAX;n++) {
+	  sum_rho+=cr[n]*d2r[n];
+	  sum_gamma+=cg[n]*d2g[n];
+	  sum_omega+=co[n]*d2o[n];
 	}
+	sum_rho*=-e_gsm;
+	sum_gamma*=-(2.0/PI)*e_gsm;
+	sum_omega*=-e_rsm*e_gsm;
 	   
 	rho(s,m)=rsm+cf*(sum_rho-rsm);
 	gamma(s,m)=gsm+cf*(sum_gamma-gsm);
@@ -2914,7 +3008,7 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
     // Treat spherical case
 
     if (r_ratio_loc==1.0) {
-      for(s=1;s<=SDIV;s++) {
+      for(int s=1;s<=SDIV;s++) {
 	for(int m=1;m<=MDIV;m++) {
 	  rho(s,m)=rho(s,1);
 	  gamma(s,m)=gamma(s,1);
@@ -2935,7 +3029,10 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
       
     // Compute first order derivatives of gamma
  
-    for(s=1;s<=SDIV;s++) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+    for(int s=1;s<=SDIV;s++) {
       for(int m=1;m<=MDIV;m++) {
 	dgds(s,m)=deriv_s(gamma,s,m);
 	dgdm(s,m)=deriv_m(gamma,s,m);
@@ -2945,18 +3042,23 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
     // ALPHA (Integration of eq (39) of Cook, et al. (1992))
  
     if (r_ratio_loc==1.0) {
-      for(s=1;s<=SDIV;s++) {
+      for(int s=1;s<=SDIV;s++) {
 	for(int m=1;m<=MDIV;m++) {
 	  da_dm(s,m)=0.0;
 	}
       }
     } else {
+
+      for(int m=1;m<=MDIV;m++) {
+	da_dm(1,m)=0.0; 
+      }
     
-      for(s=2;s<=s_temp;s++) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt)
+#endif
+      for(int s=2;s<=s_temp;s++) {
 	for(int m=1;m<=MDIV;m++) {
 
-	  da_dm(1,m)=0.0; 
-       
 	  double sgp=s_gp[s];
 	  double s1=sgp*(1.0-sgp);
 	  double mum=mu[m]; 
@@ -3011,25 +3113,31 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
       }
     }
 
-    for(s=1;s<=s_temp;s++) {
+    // The number of points where alpha is too large
+    int n_alpha_large=0;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) reduction(+:n_alpha_large)
+#endif
+    for(int s=1;s<=s_temp;s++) {
+
       alpha(s,1)=0.0;
       for(int m=1;m<=MDIV-1;m++) {
 	alpha(s,m+1)=alpha(s,m)+0.5*DM*(da_dm(s,m+1)+da_dm(s,m));
       }
-    } 
- 
-    for(s=1;s<=s_temp;s++) {
-      for(int m=1;m<=MDIV;m++) {     
 
-	alpha(s,m)+=-alpha(s,MDIV)+0.5*(gamma(s,MDIV)-rho(s,MDIV));
-	if (alpha(s,m)>=300.0) {
-	  return 3;
-	}
-	
+      double alpha_shift=-alpha(s,MDIV)+0.5*(gamma(s,MDIV)-rho(s,MDIV));
+      for(int m=1;m<=MDIV;m++) {     
+	alpha(s,m)+=alpha_shift;
+	if (alpha(s,m)>=300.0) n_alpha_large++;
 	omega(s,m)/=r_e;
       } 
     }
 
+    if (n_alpha_large>0) {
+      return 3;
+    }
+
     if (SMAX==1.0) {
       for(int m=1;m<=MDIV;m++) {
 	alpha(SDIV,m)=0.0;
@@ -3126,10 +3234,40 @@ int nstar_rot::fix_cent_eden_axis_rat(double cent_eden, double axis_rat,
     }
   }
   
-  iterate(r_ratio,eq_radius_tol_rel);
+  int ret=iterate(r_ratio,eq_radius_tol_rel);
   comp();
 
-  return 0;
+  return ret;
+}
+
+void nstar_rot::get_guess(ubmatrix &rho_g, ubmatrix &gamma_g,
+			  ubmatrix &omega_g, ubmatrix &alpha_g,
+			  double &r_e_g) const {
+  rho_g=rho_guess;
+  gamma_g=gamma_guess;
+  omega_g=omega_guess;
+  alpha_g=alpha_guess;
+  r_e_g=r_e_guess;
+  return;
+}
+
+void nstar_rot::set_guess(const ubmatrix &rho_g, const ubmatrix &gamma_g,
+			  const ubmatrix &omega_g, const ubmatrix &alpha_g,
+			  double r_e_g) {
+  size_t n1=SDIV+1, n2=MDIV+1;
+  if (rho_g.size1()!=n1 || rho_g.size2()!=n2 ||
+      gamma_g.size1()!=n1 || gamma_g.size2()!=n2 ||
+      omega_g.size1()!=n1 || omega_g.size2()!=n2 ||
+      alpha_g.size1()!=n1 || alpha_g.size2()!=n2) {
+    O2SCL_ERR("Guess has wrong size in nstar_rot::set_guess().",
+	      exc_einval);
+  }
+  rho_guess=rho_g;
+  gamma_guess=gamma_g;
+  omega_guess=omega_g;
+  alpha_guess=alpha_g;
+  r_e_guess=r_e_g;
+  return;
 }
 
 void nstar_rot::resize(int MDIV_new, int SDIV_new, int LMAX_new,
@@ -3335,13 +3473,17 @@ int nstar_rot::fix_cent_eden_with_kepler_alt(double cent_eden,
 }
 
 
-int nstar_rot::fix_cent_eden_with_kepler(double cent_eden) {
+int nstar_rot::fix_cent_eden_with_kepler(double cent_eden,
+					 bool use_guess) {
 
   if (eos_set==false) {
     O2SCL_ERR2("EOS not specified in ",
 	       "nstar_rot::fix_cent_eden_with_kepler().",exc_einval);
   }
 
+  // The starting axis ratio when use_guess is true
+  double r_ratio_start=r_ratio;
+
   if (scaled_polytrope==false) {
     e_surface=7.8*C*C*KSCALE;
     p_surface=1.01e8*KSCALE;
@@ -3376,11 +3518,20 @@ int nstar_rot::fix_cent_eden_with_kepler(double cent_eden) {
   /* First model is guess */
   
   make_center(e_center);
-  spherical_star();             
   double d_Omega=1.0;           
   double sign=1.0;
   double dr=0.1;
-  r_ratio=1.0;
+  if (use_guess) {
+    // Begin at the current axis ratio, which is the first
+    // value tried after the step below
+    dr=guess_dr;
+    double r_start=r_ratio_start;
+    if (r_start+dr>1.0) r_start=1.0-dr;
+    r_ratio=r_start+dr;
+  } else {
+    spherical_star();             
+    r_ratio=1.0;
+  }
 
   double diff_omega=1.0;
  
@@ -3406,6 +3557,7 @@ int nstar_rot::fix_cent_eden_with_kepler(double cent_eden) {
     }
     
     if (r_ratio>=1.0) {
+      if (err_nonconv==false) return o2scl::exc_efailed;
       O2SCL_ERR2("Variable r_ratio>=1.0 in ",
 		 "fix_cent_eden_with_kepler().",o2scl::exc_efailed);
     }
@@ -3510,13 +3662,17 @@ int nstar_rot::fix_cent_eden_grav_mass_alt(double cent_eden,
   return 0;
 }
 
-int nstar_rot::fix_cent_eden_grav_mass(double cent_eden, double grav_mass) {
+int nstar_rot::fix_cent_eden_grav_mass(double cent_eden, double grav_mass,
+				       bool use_guess) {
 
   if (eos_set==false) {
     O2SCL_ERR2("EOS not specified in ",
 	       "nstar_rot::fix_cent_eden_grav_mass().",exc_einval);
   }
 
+  // The starting axis ratio when use_guess is true
+  double r_ratio_start=r_ratio;
+
   if (scaled_polytrope==false) {
     e_surface=7.8*C*C*KSCALE;
     p_surface=1.01e8*KSCALE;
@@ -3559,14 +3715,24 @@ int nstar_rot::fix_cent_eden_grav_mass(double cent_eden, double grav_mass) {
 
     dr=0.1;
     r_ratio=1.0-dr;
+    if (use_guess) {
+      dr=guess_dr;
+      if (r_ratio_start>0.0 && r_ratio_start<1.0) {
+	r_ratio=r_ratio_start;
+      }
+    }
 
     /* Compute first rotating model */
 
     make_center(e_center);
-    spherical_star();
+    if (use_guess==false) spherical_star();
     int ret=iterate(r_ratio,eq_radius_tol_rel);
     double sign;
-    if (ret!=0) {
+    if (ret!=0 && use_guess) {
+      // The search below would be skipped, so report the failure
+      // and let the caller start again from a spherical star
+      return ret;
+    } else if (ret!=0) {
       diff_M=-1.0;
       sign=-1.0;
     } else { 
@@ -61,6 +61,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -779,6 +780,39 @@ namespace o2scl {
     ubmatrix P1_2n_1;
     //@}
 
+    /// \name Integration weights computed in comp_f_P()
+    //@{
+    /** \brief Weights for the angular integral for \f$ \rho \f$,
+	indexed by <tt>[n*(MDIV+1)+m]</tt>
+
+	These include the Simpson's rule weights and the factor
+	\f$ P_{2n}(\mu) \f$.
+    */
+    std::vector<double> w_ang_rho;
+    /** \brief Weights for the angular integral for \f$ \gamma \f$,
+	indexed by <tt>[n*(MDIV+1)+m]</tt>
+    */
+    std::vector<double> w_ang_gamma;
+    /** \brief Weights for the angular integral for \f$ \omega \f$,
+	indexed by <tt>[n*(MDIV+1)+m]</tt>
+    */
+    std::vector<double> w_ang_omega;
+    /// Simpson's rule weights for the radial integrals
+    std::vector<double> w_rad;
+    /** \brief Coefficients of \ref D2_rho in the summation
+	for \f$ \rho \f$, indexed by <tt>[m*(LMAX+1)+n]</tt>
+    */
+    std::vector<double> c_sum_rho;
+    /** \brief Coefficients of \ref D2_gamma in the summation
+	for \f$ \gamma \f$, indexed by <tt>[m*(LMAX+1)+n]</tt>
+    */
+    std::vector<double> c_sum_gamma;
+    /** \brief Coefficients of \ref D2_omega in the summation
+	for \f$ \omega \f$, indexed by <tt>[m*(LMAX+1)+n]</tt>
+    */
+    std::vector<double> c_sum_omega;
+    //@}
+
     /** \brief Integrated term over m in eqn for \f$ \rho \f$ */
     ubmatrix D1_rho;
     /** \brief Integrated term over m in eqn for \f$ \gamma \f$ */
@@ -939,6 +973,11 @@ namespace o2scl {
 
 	See Eqs. 27-29 of \ref Cook92 and Eqs. 33-35 of \ref
 	Komatsu89. This function is called by the constructor.
+
+	This function also computes the weights in \ref w_ang_rho,
+	\ref w_ang_gamma, \ref w_ang_omega, \ref w_rad, \ref
+	c_sum_rho, \ref c_sum_gamma, and \ref c_sum_omega which are
+	used in \ref iterate().
     */
     void comp_f_P();
 
@@ -1033,7 +1072,16 @@ namespace o2scl {
     //@}
 
     /** \brief Main iteration function
-     */
+
+	The angular and radial integrals over the source terms are
+	computed as products of the source terms with the weights
+	computed in \ref comp_f_P(), using contiguous storage. If
+	OpenMP support is enabled, the loops over the grid are
+	distributed over \ref n_threads threads. Because the loops
+	are divided over the radial grid points and the sums are
+	always performed in the same order, the results do not
+	depend on the number of threads.
+    */
     int iterate(double r_ratio, double tol_rel);
 
     /// \name EOS member variables
@@ -1075,6 +1123,60 @@ namespace o2scl {
      */
     int verbose;
 
+    /** \brief If true, call the error handler if
+	\ref fix_cent_eden_with_kepler() does not converge
+	(default true)
+
+	If this is false, \ref fix_cent_eden_with_kepler() returns
+	\ref o2scl::exc_efailed instead.
+    */
+    bool err_nonconv;
+
+    /** \brief Number of OpenMP threads used in \ref iterate()
+	(default 1)
+    */
+    size_t n_threads;
+
+    /** \brief Total number of iterations performed by
+	\ref iterate() (the constructor sets this to zero)
+
+	This counter is never reset by the class, so it can be set
+	to zero before a calculation in order to count the number of
+	iterations that calculation required.
+    */
+    size_t iter_count;
+
+    /** \brief Initial step in the axis ratio for
+	\ref fix_cent_eden_grav_mass() and
+	\ref fix_cent_eden_with_kepler() when starting from
+	the current guess (default 0.02)
+    */
+    double guess_dr;
+
+    /** \brief Get the initial guess for the metric functions
+	and the equatorial radius
+
+	The guess is the last configuration for which \ref iterate()
+	converged, or the spherical star if no rotating configuration
+	has been computed since the last call to \ref spherical_star().
+	The matrices are resized to have <tt>SDIV+1</tt> rows and
+	<tt>MDIV+1</tt> columns.
+    */
+    void get_guess(ubmatrix &rho_g, ubmatrix &gamma_g, ubmatrix &omega_g,
+		   ubmatrix &alpha_g, double &r_e_g) const;
+
+    /** \brief Set the initial guess for the metric functions
+	and the equatorial radius
+
+	The matrices must be of the size returned by \ref get_guess()
+	with the current grid. This guess is used by the next call to
+	one of the <tt>fix_cent_eden</tt> functions with
+	<tt>use_guess</tt> equal to <tt>true</tt>.
+    */
+    void set_guess(const ubmatrix &rho_g, const ubmatrix &gamma_g,
+		   const ubmatrix &omega_g, const ubmatrix &alpha_g,
+		   double r_e_g);
+
     /** \brief Create an output table
      */
     void output_table(o2scl::table3d &t);
@@ -1234,6 +1336,11 @@ namespace o2scl {
 	\mathrm{g}/\mathrm{cm}^3 \f$ and the axis ratio is unitless.
 	This is fastest of the high-level interface functions as it
 	doesn't require an additional solver.
+
+	If \c use_guess is true, then the iteration begins with the
+	current guess (see \ref get_guess()) rather than with a
+	spherical star. The return value is the value returned by
+	the final call to \ref iterate().
     */
     int fix_cent_eden_axis_rat(double cent_eden, double axis_rat,
 			       bool use_guess=false);
@@ -1244,8 +1351,16 @@ namespace o2scl {
 	The central energy density should be in \f$
 	\mathrm{g}/\mathrm{cm}^3 \f$ and the gravitational 
 	mass should be in solar masses. 
+
+	If \c use_guess is true, then the search begins with the
+	current guess (see \ref get_guess()) and the current value of
+	\ref r_ratio, using an initial step of \ref guess_dr, rather
+	than with a spherical star. In this case, if \ref iterate()
+	fails for the first configuration, its return value is
+	returned immediately.
     */
-    int fix_cent_eden_grav_mass(double cent_eden, double grav_mass);
+    int fix_cent_eden_grav_mass(double cent_eden, double grav_mass,
+				bool use_guess=false);
 
     /** \brief Construct a configuration with a fixed central 
 	energy density and a fixed baryonic mass
@@ -1261,8 +1376,13 @@ namespace o2scl {
 	
 	The central energy density should be in \f$
 	\mathrm{g}/\mathrm{cm}^3 \f$ .
+
+	If \c use_guess is true, then the search begins with the
+	current guess (see \ref get_guess()) and the current value of
+	\ref r_ratio, using an initial step of \ref guess_dr, rather
+	than with a spherical star.
     */
-    int fix_cent_eden_with_kepler(double cent_eden);
+    int fix_cent_eden_with_kepler(double cent_eden, bool use_guess=false);
 
     /** \brief Experimental alternate form for
 	\ref fix_cent_eden_with_kepler()
@@ -0,0 +1,265 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/nstar_rot_seq.h>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace o2scl;
+
+nstar_rot_seq::nstar_rot_seq() {
+  warm_start=true;
+  extrap=true;
+  n_threads=1;
+  verbose=0;
+}
+
+int nstar_rot_seq::solve_point(nstar_rot &nr, int type, double ed,
+			       double p, bool use_guess) {
+  int ret;
+  try {
+    if (type==fix_axis_rat) {
+      ret=nr.fix_cent_eden_axis_rat(ed,p,use_guess);
+    } else if (type==fix_grav_mass) {
+      ret=nr.fix_cent_eden_grav_mass(ed,p,use_guess);
+    } else {
+      ret=nr.fix_cent_eden_with_kepler(ed,use_guess);
+    }
+  } catch (std::exception &e) {
+    ret=exc_efailed;
+  }
+  // The root-finding loops in nstar_rot do not report a failure
+  // when the axis ratio leaves the physical range
+  if (ret==0 && (!std::isfinite(nr.Mass) || !std::isfinite(nr.r_ratio) ||
+		 nr.r_ratio<=0.0 || nr.r_ratio>1.0)) {
+    ret=exc_efailed;
+  }
+  return ret;
+}
+
+void nstar_rot_seq::check_input
+(int type, size_t n_seq, const std::vector<std::vector<double> > &cent_eden,
+ const std::vector<std::vector<double> > &par) {
+
+  if (type!=fix_axis_rat && type!=fix_grav_mass && type!=fix_kepler) {
+    O2SCL_ERR("Invalid sequence type in nstar_rot_seq.",exc_einval);
+  }
+  if (cent_eden.size()<n_seq) {
+    O2SCL_ERR("Too few energy density vectors in nstar_rot_seq.",
+	      exc_einval);
+  }
+  if (type!=fix_kepler) {
+    if (par.size()<n_seq) {
+      O2SCL_ERR("Too few parameter vectors in nstar_rot_seq.",exc_einval);
+    }
+    for(size_t i=0;i<n_seq;i++) {
+      if (par[i].size()<cent_eden[i].size()) {
+	O2SCL_ERR("Too few parameters in nstar_rot_seq.",exc_einval);
+      }
+    }
+  }
+  return;
+}
+
+int nstar_rot_seq::compute(nstar_rot &nr, int type,
+			   const std::vector<double> &cent_eden,
+			   const std::vector<double> &par,
+			   nstar_rot_seq_result &res) {
+
+  size_t n=cent_eden.size();
+
+  res.clear();
+  res.cent_eden=cent_eden;
+  res.par.resize(n,0.0);
+  res.r_ratio.resize(n,0.0);
+  res.Mass.resize(n,0.0);
+  res.Mass_0.resize(n,0.0);
+  res.R_e.resize(n,0.0);
+  res.Omega.resize(n,0.0);
+  res.Omega_K.resize(n,0.0);
+  res.J.resize(n,0.0);
+  res.n_iter.resize(n,0);
+  res.point_info.resize(n,0);
+  res.warm.resize(n,false);
+
+  // The two previous solutions, g1 being the most recent, and
+  // the number of consecutive successful points (at most 2)
+  seq_guess g0, g1;
+  size_t n_good=0;
+
+  // Report failures to find the Keplerian configuration with
+  // return values rather than the error handler
+  bool err_nonconv_save=nr.err_nonconv;
+  nr.err_nonconv=false;
+
+  for(size_t i=0;i<n;i++) {
+
+    double ed=cent_eden[i], p=0.0;
+    if (type!=fix_kepler) p=par[i];
+    res.par[i]=p;
+
+    bool use_guess=(warm_start && n_good>0);
+
+    if (use_guess) {
+
+      if (extrap && n_good>1) {
+
+	// The size of the new step relative to the previous one
+	double ed1=res.cent_eden[i-1], ed0=res.cent_eden[i-2];
+	double d1=(ed-ed1)/ed1, d0=(ed1-ed0)/ed0;
+	double dist1=d1*d1, dist0=d0*d0;
+	if (type!=fix_kepler) {
+	  double p1=res.par[i-1], p0=res.par[i-2];
+	  if (p1!=0.0) {
+	    d1=(p-p1)/p1;
+	    dist1+=d1*d1;
+	  }
+	  if (p0!=0.0) {
+	    d0=(p1-p0)/p0;
+	    dist0+=d0*d0;
+	  }
+	}
+	double t=0.0;
+	if (dist0>0.0) t=sqrt(dist1/dist0);
+	if (t>1.0) t=1.0;
+
+	seq_guess ge;
+	ge.rho=g1.rho+t*(g1.rho-g0.rho);
+	ge.gamma=g1.gamma+t*(g1.gamma-g0.gamma);
+	ge.omega=g1.omega+t*(g1.omega-g0.omega);
+	ge.alpha=g1.alpha+t*(g1.alpha-g0.alpha);
+	ge.r_e=g1.r_e+t*(g1.r_e-g0.r_e);
+	ge.r_ratio=g1.r_ratio+t*(g1.r_ratio-g0.r_ratio);
+	if (ge.r_ratio>1.0) ge.r_ratio=1.0;
+	if (ge.r_ratio<=0.0 || ge.r_e<=0.0) {
+	  ge.r_ratio=g1.r_ratio;
+	  ge.r_e=g1.r_e;
+	}
+	nr.set_guess(ge.rho,ge.gamma,ge.omega,ge.alpha,ge.r_e);
+	nr.r_ratio=ge.r_ratio;
+
+      } else {
+
+	nr.set_guess(g1.rho,g1.gamma,g1.omega,g1.alpha,g1.r_e);
+	nr.r_ratio=g1.r_ratio;
+
+      }
+    }
+
+    size_t it_start=nr.iter_count;
+    int ret=solve_point(nr,type,ed,p,use_guess);
+    if (ret!=0 && use_guess) {
+      if (verbose>0) {
+	cout << "nstar_rot_seq: point " << i << " failed with return "
+	     << ret << " from previous solution, restarting." << endl;
+      }
+      use_guess=false;
+      ret=solve_point(nr,type,ed,p,false);
+    }
+    res.n_iter[i]=nr.iter_count-it_start;
+    res.point_info[i]=ret;
+
+    if (ret==0) {
+      res.warm[i]=use_guess;
+      res.r_ratio[i]=nr.r_ratio;
+      res.Mass[i]=nr.Mass;
+      res.Mass_0[i]=nr.Mass_0;
+      res.R_e[i]=nr.R_e;
+      res.Omega[i]=nr.Omega;
+      res.Omega_K[i]=nr.Omega_K;
+      res.J[i]=nr.J;
+      std::swap(g0,g1);
+      nr.get_guess(g1.rho,g1.gamma,g1.omega,g1.alpha,g1.r_e);
+      g1.r_ratio=nr.r_ratio;
+      if (n_good<2) n_good++;
+    } else {
+      res.info++;
+      n_good=0;
+    }
+
+    if (verbose>1) {
+      cout << "nstar_rot_seq: " << i << " " << ed << " " << p << " "
+	   << ret << " " << res.n_iter[i] << " " << res.r_ratio[i] << " "
+	   << res.Mass[i] << endl;
+    }
+  }
+
+  nr.err_nonconv=err_nonconv_save;
+
+  return res.info;
+}
+
+int nstar_rot_seq::sequence(nstar_rot &nr, int type,
+			    const std::vector<double> &cent_eden,
+			    const std::vector<double> &par,
+			    nstar_rot_seq_result &res) {
+
+  std::vector<std::vector<double> > ed_list(1,cent_eden), par_list;
+  if (type!=fix_kepler) par_list.push_back(par);
+  check_input(type,1,ed_list,par_list);
+
+  return compute(nr,type,cent_eden,par,res);
+}
+
+int nstar_rot_seq::solve(int type, std::vector<nstar_rot *> &nrs,
+			 const std::vector<std::vector<double> > &cent_eden,
+			 const std::vector<std::vector<double> > &par,
+			 std::vector<nstar_rot_seq_result> &res) {
+
+  size_t n_seq=nrs.size();
+  check_input(type,n_seq,cent_eden,par);
+  for(size_t i=0;i<n_seq;i++) {
+    for(size_t j=0;j<i;j++) {
+      if (nrs[i]==nrs[j]) {
+	O2SCL_ERR2("The same nstar_rot object was given for two ",
+		   "sequences in nstar_rot_seq::solve().",exc_einval);
+      }
+    }
+  }
+
+  res.resize(n_seq);
+  std::vector<double> empty;
+
+#ifdef O2SCL_OPENMP
+  // There is no reason to use more threads than sequences
+  size_t nt=n_threads;
+  if (nt>n_seq) nt=n_seq;
+  if (nt<1) nt=1;
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+  for(size_t i=0;i<n_seq;i++) {
+    if (type==fix_kepler && par.size()<=i) {
+      compute(*(nrs[i]),type,cent_eden[i],empty,res[i]);
+    } else {
+      compute(*(nrs[i]),type,cent_eden[i],par[i],res[i]);
+    }
+  }
+
+  int n_fail=0;
+  for(size_t i=0;i<n_seq;i++) {
+    if (res[i].info!=0) n_fail++;
+  }
+  return n_fail;
+}
@@ -0,0 +1,274 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_NSTAR_ROT_SEQ_H
+#define O2SCL_NSTAR_ROT_SEQ_H
+
+/** \file nstar_rot_seq.h
+    \brief File defining \ref o2scl::nstar_rot_seq
+*/
+
+#include <vector>
+
+#include <o2scl/nstar_rot.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief The configurations along one sequence computed by
+      \ref nstar_rot_seq
+
+      All vectors have one entry for each point in the sequence.
+      The central energy density and the fixed parameter are
+      copied from the input, and the remaining quantities are in
+      the same units as the corresponding members of \ref
+      nstar_rot. The quantities for points which failed are zero.
+  */
+  class nstar_rot_seq_result {
+
+  public:
+
+    nstar_rot_seq_result() {
+      info=0;
+    }
+
+    /** \brief The number of points which failed
+     */
+    int info;
+
+    /// \name Input
+    //@{
+    /// Central energy density
+    std::vector<double> cent_eden;
+    /// The fixed parameter (zero for Keplerian sequences)
+    std::vector<double> par;
+    //@}
+
+    /// \name Results
+    //@{
+    /// Ratio of polar to equatorial radius
+    std::vector<double> r_ratio;
+    /// Gravitational mass
+    std::vector<double> Mass;
+    /// Baryonic mass
+    std::vector<double> Mass_0;
+    /// Circumferential equatorial radius
+    std::vector<double> R_e;
+    /// Angular velocity
+    std::vector<double> Omega;
+    /// Kepler angular velocity
+    std::vector<double> Omega_K;
+    /// Angular momentum
+    std::vector<double> J;
+    /** \brief The number of iterations of \ref nstar_rot::iterate()
+	required for each point, including any failed attempts
+    */
+    std::vector<size_t> n_iter;
+    /** \brief Zero for success, otherwise the value returned by
+	the last attempt or \ref exc_efailed if it threw an exception
+    */
+    std::vector<int> point_info;
+    /** \brief True if the point was started from the previous
+	solution and this attempt succeeded
+    */
+    std::vector<bool> warm;
+    //@}
+
+    /// Remove all points
+    void clear() {
+      info=0;
+      cent_eden.clear();
+      par.clear();
+      r_ratio.clear();
+      Mass.clear();
+      Mass_0.clear();
+      R_e.clear();
+      Omega.clear();
+      Omega_K.clear();
+      J.clear();
+      n_iter.clear();
+      point_info.clear();
+      warm.clear();
+      return;
+    }
+
+  };
+
+  /** \brief Sequences of rotating neutron stars from \ref nstar_rot
+
+      The high-level functions in \ref nstar_rot begin each
+      calculation with a spherical star and then, for fixed
+      gravitational mass or Keplerian rotation, step the axis
+      ratio down from unity. Along a sequence of configurations
+      with slowly varying central energy density or fixed
+      parameter, the previous solution is a much better starting
+      point. The function \ref sequence() computes a sequence of
+      configurations, starting each point from the metric functions,
+      equatorial radius, and axis ratio of the previous one (see
+      \ref nstar_rot::get_guess() and \ref nstar_rot::set_guess()).
+      If \ref extrap is true and the two previous points were
+      successful, the starting point is instead obtained by linear
+      extrapolation from the two previous solutions, using the
+      distance between the points in the space of central energy
+      density and fixed parameter (each measured relative to the
+      previous point). The extrapolation never extends beyond a
+      full step.
+
+      The first point in a sequence and any point following a
+      failure begin with a spherical star. If a point which began
+      from the previous solution fails, either through a nonzero
+      return value or an exception, it is recomputed from a
+      spherical star. The number of iterations for each point is
+      stored in \ref nstar_rot_seq_result::n_iter .
+
+      The function \ref solve() computes several independent
+      sequences. Each sequence requires its own \ref nstar_rot
+      object, and each \ref nstar_rot object must have its own EOS
+      object since the EOS interpolation objects are not
+      thread-safe. If OpenMP support is enabled, the sequences are
+      distributed over \ref n_threads threads.
+
+      While a sequence is computed, \ref nstar_rot::err_nonconv is
+      set to false, so that a failure to find a Keplerian
+      configuration is reported by a return value. Other errors in
+      \ref nstar_rot, for example an energy density outside the
+      range of the EOS table, still call the error handler, also
+      from inside the parallel region in \ref solve(). The resulting
+      exceptions are caught, and the point is treated as a failure
+      with \ref o2scl::exc_efailed stored in \ref
+      nstar_rot_seq_result::point_info . The error handler is not
+      thread-safe, so the message stored in it may be incorrect if
+      this happens in two threads at once, and the program ends at
+      the first such error if exceptions are disabled (see \ref
+      omp_errorhand_subsect).
+
+      \note The \ref nstar_rot::verbose parameter of each object
+      is not modified, so it may be useful to set it to zero before
+      computing many sequences.
+  */
+  class nstar_rot_seq {
+
+  public:
+
+    typedef boost::numeric::ublas::matrix<double> ubmatrix;
+
+    nstar_rot_seq();
+
+    virtual ~nstar_rot_seq() {
+    }
+
+    /// \name Sequence types
+    //@{
+    /// Fixed axis ratio (\ref nstar_rot::fix_cent_eden_axis_rat())
+    static const int fix_axis_rat=0;
+    /// Fixed mass (\ref nstar_rot::fix_cent_eden_grav_mass())
+    static const int fix_grav_mass=1;
+    /// Keplerian rotation (\ref nstar_rot::fix_cent_eden_with_kepler())
+    static const int fix_kepler=2;
+    //@}
+
+    /// \name Parameters
+    //@{
+    /** \brief If true, begin each point from the previous
+	solution (default true)
+    */
+    bool warm_start;
+    /** \brief If true, extrapolate the starting point from the
+	two previous solutions (default true)
+    */
+    bool extrap;
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+    /// Verbosity parameter (default 0)
+    int verbose;
+    //@}
+
+    /** \brief Compute a sequence of type \c type with \c nr
+
+	The vector \c cent_eden gives the central energy densities
+	and \c par gives the fixed axis ratio or gravitational mass
+	for each point (in the units used by the corresponding
+	function in \ref nstar_rot). For Keplerian sequences \c par
+	is ignored and may be empty. The return value is the number
+	of points which failed.
+    */
+    int sequence(nstar_rot &nr, int type,
+		 const std::vector<double> &cent_eden,
+		 const std::vector<double> &par,
+		 nstar_rot_seq_result &res);
+
+    /** \brief Compute \c nrs.size() independent sequences of type
+	\c type
+
+	Sequence \c i is computed with <tt>*nrs[i]</tt> using the
+	central energy densities in <tt>cent_eden[i]</tt> and the
+	fixed parameters in <tt>par[i]</tt>, and the results are
+	stored in <tt>res[i]</tt>. For Keplerian sequences \c par
+	may be empty. The return value is the number of sequences
+	for which at least one point failed.
+    */
+    int solve(int type, std::vector<nstar_rot *> &nrs,
+	      const std::vector<std::vector<double> > &cent_eden,
+	      const std::vector<std::vector<double> > &par,
+	      std::vector<nstar_rot_seq_result> &res);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief The metric functions, equatorial radius, and axis
+	ratio for one solution
+    */
+    class seq_guess {
+    public:
+      ubmatrix rho, gamma, omega, alpha;
+      double r_e, r_ratio;
+    };
+
+    /** \brief Compute one sequence without checking the input
+     */
+    int compute(nstar_rot &nr, int type,
+		const std::vector<double> &cent_eden,
+		const std::vector<double> &par,
+		nstar_rot_seq_result &res);
+
+    /** \brief Compute one point, returning zero for success
+     */
+    int solve_point(nstar_rot &nr, int type, double ed, double p,
+		    bool use_guess);
+
+    /** \brief Check the type and the sizes of the input vectors
+     */
+    void check_input(int type, size_t n_seq,
+		     const std::vector<std::vector<double> > &cent_eden,
+		     const std::vector<std::vector<double> > &par);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
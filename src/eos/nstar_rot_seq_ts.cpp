@@ -0,0 +1,154 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/test_mgr.h>
+#include <o2scl/nstar_rot_seq.h>
+
+using namespace std;
+using namespace o2scl;
+
+size_t sum_iter(const nstar_rot_seq_result &res) {
+  size_t n=0;
+  for(size_t i=0;i<res.n_iter.size();i++) n+=res.n_iter[i];
+  return n;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(2);
+
+  eos_nstar_rot_C p1(true), p2(true), p3(true);
+  nstar_rot nr1, nr2, nr3;
+  nr1.constants_rns();
+  nr1.set_eos(p1);
+  nr1.verbose=0;
+  nr2.constants_rns();
+  nr2.set_eos(p2);
+  nr2.verbose=0;
+  nr3.constants_rns();
+  nr3.set_eos(p3);
+  nr3.verbose=0;
+
+  nstar_rot_seq seq;
+  nstar_rot_seq_result cold, warm, ext;
+
+  // Sequences of central energy densities
+  vector<double> ed, ed_m, ed_k;
+  for(size_t i=0;i<6;i++) {
+    ed.push_back(1.0e15+0.1e15*i);
+    ed_m.push_back(0.98e15+0.02e15*i);
+    ed_k.push_back(1.5e15+0.1e15*i);
+  }
+
+  // Fixed axis ratio. The results differ from those computed from
+  // a spherical star by an amount set by nstar_rot::eq_radius_tol_rel.
+  vector<double> ar(ed.size(),0.7);
+  seq.warm_start=false;
+  seq.sequence(nr1,nstar_rot_seq::fix_axis_rat,ed,ar,cold);
+  seq.warm_start=true;
+  seq.extrap=false;
+  seq.sequence(nr1,nstar_rot_seq::fix_axis_rat,ed,ar,warm);
+  seq.extrap=true;
+  seq.sequence(nr1,nstar_rot_seq::fix_axis_rat,ed,ar,ext);
+  t.test_gen(cold.info==0 && warm.info==0 && ext.info==0,"axis info");
+  t.test_rel_vec(ed.size(),warm.Mass,cold.Mass,2.0e-4,"axis mass");
+  t.test_rel_vec(ed.size(),ext.Mass,cold.Mass,2.0e-4,"axis mass 2");
+  t.test_rel_vec(ed.size(),ext.Omega,cold.Omega,2.0e-4,"axis Omega");
+  t.test_gen(warm.warm[ed.size()-1],"axis warm");
+  cout << "axis ratio iterations (cold, warm, extrap.): "
+       << sum_iter(cold) << " " << sum_iter(warm) << " "
+       << sum_iter(ext) << endl;
+  t.test_gen(sum_iter(warm)<sum_iter(cold),"axis warm faster");
+  t.test_gen(sum_iter(ext)<=sum_iter(warm),"axis extrap faster");
+
+  // Fixed gravitational mass. The mass is only determined to within
+  // nstar_rot::tol_abs.
+  vector<double> gm(ed_m.size(),1.5);
+  seq.warm_start=false;
+  seq.sequence(nr1,nstar_rot_seq::fix_grav_mass,ed_m,gm,cold);
+  seq.warm_start=true;
+  seq.sequence(nr1,nstar_rot_seq::fix_grav_mass,ed_m,gm,ext);
+  t.test_gen(cold.info==0 && ext.info==0,"mass info");
+  t.test_rel_vec(ed_m.size(),ext.Mass,cold.Mass,3.0e-4,"mass mass");
+  t.test_rel_vec(ed_m.size(),ext.r_ratio,cold.r_ratio,1.0e-2,"mass ratio");
+  cout << "grav. mass iterations (cold, extrap.): "
+       << sum_iter(cold) << " " << sum_iter(ext) << endl;
+  t.test_gen(sum_iter(ext)<sum_iter(cold),"mass warm faster");
+
+  // A guess which diverges should be reported for fixed mass, so
+  // that nstar_rot_seq can start the point again from a spherical
+  // star
+  {
+    nstar_rot_seq::ubmatrix rho_g, gamma_g, omega_g, alpha_g;
+    double r_e_g;
+    nr1.fix_cent_eden_grav_mass(ed_m[0],1.5);
+    nr1.get_guess(rho_g,gamma_g,omega_g,alpha_g,r_e_g);
+    rho_g*=1.0e3;
+    nr1.set_guess(rho_g,gamma_g,omega_g,alpha_g,r_e_g);
+    int ret=nr1.fix_cent_eden_grav_mass(ed_m[0],1.5,true);
+    t.test_gen(ret!=0,"mass bad guess");
+    ret=nr1.fix_cent_eden_grav_mass(ed_m[0],1.5);
+    t.test_gen(ret==0,"mass bad guess retry");
+    t.test_rel(nr1.Mass/nr1.MSUN,1.5,3.0e-4,"mass bad guess mass");
+  }
+
+  // Keplerian rotation
+  seq.warm_start=false;
+  seq.sequence(nr1,nstar_rot_seq::fix_kepler,ed_k,vector<double>(),cold);
+  seq.warm_start=true;
+  seq.sequence(nr1,nstar_rot_seq::fix_kepler,ed_k,vector<double>(),ext);
+  t.test_gen(cold.info==0 && ext.info==0,"kepler info");
+  t.test_rel_vec(ed_k.size(),ext.Omega,cold.Omega,1.0e-3,"kepler Omega");
+  t.test_rel_vec(ed_k.size(),ext.Omega,ext.Omega_K,1.0e-3,
+		 "kepler Omega_K");
+  cout << "Kepler iterations (cold, extrap.): "
+       << sum_iter(cold) << " " << sum_iter(ext) << endl;
+  t.test_gen(sum_iter(ext)<sum_iter(cold),"kepler warm faster");
+  t.test_gen(nr1.err_nonconv,"err_nonconv restored");
+
+  // Several sequences at once. The results should not depend on the
+  // number of threads.
+  vector<nstar_rot *> nrs={&nr1,&nr2,&nr3};
+  vector<vector<double> > ed_list={ed,ed,ed}, par_list(3);
+  for(size_t i=0;i<3;i++) {
+    par_list[i].resize(ed.size(),0.6+0.1*i);
+  }
+  vector<nstar_rot_seq_result> res1, res3;
+  seq.n_threads=1;
+  t.test_gen(seq.solve(nstar_rot_seq::fix_axis_rat,nrs,ed_list,
+		       par_list,res1)==0,"solve");
+  seq.n_threads=3;
+  t.test_gen(seq.solve(nstar_rot_seq::fix_axis_rat,nrs,ed_list,
+		       par_list,res3)==0,"solve threaded");
+  for(size_t i=0;i<3;i++) {
+    t.test_gen(res1[i].Mass==res3[i].Mass,"threaded mass");
+    t.test_gen(res1[i].n_iter==res3[i].n_iter,"threaded iterations");
+  }
+  seq.sequence(nr1,nstar_rot_seq::fix_axis_rat,ed,par_list[2],ext);
+  t.test_gen(ext.Mass==res1[2].Mass,"solve and sequence");
+
+  t.report();
+  return 0;
+}
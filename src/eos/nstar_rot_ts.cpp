@@ -61,6 +61,25 @@ int main(void) {
     nst.test8(t);
     nst.constants_o2scl();
   }
+
+#ifdef O2SCL_OPENMP
+  if (true) {
+    // The results should not depend on the number of threads
+    eos_nstar_rot_C p(true);
+    nstar_rot nst1, nst3;
+    nst1.constants_rns();
+    nst1.set_eos(p);
+    nst1.fix_cent_eden_axis_rat(2.0e15,0.59);
+    nst3.constants_rns();
+    nst3.set_eos(p);
+    nst3.n_threads=3;
+    nst3.fix_cent_eden_axis_rat(2.0e15,0.59);
+    t.test_gen(nst1.Mass==nst3.Mass,"threaded mass");
+    t.test_gen(nst1.R_e==nst3.R_e,"threaded radius");
+    t.test_gen(nst1.Omega==nst3.Omega,"threaded angular velocity");
+    t.test_gen(nst1.J==nst3.J,"threaded angular momentum");
+  }
+#endif
   
   if (true) {
 
@@ -0,0 +1,382 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/tov_ensemble.h>
+#include <o2scl/constants.h>
+#include <o2scl/misc.h>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+
+tov_ensemble::tov_ensemble() {
+
+  // ODE solver, the same as tov_solve
+  step_min=1.0e-4;
+  step_max=0.05;
+  step_start=4.0e-3;
+  max_integ_steps=100000;
+  tol_abs=1.0e-6;
+  min_log_pres=-1.0e2;
+
+  // Pressure grid, the same as tov_solve::mvsr()
+  prbegin=7.0e-7;
+  prend=8.0e-3;
+  princ=1.1;
+
+  interp_type=itp_linear;
+  stop_after_max=false;
+  calc_lambda=true;
+  n_threads=1;
+  verbose=0;
+
+  schwarz_km=o2scl_cgs::schwarzchild_radius/1.0e5;
+}
+
+double tov_ensemble::eval_k2(double beta, double yR) const {
+  double k2=8.0/5.0*pow(beta,5.0)*pow(1.0-2.0*beta,2.0)*
+    (2.0-yR+2.0*beta*(yR-1.0))/
+    (2.0*beta*(6.0-3.0*yR+3.0*beta*(5.0*yR-8.0))+
+     4.0*beta*beta*beta*(13.0-11.0*yR+beta*(3.0*yR-2.0)+2.0*
+			 beta*beta*(1.0+yR))+
+     3.0*pow(1.0-2.0*beta,2.0)*(2.0-yR+2.0*beta*(yR-1.0))*
+     log(1.0-2.0*beta));
+  return k2;
+}
+
+int tov_ensemble::derivs(double r, size_t nv, const ubvector &y,
+			 ubvector &dydx,
+			 const interp_vec<std::vector<double> > &itp,
+			 double pr_low) {
+
+  // As in tov_solve::derivs(), we don't call the error handler here
+  // so that the stepper can recover by decreasing the step size
+
+  if (y[1]<=min_log_pres || y[1]>0.0) {
+    return exc_efailed;
+  }
+
+  if (r==0.0) {
+    for(size_t i=0;i<nv;i++) dydx[i]=0.0;
+    return success;
+  }
+
+  double pres=exp(y[1]);
+  double gm=y[0];
+
+  // The low-density end of the table is the surface
+  if (pres<pr_low) {
+    return exc_efailed;
+  }
+
+  double ed=itp.eval(pres);
+  if (!std::isfinite(ed)) {
+    return exc_efailed;
+  }
+
+  const double pi=o2scl_const::pi;
+
+  double term2;
+  if (gm<0.0) term2=4.0*pi*pow(r,3.0)*pres;
+  else term2=gm+4.0*pi*pow(r,3.0)*pres;
+  double term3=r-schwarz_km*gm;
+
+  dydx[0]=4.0*pi*r*r*ed;
+  dydx[1]=-schwarz_km/2.0/r*(ed+pres)*term2/term3/pres;
+
+  if (nv>2) {
+
+    // The equation for y(r) from tov_love::y_derivs()
+    double cs2=1.0/itp.deriv(pres);
+    double elam=1.0/(1.0-schwarz_km*gm/r);
+    double nup=schwarz_km*elam*(gm+4.0*pi*pres*r*r*r)/r/r;
+    double Q=2.0*pi*schwarz_km*elam*(5.0*ed+9.0*pres+(ed+pres)/cs2)-
+      6.0*elam/r/r-nup*nup;
+    dydx[2]=(-r*r*Q-y[2]*elam*(1.0+2.0*pi*schwarz_km*r*r*(pres-ed))-
+	     y[2]*y[2])/r;
+    if (!std::isfinite(dydx[2])) {
+      return exc_efailed;
+    }
+  }
+
+  return success;
+}
+
+int tov_ensemble::integ_star(double pc, stepper_t &stepper, ode_funct &ofm,
+			     double &mass, double &rad, double &lambda) {
+
+  size_t nvar=2;
+  if (calc_lambda) nvar++;
+
+  // Only the current and the next point are stored
+  ubvector y(nvar), dydx(nvar), ynext(nvar), dydx_next(nvar), yerr(nvar);
+  y[0]=0.0;
+  y[1]=log(pc);
+  if (calc_lambda) y[2]=2.0;
+  for(size_t k=0;k<nvar;k++) dydx[k]=0.0;
+
+  double r=0.0, rnext;
+  size_t it;
+  bool done=false;
+  for(it=0;it<max_integ_steps && done==false;it++) {
+
+    double h=step_start;
+    if (h>step_max) h=step_max;
+    if (h<step_min) h=step_min;
+
+    int test=stepper.astep_full(r,r+step_max,rnext,h,nvar,y,dydx,
+				ynext,yerr,dydx_next,ofm);
+    if (test!=0) {
+      done=true;
+    } else {
+      r=rnext;
+      std::swap(y,ynext);
+      std::swap(dydx,dydx_next);
+    }
+  }
+
+  if (it>=max_integ_steps && done==false) {
+    return over_max_steps;
+  }
+
+  // Linear extrapolation to zero pressure as in tov_solve::integ_star()
+  rad=-1.0/dydx[1]+r;
+  mass=y[0]-dydx[0]*(r-rad);
+  if (rad>1.1*r) {
+    return last_step_large;
+  }
+
+  lambda=0.0;
+  if (calc_lambda) {
+    double yR=y[2]-dydx[2]*(r-rad);
+    double beta=schwarz_km/2.0*mass/rad;
+    lambda=2.0/3.0*eval_k2(beta,yR)/pow(beta,5.0);
+  }
+
+  if (!std::isfinite(mass) || !std::isfinite(rad) ||
+      !std::isfinite(lambda)) {
+    return result_not_finite;
+  }
+
+  return 0;
+}
+
+void tov_ensemble::solve_eos(const std::vector<double> &ed,
+			     const std::vector<double> &pr,
+			     const std::vector<double> &pcent,
+			     stepper_t &stepper,
+			     interp_vec<std::vector<double> > &itp,
+			     tov_ensemble_result &res) {
+
+  res.clear();
+
+  itp.set(pr.size(),pr,ed,interp_type);
+
+  ode_funct ofm=std::bind
+    (std::mem_fn<int(double,size_t,const ubvector &,ubvector &,
+		     const interp_vec<std::vector<double> > &,double)>
+     (&tov_ensemble::derivs),this,std::placeholders::_1,
+     std::placeholders::_2,std::placeholders::_3,std::placeholders::_4,
+     std::cref(itp),pr[0]);
+
+  res.pcent.reserve(pcent.size());
+  res.mass.reserve(pcent.size());
+  res.rad.reserve(pcent.size());
+  res.lambda.reserve(pcent.size());
+
+  for(size_t i=0;i<pcent.size();i++) {
+
+    double mass=0.0, rad=0.0, lambda=0.0;
+    int ret;
+    if (pcent[i]<=pr[0] || pcent[i]>pr[pr.size()-1]) {
+      ret=cent_press_range;
+    } else {
+      ret=integ_star(pcent[i],stepper,ofm,mass,rad,lambda);
+    }
+
+    if (ret!=0) {
+      if (res.info==0) res.info=ret;
+      mass=0.0;
+      rad=0.0;
+      lambda=0.0;
+    }
+
+    res.pcent.push_back(pcent[i]);
+    res.mass.push_back(mass);
+    res.rad.push_back(rad);
+    res.lambda.push_back(lambda);
+
+    if (ret==0 && mass>res.m_max) {
+      res.m_max=mass;
+      res.ix_max=res.mass.size()-1;
+    } else if (stop_after_max && ret==0 && mass<res.m_max) {
+      break;
+    }
+  }
+
+  if (res.mass.size()==0 || res.m_max<=0.0) return;
+
+  // Refine the maximum mass with a quadratic in log(pcent) when
+  // the largest mass is not at either end of the sequence
+  size_t ix=res.ix_max;
+  res.r_max=res.rad[ix];
+  res.pc_max=res.pcent[ix];
+  if (ix>0 && ix+1<res.mass.size() && res.mass[ix-1]>0.0 &&
+      res.mass[ix+1]>0.0) {
+    double x1=log(res.pcent[ix-1]), x2=log(res.pcent[ix]);
+    double x3=log(res.pcent[ix+1]);
+    double xm=x2, ym=0.0;
+    // The grid need not be increasing, but the function
+    // quadratic_extremum_xy() requires distinct abscissae
+    if (x1!=x2 && x2!=x3 && x1!=x3) {
+      quadratic_extremum_xy(x1,x2,x3,res.mass[ix-1],res.mass[ix],
+			    res.mass[ix+1],xm,ym);
+    }
+    if (std::isfinite(ym) && ym>=res.mass[ix] &&
+	(xm-x1)*(xm-x3)<0.0) {
+      res.m_max=ym;
+      res.pc_max=exp(xm);
+      if ((xm-x1)*(xm-x2)<=0.0) {
+	res.r_max=res.rad[ix-1]+(res.rad[ix]-res.rad[ix-1])*(xm-x1)/(x2-x1);
+      } else {
+	res.r_max=res.rad[ix]+(res.rad[ix+1]-res.rad[ix])*(xm-x2)/(x3-x2);
+      }
+    }
+  }
+
+  return;
+}
+
+void tov_ensemble::check_input
+(size_t n_eos, const std::vector<std::vector<double> > &ed,
+ const std::vector<std::vector<double> > &pr) {
+
+  if (ed.size()<n_eos || pr.size()<n_eos) {
+    O2SCL_ERR("Too few EOS tables in tov_ensemble::solve().",
+	      exc_einval);
+  }
+  for(size_t i=0;i<n_eos;i++) {
+    if (ed[i].size()!=pr[i].size() || pr[i].size()<2) {
+      O2SCL_ERR2("Energy density and pressure vectors have different ",
+		 "or too small sizes in tov_ensemble::solve().",exc_einval);
+    }
+    for(size_t j=1;j<pr[i].size();j++) {
+      if (pr[i][j]<=pr[i][j-1]) {
+	O2SCL_ERR2("Pressure not strictly increasing in ",
+		   "tov_ensemble::solve().",exc_einval);
+      }
+    }
+  }
+  return;
+}
+
+int tov_ensemble::solve(size_t n_eos,
+			const std::vector<std::vector<double> > &ed,
+			const std::vector<std::vector<double> > &pr,
+			const std::vector<std::vector<double> > &pcent,
+			std::vector<tov_ensemble_result> &res) {
+
+  if (pcent.size()<n_eos) {
+    O2SCL_ERR("Too few pressure grids in tov_ensemble::solve().",
+	      exc_einval);
+  }
+  std::vector<const std::vector<double> *> pc_list(n_eos);
+  for(size_t i=0;i<n_eos;i++) pc_list[i]=&pcent[i];
+  return solve_list(n_eos,ed,pr,pc_list,res);
+}
+
+int tov_ensemble::solve_list
+(size_t n_eos, const std::vector<std::vector<double> > &ed,
+ const std::vector<std::vector<double> > &pr,
+ const std::vector<const std::vector<double> *> &pcent,
+ std::vector<tov_ensemble_result> &res) {
+
+  // Check the input before the parallel region
+  check_input(n_eos,ed,pr);
+
+  res.resize(n_eos);
+
+  int n_fail=0;
+
+#ifdef O2SCL_OPENMP
+  int nt=((int)n_threads);
+  if (nt<1) nt=1;
+  if (verbose>0) {
+    cout << "tov_ensemble::solve(): " << n_eos << " EOSs with "
+	 << nt << " threads." << endl;
+  }
+#pragma omp parallel num_threads(nt) reduction(+:n_fail)
+#else
+  if (verbose>0) {
+    cout << "tov_ensemble::solve(): " << n_eos << " EOSs." << endl;
+  }
+#endif
+  {
+    // Each thread has its own stepper and interpolation object
+    stepper_t stepper;
+    stepper.con.eps_abs=tol_abs;
+    interp_vec<std::vector<double> > itp;
+
+#ifdef O2SCL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(size_t i=0;i<n_eos;i++) {
+      solve_eos(ed[i],pr[i],*(pcent[i]),stepper,itp,res[i]);
+      if (res[i].info!=0) n_fail++;
+    }
+  }
+
+  return n_fail;
+}
+
+int tov_ensemble::solve(size_t n_eos,
+			const std::vector<std::vector<double> > &ed,
+			const std::vector<std::vector<double> > &pr,
+			const std::vector<double> &pcent,
+			std::vector<tov_ensemble_result> &res) {
+  std::vector<const std::vector<double> *> pc_list(n_eos,&pcent);
+  return solve_list(n_eos,ed,pr,pc_list,res);
+}
+
+int tov_ensemble::solve(size_t n_eos,
+			const std::vector<std::vector<double> > &ed,
+			const std::vector<std::vector<double> > &pr,
+			std::vector<tov_ensemble_result> &res) {
+
+  if ((prend>prbegin && princ<=1.0) || (prend<prbegin && princ>=1.0) ||
+      princ<=0.0) {
+    O2SCL_ERR("Invalid pressure grid in tov_ensemble::solve().",
+	      exc_einval);
+  }
+
+  std::vector<double> pcent;
+  for (double pc=prbegin;((prend>prbegin && pc<=prend) ||
+			  (prend<prbegin && pc>=prend));pc*=princ) {
+    pcent.push_back(pc);
+  }
+  return solve(n_eos,ed,pr,pcent,res);
+}
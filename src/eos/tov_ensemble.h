@@ -0,0 +1,319 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_TOV_ENSEMBLE_H
+#define O2SCL_TOV_ENSEMBLE_H
+
+/** \file tov_ensemble.h
+    \brief File defining \ref o2scl::tov_ensemble
+*/
+
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <o2scl/interp.h>
+#include <o2scl/astep_gsl.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Compact mass-radius results for one EOS from
+      \ref tov_ensemble
+
+      All vectors have one entry for each central pressure which
+      was integrated. Masses are in \f$ \mathrm{M}_{\odot} \f$,
+      radii are in km, and central pressures are in
+      \f$ \mathrm{M}_{\odot}/\mathrm{km}^3 \f$.
+  */
+  class tov_ensemble_result {
+
+  public:
+
+    tov_ensemble_result() {
+      info=0;
+      m_max=0.0;
+      r_max=0.0;
+      pc_max=0.0;
+      ix_max=0;
+    }
+
+    /** \brief Zero for success, otherwise the value returned by
+	\ref tov_ensemble for the first star which failed
+    */
+    int info;
+
+    /// \name Sequence of stars
+    //@{
+    /// Central pressure
+    std::vector<double> pcent;
+    /// Gravitational mass
+    std::vector<double> mass;
+    /// Radius
+    std::vector<double> rad;
+    /// Dimensionless tidal deformability
+    std::vector<double> lambda;
+    //@}
+
+    /// \name Maximum mass star
+    //@{
+    /// Maximum gravitational mass
+    double m_max;
+    /// Radius of the maximum mass star
+    double r_max;
+    /// Central pressure of the maximum mass star
+    double pc_max;
+    /// Index of the largest mass in \ref mass
+    size_t ix_max;
+    //@}
+
+    /// Remove all stars and reset the summary
+    void clear() {
+      pcent.clear();
+      mass.clear();
+      rad.clear();
+      lambda.clear();
+      info=0;
+      m_max=0.0;
+      r_max=0.0;
+      pc_max=0.0;
+      ix_max=0;
+      return;
+    }
+
+  };
+
+  /** \brief Mass-radius curves and tidal deformabilities for
+      many EOSs at once
+
+      This class is designed for the case, common in Bayesian
+      inference, where the mass-radius curves for a large number of
+      EOSs are required but the full profile of each star is not.
+      The function \ref solve() takes a batch of EOS tables and
+      a grid of central pressures for each EOS and computes
+      the gravitational mass, radius, and dimensionless tidal
+      deformability of each star and the properties of the maximum
+      mass star for each EOS.
+
+      Each star is computed with a single integration of the
+      Tolman-Oppenheimer-Volkov equations in the same form and with
+      the same stepping strategy (and default parameters) as
+      \ref tov_solve::integ_star(), together with the equation for
+      the function \f$ y(r) \f$ which determines the Love number as
+      described in \ref tov_love. Only the current point of the
+      integration is stored, so no profile table is created, and the
+      surface is located by the same linear extrapolation as used in
+      \ref tov_solve. The tidal deformability is
+      \f[
+      \Lambda = \frac{2}{3} k_2 \beta^{-5}
+      \f]
+      where \f$ \beta = G M/R \f$ is the compactness.
+
+      The EOS tables are specified by vectors of energy density
+      and pressure in units of \f$ \mathrm{M}_{\odot}/\mathrm{km}^3
+      \f$, ordered by increasing pressure, and are interpolated with
+      the method specified in \ref interp_type. The speed of sound
+      required for the Love number is obtained from the derivative
+      of the interpolated energy density. The low-density end of each
+      table is treated as the stellar surface, so the tables should
+      extend to sufficiently small pressures (for example by
+      including a crust).
+
+      If OpenMP support is enabled, the EOSs are distributed over
+      \ref n_threads threads. Each thread has its own ODE stepper
+      and interpolation object, so the results do not depend on the
+      number of threads. Failures for individual stars are reported
+      in \ref tov_ensemble_result::info rather than by calling the
+      error handler (see \ref omp_errorhand_subsect).
+
+      \note The energy density at the surface is assumed to vanish,
+      so strange quark stars are not yet supported.
+  */
+  class tov_ensemble {
+
+  public:
+
+    typedef boost::numeric::ublas::vector<double> ubvector;
+
+    tov_ensemble();
+
+    virtual ~tov_ensemble() {
+    }
+
+    /// \name Return values for individual stars
+    //@{
+    /// Central pressure outside the EOS table
+    static const int cent_press_range=1;
+    /// Integration exceeded \ref max_integ_steps
+    static const int over_max_steps=2;
+    /// The last step of the integration was too large
+    static const int last_step_large=3;
+    /// The stellar properties were not finite
+    static const int result_not_finite=4;
+    //@}
+
+    /// \name Integration parameters
+    //@{
+    /// Smallest allowed radial stepsize in km (default \f$ 10^{-4} \f$)
+    double step_min;
+    /// Largest allowed radial stepsize in km (default 0.05)
+    double step_max;
+    /// Initial radial stepsize in km (default \f$ 4 \times 10^{-3} \f$)
+    double step_start;
+    /// Maximum number of integration steps (default 100000)
+    size_t max_integ_steps;
+    /** \brief Absolute tolerance for the ODE stepper
+	(default \f$ 10^{-6} \f$)
+    */
+    double tol_abs;
+    //@}
+
+    /// \name Default central pressure grid
+    //@{
+    /** \brief Beginning pressure in \f$ \mathrm{M}_{\odot}/\mathrm{km}^3
+	\f$ (default \f$ 7 \times 10^{-7} \f$)
+    */
+    double prbegin;
+    /** \brief Ending pressure in \f$ \mathrm{M}_{\odot}/\mathrm{km}^3
+	\f$ (default \f$ 8 \times 10^{-3} \f$)
+    */
+    double prend;
+    /// Ratio between successive pressures (default 1.1)
+    double princ;
+    //@}
+
+    /// \name Other parameters
+    //@{
+    /// Interpolation type for the EOS (default \ref itp_linear)
+    size_t interp_type;
+    /** \brief If true, stop the sequence for each EOS after the first
+	star with a mass smaller than the maximum (default false)
+
+	This avoids integrating the unstable branch when only the
+	stable stars are required.
+    */
+    bool stop_after_max;
+    /// If true, compute the tidal deformability (default true)
+    bool calc_lambda;
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+    /// Verbosity parameter (default 0)
+    int verbose;
+    //@}
+
+    /** \brief Compute the stars for \c n_eos EOSs with the
+	central pressures in \c pcent
+
+	The vectors <tt>ed[i]</tt> and <tt>pr[i]</tt> give
+	the energy density and pressure for EOS \c i and
+	<tt>pcent[i]</tt> gives the central pressures for
+	EOS \c i. On exit, <tt>res[i]</tt> contains the results
+	for EOS \c i. The return value is the number of EOSs
+	for which at least one star failed.
+    */
+    int solve(size_t n_eos, const std::vector<std::vector<double> > &ed,
+	      const std::vector<std::vector<double> > &pr,
+	      const std::vector<std::vector<double> > &pcent,
+	      std::vector<tov_ensemble_result> &res);
+
+    /** \brief Compute the stars for \c n_eos EOSs using the
+	same central pressures for every EOS
+    */
+    int solve(size_t n_eos, const std::vector<std::vector<double> > &ed,
+	      const std::vector<std::vector<double> > &pr,
+	      const std::vector<double> &pcent,
+	      std::vector<tov_ensemble_result> &res);
+
+    /** \brief Compute the stars for \c n_eos EOSs using the
+	central pressures from \ref prbegin to \ref prend
+    */
+    int solve(size_t n_eos, const std::vector<std::vector<double> > &ed,
+	      const std::vector<std::vector<double> > &pr,
+	      std::vector<tov_ensemble_result> &res);
+
+    /** \brief Compute \f$ k_2(\beta,y_R) \f$
+
+	This is the same expression as used in
+	\ref tov_love::calc_y().
+    */
+    double eval_k2(double beta, double yR) const;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The stepper type
+    typedef astep_gsl<ubvector,ubvector,ubvector,ode_funct> stepper_t;
+
+    /// Schwarzchild radius in km (set in constructor)
+    double schwarz_km;
+
+    /// Minimum log(pressure) (the same as \ref tov_solve)
+    double min_log_pres;
+
+    /** \brief The TOV equations and the equation for
+	\f$ y(r) \f$ for the EOS in \c itp
+    */
+    int derivs(double r, size_t nv, const ubvector &y, ubvector &dydx,
+	       const interp_vec<std::vector<double> > &itp,
+	       double pr_low);
+
+    /** \brief Compute the mass, radius and tidal deformability
+	of one star with central pressure \c pc
+    */
+    int integ_star(double pc, stepper_t &stepper, ode_funct &ofm,
+		   double &mass, double &rad, double &lambda);
+
+    /** \brief Compute all the stars for one EOS using the specified
+	stepper and interpolation object
+    */
+    void solve_eos(const std::vector<double> &ed,
+		   const std::vector<double> &pr,
+		   const std::vector<double> &pcent,
+		   stepper_t &stepper, interp_vec<std::vector<double> > &itp,
+		   tov_ensemble_result &res);
+
+    /** \brief Compute the stars for \c n_eos EOSs where
+	<tt>pcent[i]</tt> points to the central pressures for EOS \c i
+    */
+    int solve_list(size_t n_eos,
+		   const std::vector<std::vector<double> > &ed,
+		   const std::vector<std::vector<double> > &pr,
+		   const std::vector<const std::vector<double> *> &pcent,
+		   std::vector<tov_ensemble_result> &res);
+
+    /** \brief Check the sizes and ordering of the EOS tables
+     */
+    void check_input(size_t n_eos,
+		     const std::vector<std::vector<double> > &ed,
+		     const std::vector<std::vector<double> > &pr);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
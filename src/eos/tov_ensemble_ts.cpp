@@ -0,0 +1,161 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <o2scl/test_mgr.h>
+#include <o2scl/tov_ensemble.h>
+#include <o2scl/tov_solve.h>
+#include <o2scl/tov_love.h>
+
+using namespace std;
+using namespace o2scl;
+using namespace o2scl_const;
+
+/* A simple polytrope, P = K eps^2, tabulated on a logarithmic grid
+   in energy density in units of Msun/km^3
+*/
+void make_eos(double K, size_t n, std::vector<double> &ed,
+	      std::vector<double> &pr) {
+  ed.resize(n);
+  pr.resize(n);
+  for(size_t i=0;i<n;i++) {
+    ed[i]=1.0e-14*pow(2.0e-2/1.0e-14,((double)i)/((double)(n-1)));
+    pr[i]=K*ed[i]*ed[i];
+  }
+  return;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  double schwarz_km=o2scl_cgs::schwarzchild_radius/1.0e5;
+
+  // A batch of EOSs with different stiffness
+  size_t n_eos=6;
+  std::vector<std::vector<double> > ed(n_eos), pr(n_eos);
+  for(size_t i=0;i<n_eos;i++) {
+    make_eos(250.0+50.0*i,400+50*i,ed[i],pr[i]);
+  }
+
+  tov_ensemble te;
+  std::vector<tov_ensemble_result> res;
+  int ret=te.solve(n_eos,ed,pr,res);
+  t.test_gen(ret==0,"solve() return value");
+  t.test_gen(res.size()==n_eos,"result size");
+
+  // Compare with tov_solve::mvsr() for one of the EOSs
+  size_t ie=1;
+  std::vector<double> ed2=ed[ie], pr2=pr[ie];
+  eos_tov_vectors<std::vector<double> > etv;
+  etv.read_vectors_copy(ed2.size(),ed2,pr2);
+
+  tov_solve ts;
+  ts.verbose=0;
+  ts.set_eos(etv);
+  ts.mvsr();
+  std::shared_ptr<table_units<> > mvsr_tab=ts.get_results();
+
+  t.test_gen(mvsr_tab->get_nlines()==res[ie].mass.size(),"sizes");
+  double max_dm=0.0, max_dr=0.0;
+  for(size_t j=0;j<res[ie].mass.size();j++) {
+    double dm=fabs(res[ie].mass[j]-mvsr_tab->get("gm",j))/
+      mvsr_tab->get("gm",j);
+    double dr=fabs(res[ie].rad[j]-mvsr_tab->get("r",j))/
+      mvsr_tab->get("r",j);
+    if (dm>max_dm) max_dm=dm;
+    if (dr>max_dr) max_dr=dr;
+  }
+  cout << "Max. rel. deviation in mass and radius: "
+       << max_dm << " " << max_dr << endl;
+  t.test_rel(max_dm,0.0,1.0e-4,"mass vs. tov_solve");
+  t.test_rel(max_dr,0.0,1.0e-4,"radius vs. tov_solve");
+
+  // Compare the maximum mass with tov_solve::max()
+  ts.max();
+  cout << "Maximum mass: " << res[ie].m_max << " " << ts.mass << endl;
+  cout << "Radius: " << res[ie].r_max << " " << ts.rad << endl;
+  t.test_rel(res[ie].m_max,ts.mass,1.0e-4,"maximum mass");
+  t.test_rel(res[ie].r_max,ts.rad,1.0e-2,"radius of maximum mass star");
+
+  // Compare the tidal deformability with tov_love for a
+  // star near the middle of the stable branch
+  size_t is=res[ie].ix_max/2;
+  ts.fixed_pr(res[ie].pcent[is]);
+  std::shared_ptr<table_units<> > profile=ts.get_results();
+  profile->deriv("ed","pr","cs2");
+  tov_love tl;
+  tl.tab=profile;
+  double yR, beta, k2, lambda_km5, lambda_cgs;
+  tl.calc_y(yR,beta,k2,lambda_km5,lambda_cgs);
+  double lbar=lambda_km5/pow(ts.mass*schwarz_km/2.0,5.0);
+  cout << "Mass: " << ts.mass << " Lambda: " << res[ie].lambda[is] << " "
+       << lbar << endl;
+  t.test_rel(res[ie].lambda[is],lbar,2.0e-2,"lambda vs. tov_love");
+
+  // Stiffer EOSs give larger maximum masses
+  for(size_t i=1;i<n_eos;i++) {
+    t.test_gen(res[i].m_max>res[i-1].m_max,"maximum mass ordering");
+  }
+
+  // Stopping after the maximum gives the same maximum mass
+  te.stop_after_max=true;
+  std::vector<tov_ensemble_result> res2;
+  te.solve(n_eos,ed,pr,res2);
+  for(size_t i=0;i<n_eos;i++) {
+    t.test_gen(res2[i].mass.size()==res2[i].ix_max+2,"stop_after_max");
+    t.test_rel(res2[i].m_max,res[i].m_max,1.0e-12,"stop_after_max m_max");
+  }
+  te.stop_after_max=false;
+
+  // A central pressure outside of the table is reported as a failure
+  std::vector<double> pc_bad={1.0e-4,1.0e2};
+  ret=te.solve(1,ed,pr,pc_bad,res2);
+  t.test_gen(ret==1,"failure count");
+  t.test_gen(res2[0].info==tov_ensemble::cent_press_range,"failure info");
+  t.test_gen(res2[0].mass[0]>0.0 && res2[0].mass[1]==0.0,"failed star");
+
+#ifdef O2SCL_OPENMP
+  // The results should not depend on the number of threads
+  te.n_threads=4;
+  std::vector<tov_ensemble_result> res3;
+  te.solve(n_eos,ed,pr,res3);
+  bool same=true;
+  for(size_t i=0;i<n_eos;i++) {
+    if (res3[i].mass!=res[i].mass || res3[i].rad!=res[i].rad ||
+	res3[i].lambda!=res[i].lambda || res3[i].m_max!=res[i].m_max) {
+      same=false;
+    }
+  }
+  t.test_gen(same,"threaded results");
+#endif
+
+  t.report();
+
+  return 0;
+}
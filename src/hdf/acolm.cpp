@@ -470,11 +470,14 @@ void acol_manager::command_add(std::string new_type) {
        "<column> <unit>","",
        new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_set_unit),
        both},
-      {'S',"sort","Sort the entire table by a column.",0,2,
-       "<col> [unique]",
+      {'S',"sort","Sort the entire table by one or more columns.",0,-1,
+       "<col> [col2 ...] [unique]",
        ((string)"Sorts the entire table by the column specified in <col>. ")+
-       "If the word \"unique\" is specified as the second argument, then "+
-       "delete duplicate rows after sorting.",
+       "Rows with equal values in <col> are sorted by <col2>, and so on. "+
+       "A column is sorted in descending order if its name is followed "+
+       "by \":desc\" (e.g. \"x:desc\"). If the word \"unique\" is "+
+       "specified as the last argument, then delete duplicate rows after "+
+       "sorting. The sort uses 'n_threads' OpenMP threads.",
        new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_sort),
        both},
       {0,"stats","Show column statistics.",0,1,"<col>",
@@ -508,7 +511,11 @@ void acol_manager::command_add(std::string new_type) {
        "'5*tau/M' in column <ftom>. Columns <ac> and <ftom> are created "+
        "if they are not already present and overwritten if they "+
        "already contain data. Also, the autocorrelation length and "+
-       "estimated sample size are output to the screen.",
+       "estimated sample size are output to the screen, along with "+
+       "the integrated autocorrelation time (using an automatic window "+
+       "of at least five times the autocorrelation time) and the "+
+       "effective sample size. The autocorrelation coefficients are "+
+       "computed with a fast Fourier transform.",
        new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_autocorr),
        both}
     };
@@ -589,7 +596,7 @@ void acol_manager::command_add(std::string new_type) {
     
   } else if (new_type=="table3d") {
     
-    static const size_t narr=15;
+    static const size_t narr=16;
     comm_option_s options_arr[narr]={
       {0,"cat",
        "Concatenate data from a second table3d onto current table3d.",0,2,
@@ -668,6 +675,13 @@ void acol_manager::command_add(std::string new_type) {
        "for each slice.",
        new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_slice),
        both},
+      {0,"sort","Sort the x and y grids.",0,2,"[\"x:desc\"] [\"y:desc\"]",
+       ((string)"Sort the x and y grids into ascending order, ")+
+       "rearranging the slices accordingly. If \"x:desc\" or \"y:desc\" "+
+       "is given, the corresponding grid is sorted in descending order "+
+       "instead. The sort uses 'n_threads' OpenMP threads.",
+       new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_sort),
+       both},
       {0,"sum","Add data from a second table3d object to current table3d.",
        0,2,"<file> [name]",((string)"Add all slides from the ")+
        "second table3d to their "+
@@ -1020,6 +1034,7 @@ acol_manager::acol_manager() : cset(this,&acol_manager::comm_set),
 
   env_var_name="ACOL_DEFAULTS";
   interp_type=1;
+  n_threads=1;
 
   o2graph_mode=false;
 
@@ -1105,6 +1120,7 @@ void acol_manager::command_del() {
     cl->remove_comm_option("rename");
     cl->remove_comm_option("set-data");
     cl->remove_comm_option("slice");
+    cl->remove_comm_option("sort");
     cl->remove_comm_option("sum");
 
     if (o2graph_mode) {
@@ -1613,6 +1629,7 @@ int acol_manager::setup_parameters() {
   p_prec.i=&prec;
   p_ncols.i=&ncols;
   p_interp_type.i=&interp_type;
+  p_n_threads.i=&n_threads;
   p_scientific.b=&scientific;
   p_pretty.b=&pretty;
   p_names_out.b=&names_out;
@@ -1629,6 +1646,9 @@ int acol_manager::setup_parameters() {
   p_interp_type.help=((std::string)"The interpolation type ")+
     "(1=linear, 2=cubic spline, 3=periodic cubic spline, 4=Akima, "+
     "5=periodic Akima, 6=monotonic, 7=Steffen's monotonic).";
+  p_n_threads.help=((std::string)"The number of OpenMP threads ")+
+    "used by commands which support them (currently 'generic' "+
+    "for tables and 'sort' for tables and table3d objects).";
   p_names_out.help="If true, output column names at top.";
   p_pretty.help="If true, align the columns using spaces.";
   p_scientific.help="If true, output in scientific mode.";
@@ -1641,6 +1661,7 @@ int acol_manager::setup_parameters() {
   cl->par_list.insert(make_pair("compress",&p_compress));
   cl->par_list.insert(make_pair("ncols",&p_ncols));
   cl->par_list.insert(make_pair("interp_type",&p_interp_type));
+  cl->par_list.insert(make_pair("n_threads",&p_n_threads));
   cl->par_list.insert(make_pair("names_out",&p_names_out));
   cl->par_list.insert(make_pair("pretty",&p_pretty));
   cl->par_list.insert(make_pair("scientific",&p_scientific));
@@ -3867,10 +3888,14 @@ int acol_manager::comm_autocorr(std::vector<std::string> &sv, bool itive_com) {
 
     // Compute autocorrelation length and sample size
     vector<double> ac_vec, ftom;
-    vector_autocorr_vector(table_obj[in[0]],ac_vec);
+    vector_autocorr_vector_fft(table_obj[in[0]],ac_vec);
     size_t len=vector_autocorr_tau(table_obj[in[0]],ac_vec,ftom);
     cout << "Autocorrelation length: " << len << " sample size: "
 	 << table_obj.get_nlines()/len << endl;
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac_vec.size(),ac_vec,window);
+    cout << "Integrated autocorrelation time: " << tau
+	 << " effective sample size: " << table_obj.get_nlines()/tau << endl;
 
     // Add autocorrelation and ftom data to table
     for(size_t i=0;i<table_obj.get_nlines();i++) {
@@ -3889,10 +3914,14 @@ int acol_manager::comm_autocorr(std::vector<std::string> &sv, bool itive_com) {
   } else if (type=="double[]") {
 
     vector<double> ac_vec, ftom;
-    vector_autocorr_vector(doublev_obj,ac_vec);
+    vector_autocorr_vector_fft(doublev_obj,ac_vec);
     size_t len=vector_autocorr_tau(doublev_obj,ac_vec,ftom);
     cout << "Autocorrelation length: " << len << " sample size: "
 	 << doublev_obj.size()/len << endl;
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac_vec.size(),ac_vec,window);
+    cout << "Integrated autocorrelation time: " << tau
+	 << " effective sample size: " << doublev_obj.size()/tau << endl;
 
     doublev_obj=ac_vec;
 
@@ -3900,10 +3929,14 @@ int acol_manager::comm_autocorr(std::vector<std::string> &sv, bool itive_com) {
 
     vector_copy(intv_obj,doublev_obj);
     vector<double> ac_vec, ftom;
-    vector_autocorr_vector(doublev_obj,ac_vec);
+    vector_autocorr_vector_fft(doublev_obj,ac_vec);
     size_t len=vector_autocorr_tau(doublev_obj,ac_vec,ftom);
     cout << "Autocorrelation length: " << len << " sample size: "
 	 << doublev_obj.size()/len << endl;
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac_vec.size(),ac_vec,window);
+    cout << "Integrated autocorrelation time: " << tau
+	 << " effective sample size: " << doublev_obj.size()/tau << endl;
 
     command_del();
     clear_obj();
@@ -3915,10 +3948,14 @@ int acol_manager::comm_autocorr(std::vector<std::string> &sv, bool itive_com) {
     
     vector_copy(size_tv_obj,doublev_obj);
     vector<double> ac_vec, ftom;
-    vector_autocorr_vector(doublev_obj,ac_vec);
+    vector_autocorr_vector_fft(doublev_obj,ac_vec);
     size_t len=vector_autocorr_tau(doublev_obj,ac_vec,ftom);
     cout << "Autocorrelation length: " << len << " sample size: "
 	 << doublev_obj.size()/len << endl;
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac_vec.size(),ac_vec,window);
+    cout << "Integrated autocorrelation time: " << tau
+	 << " effective sample size: " << doublev_obj.size()/tau << endl;
 
     command_del();
     clear_obj();
@@ -6307,7 +6344,11 @@ int acol_manager::comm_generic(std::vector<std::string> &sv, bool itive_com) {
   if (ctype=="table") {
     
     if (sv2[1]!=((std::string)"cin")) {
-      table_obj.read_generic(ifs,verbose);
+      // Files are read with the faster memory-mapped method
+      ifs.close();
+      size_t nt=1;
+      if (n_threads>1) nt=((size_t)n_threads);
+      table_obj.read_generic_file(sv2[1],verbose,nt);
     } else {
       table_obj.read_generic(std::cin,verbose);
     }
@@ -6570,27 +6611,29 @@ int acol_manager::comm_list(std::vector<std::string> &sv, bool itive_com) {
 
 int acol_manager::comm_sort(std::vector<std::string> &sv, bool itive_com) {
 
+  size_t nt=1;
+  if (n_threads>1) nt=((size_t)n_threads);
+
   if (type=="table") {
   
-    std::string i1, i2;
+    std::vector<std::string> args;
     
     if (table_obj.get_nlines()==0) {
       cerr << "No table to sort." << endl;
       return exc_efailed;
     }
     
-    if (sv.size()>2) {
-      i1=sv[1];
-      i2=sv[2];
-    } else if (sv.size()>1) {
-      i1=sv[1];
+    if (sv.size()>1) {
+      for(size_t i=1;i<sv.size();i++) args.push_back(sv[i]);
     } else {
       if (itive_com) {
-	i1=cl->cli_gets("Enter column to sort by (or blank to stop): ");
+	std::string i1=cl->cli_gets
+	  ("Enter column to sort by (or blank to stop): ");
 	if (i1.length()==0) {
 	  cout << "Command 'sort' cancelled." << endl;
 	  return 0;
 	}
+	args.push_back(i1);
       } else {
 	cerr << "Not enough arguments for 'sort'." << endl;
 	return exc_efailed;
@@ -6598,24 +6641,73 @@ int acol_manager::comm_sort(std::vector<std::string> &sv, bool itive_com) {
     }
     
     bool unique=false;
-    if (i2==((std::string)"unique")) unique=true;
-    
-    if (table_obj.is_column(i1)==false) {
-      cerr << "Could not find column named '" << i1 << "'." << endl;
-      return exc_efailed;
+    if (args.size()>1 && args[args.size()-1]==((std::string)"unique")) {
+      unique=true;
+      args.pop_back();
+    }
+
+    // Determine the columns and the sort order. A column name
+    // which includes a ":desc" or ":asc" suffix is used as is.
+    std::vector<std::string> cols;
+    std::vector<bool> desc;
+    for(size_t i=0;i<args.size();i++) {
+      std::string col=args[i];
+      bool d=false;
+      if (table_obj.is_column(col)==false) {
+	size_t loc=col.rfind(':');
+	if (loc!=std::string::npos) {
+	  std::string suffix=col.substr(loc+1);
+	  if (suffix==((std::string)"desc")) {
+	    d=true;
+	    col=col.substr(0,loc);
+	  } else if (suffix==((std::string)"asc")) {
+	    col=col.substr(0,loc);
+	  }
+	}
+      }
+      if (table_obj.is_column(col)==false) {
+	cerr << "Could not find column named '" << col << "'." << endl;
+	return exc_efailed;
+      }
+      cols.push_back(col);
+      desc.push_back(d);
     }
     
     if (verbose>1) {
-      cout << "Sorting by column " << i1 << endl; 
+      cout << "Sorting by column";
+      if (cols.size()>1) cout << "s";
+      for(size_t i=0;i<cols.size();i++) {
+	cout << " " << cols[i];
+	if (desc[i]) cout << " (descending)";
+      }
+      cout << endl;
     }
-    table_obj.sort_table(i1);
+    table_obj.sort_table(cols,desc,nt);
     
     if (unique) {
-      std::cout << "Going to dir." << std::endl;
       table_obj.delete_idadj_rows();
-      std::cout << "Done in dir." << std::endl;
     }
 
+  } else if (type=="table3d") {
+
+    bool x_desc=false, y_desc=false;
+    for(size_t i=1;i<sv.size();i++) {
+      if (sv[i]==((std::string)"x:desc")) {
+	x_desc=true;
+      } else if (sv[i]==((std::string)"y:desc")) {
+	y_desc=true;
+      } else if (sv[i]!=((std::string)"x:asc") &&
+		 sv[i]!=((std::string)"y:asc")) {
+	cerr << "Argument '" << sv[i] << "' to 'sort' not understood."
+	     << endl;
+	return exc_efailed;
+      }
+    }
+    table3d_obj.sort_grid(x_desc,y_desc,nt);
+    if (verbose>0) {
+      cout << "Grids of table3d object sorted." << endl;
+    }
+    
   } else if (type=="double[]") {
 
     vector_sort<vector<double>,double>(doublev_obj.size(),doublev_obj);
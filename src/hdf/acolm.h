@@ -153,6 +153,9 @@ namespace o2scl_acol {
     
     /// True for scientific output mode
     bool scientific;
+
+    /// The number of OpenMP threads (default 1)
+    int n_threads;
     //@}
 
     /// \name The parameter objects
@@ -165,6 +168,7 @@ namespace o2scl_acol {
     o2scl::cli::parameter_int p_prec;
     o2scl::cli::parameter_int p_ncols;
     o2scl::cli::parameter_int p_interp_type;
+    o2scl::cli::parameter_int p_n_threads;
     o2scl::cli::parameter_bool p_scientific;
     o2scl::cli::parameter_bool p_pretty;
     o2scl::cli::parameter_bool p_names_out;
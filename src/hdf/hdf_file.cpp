@@ -1604,6 +1604,122 @@ int hdf_file::setd_arr(std::string name, size_t n, const double *d) {
   return 0;
 }
 
+int hdf_file::setd_arr_tail(std::string name, size_t start, size_t n,
+			    const double *d) {
+  
+  if (write_access==false) {
+    O2SCL_ERR2("File not opened with write access in ",
+	       "hdf_file::setd_arr_tail().",exc_efailed);
+  }
+
+  hid_t dset, space;
+
+  H5E_BEGIN_TRY
+    {
+      // See if the dataspace already exists first
+      dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+    } 
+  H5E_END_TRY 
+#ifdef O2SCL_NEVER_DEFINED
+    {
+    }
+#endif
+      
+  // If it doesn't exist, create it
+  if (dset<0) {
+
+    if (start!=0) {
+      O2SCL_ERR2("Dataset does not exist and start is nonzero in ",
+		 "hdf_file::setd_arr_tail().",exc_einval);
+    }
+
+    // Create the dataspace
+    hsize_t dims=n;
+    hsize_t max=H5S_UNLIMITED;
+    space=H5Screate_simple(1,&dims,&max);
+
+    // Use a chunk size large enough for efficient appends
+    hid_t dcpl=H5Pcreate(H5P_DATASET_CREATE);
+    hsize_t chunk=def_chunk(n);
+    if (chunk<1000) chunk=1000;
+    H5Pset_chunk(dcpl,1,&chunk);
+
+#ifdef O2SCL_HDF5_COMP
+    // Compare the chunk size rather than n with min_compr_size,
+    // since the dataset is expected to grow
+    if (chunk>=min_compr_size) {
+      if (compr_type==1) {
+	int status3=H5Pset_deflate(dcpl,6);
+      } else if (compr_type==2) {
+	int status3=H5Pset_szip(dcpl,H5_SZIP_NN_OPTION_MASK,16);
+      } else if (compr_type!=0) {
+	H5Pclose(dcpl);
+	H5Sclose(space);
+	O2SCL_ERR2("Invalid compression type in ",
+		   "hdf_file::setd_arr_tail().",exc_einval);
+      }
+    }
+#endif
+
+    dset=H5Dcreate(current,name.c_str(),H5T_IEEE_F64LE,space,H5P_DEFAULT,
+		   dcpl,H5P_DEFAULT);
+    H5Pclose(dcpl);
+    H5Sclose(space);
+
+    if (dset<0) {
+      O2SCL_ERR2("Could not create dataset in ",
+		 "hdf_file::setd_arr_tail().",exc_efailed);
+    }
+
+  } else {
+    
+    // Get current dimensions
+    space=H5Dget_space(dset);  
+    hsize_t dims;
+    int ndims=H5Sget_simple_extent_dims(space,&dims,0);
+    H5Sclose(space);
+
+    if (ndims!=1) {
+      H5Dclose(dset);
+      O2SCL_ERR2("Dataset not one-dimensional in ",
+		 "hdf_file::setd_arr_tail().",exc_einval);
+    }
+    if (start>dims) {
+      H5Dclose(dset);
+      O2SCL_ERR2("Value of start past the end of the dataset in ",
+		 "hdf_file::setd_arr_tail().",exc_einval);
+    }
+
+    // Resize the dataset
+    if (start+n!=dims) {
+      hsize_t new_dims=start+n;
+      herr_t status=H5Dset_extent(dset,&new_dims);
+      if (status<0) {
+	H5Dclose(dset);
+	O2SCL_ERR2("Could not resize dataset (not chunked?) in ",
+		   "hdf_file::setd_arr_tail().",exc_efailed);
+      }
+    }
+    
+  }
+
+  // Write the data to the selected range
+  if (n>0) {
+    space=H5Dget_space(dset);
+    hsize_t offset[1]={start};
+    hsize_t count[1]={n};
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,offset,0,count,0);
+    hid_t mem_space=H5Screate_simple(1,count,0);
+    H5Dwrite(dset,H5T_NATIVE_DOUBLE,mem_space,space,H5P_DEFAULT,d);
+    H5Sclose(mem_space);
+    H5Sclose(space);
+  }
+  
+  H5Dclose(dset);
+      
+  return 0;
+}
+
 int hdf_file::setf_arr(std::string name, size_t n, const float *f) { 
   
   if (write_access==false) {
@@ -2960,6 +3076,217 @@ int hdf_file::geti_ten(std::string name,
   return 0;
 }
 
+int hdf_file::getd_vec_range(std::string name, size_t start, size_t n,
+			     std::vector<double> &v) {
+  
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+  if (dset<0) {
+    O2SCL_ERR2("Could not open dataset in ",
+	       "hdf_file::getd_vec_range().",exc_efailed);
+  }
+  
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[1];
+  int ndims=H5Sget_simple_extent_dims(space,dims,0);
+  if (ndims!=1) {
+    H5Sclose(space);
+    H5Dclose(dset);
+    O2SCL_ERR2("Dataset not one-dimensional in ",
+	       "hdf_file::getd_vec_range().",exc_einval);
+  }
+  if (start+n>dims[0]) {
+    H5Sclose(space);
+    H5Dclose(dset);
+    O2SCL_ERR2("Requested range extends beyond dataset in ",
+	       "hdf_file::getd_vec_range().",exc_einval);
+  }
+  
+  v.resize(n);
+  
+  if (n>0) {
+    
+    // Select the range in the file and read it into a 
+    // contiguous memory space
+    hsize_t offset[1]={start};
+    hsize_t count[1]={n};
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,offset,0,count,0);
+    hid_t mem_space=H5Screate_simple(1,count,0);
+    
+    herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+			  H5P_DEFAULT,&v[0]);
+    
+    H5Sclose(mem_space);
+  }
+  
+  H5Sclose(space);
+  H5Dclose(dset);
+  
+  return 0;
+}
+
+int hdf_file::getd_vec_block(std::string name, 
+			     const std::vector<size_t> &size,
+			     const std::vector<size_t> &start,
+			     const std::vector<size_t> &count,
+			     std::vector<double> &v) {
+
+  size_t rank=size.size();
+  if (rank==0 || start.size()!=rank || count.size()!=rank) {
+    O2SCL_ERR2("Sizes of index vectors do not match in ",
+	       "hdf_file::getd_vec_block().",exc_einval);
+  }
+  
+  // Compute the strides of the row-major array and the total size
+  std::vector<size_t> stride(rank);
+  size_t total=1, full=1;
+  for(size_t k=rank;k>0;k--) {
+    if (start[k-1]+count[k-1]>size[k-1]) {
+      O2SCL_ERR2("Requested block extends beyond array in ",
+		 "hdf_file::getd_vec_block().",exc_einval);
+    }
+    stride[k-1]=full;
+    full*=size[k-1];
+    total*=count[k-1];
+  }
+  
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+  if (dset<0) {
+    O2SCL_ERR2("Could not open dataset in ",
+	       "hdf_file::getd_vec_block().",exc_efailed);
+  }
+  
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[1];
+  int ndims=H5Sget_simple_extent_dims(space,dims,0);
+  if (ndims!=1 || dims[0]!=full) {
+    H5Sclose(space);
+    H5Dclose(dset);
+    O2SCL_ERR2("Dataset size does not match array size in ",
+	       "hdf_file::getd_vec_block().",exc_einval);
+  }
+  
+  v.resize(total);
+  
+  if (total>0) {
+
+    // Each combination of the indices in all but the last two
+    // dimensions gives a regular pattern of count[rank-2] blocks
+    // of count[rank-1] elements separated by stride[rank-2],
+    // which is selected with a single hyperslab. Since HDF5
+    // reads the selected elements in the order in which they are
+    // stored in the file, the block is obtained in row-major
+    // order.
+    size_t n_outer=1;
+    for(size_t k=0;k+2<rank;k++) n_outer*=count[k];
+    std::vector<size_t> ix(rank,0);
+    
+    H5Sselect_none(space);
+    for(size_t io=0;io<n_outer;io++) {
+
+      // Compute the indices in the outer dimensions
+      size_t rem=io;
+      for(size_t k=rank-2;k>0 && rank>2;k--) {
+	ix[k-1]=rem%count[k-1];
+	rem/=count[k-1];
+      }
+      
+      size_t offset0=0;
+      for(size_t k=0;k+2<rank;k++) {
+	offset0+=(start[k]+ix[k])*stride[k];
+      }
+      
+      hsize_t offset[1], hstride[1], hcount[1], block[1];
+      if (rank==1) {
+	offset[0]=start[0];
+	hstride[0]=1;
+	hcount[0]=1;
+	block[0]=count[0];
+      } else {
+	offset[0]=offset0+start[rank-2]*stride[rank-2]+start[rank-1];
+	hstride[0]=stride[rank-2];
+	hcount[0]=count[rank-2];
+	block[0]=count[rank-1];
+      }
+      H5Sselect_hyperslab(space,H5S_SELECT_OR,offset,hstride,hcount,block);
+    }
+    
+    hsize_t mem_dims[1]={total};
+    hid_t mem_space=H5Screate_simple(1,mem_dims,0);
+    
+    herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+			  H5P_DEFAULT,&v[0]);
+    
+    H5Sclose(mem_space);
+  }
+  
+  H5Sclose(space);
+  H5Dclose(dset);
+  
+  return 0;
+}
+
+int hdf_file::getd_ten_block(std::string name, 
+			     const std::vector<size_t> &start,
+			     const std::vector<size_t> &count,
+			     o2scl::tensor<double,std::vector<double>,
+			     std::vector<size_t> > &t) {
+  
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+  if (dset<0) {
+    O2SCL_ERR2("Could not open dataset in ",
+	       "hdf_file::getd_ten_block().",exc_efailed);
+  }
+  
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[100];
+  int ndims=H5Sget_simple_extent_dims(space,dims,0);
+  if (ndims<1 || ndims>100 || start.size()!=((size_t)ndims) ||
+      count.size()!=((size_t)ndims)) {
+    H5Sclose(space);
+    H5Dclose(dset);
+    O2SCL_ERR2("Rank of dataset does not match index vectors ",
+	       "in hdf_file::getd_ten_block().",exc_einval);
+  }
+  
+  hsize_t offset[100], hcount[100];
+  size_t total=1;
+  for(int k=0;k<ndims;k++) {
+    if (start[k]+count[k]>dims[k]) {
+      H5Sclose(space);
+      H5Dclose(dset);
+      O2SCL_ERR2("Requested block extends beyond dataset in ",
+		 "hdf_file::getd_ten_block().",exc_einval);
+    }
+    offset[k]=start[k];
+    hcount[k]=count[k];
+    total*=count[k];
+  }
+  
+  // Allocate new data
+  t.resize(ndims,count);
+
+  if (total>0) {
+    
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,offset,0,hcount,0);
+    hid_t mem_space=H5Screate_simple(ndims,hcount,0);
+    
+    // Get pointer to first element
+    vector<size_t> zero(ndims);
+    for(int k=0;k<ndims;k++) zero[k]=0;
+    double *first=&t.get(zero);
+    
+    herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+			  H5P_DEFAULT,first);
+    
+    H5Sclose(mem_space);
+  }
+  
+  H5Sclose(space);
+  H5Dclose(dset);
+  
+  return 0;
+}
+
 int hdf_file::getd_vec_prealloc(std::string name, size_t n, double *d) {
       
   // See if the dataspace already exists first
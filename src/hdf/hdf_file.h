@@ -359,6 +359,51 @@ namespace o2scl_hdf {
     int gets_vec(std::string name, std::vector<std::string> &s);
     //@}
 
+    /** \name Partial get functions
+
+	These functions read only part of a dataset using HDF5
+	hyperslab selections, so that the memory and I/O required
+	scale with the size of the requested part rather than with the
+	size of the full dataset. As with the vector get functions,
+	any previously allocated memory in the output object is freed
+	and the proper space is allocated. If the requested part
+	extends beyond the dataset, the error handler is called.
+    */
+    //@{
+    /** \brief Get the \c n elements starting at index \c start 
+	from the one-dimensional dataset named \c name
+    */
+    int getd_vec_range(std::string name, size_t start, size_t n,
+		       std::vector<double> &v);
+
+    /** \brief Get a rectangular block from a one-dimensional
+	dataset which stores a multi-dimensional array
+
+	The dataset named \c name is assumed to hold a
+	multi-dimensional array with sizes given in \c size stored in
+	row-major order (as in \ref o2scl::tensor). The block which
+	begins at the indices given in \c start and has the sizes
+	given in \c count is stored in row-major order in \c v.
+    */
+    int getd_vec_block(std::string name, const std::vector<size_t> &size,
+		       const std::vector<size_t> &start,
+		       const std::vector<size_t> &count,
+		       std::vector<double> &v);
+
+    /** \brief Get a rectangular block of a tensor of
+	double-precision numbers from an HDF file
+
+	This function reads the block of a multi-dimensional dataset
+	(e.g. one written by \ref setd_ten()) which begins at the
+	indices given in \c start and has the sizes given in \c
+	count. The tensor \c t is resized to have sizes \c count.
+    */
+    int getd_ten_block(std::string name, const std::vector<size_t> &start,
+		       const std::vector<size_t> &count,
+		       o2scl::tensor<double,std::vector<double>,
+		       std::vector<size_t> > &t);
+    //@}
+
     /** \name Vector set functions
 
 	These functions automatically write all of the vector elements
@@ -951,6 +996,22 @@ namespace o2scl_hdf {
     /// Set a double array named \c name of size \c n to value \c d
     int setd_arr(std::string name, size_t n, const double *d);
 
+    /** \brief Write the \c n values in \c d to the double array
+	named \c name beginning at index \c start
+
+	The entries before \c start which are already present in the
+	file are left unchanged and the dataset is resized to have
+	exactly <tt>start+n</tt> entries, so this function can be used
+	to append data to a growing vector without rewriting the
+	entire vector. If the dataset does not exist, then \c start
+	must be zero and the dataset is created with a chunk size of
+	at least 1000, since it is expected to grow, and compressed
+	according to \ref compr_type. The dataset must have been
+	created in the chunked format (as done by \ref setd_arr()).
+    */
+    int setd_arr_tail(std::string name, size_t start, size_t n,
+		      const double *d);
+
     /// Set a float array named \c name of size \c n to value \c f
     int setf_arr(std::string name, size_t n, const float *f);
 
@@ -820,6 +820,39 @@ int main(void) {
     }
     cout << endl;
 
+    cout << "Test appended vectors: " << endl;
+    {
+      vector<double> v1(30), v2(3000);
+      for(size_t i=0;i<3000;i++) {
+	v2[i]=sin(((double)i));
+	if (i<30) v1[i]=v2[i];
+      }
+
+      // Start with a short dataset and append to it
+      hdf_file hf;
+      hf.compr_type=1;
+      hf.open("hdf_file_comp.o2",true);
+      hf.setd_arr_tail("tail",0,30,&v1[0]);
+      hf.setd_arr_tail("tail",30,2970,&v2[30]);
+      hf.close();
+
+      hf.open("hdf_file_comp.o2");
+      vector<double> v3;
+      hf.getd_vec("tail",v3);
+
+      // Check that the dataset was compressed
+      hid_t dset=H5Dopen(hf.get_current_id(),"tail",H5P_DEFAULT);
+      hid_t dcpl=H5Dget_create_plist(dset);
+      t.test_gen(H5Pget_nfilters(dcpl)==1,"appended compressed");
+      H5Pclose(dcpl);
+      H5Dclose(dset);
+      hf.close();
+
+      t.test_gen(v3.size()==3000,"appended size");
+      t.test_rel_vec(3000,v3,v2,1.0e-12,"appended data");
+    }
+    cout << endl;
+
   }
 
 #endif
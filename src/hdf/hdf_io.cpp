@@ -85,6 +85,78 @@ void o2scl_hdf::hdf_output(hdf_file &hf, o2scl::table_units<> &t,
   return;
 }
 
+void o2scl_hdf::hdf_output_append(hdf_file &hf, o2scl::table<> &t,
+				  std::string name, size_t row_start,
+				  size_t file_offset) {
+  
+  if (hf.has_write_access()==false) {
+    O2SCL_ERR2("File not opened with write access in hdf_output_append",
+	       "(hdf_file,table<>,string,size_t,size_t).",exc_efailed);
+  }
+  
+  // Start group
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+  
+  // Add typename
+  hf.sets_fixed("o2scl_type","table");
+  
+  // Output table data
+  hdf_output_data_append(hf,t,row_start,file_offset);
+  
+  // Close table group
+  hf.close_group(group);
+  
+  // Return location to previous value
+  hf.set_current_id(top);
+
+  return;
+}
+
+void o2scl_hdf::hdf_output_append(hdf_file &hf, o2scl::table_units<> &t,
+				  std::string name, size_t row_start,
+				  size_t file_offset) {
+  
+  if (hf.has_write_access()==false) {
+    O2SCL_ERR2("File not opened with write access in hdf_output_append",
+	       "(hdf_file,table_units<>,string,size_t,size_t).",
+	       exc_efailed);
+  }
+  
+  // Start group
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+  
+  // Add typename
+  hf.sets_fixed("o2scl_type","table");
+  
+  // Output base table object
+  o2scl::table<> *tbase=dynamic_cast<o2scl::table_units<> *>(&t);
+  if (tbase==0) {
+    O2SCL_ERR2("Cast failed in hdf_output_append",
+	       "(hdf_file &, table_units &, ...).",o2scl::exc_efailed);
+  }
+  hdf_output_data_append(hf,*tbase,row_start,file_offset);
+      
+  // Output unit info
+  hf.seti("unit_flag",1);
+  std::vector<std::string> units;
+  for(size_t i=0;i<t.get_ncolumns();i++) {
+    units.push_back(t.get_unit(t.get_column_name(i)));
+  }
+  hf.sets_vec("units",units);
+  
+  // Close table group
+  hf.close_group(group);
+  
+  // Return location to previous value
+  hf.set_current_id(top);
+
+  return;
+}
+
 void o2scl_hdf::hdf_output_data(hdf_file &hf, o2scl::table_units<> &t) {
       
   // Output base table object
@@ -176,6 +248,70 @@ void o2scl_hdf::hdf_output_data(hdf_file &hf, o2scl::table<> &t) {
 }
 
 
+void o2scl_hdf::hdf_output_data_append(hdf_file &hf, o2scl::table<> &t,
+				       size_t row_start, size_t file_offset) {
+
+  if (row_start>t.get_nlines()) {
+    O2SCL_ERR2("Starting row larger than number of lines in ",
+	       "hdf_output_data_append().",exc_einval);
+  }
+  
+  hid_t group=hf.get_current_id();
+
+  // Restructure constants and column names
+  std::vector<std::string> cnames, cols;
+  std::vector<double> cvalues;
+  for(size_t i=0;i<t.get_nconsts();i++) {
+    std::string name;
+    double val;
+    t.get_constant(i,name,val);
+    cnames.push_back(name);
+    cvalues.push_back(val);
+  }
+  for(size_t i=0;i<t.get_ncolumns();i++) {
+    cols.push_back(t.get_column_name(i));
+  }
+
+  // When appending, make sure the columns match those already
+  // present in the file
+  if (file_offset+row_start>0) {
+    std::vector<std::string> file_cols;
+    hf.gets_vec("col_names",file_cols);
+    if (file_cols!=cols) {
+      O2SCL_ERR2("Columns do not match those in file in ",
+		 "hdf_output_data_append().",exc_einval);
+    }
+  }
+  
+  // Output the small objects, which are rewritten every time
+  hf.sets_vec("con_names",cnames);
+  hf.setd_vec("con_values",cvalues);
+  hf.sets_vec("col_names",cols);
+  hf.seti("unit_flag",0);
+  hf.seti("nlines",((int)(file_offset+t.get_nlines())));
+  hf.set_szt("itype",t.itype);
+      
+  // Output the new rows of each column
+  hid_t group2=hf.open_group("data");
+  hf.set_current_id(group2);
+
+  size_t n_new=t.get_nlines()-row_start;
+  for(size_t i=0;i<t.get_ncolumns();i++) {
+    const std::vector<double> &col=t.get_column(t.get_column_name(i));
+    if (n_new>0) {
+      hf.setd_arr_tail(cols[i],file_offset+row_start,n_new,
+		       &(col[row_start]));
+    } else {
+      hf.setd_arr_tail(cols[i],file_offset+row_start,0,0);
+    }
+  }
+
+  hf.close_group(group2);
+  hf.set_current_id(group);
+
+  return;
+}
+
 void o2scl_hdf::hdf_output(hdf_file &hf, hist &h, std::string name) {
   
   if (hf.has_write_access()==false) {
@@ -1221,3 +1357,75 @@ void o2scl_hdf::hdf_input(hdf_file &hf, o2scl::tensor_grid<std::vector<double>,
       
   return;
 }
+
+void o2scl_hdf::hdf_input(hdf_file &hf, o2scl::tensor_grid<std::vector<double>,
+			  std::vector<size_t>> &t, std::string name,
+			  const std::vector<size_t> &start,
+			  const std::vector<size_t> &count) {
+    
+  // If no name specified, find name of first group of specified type
+  if (name.length()==0) {
+    hf.find_group_by_type("tensor_grid",name);
+    if (name.length()==0) {
+      O2SCL_ERR2("No object of type tensor_grid found in ",
+		 "tensor::hdf_input().",o2scl::exc_efailed);
+    }
+  }
+      
+  // Open main group
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+      
+  // Check typename
+  std::string type;
+  hf.gets_fixed("o2scl_type",type);
+  if (type!="tensor_grid") {
+    O2SCL_ERR2("Typename in HDF group does not match ",
+	       "class in hdf_input().",o2scl::exc_einval);
+  }
+      
+  // Get rank
+  int rank;
+  hf.geti("rank",rank);
+  if (start.size()!=((size_t)rank) || count.size()!=((size_t)rank)) {
+    O2SCL_ERR2("Size of index vectors does not match rank in ",
+	       "hdf_input().",o2scl::exc_einval);
+  }
+  std::vector<int> size_i;
+  hf.geti_vec("size",size_i);
+  std::vector<size_t> size_s(rank);
+  for(int k=0;k<rank;k++) size_s[k]=size_i[k];
+
+  // Read the block
+  std::vector<double> data;
+  hf.getd_vec_block("data",size_s,start,count,data);
+  t.resize(rank,count);
+  std::swap(t.get_data(),data);
+  
+  // Get the corresponding part of the grid
+  bool grid_set2=false;
+  int igrid_set;
+  hf.geti("grid_set",igrid_set);
+  if (igrid_set>0) grid_set2=true;
+  if (grid_set2) {
+    std::vector<double> ogrid, grid2;
+    hf.getd_vec("grid",ogrid);
+    size_t ix=0;
+    for(size_t j=0;j<((size_t)rank);j++) {
+      for(size_t k=0;k<count[j];k++) {
+	grid2.push_back(ogrid[ix+start[j]+k]);
+      }
+      ix+=size_s[j];
+    }
+    t.set_grid_packed(grid2);
+  }
+      
+  // Close group
+  hf.close_group(group);
+      
+  // Return location to previous value
+  hf.set_current_id(top);
+      
+  return;
+}
@@ -47,6 +47,30 @@ namespace o2scl_hdf {
    */
   void hdf_output(hdf_file &hf, o2scl::table<> &t, std::string name);
 
+  /** \brief Output rows of a \ref o2scl::table object to a 
+      table in a \ref hdf_file, beginning at a specified row
+
+      This function writes rows \c row_start through the last row
+      of \c t to rows <tt>file_offset+row_start</tt> and beyond of
+      the table named \c name in \c hf. Rows before
+      <tt>file_offset+row_start</tt> which are already present in
+      the file are not rewritten and any rows after the last row
+      written are removed, so the number of lines in the file is
+      <tt>file_offset+t.get_nlines()</tt>. The column names, the
+      constants, and the number of lines are always written. This
+      allows a table which only grows (or is only modified near its
+      end) to be written periodically at a cost proportional to the
+      number of new rows. The argument \c file_offset allows \c t
+      to hold only the final rows of a larger table.
+
+      If \c file_offset and \c row_start are both zero, the table
+      is created if necessary. Otherwise, the table must have been
+      created by this function with the same columns. The result
+      can be read with \ref hdf_input() as usual.
+  */
+  void hdf_output_append(hdf_file &hf, o2scl::table<> &t, std::string name,
+			 size_t row_start, size_t file_offset=0);
+
 #ifndef O2SCL_NO_HDF_INPUT  
   /** \brief Input a \ref o2scl::table object from a \ref hdf_file
 
@@ -89,6 +113,12 @@ namespace o2scl_hdf {
    */
   void hdf_output_data(hdf_file &hf, o2scl::table<> &t);
 
+  /** \brief Internal function for outputting rows of a 
+      \ref o2scl::table object
+  */
+  void hdf_output_data_append(hdf_file &hf, o2scl::table<> &t,
+			      size_t row_start, size_t file_offset);
+
   /** \brief Internal function for inputting a \ref o2scl::table object
    */
   template<class vec_t> 
@@ -164,12 +194,182 @@ namespace o2scl_hdf {
 
     return;
   }
+
+#ifndef O2SCL_NO_HDF_INPUT  
+  /** \brief Input part of a \ref o2scl::table object from a 
+      \ref hdf_file
+
+      This function reads only the columns with names given in \c
+      cols (or all of the columns if \c cols is empty) and the \c
+      n_rows rows beginning with row \c row_start. If the requested
+      rows extend past the end of the table, then only the rows up to
+      the end of the table are read. The columns are read with \ref
+      hdf_file::getd_vec_range(), so the memory and I/O required
+      scale with the size of the slice rather than the size of the
+      table. The constants are always read. If one of the requested
+      columns is not present, the error handler is called.
+  */
+  template<class vec_t> 
+    void hdf_input(hdf_file &hf, o2scl::table<vec_t> &t, std::string name,
+		   const std::vector<std::string> &cols, size_t row_start,
+		   size_t n_rows) {
+      
+    // If no name specified, find name of first group of specified type
+    if (name.length()==0) {
+      hf.find_group_by_type("table",name);
+      if (name.length()==0) {
+	O2SCL_ERR2("No object of type table found in ",
+		   "o2scl_hdf::hdf_input().",o2scl::exc_efailed);
+      }
+    }
+
+    // Open main group
+    hid_t top=hf.get_current_id();
+    hid_t group=hf.open_group(name);
+    hf.set_current_id(group);
+
+    // Input the table data
+    std::vector<size_t> col_index;
+    hdf_input_data_slice(hf,t,cols,row_start,n_rows,col_index);
+
+    // Close group
+    hf.close_group(group);
+
+    // Return location to previous value
+    hf.set_current_id(top);
+
+    return;
+  }
+#endif
+
+  /** \brief Internal function for inputting part of a 
+      \ref o2scl::table object
+
+      On exit, \c col_index contains the index of each column
+      in \c t among the columns stored in the HDF file.
+  */
+  template<class vec_t> 
+    void hdf_input_data_slice(hdf_file &hf, o2scl::table<vec_t> &t,
+			      const std::vector<std::string> &cols,
+			      size_t row_start, size_t n_rows,
+			      std::vector<size_t> &col_index) {
+    hid_t group=hf.get_current_id();
+
+    // Clear previous data
+    t.clear_table();
+    t.clear_constants();
+
+    // Check typename
+    std::string type2;
+    hf.gets_fixed("o2scl_type",type2);
+    if (type2!="table") {
+      O2SCL_ERR2("Typename in HDF group does not match ",
+		 "class in o2scl_hdf::hdf_input_data_slice().",
+		 o2scl::exc_einval);
+    }
+
+    // Storage
+    std::vector<std::string> cnames, file_cols;
+    typedef boost::numeric::ublas::vector<double> ubvector;
+    ubvector cvalues;
+      
+    // Get constants
+    hf.gets_vec("con_names",cnames);
+    hf.getd_vec_copy("con_values",cvalues);
+    if (cnames.size()!=cvalues.size()) {
+      O2SCL_ERR2("Size mismatch between constant names and values ",
+		 "in o2scl_hdf::hdf_input_data_slice().",o2scl::exc_einval);
+    }
+    for(size_t i=0;i<cnames.size();i++) {
+      t.add_constant(cnames[i],cvalues[i]);
+    }
+
+    // Get column names and find the requested columns
+    hf.gets_vec("col_names",file_cols);
+    col_index.clear();
+    if (cols.size()==0) {
+      for(size_t i=0;i<file_cols.size();i++) {
+	col_index.push_back(i);
+      }
+    } else {
+      for(size_t j=0;j<cols.size();j++) {
+	bool found=false;
+	for(size_t i=0;i<file_cols.size() && found==false;i++) {
+	  if (file_cols[i]==cols[j]) {
+	    col_index.push_back(i);
+	    found=true;
+	  }
+	}
+	if (found==false) {
+	  std::string err=((std::string)"Column '")+cols[j]+
+	    "' not found in o2scl_hdf::hdf_input_data_slice().";
+	  O2SCL_ERR(err.c_str(),o2scl::exc_enotfound);
+	}
+      }
+    }
+    for(size_t i=0;i<col_index.size();i++) {
+      t.new_column(file_cols[col_index[i]]);
+    }
+
+    // Get number of lines and restrict to the requested range
+    int nlines2;
+    hf.geti("nlines",nlines2);
+    size_t nlines=0;
+    if (row_start<((size_t)nlines2)) {
+      nlines=((size_t)nlines2)-row_start;
+      if (n_rows<nlines) nlines=n_rows;
+    }
+    t.set_nlines(nlines);
+    
+    // Output the interpolation type
+    hf.get_szt_def("itype",o2scl::itp_cspline,t.itype);
+
+    // Open data group
+    hid_t group2=hf.open_group("data");
+    hf.set_current_id(group2);
+
+    if (nlines>0) {
+    
+      // Get data. Each column is copied into a vector of the
+      // full column size and swapped into the table, and the vector
+      // which is swapped out is reused for the next column.
+      std::vector<double> vtmp;
+      vec_t col(t.get_maxlines());
+      for(size_t i=0;i<t.get_ncolumns();i++) {
+	std::string cname=t.get_column_name(i);
+	hf.getd_vec_range(cname,row_start,nlines,vtmp);
+	for(size_t j=0;j<nlines;j++) col[j]=vtmp[j];
+	t.swap_column_data(cname,col);
+      }
+
+    }
+
+    // Close groups
+    hf.close_group(group2);
+
+    hf.set_current_id(group);
+
+    // Check that input created a valid table
+    t.check_synchro();
+
+    return;
+  }
   
   /** \brief Output a \ref o2scl::table_units object to a \ref hdf_file
    */
   void hdf_output(hdf_file &hf, o2scl::table_units<> &t, 
 		  std::string name);
 
+  /** \brief Output rows of a \ref o2scl::table_units object to a 
+      table in a \ref hdf_file, beginning at a specified row
+
+      This function works as the corresponding function for
+      \ref o2scl::table objects and also writes the units.
+  */
+  void hdf_output_append(hdf_file &hf, o2scl::table_units<> &t,
+			 std::string name, size_t row_start,
+			 size_t file_offset=0);
+
   /** \brief Input a \ref o2scl::table_units object from a \ref hdf_file
 
       \comment
@@ -238,6 +438,65 @@ namespace o2scl_hdf {
 
     return;
   }
+
+  /** \brief Input part of a \ref o2scl::table_units object from a 
+      \ref hdf_file
+
+      This function reads only the specified columns and rows, 
+      as described in the corresponding function for 
+      \ref o2scl::table objects.
+  */
+  template<class vec_t> 
+    void hdf_input(hdf_file &hf, o2scl::table_units<vec_t> &t, 
+		   std::string name, const std::vector<std::string> &cols,
+		   size_t row_start, size_t n_rows) {
+      
+    // If no name specified, find name of first group of specified type
+    if (name.length()==0) {
+      hf.find_group_by_type("table",name);
+      if (name.length()==0) {
+	O2SCL_ERR2("No object of type table found in ",
+		   "o2scl_hdf::hdf_input().",o2scl::exc_efailed);
+      }
+    }
+
+    // Open main group
+    hid_t top=hf.get_current_id();
+    hid_t group=hf.open_group(name);
+    hf.set_current_id(group);
+
+    // Input base table object
+    o2scl::table<vec_t> *tbase=dynamic_cast<o2scl::table_units<vec_t> *>(&t);
+    if (tbase==0) {
+      O2SCL_ERR2("Cast failed in hdf_input",
+		 "(hdf_file &, table_units &, ...).",o2scl::exc_efailed);
+    }
+    std::vector<size_t> col_index;
+    hdf_input_data_slice(hf,*tbase,cols,row_start,n_rows,col_index);
+  
+    // Get unit flag
+    int uf;
+    hf.geti("unit_flag",uf);
+
+    // If present, get units for the columns which were read
+    if (uf>0) {
+      std::vector<std::string> units;
+      hf.gets_vec("units",units);
+      for(size_t i=0;i<col_index.size();i++) {
+	if (col_index[i]<units.size()) {
+	  t.set_unit(t.get_column_name(i),units[col_index[i]]);
+	}
+      }
+    }
+
+    // Close group
+    hf.close_group(group);
+
+    // Return location to previous value
+    hf.set_current_id(top);
+
+    return;
+  }
   
   /// Output a \ref o2scl::hist object to a \ref hdf_file
   void hdf_output(hdf_file &hf, o2scl::hist &h, std::string name);
@@ -287,6 +546,19 @@ namespace o2scl_hdf {
   /// Input a \ref o2scl::tensor_grid object from a \ref hdf_file
   void hdf_input(hdf_file &hf, o2scl::tensor_grid<std::vector<double>,
 		 std::vector<size_t> > &t, std::string name="");
+  /** \brief Input a rectangular block of a \ref o2scl::tensor_grid
+      object from a \ref hdf_file
+
+      This function reads only the block of the tensor which begins
+      at the indices in \c start and has the sizes given in \c
+      count (using \ref hdf_file::getd_vec_block() ), along with the
+      corresponding part of the grid. All of the entries in \c
+      count must be greater than zero.
+  */
+  void hdf_input(hdf_file &hf, o2scl::tensor_grid<std::vector<double>,
+		 std::vector<size_t> > &t, std::string name,
+		 const std::vector<size_t> &start,
+		 const std::vector<size_t> &count);
 
 }
 
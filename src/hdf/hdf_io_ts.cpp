@@ -94,6 +94,153 @@ int main(void) {
     t.test_gen(tab.get_unit("a")==tab2.get_unit("a"),"unit");
   }
 
+  // Test of partial table input
+  {
+    table_units<> tab, tab2, tab3;
+    tab.add_constant("pi",acos(-1.0));
+    tab.line_of_names("a b c");
+    tab.set_unit("a","m");
+    tab.set_unit("c","km");
+    for(size_t i2=0;i2<100;i2++) {
+      double d=((double)i2);
+      double line[3]={d,sin(d),cos(d)};
+      tab.line_of_data(3,line);
+    }
+
+    hdf_file hf;
+    hf.open_or_create("table_slice.o2");
+    hdf_output(hf,tab,"table_test");
+    hf.close();
+
+    hf.open("table_slice.o2");
+    vector<string> cols={"c","a"};
+    hdf_input(hf,tab2,"table_test",cols,20,30);
+    // Request more rows than are present
+    hdf_input(hf,tab3,"table_test",vector<string>(),90,30);
+    hf.close();
+
+    t.test_gen(tab2.get_nlines()==30,"slice lines");
+    t.test_gen(tab2.get_ncolumns()==2,"slice cols");
+    t.test_gen(tab2.get_column_name(0)=="c","slice col order");
+    t.test_gen(tab2.get_nconsts()==1,"slice consts");
+    t.test_gen(tab2.get_unit("a")=="m","slice unit 1");
+    t.test_gen(tab2.get_unit("c")=="km","slice unit 2");
+    t.test_rel(tab2.get("a",0),20.0,1.0e-12,"slice data 1");
+    t.test_rel(tab2.get("c",29),cos(49.0),1.0e-12,"slice data 2");
+    t.test_gen(tab3.get_nlines()==10,"slice clip lines");
+    t.test_gen(tab3.get_ncolumns()==3,"slice clip cols");
+    t.test_rel(tab3.get("b",9),sin(99.0),1.0e-12,"slice clip data");
+  }
+
+  // Test of appending rows to a table
+  {
+    table_units<> tab, tab2, tab3;
+    tab.line_of_names("a b");
+    tab.set_unit("b","s");
+
+    hdf_file hf;
+    hf.open_or_create("table_append.o2");
+    // Write in three pieces, modifying the last row already
+    // written before each new write
+    size_t row_start=0;
+    for(size_t k=0;k<3;k++) {
+      if (tab.get_nlines()>0) {
+	tab.set("b",tab.get_nlines()-1,-1.0);
+	row_start=tab.get_nlines()-1;
+      }
+      for(size_t i2=0;i2<40;i2++) {
+	double d=((double)tab.get_nlines());
+	double line[2]={d,d*d};
+	tab.line_of_data(2,line);
+      }
+      hdf_output_append(hf,tab,"table_test",row_start);
+    }
+    // Remove rows from the end
+    tab.set_nlines(110);
+    hdf_output_append(hf,tab,"table_test",105);
+    hf.close();
+
+    hf.open("table_append.o2");
+    hdf_input(hf,tab2,"table_test");
+    hf.close();
+
+    t.test_gen(tab2.get_nlines()==110,"append lines");
+    t.test_gen(tab2.get_unit("b")=="s","append unit");
+    bool match=true;
+    for(size_t i2=0;i2<110;i2++) {
+      if (tab2.get("a",i2)!=tab.get("a",i2) ||
+	  tab2.get("b",i2)!=tab.get("b",i2)) match=false;
+    }
+    t.test_gen(match,"append data");
+    t.test_rel(tab2.get("b",79),-1.0,1.0e-12,"append modified row");
+
+    // Write only the final rows of a table at an offset
+    table_units<> tail;
+    tail.line_of_names("a b");
+    tail.set_unit("b","s");
+    double line[2]={110.0,-2.0};
+    tail.line_of_data(2,line);
+    hf.open("table_append.o2",true);
+    hdf_output_append(hf,tail,"table_test",0,110);
+    hf.close();
+
+    hf.open("table_append.o2");
+    hdf_input(hf,tab3,"table_test");
+    hf.close();
+    t.test_gen(tab3.get_nlines()==111,"append offset lines");
+    t.test_rel(tab3.get("b",110),-2.0,1.0e-12,"append offset data");
+    t.test_rel(tab3.get("b",109),tab.get("b",109),1.0e-12,
+	       "append offset data 2");
+  }
+
+  // Test of partial tensor_grid input
+  {
+    tensor_grid<> tg, tg2;
+    size_t sz[3]={4,5,6};
+    tg.resize(3,sz);
+    vector<double> grid;
+    for(size_t j=0;j<3;j++) {
+      for(size_t k=0;k<sz[j];k++) {
+	grid.push_back(((double)(j*10+k)));
+      }
+    }
+    tg.set_grid_packed(grid);
+    for(size_t i=0;i<4;i++) {
+      for(size_t j=0;j<5;j++) {
+	for(size_t k=0;k<6;k++) {
+	  size_t ix[3]={i,j,k};
+	  tg.set(ix,((double)(i*100+j*10+k)));
+	}
+      }
+    }
+
+    hdf_file hf;
+    hf.open_or_create("tensor_grid_block.o2");
+    hdf_output(hf,tg,"tg");
+    hf.close();
+
+    hf.open("tensor_grid_block.o2");
+    vector<size_t> start={1,2,3}, count={2,3,2};
+    hdf_input(hf,tg2,"tg",start,count);
+    hf.close();
+
+    t.test_gen(tg2.get_rank()==3,"block rank");
+    t.test_gen(tg2.get_size(1)==3,"block size");
+    bool match=true;
+    for(size_t i=0;i<2;i++) {
+      for(size_t j=0;j<3;j++) {
+	for(size_t k=0;k<2;k++) {
+	  size_t ix[3]={i,j,k};
+	  size_t ix2[3]={i+1,j+2,k+3};
+	  if (tg2.get(ix)!=tg.get(ix2)) match=false;
+	}
+      }
+    }
+    t.test_gen(match,"block data");
+    t.test_rel(tg2.get_grid(0,0),1.0,1.0e-12,"block grid 1");
+    t.test_rel(tg2.get_grid(2,1),24.0,1.0e-12,"block grid 2");
+  }
+
   t.report();
 
   return 0;
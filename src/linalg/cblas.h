@@ -30,6 +30,8 @@
 */
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include <o2scl/permutation.h>
 
 /** \brief Namespace for O2scl CBLAS function templates
@@ -55,7 +57,10 @@
 
     <b>Level-3 BLAS functions</b>
 
-    Currently only \ref dgemm() is implemented.
+    Currently only \ref dgemm() is implemented. The functions
+    \ref dgemm_tiled() and \ref dsyrk_tiled() are faster versions
+    of <tt>dgemm()</tt> and <tt>dsyrk()</tt> which only work
+    with contiguous row-major storage.
 
     <b>Helper BLAS functions</b>
 
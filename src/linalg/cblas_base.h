@@ -805,6 +805,212 @@ namespace o2scl_cblas {
   }
   //@}
 
+  /// \name Tiled level-3 BLAS functions for contiguous storage
+  //@{
+  /** \brief Compute \f$ C=\alpha \mathrm{op}(A) \mathrm{op}(B) +
+      \beta C \f$ for contiguous row-major matrices
+
+      The matrix \f$ \mathrm{op}(A) \f$ has \c M rows and \c K
+      columns, \f$ \mathrm{op}(B) \f$ has \c K rows and \c N columns,
+      and \c C has \c M rows and \c N columns. Element <tt>(i,j)</tt>
+      of \c A is stored in <tt>A[i*lda+j]</tt>, and similarly for \c
+      B and \c C, so submatrices of a larger matrix can be specified
+      by pointing to their first element and giving the number of
+      columns of the full matrix as the leading dimension.
+
+      Unlike \ref dgemm(), this function only works with raw
+      pointers. Blocks of \f$ \mathrm{op}(B) \f$ are copied into
+      contiguous storage so that the innermost loop runs over
+      contiguous rows of \c B and \c C (which the compiler can
+      vectorize) and four rows of \c C are updated at a time. This
+      makes it much faster than \ref dgemm() for large matrices.
+      It is used for the trailing updates in the blocked
+      decompositions like \ref o2scl_linalg::LU_decomp_blocked().
+  */
+  inline void dgemm_tiled(const enum o2cblas_transpose TransA,
+			  const enum o2cblas_transpose TransB,
+			  const size_t M, const size_t N, const size_t K,
+			  const double alpha, const double *A,
+			  const size_t lda, const double *B,
+			  const size_t ldb, const double beta,
+			  double *C, const size_t ldc) {
+
+    // Tile sizes, chosen so that a packed block of B fits in
+    // the L2 cache and four rows of C fit in the L1 cache
+    const size_t kc=128;
+    const size_t nc=512;
+    
+    bool trans_a=(TransA!=o2cblas_NoTrans);
+    bool trans_b=(TransB!=o2cblas_NoTrans);
+    
+    // Form C := beta*C
+    if (beta==0.0) {
+      for(size_t i=0;i<M;i++) {
+	double *c=C+i*ldc;
+	for(size_t j=0;j<N;j++) c[j]=0.0;
+      }
+    } else if (beta!=1.0) {
+      for(size_t i=0;i<M;i++) {
+	double *c=C+i*ldc;
+	for(size_t j=0;j<N;j++) c[j]*=beta;
+      }
+    }
+    
+    if (alpha==0.0 || M==0 || N==0 || K==0) return;
+
+    std::vector<double> bp(std::min(kc,K)*std::min(nc,N));
+    
+    for(size_t k0=0;k0<K;k0+=kc) {
+      size_t kb=std::min(kc,K-k0);
+      
+      for(size_t j0=0;j0<N;j0+=nc) {
+	size_t jb=std::min(nc,N-j0);
+
+	// Pack alpha*op(B) for this tile
+	for(size_t k=0;k<kb;k++) {
+	  double *b=&bp[k*jb];
+	  if (trans_b) {
+	    for(size_t j=0;j<jb;j++) b[j]=alpha*B[(j0+j)*ldb+k0+k];
+	  } else {
+	    const double *bsrc=B+(k0+k)*ldb+j0;
+	    for(size_t j=0;j<jb;j++) b[j]=alpha*bsrc[j];
+	  }
+	}
+
+	// Update four rows of C at a time
+	size_t i=0;
+	for(;i+4<=M;i+=4) {
+	  double *c0=C+i*ldc+j0;
+	  double *c1=c0+ldc;
+	  double *c2=c1+ldc;
+	  double *c3=c2+ldc;
+	  for(size_t k=0;k<kb;k++) {
+	    double a0, a1, a2, a3;
+	    if (trans_a) {
+	      const double *ak=A+(k0+k)*lda+i;
+	      a0=ak[0];
+	      a1=ak[1];
+	      a2=ak[2];
+	      a3=ak[3];
+	    } else {
+	      const double *ai=A+i*lda+k0+k;
+	      a0=ai[0];
+	      a1=ai[lda];
+	      a2=ai[2*lda];
+	      a3=ai[3*lda];
+	    }
+	    const double *b=&bp[k*jb];
+	    for(size_t j=0;j<jb;j++) {
+	      double bj=b[j];
+	      c0[j]+=a0*bj;
+	      c1[j]+=a1*bj;
+	      c2[j]+=a2*bj;
+	      c3[j]+=a3*bj;
+	    }
+	  }
+	}
+
+	// The remaining rows
+	for(;i<M;i++) {
+	  double *c0=C+i*ldc+j0;
+	  for(size_t k=0;k<kb;k++) {
+	    double a0;
+	    if (trans_a) a0=A[(k0+k)*lda+i];
+	    else a0=A[i*lda+k0+k];
+	    const double *b=&bp[k*jb];
+	    for(size_t j=0;j<jb;j++) {
+	      c0[j]+=a0*b[j];
+	    }
+	  }
+	}
+	
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Compute \f$ C=\alpha \mathrm{op}(A) \mathrm{op}(A)^{T} +
+      \beta C \f$ for a contiguous row-major symmetric matrix \c C
+
+      The matrix \c C has \c N rows and \c N columns and only the
+      triangle specified by \c Uplo is referenced and updated. If \c
+      Trans is \ref o2cblas_NoTrans, then \c A has \c N rows and \c K
+      columns, otherwise \c A has \c K rows and \c N columns. The
+      storage convention is the same as in \ref dgemm_tiled(), to
+      which the off-diagonal blocks are delegated.
+  */
+  inline void dsyrk_tiled(const enum o2cblas_uplo Uplo,
+			  const enum o2cblas_transpose Trans,
+			  const size_t N, const size_t K,
+			  const double alpha, const double *A,
+			  const size_t lda, const double beta,
+			  double *C, const size_t ldc) {
+
+    // The number of rows of C in each block
+    const size_t nb=128;
+
+    bool lower=(Uplo==o2cblas_Lower);
+    bool trans=(Trans!=o2cblas_NoTrans);
+    enum o2cblas_transpose ta, tb;
+    if (trans) {
+      ta=o2cblas_Trans;
+      tb=o2cblas_NoTrans;
+    } else {
+      ta=o2cblas_NoTrans;
+      tb=o2cblas_Trans;
+    }
+    
+    // Form C := beta*C on the triangle
+    if (beta!=1.0) {
+      for(size_t i=0;i<N;i++) {
+	size_t jlo=(lower ? 0 : i);
+	size_t jhi=(lower ? i+1 : N);
+	for(size_t j=jlo;j<jhi;j++) {
+	  if (beta==0.0) C[i*ldc+j]=0.0;
+	  else C[i*ldc+j]*=beta;
+	}
+      }
+    }
+    
+    if (alpha==0.0 || N==0 || K==0) return;
+
+    std::vector<double> tmp(std::min(nb,N)*std::min(nb,N));
+    
+    for(size_t i0=0;i0<N;i0+=nb) {
+      size_t ib=std::min(nb,N-i0);
+
+      // Pointers to the first row (or column) of op(A) for
+      // this block
+      const double *ai=(trans ? A+i0 : A+i0*lda);
+      
+      // Off-diagonal block
+      if (lower && i0>0) {
+	dgemm_tiled(ta,tb,ib,i0,K,alpha,ai,lda,A,lda,1.0,
+		    C+i0*ldc,ldc);
+      } else if (!lower && i0+ib<N) {
+	const double *aj=(trans ? A+i0+ib : A+(i0+ib)*lda);
+	dgemm_tiled(ta,tb,ib,N-i0-ib,K,alpha,ai,lda,aj,lda,1.0,
+		    C+i0*ldc+i0+ib,ldc);
+      }
+
+      // Diagonal block, computed in full and then added to the
+      // requested triangle
+      dgemm_tiled(ta,tb,ib,ib,K,alpha,ai,lda,ai,lda,0.0,&tmp[0],ib);
+      for(size_t i=0;i<ib;i++) {
+	size_t jlo=(lower ? 0 : i);
+	size_t jhi=(lower ? i+1 : ib);
+	double *c=C+(i0+i)*ldc+i0;
+	for(size_t j=jlo;j<jhi;j++) {
+	  c[j]+=tmp[i*ib+j];
+	}
+      }
+    }
+    
+    return;
+  }
+  //@}
+
   /// \name Helper BLAS functions - Subvectors
   //@{
   /** \brief Compute \f$ y=\alpha x+y \f$ beginning with index \c ie 
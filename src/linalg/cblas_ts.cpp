@@ -492,6 +492,84 @@ int main(void) {
   }
 
 
+  {
+    using namespace o2scl_cblas;
+    
+    // -------------------------------------------------
+    // Test the tiled functions against dgemm() with matrices large
+    // enough to require several tiles
+    
+    size_t m=137, n=601, k=290;
+    for(size_t ta=0;ta<2;ta++) {
+      for(size_t tb=0;tb<2;tb++) {
+	o2cblas_transpose opa=(ta==0 ? o2cblas_NoTrans : o2cblas_Trans);
+	o2cblas_transpose opb=(tb==0 ? o2cblas_NoTrans : o2cblas_Trans);
+	ubmatrix a(ta==0 ? m : k,ta==0 ? k : m);
+	ubmatrix b(tb==0 ? k : n,tb==0 ? n : k);
+	ubmatrix c1(m,n), c2(m,n);
+	for(size_t i=0;i<a.size1();i++) {
+	  for(size_t j=0;j<a.size2();j++) {
+	    a(i,j)=sin(1.0+i+2.0*j);
+	  }
+	}
+	for(size_t i=0;i<b.size1();i++) {
+	  for(size_t j=0;j<b.size2();j++) {
+	    b(i,j)=cos(3.0*i+j);
+	  }
+	}
+	for(size_t i=0;i<m;i++) {
+	  for(size_t j=0;j<n;j++) {
+	    c1(i,j)=sin(i*j+0.5);
+	    c2(i,j)=c1(i,j);
+	  }
+	}
+	dgemm(o2cblas_RowMajor,opa,opb,m,n,k,0.5,a,b,2.0,c1);
+	dgemm_tiled(opa,opb,m,n,k,0.5,&a(0,0),a.size2(),&b(0,0),b.size2(),
+		    2.0,&c2(0,0),n);
+	t.test_abs_mat(m,n,c2,c1,1.0e-11,"dgemm_tiled");
+      }
+    }
+
+    // Compare dsyrk_tiled() with the same triangle computed
+    // with dgemm()
+    for(size_t tr=0;tr<2;tr++) {
+      for(size_t up=0;up<2;up++) {
+	o2cblas_transpose opa=(tr==0 ? o2cblas_NoTrans : o2cblas_Trans);
+	o2cblas_transpose opb=(tr==0 ? o2cblas_Trans : o2cblas_NoTrans);
+	o2cblas_uplo uplo=(up==0 ? o2cblas_Lower : o2cblas_Upper);
+	ubmatrix a(tr==0 ? n : k,tr==0 ? k : n);
+	ubmatrix c1(n,n), c2(n,n);
+	for(size_t i=0;i<a.size1();i++) {
+	  for(size_t j=0;j<a.size2();j++) {
+	    a(i,j)=sin(1.0+i+2.0*j);
+	  }
+	}
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<n;j++) {
+	    c1(i,j)=sin(i*j+0.5);
+	    c2(i,j)=c1(i,j);
+	  }
+	}
+	dgemm(o2cblas_RowMajor,opa,opb,n,n,k,-1.0,a,a,0.5,c1);
+	dsyrk_tiled(uplo,opa,n,k,-1.0,&a(0,0),a.size2(),0.5,&c2(0,0),n);
+	double max_diff=0.0;
+	bool other_same=true;
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<n;j++) {
+	    if ((up==0 && j<=i) || (up==1 && j>=i)) {
+	      double diff=fabs(c2(i,j)-c1(i,j));
+	      if (diff>max_diff) max_diff=diff;
+	    } else if (c2(i,j)!=sin(i*j+0.5)) {
+	      other_same=false;
+	    }
+	  }
+	}
+	t.test_abs(max_diff,0.0,1.0e-11,"dsyrk_tiled");
+	t.test_gen(other_same,"dsyrk_tiled other triangle");
+      }
+    }
+  }
+
   t.report();
   return 0;
 }
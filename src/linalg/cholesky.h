@@ -27,6 +27,9 @@
     \brief Header wrapper for \ref cholesky_base.h
 */
 
+#include <vector>
+#include <algorithm>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/permutation.h>
 #include <o2scl/cblas.h>
@@ -55,10 +55,14 @@ namespace o2scl_linalg {
       the diagonal and lower triangular part contain the matrix L
       and the upper triangular part contains L^T. 
     
-      If the matrix is not positive-definite, the error handler 
-      will be called. 
+      If the matrix is not positive-definite and \c err_on_fail is
+      true, the error handler will be called. If \c err_on_fail is
+      false, then \ref o2scl::exc_einval is returned instead (and
+      the contents of \c A are unspecified), which is useful when
+      the caller wants to fall back to a more general decomposition.
   */
-  template<class mat_t> void cholesky_decomp(const size_t M, mat_t &A) {
+  template<class mat_t> int cholesky_decomp(const size_t M, mat_t &A,
+					    bool err_on_fail) {
   
     size_t i,j,k;
 
@@ -73,6 +77,7 @@ namespace o2scl_linalg {
     // the square root should always be safe?
 
     if (A_00<=0) {
+      if (!err_on_fail) return o2scl::exc_einval;
       O2SCL_ERR2("Matrix not positive definite (A[0][0]<=0) in ",
 		 "cholesky_decomp().",o2scl::exc_einval);
     }
@@ -88,6 +93,7 @@ namespace o2scl_linalg {
       double diag=A_11-L_10*L_10;
     
       if (diag<=0) {
+	if (!err_on_fail) return o2scl::exc_einval;
 	O2SCL_ERR2("Matrix not positive definite (diag<=0 for 2x2) in ",
 		   "cholesky_decomp().",o2scl::exc_einval);
       }
@@ -123,6 +129,7 @@ namespace o2scl_linalg {
 	double diag=A_kk-sum*sum;
 
 	if(diag<=0) {
+	  if (!err_on_fail) return o2scl::exc_einval;
 	  O2SCL_ERR2("Matrix not positive definite (diag<=0) in ",
 		     "cholesky_decomp().",o2scl::exc_einval);
 	}
@@ -144,9 +151,137 @@ namespace o2scl_linalg {
       }
     } 
   
+    return o2scl::success;
+  }
+
+  /** \brief Compute the in-place Cholesky decomposition of a symmetric
+      positive-definite square matrix
+
+      This function calls the error handler if the matrix is not
+      positive-definite.
+  */
+  template<class mat_t> void cholesky_decomp(const size_t M, mat_t &A) {
+    cholesky_decomp(M,A,true);
     return;
   }
 
+  /** \brief Compute the in-place Cholesky decomposition of a
+      symmetric positive-definite matrix stored in contiguous
+      row-major order using a blocked algorithm
+
+      This function computes the same decomposition as \ref
+      cholesky_decomp() (up to the effects of finite precision) for
+      the \c M by \c M matrix stored with element <tt>(i,j)</tt> in
+      <tt>A[i*lda+j]</tt>. The matrix is processed in panels of \c
+      nb columns. For each panel, the diagonal block is decomposed
+      with the unblocked algorithm, the block of \f$ L \f$ below it
+      is computed with a triangular solve, and the remaining
+      lower-right block is updated with \ref
+      o2scl_cblas::dsyrk_tiled().
+
+      If the matrix is not positive-definite and \c err_on_fail is
+      true, the error handler will be called. If \c err_on_fail is
+      false, then \ref o2scl::exc_einval is returned instead (and the
+      contents of \c A are unspecified).
+  */
+  inline int cholesky_decomp_rowmajor(const size_t M, double *A,
+				      const size_t lda, bool err_on_fail,
+				      size_t nb=64) {
+
+    if (nb==0) nb=1;
+    
+    for(size_t j0=0;j0<M;j0+=nb) {
+      size_t j1=std::min(j0+nb,M);
+
+      // Decompose the diagonal block
+      for(size_t k=j0;k<j1;k++) {
+	double *rk=A+k*lda;
+	for(size_t i=j0;i<k;i++) {
+	  const double *ri=A+i*lda;
+	  double sum=0.0;
+	  for(size_t m=j0;m<i;m++) sum+=ri[m]*rk[m];
+	  rk[i]=(rk[i]-sum)/ri[i];
+	}
+	double diag=rk[k];
+	for(size_t m=j0;m<k;m++) diag-=rk[m]*rk[m];
+	if (diag<=0.0) {
+	  if (!err_on_fail) return o2scl::exc_einval;
+	  O2SCL_ERR2("Matrix not positive definite (diag<=0) in ",
+		     "cholesky_decomp_rowmajor().",o2scl::exc_einval);
+	  return o2scl::exc_einval;
+	}
+	rk[k]=sqrt(diag);
+      }
+
+      if (j1<M) {
+	
+	// Compute the block of L below the diagonal block by
+	// solving L_21 L_11^T = A_21
+	for(size_t i=j1;i<M;i++) {
+	  double *ri=A+i*lda;
+	  for(size_t k=j0;k<j1;k++) {
+	    const double *rk=A+k*lda;
+	    double sum=0.0;
+	    for(size_t m=j0;m<k;m++) sum+=ri[m]*rk[m];
+	    ri[k]=(ri[k]-sum)/rk[k];
+	  }
+	}
+	
+	// Update the trailing matrix, A_22 -= L_21 L_21^T
+	o2scl_cblas::dsyrk_tiled(o2scl_cblas::o2cblas_Lower,
+				 o2scl_cblas::o2cblas_NoTrans,
+				 M-j1,j1-j0,-1.0,A+j1*lda+j0,lda,
+				 1.0,A+j1*lda+j1,lda);
+      }
+    }
+    
+    // Copy the transposed lower triangle to the upper triangle
+    for(size_t i=1;i<M;i++) {
+      for(size_t j=0;j<i;j++) {
+	A[j*lda+i]=A[i*lda+j];
+      }
+    } 
+    
+    return o2scl::success;
+  }
+
+  /** \brief Compute the in-place Cholesky decomposition of a symmetric
+      positive-definite square matrix using a blocked algorithm
+
+      This function gives the same results as \ref cholesky_decomp()
+      (up to the effects of finite precision). If \c M is larger than
+      twice the block size \c nb, the matrix is copied to contiguous
+      storage, decomposed with \ref cholesky_decomp_rowmajor(), and
+      copied back. Otherwise, \ref cholesky_decomp() is used.
+  */
+  template<class mat_t>
+    int cholesky_decomp_blocked(const size_t M, mat_t &A,
+				bool err_on_fail=true, size_t nb=64) {
+    
+    if (nb==0 || M<=2*nb) {
+      return cholesky_decomp(M,A,err_on_fail);
+    }
+    
+    // Only the lower triangle and the diagonal are used
+    std::vector<double> a(M*M);
+    for(size_t i=0;i<M;i++) {
+      for(size_t j=0;j<=i;j++) {
+	a[i*M+j]=O2SCL_IX2(A,i,j);
+      }
+    }
+    
+    int ret=cholesky_decomp_rowmajor(M,&a[0],M,err_on_fail,nb);
+    if (ret!=0) return ret;
+    
+    for(size_t i=0;i<M;i++) {
+      for(size_t j=0;j<M;j++) {
+	O2SCL_IX2(A,i,j)=a[i*M+j];
+      }
+    }
+    
+    return o2scl::success;
+  }
+
   /** \brief Solve a symmetric positive-definite linear system after a 
       Cholesky decomposition
 
@@ -301,7 +436,7 @@ namespace o2scl_linalg {
     size_t i, j;
   
     // [GSL] Initial Cholesky decomposition
-    int stat_chol=cholesky_decomp(N,A);
+    int stat_chol=cholesky_decomp(N,A,true);
   
     // [GSL] Calculate D from diagonal part of initial Cholesky
     for(i=0;i<N;++i) {
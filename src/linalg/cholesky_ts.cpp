@@ -152,6 +152,37 @@ int main(void) {
 
   }
 
+  {
+    using namespace o2scl_linalg;
+    
+    // -------------------------------------------------
+    // Test the blocked Cholesky decomposition with a matrix large
+    // enough to require several blocks
+
+    size_t n=150;
+    ubmatrix a1(n,n), a2(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	a1(i,j)=exp(-fabs(((double)i)-((double)j))/10.0);
+	if (i==j) a1(i,j)+=1.0;
+	a2(i,j)=a1(i,j);
+      }
+    }
+    cholesky_decomp(n,a1);
+    cholesky_decomp_blocked(n,a2,true,16);
+    t.test_abs_mat(n,n,a2,a1,1.0e-12,"cholesky_decomp_blocked");
+
+    // A matrix which is not positive definite
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	a2(i,j)=exp(-fabs(((double)i)-((double)j))/10.0);
+      }
+    }
+    a2(100,100)=-1.0;
+    int ret=cholesky_decomp_blocked(n,a2,false,16);
+    t.test_gen(ret==exc_einval,"cholesky_decomp_blocked fail");
+  }
+
   t.report();
   return 0;
 }
@@ -26,6 +26,9 @@
 #ifndef O2SCL_LU_H
 #define O2SCL_LU_H
 
+#include <vector>
+#include <algorithm>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/permutation.h>
 #include <o2scl/cblas.h>
@@ -137,6 +137,131 @@ namespace o2scl_linalg {
     return o2scl::success;
   }
 
+  /** \brief Compute the LU decomposition of a matrix stored
+      in contiguous row-major order using a blocked algorithm
+
+      This function computes the same decomposition as \ref
+      LU_decomp() (with the same pivots, up to the effects of
+      finite precision) of the \c N by \c N matrix stored with
+      element <tt>(i,j)</tt> in <tt>A[i*lda+j]</tt>. The matrix is
+      processed in panels of \c nb columns. Each panel is
+      factored with the unblocked algorithm, then the
+      corresponding rows of \f$ U \f$ are computed with a
+      triangular solve, and the remaining lower-right block is
+      updated with a single call to \ref o2scl_cblas::dgemm_tiled().
+      Since most of the floating point operations are in the
+      trailing update, this is much faster than \ref LU_decomp()
+      for large matrices.
+  */
+  inline int LU_decomp_rowmajor(const size_t N, double *A, const size_t lda,
+				o2scl::permutation &p, int &signum,
+				size_t nb=64) {
+    
+    signum=1;
+    p.init();
+
+    if (nb==0) nb=1;
+    
+    for(size_t j0=0;j0<N;j0+=nb) {
+      size_t j1=std::min(j0+nb,N);
+
+      // Factor the panel, applying the row interchanges to the
+      // full rows
+      for(size_t j=j0;j<j1;j++) {
+
+	// Find maximum in the j-th column
+	double max=fabs(A[j*lda+j]);
+	size_t i_pivot=j;
+	for(size_t i=j+1;i<N;i++) {
+	  double aij=fabs(A[i*lda+j]);
+	  if (aij>max) {
+	    max=aij;
+	    i_pivot=i;
+	  }
+	}
+	
+	if (i_pivot!=j) {
+	  double *r1=A+j*lda;
+	  double *r2=A+i_pivot*lda;
+	  for(size_t k=0;k<N;k++) std::swap(r1[k],r2[k]);
+	  p.swap(j,i_pivot);
+	  signum=-signum;
+	}
+	
+	double ajj=A[j*lda+j];
+	if (ajj!=0.0) {
+	  const double *rj=A+j*lda;
+	  for(size_t i=j+1;i<N;i++) {
+	    double *ri=A+i*lda;
+	    double aij=ri[j]/ajj;
+	    ri[j]=aij;
+	    for(size_t k=j+1;k<j1;k++) {
+	      ri[k]-=aij*rj[k];
+	    }
+	  }
+	}
+      }
+
+      if (j1<N) {
+	
+	// Compute the block row of U by solving L_11 U_12 = A_12
+	for(size_t i=j0+1;i<j1;i++) {
+	  double *ri=A+i*lda;
+	  for(size_t k=j0;k<i;k++) {
+	    double lik=ri[k];
+	    const double *rk=A+k*lda;
+	    for(size_t m=j1;m<N;m++) {
+	      ri[m]-=lik*rk[m];
+	    }
+	  }
+	}
+
+	// Update the trailing matrix, A_22 -= L_21 U_12
+	o2scl_cblas::dgemm_tiled(o2scl_cblas::o2cblas_NoTrans,
+				 o2scl_cblas::o2cblas_NoTrans,
+				 N-j1,N-j1,j1-j0,-1.0,A+j1*lda+j0,lda,
+				 A+j0*lda+j1,lda,1.0,A+j1*lda+j1,lda);
+      }
+    }
+
+    return o2scl::success;
+  }
+
+  /** \brief Compute the LU decomposition of the matrix \c A
+      using a blocked algorithm
+
+      This function gives the same results as \ref LU_decomp() (up to
+      the effects of finite precision). If \c N is larger than twice
+      the block size \c nb, the matrix is copied to contiguous
+      storage, decomposed with \ref LU_decomp_rowmajor(), and copied
+      back. Otherwise, \ref LU_decomp() is used.
+  */
+  template<class mat_t>
+    int LU_decomp_blocked(const size_t N, mat_t &A, o2scl::permutation &p, 
+			  int &signum, size_t nb=64) {
+
+    if (nb==0 || N<=2*nb) {
+      return LU_decomp(N,A,p,signum);
+    }
+    
+    std::vector<double> a(N*N);
+    for(size_t i=0;i<N;i++) {
+      for(size_t j=0;j<N;j++) {
+	a[i*N+j]=O2SCL_IX2(A,i,j);
+      }
+    }
+    
+    int ret=LU_decomp_rowmajor(N,&a[0],N,p,signum,nb);
+    
+    for(size_t i=0;i<N;i++) {
+      for(size_t j=0;j<N;j++) {
+	O2SCL_IX2(A,i,j)=a[i*N+j];
+      }
+    }
+    
+    return ret;
+  }
+
   /** \brief Solve a linear system after LU decomposition in place
       
       These functions solve the square system A x = b in-place using
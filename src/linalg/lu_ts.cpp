@@ -171,6 +171,34 @@ int main(void) {
     }
   }
 
+  {
+    using namespace o2scl_linalg;
+    
+    // -------------------------------------------------
+    // Test the blocked LU decomposition with a matrix large
+    // enough to require several blocks
+
+    size_t n=150;
+    ubmatrix a1(n,n), a2(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	a1(i,j)=sin(1.3*i+0.7*j+0.1*i*j);
+	a2(i,j)=a1(i,j);
+      }
+    }
+    permutation p1(n), p2(n);
+    int sig1, sig2;
+    LU_decomp(n,a1,p1,sig1);
+    LU_decomp_blocked(n,a2,p2,sig2,16);
+    t.test_abs_mat(n,n,a2,a1,1.0e-10,"LU_decomp_blocked");
+    t.test_gen(sig1==sig2,"LU_decomp_blocked signum");
+    bool perm_same=true;
+    for(size_t i=0;i<n;i++) {
+      if (p1[i]!=p2[i]) perm_same=false;
+    }
+    t.test_gen(perm_same,"LU_decomp_blocked permutation");
+  }
+
   t.report();
   return 0;
 }
@@ -26,6 +26,10 @@
 #ifndef O2SCL_QR_H
 #define O2SCL_QR_H
 
+#include <vector>
+#include <limits>
+#include <algorithm>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/permutation.h>
 #include <o2scl/cblas.h>
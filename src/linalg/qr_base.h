@@ -65,6 +65,209 @@ namespace o2scl_linalg {
     return;
   }
 
+  /** \brief Compute the QR decomposition of a matrix stored
+      in contiguous row-major order using a blocked algorithm
+
+      This function computes the same decomposition as \ref
+      QR_decomp() (up to the effects of finite precision) for the \c
+      M by \c N matrix stored with element <tt>(i,j)</tt> in
+      <tt>A[i*lda+j]</tt>. The matrix is processed in panels of \c
+      nb columns. Each panel is decomposed with Householder
+      transformations as in \ref QR_decomp(), and the product of
+      the transformations is written in the form \f$ I - V T V^{T}
+      \f$ where \f$ V \f$ contains the Householder vectors and \f$ T
+      \f$ is upper triangular (Schreiber and Van Loan, SIAM J. Sci.
+      Stat. Comput. 10 (1989) 53). The transformations are then
+      applied to the remaining columns with two calls to \ref
+      o2scl_cblas::dgemm_tiled().
+  */
+  template<class vec_t>
+    void QR_decomp_rowmajor(const size_t M, const size_t N, double *A,
+			    const size_t lda, vec_t &tau, size_t nb=32) {
+
+    double dbl_eps=std::numeric_limits<double>::epsilon();
+    double dbl_min=std::numeric_limits<double>::min();
+
+    if (nb==0) nb=1;
+    
+    size_t kmax=std::min(M,N);
+    std::vector<double> V, T, W;
+    
+    for(size_t j0=0;j0<kmax;j0+=nb) {
+      size_t j1=std::min(j0+nb,kmax);
+      size_t jb=j1-j0;
+
+      // Decompose the panel
+      for(size_t j=j0;j<j1;j++) {
+
+	// Compute the Householder transformation for column j
+	// as in householder_transform_subcol()
+	double tau_j=0.0;
+	if (j+1<M) {
+	  
+	  // Compute the norm of the subdiagonal part of the column
+	  double scale=0.0, ssq=1.0;
+	  for(size_t i=j+1;i<M;i++) {
+	    double x=A[i*lda+j];
+	    if (x!=0.0) {
+	      double ax=fabs(x);
+	      if (scale<ax) {
+		ssq=1.0+ssq*(scale/ax)*(scale/ax);
+		scale=ax;
+	      } else {
+		ssq+=(ax/scale)*(ax/scale);
+	      }
+	    }
+	  }
+	  double xnorm=scale*sqrt(ssq);
+	  
+	  if (xnorm!=0.0) {
+	    double alpha=A[j*lda+j];
+	    double beta=-(alpha>=0.0 ? +1.0 : -1.0)*hypot(alpha,xnorm);
+	    tau_j=(beta-alpha)/beta;
+	    double s=alpha-beta;
+	    if (fabs(s)>dbl_min) {
+	      for(size_t i=j+1;i<M;i++) A[i*lda+j]*=1.0/s;
+	    } else {
+	      for(size_t i=j+1;i<M;i++) A[i*lda+j]*=dbl_eps/s;
+	      for(size_t i=j+1;i<M;i++) A[i*lda+j]*=1.0/dbl_eps;
+	    }
+	    A[j*lda+j]=beta;
+	  }
+	}
+	O2SCL_IX(tau,j)=tau_j;
+
+	// Apply the transformation to the rest of the panel
+	if (tau_j!=0.0 && j+1<j1) {
+	  size_t nw=j1-j-1;
+	  W.resize(nw);
+	  const double *rj=A+j*lda+j+1;
+	  for(size_t c=0;c<nw;c++) W[c]=rj[c];
+	  for(size_t i=j+1;i<M;i++) {
+	    const double *ri=A+i*lda+j+1;
+	    double vi=A[i*lda+j];
+	    for(size_t c=0;c<nw;c++) W[c]+=ri[c]*vi;
+	  }
+	  double *wj=A+j*lda+j+1;
+	  for(size_t c=0;c<nw;c++) wj[c]-=tau_j*W[c];
+	  for(size_t i=j+1;i<M;i++) {
+	    double *ri=A+i*lda+j+1;
+	    double vi=A[i*lda+j];
+	    for(size_t c=0;c<nw;c++) ri[c]-=tau_j*W[c]*vi;
+	  }
+	}
+      }
+
+      if (j1<N) {
+
+	size_t m2=M-j0;
+	size_t n2=N-j1;
+	
+	// Copy the Householder vectors to V, including the
+	// unit diagonal and the zeros above it
+	V.resize(m2*jb);
+	for(size_t r=0;r<m2;r++) {
+	  const double *ar=A+(j0+r)*lda+j0;
+	  for(size_t c=0;c<jb;c++) {
+	    if (r>c) V[r*jb+c]=ar[c];
+	    else if (r==c) V[r*jb+c]=1.0;
+	    else V[r*jb+c]=0.0;
+	  }
+	}
+
+	// Form the upper triangular matrix T
+	T.resize(jb*jb);
+	for(size_t i=0;i<jb;i++) {
+	  double tau_i=O2SCL_IX(tau,j0+i);
+	  for(size_t r=i+1;r<jb;r++) T[r*jb+i]=0.0;
+	  T[i*jb+i]=tau_i;
+	  if (i>0) {
+	    // z = -tau_i V(:,0:i)^T v_i, stored temporarily in
+	    // the column i of T
+	    for(size_t r=0;r<i;r++) T[r*jb+i]=0.0;
+	    for(size_t row=i;row<m2;row++) {
+	      const double *vr=&V[row*jb];
+	      double vi=vr[i];
+	      for(size_t r=0;r<i;r++) T[r*jb+i]+=vr[r]*vi;
+	    }
+	    for(size_t r=0;r<i;r++) T[r*jb+i]*=-tau_i;
+	    // T(0:i,i) = T(0:i,0:i) z
+	    for(size_t r=0;r<i;r++) {
+	      double sum=0.0;
+	      for(size_t q=r;q<i;q++) sum+=T[r*jb+q]*T[q*jb+i];
+	      T[r*jb+i]=sum;
+	    }
+	  }
+	}
+
+	// Apply (I - V T V^T)^T to the trailing matrix C, first
+	// computing W = V^T C
+	double *C=A+j0*lda+j1;
+	W.resize(jb*n2);
+	o2scl_cblas::dgemm_tiled(o2scl_cblas::o2cblas_Trans,
+				 o2scl_cblas::o2cblas_NoTrans,
+				 jb,n2,m2,1.0,&V[0],jb,C,lda,0.0,&W[0],n2);
+
+	// W = T^T W, starting from the last row since T^T is
+	// lower triangular
+	for(size_t i=jb;i-- > 0;) {
+	  double *wi=&W[i*n2];
+	  double tii=T[i*jb+i];
+	  for(size_t c=0;c<n2;c++) wi[c]*=tii;
+	  for(size_t r=0;r<i;r++) {
+	    double tri=T[r*jb+i];
+	    const double *wr=&W[r*n2];
+	    for(size_t c=0;c<n2;c++) wi[c]+=tri*wr[c];
+	  }
+	}
+
+	// C = C - V W
+	o2scl_cblas::dgemm_tiled(o2scl_cblas::o2cblas_NoTrans,
+				 o2scl_cblas::o2cblas_NoTrans,
+				 m2,n2,jb,-1.0,&V[0],jb,&W[0],n2,1.0,C,lda);
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Compute the QR decomposition of matrix \c A using
+      a blocked algorithm
+
+      This function gives the same results as \ref QR_decomp() (up
+      to the effects of finite precision). If both \c M and \c N are
+      larger than twice the block size \c nb, the matrix is copied
+      to contiguous storage, decomposed with \ref
+      QR_decomp_rowmajor(), and copied back. Otherwise, \ref
+      QR_decomp() is used.
+  */
+  template<class mat_t, class vec_t>
+    void QR_decomp_blocked(size_t M, size_t N, mat_t &A, vec_t &tau,
+			   size_t nb=32) {
+    
+    if (nb==0 || M<=2*nb || N<=2*nb) {
+      QR_decomp(M,N,A,tau);
+      return;
+    }
+    
+    std::vector<double> a(M*N);
+    for(size_t i=0;i<M;i++) {
+      for(size_t j=0;j<N;j++) {
+	a[i*N+j]=O2SCL_IX2(A,i,j);
+      }
+    }
+    
+    QR_decomp_rowmajor(M,N,&a[0],N,tau,nb);
+    
+    for(size_t i=0;i<M;i++) {
+      for(size_t j=0;j<N;j++) {
+	O2SCL_IX2(A,i,j)=a[i*N+j];
+      }
+    }
+    
+    return;
+  }
+
   /** \brief Form the product Q^T v from a QR factorized matrix
   */
   template<class mat_t, class vec_t, class vec2_t>
@@ -169,6 +169,36 @@ int main(void) {
 
   }
 
+  {
+    using namespace o2scl_linalg;
+    
+    // -------------------------------------------------
+    // Test the blocked QR decomposition with matrices large
+    // enough to require several blocks
+
+    for(size_t k=0;k<2;k++) {
+      size_t m=150, n=110;
+      if (k==1) {
+	m=110;
+	n=150;
+      }
+      ubmatrix a1(m,n), a2(m,n);
+      ubvector tau1(std::min(m,n)), tau2(std::min(m,n));
+      for(size_t i=0;i<m;i++) {
+	for(size_t j=0;j<n;j++) {
+	  a1(i,j)=sin(1.3*i+0.7*j+0.1*i*j);
+	  if (i==j) a1(i,j)+=10.0;
+	  a2(i,j)=a1(i,j);
+	}
+      }
+      QR_decomp(m,n,a1,tau1);
+      QR_decomp_blocked(m,n,a2,tau2,16);
+      t.test_abs_mat(m,n,a2,a1,1.0e-10,"QR_decomp_blocked");
+      t.test_abs_vec(std::min(m,n),tau2,tau1,1.0e-10,
+		     "QR_decomp_blocked tau");
+    }
+  }
+
   if (eigen_tests) {
     cout << "Included tests with Eigen." << endl;
   }
@@ -29,6 +29,12 @@
 
 #include <iostream>
 #include <random>
+#include <string>
+#include <functional>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
 
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -39,11 +45,41 @@
 namespace o2scl {
 #endif
 
+  /** \brief Batch integrand for Monte Carlo integration
+
+      The function is given the number of points \c n, the number of
+      dimensions \c d, and the coordinates \c x of the points, where
+      coordinate \c j of point \c i is <tt>x[i*d+j]</tt>. It should
+      store the integrand for point \c i in <tt>y[i]</tt> and return
+      zero for success.
+  */
+  typedef std::function<int(size_t,size_t,
+			    const boost::numeric::ublas::vector<double> &,
+			    boost::numeric::ublas::vector<double> &)>
+    mcarlo_batch_funct;
+  
   /** \brief Monte-Carlo integration [abstract base]
       
       This class provides the generic Monte Carlo parameters and the
       random number generator. The default type for the random number
       generator is a \ref rng_gsl object. 
+
+      The children \ref mcarlo_vegas and \ref mcarlo_miser also have
+      a parallel sampling mode, which is used when \ref n_threads is
+      larger than one or when the integrand is specified as a \ref
+      mcarlo_batch_funct. In this mode the points are generated in
+      blocks of about \ref block_size points, and each block has its
+      own random number stream, seeded by a combination of a seed
+      drawn from \ref rng and the index of the block. The blocks are
+      distributed over \ref n_threads OpenMP threads, and the
+      results from each block are combined in a fixed order. For a
+      fixed seed the results therefore do not depend on the number of
+      threads, although they differ from the results of the serial
+      algorithm. The integrand may be called from several threads at
+      once, so it must be thread-safe. Exceptions thrown by the
+      integrand (and non-zero return values from a batch integrand)
+      are collected and the error handler is called after the
+      parallel loop (see \ref omp_errorhand_subsect).
   */
   template<class func_t=multi_funct, 
     class vec_t=boost::numeric::ublas::vector<double>,
@@ -54,6 +90,8 @@ namespace o2scl {
   
   mcarlo() {
       n_points=1000;
+      n_threads=1;
+      block_size=1024;
     }
 
     virtual ~mcarlo() {}
@@ -69,8 +107,107 @@ namespace o2scl {
     /// The random number generator
     rng_t rng;
   
+    /// \name Parallel sampling
+    //@{
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+    /** \brief The approximate number of points in each block
+	(default 1024)
+
+	The results in the parallel sampling mode depend on
+	this value.
+    */
+    size_t block_size;
+    //@}
+
     /// Return string denoting type ("mcarlo")
     virtual const char *type() { return "mcarlo"; }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Return the seed for the random number stream with
+	index \c k derived from seed \c s
+
+	This uses the mixing function from the SplitMix64 generator
+	so that nearby values of \c s and \c k give unrelated seeds.
+    */
+    static unsigned long int stream_seed(unsigned long int s,
+					 unsigned long int k) {
+      unsigned long long z=((unsigned long long)s)+
+	0x9e3779b97f4a7c15ULL*(((unsigned long long)k)+1);
+      z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+      z=(z^(z>>27))*0x94d049bb133111ebULL;
+      return (unsigned long int)(z^(z>>31));
+    }
+
+    /** \brief Return a random number in \f$ (0,1) \f$ from \c r
+	
+	This is the equivalent of <tt>gsl_rng_uniform_pos()</tt>.
+    */
+    double random_pos(rng_t &r) {
+      double z;
+      do {
+	z=rng_dist(r);
+      } while (z==0);
+      return z;
+    }
+
+    /** \brief Evaluate the integrand at the \c np points in
+	\c xb, storing the results in \c yb
+
+	If \c bfunc is not zero, then the batch integrand is used,
+	otherwise \c func is called for each point using \c xp as
+	temporary storage. The return value is the value returned by
+	the batch integrand, or zero.
+    */
+    int eval_block(func_t *func, mcarlo_batch_funct *bfunc, size_t np,
+		   size_t ndim, const boost::numeric::ublas::vector<double> &xb,
+		   boost::numeric::ublas::vector<double> &yb, vec_t &xp) {
+      if (bfunc!=0) {
+	return (*bfunc)(np,ndim,xb,yb);
+      }
+      for(size_t i=0;i<np;i++) {
+	for(size_t j=0;j<ndim;j++) xp[j]=xb[i*ndim+j];
+	yb[i]=(*func)(ndim,xp);
+      }
+      return 0;
+    }
+
+    /** \brief Record the first failure in a parallel region
+
+	This function is called from inside the parallel region, and
+	\ref report_failure() is called afterwards.
+    */
+    void record_failure(bool &failed, std::string &msg,
+			const std::string &new_msg) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (mcarlo_failure)
+#endif
+      {
+	if (failed==false) {
+	  failed=true;
+	  msg=new_msg;
+	}
+      }
+      return;
+    }
+
+    /** \brief If \c failed is true, call the error handler with
+	message \c msg
+    */
+    void report_failure(bool failed, const std::string &msg,
+			const std::string &fname) {
+      if (failed) {
+	std::string str=((std::string)"Integrand failed in ")+fname+
+	  ": "+msg;
+	O2SCL_ERR(str.c_str(),exc_efailed);
+      }
+      return;
+    }
+
+#endif
   
   };
 
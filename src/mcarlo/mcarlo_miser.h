@@ -317,7 +317,27 @@ namespace o2scl {
 	}
       }
 
-      for (i=0;i<dim;i++) {
+      estimate_sigma(xl,xu,vol,lxmid,lsigma_l,lsigma_r);
+      
+      res=vol*m;
+      
+      if (calls<2) {
+	err=GSL_POSINF;
+      } else {
+	err=vol*sqrt(q/(calls*(calls-1.0)));
+      }
+      
+      return success;
+    }
+
+    /** \brief Compute the variances on each side of the
+	bisection from the sums accumulated by the estimate
+    */
+    void estimate_sigma(const vec_t &xl, const vec_t &xu, double vol,
+			const ubvector &lxmid, ubvector &lsigma_l,
+			ubvector &lsigma_r) {
+      
+      for (size_t i=0;i<dim;i++) {
 	double fraction_l=(lxmid[i]-xl[i])/(xu[i]-xl[i]);
 
 	if (hits_l[i] > 0) {
@@ -332,6 +352,496 @@ namespace o2scl {
 	  lsigma_r[i]*=(1-fraction_l)*vol/hits_r[i];
 	}
       }
+
+      return;
+    }
+
+    /** \brief Choose the direction to bisect and distribute the 
+	remaining \c calls among the two halves
+
+	This uses the variances in \ref sigma_l and \ref sigma_r
+	and the midpoint in \ref xmid. If all of the estimates are
+	the same, the random number generator \c r is used to choose
+	the direction.
+    */
+    void select_bisection(rng_t &r, size_t calls, const vec_t &xl,
+			  const vec_t &xu, size_t &i_bisect,
+			  size_t &calls_l, size_t &calls_r) {
+      
+      size_t i;
+      int found_best;
+      double weight_l, weight_r;
+      
+      // [GSL] Now find direction with the smallest total "variance"
+
+      {
+	double best_var=GSL_DBL_MAX;
+	double beta=2.0/(1.0+alpha);
+	found_best=0;
+	i_bisect=0;
+	weight_l=weight_r=1.0;
+
+	for (i=0;i<dim;i++) {
+	  if (sigma_l[i] >= 0 && sigma_r[i] >= 0) {
+	    // [GSL] Estimates are okay 
+	    double var=pow (sigma_l[i], beta)+pow (sigma_r[i], beta);
+	    
+	    if (var <= best_var) {
+	      found_best=1;
+	      best_var=var;
+	      i_bisect=i;
+	      weight_l=pow (sigma_l[i], beta);
+	      weight_r=pow (sigma_r[i], beta);
+	      if (weight_l==0 && weight_r==0) {
+		weight_l=1;
+		weight_r=1;
+	      }
+	    }
+	  } else {
+	    if (sigma_l[i]<0) {
+	      O2SCL_ERR2("No points in left-half space ", 
+			     "in mcarlo_miser::miser_minteg_err().",
+			     exc_esanity);
+	    }
+	    if (sigma_r[i]<0) {
+	      O2SCL_ERR2("No points in right-half space ", 
+			     "in mcarlo_miser::miser_minteg_err().",
+			     exc_esanity);
+	    }
+	  }
+	}
+      }
+      
+      if (!found_best) {
+	// [GSL] All estimates were the same, so chose a direction at
+	// random
+	i_bisect=((int)(this->rng_dist(r)*(dim-1.0e-10)));
+	//std::uniform_int_distribution<int> int_dist(0,dim-1);
+	//i_bisect=int_dist(this->rng);
+	//gsl_rnga gr;
+	//i_bisect=gr.random_int(dim);
+      }
+
+      double xbi_l=xl[i_bisect];
+      double xbi_m=xmid[i_bisect];
+      double xbi_r=xu[i_bisect];
+
+      // [GSL] Get the actual fractional sizes of the two "halves", and
+      // distribute the remaining calls among them 
+      {
+	double fraction_l=fabs ((xbi_m-xbi_l)/(xbi_r-xbi_l));
+	double fraction_r=1-fraction_l;
+
+	double a=fraction_l*weight_l;
+	double b=fraction_r*weight_r;
+
+	calls_l=(size_t)(min_calls+(calls-2*min_calls)*a/(a+b));
+	calls_r=(size_t)(min_calls+(calls-2*min_calls)*b/(a+b));
+      }
+
+      return;
+    }
+
+    /** \brief Output the status of the integration at
+	bisection level \c level
+    */
+    void print_level(size_t level, size_t calls_l, size_t calls_r,
+		     size_t calls, double res_est, double err_est,
+		     size_t i_bisect, const vec_t &xl, const vec_t &xu) {
+      
+      if (this->verbose>0 && level<n_levels_out) {
+	std::cout << "mcarlo_miser: level,calls_l,calls_r,calls,min_calls_pb: " 
+	<< level << " " << calls_l << " " << calls_r << " " << calls << " "
+	<< min_calls_per_bisection << std::endl;
+	std::cout << "\tres,err: " << res_est << " " << err_est << std::endl;
+	if (this->verbose>1) {
+	  std::cout << "\ti,left,mid,right: " << i_bisect << " "
+		    << xl[i_bisect] << " " << xmid[i_bisect] << " "
+		    << xu[i_bisect] << std::endl;
+	  for(size_t j=0;j<dim;j++) {
+	    std::cout << "\t\ti,low,high: " << j << " " << xl[j] << " " << xu[j] 
+		      << std::endl;
+	  }
+	}
+	if (this->verbose>2) {
+	  char ch;
+	  std::cin >> ch;
+	}
+      }
+      
+      return;
+    }
+
+    /// The most recent integration point
+    vec_t x;
+
+    /** \brief Check the parameters and the integration limits
+     */
+    void check_args(const vec_t &xl, const vec_t &xu) {
+      
+      if (min_calls==0 || min_calls_per_bisection==0) {
+	O2SCL_ERR2("Variables min_calls or min_calls_per_bisection ",
+		       "are zero in mcarlo_miser::miser_minteg_err().",
+		       exc_einval);
+      }
+      
+      for (size_t i=0;i<dim;i++) {
+	if (xu[i] <= xl[i]) {
+	  std::string str="Upper limit, "+dtos(xu[i])+", must be greater "+
+	    "than lower limit, "+dtos(xl[i])+", in mcarlo_miser::"+
+	    "miser_minteg_err().";
+	  O2SCL_ERR(str.c_str(),exc_einval);
+	}
+	if (xu[i]-xl[i]>GSL_DBL_MAX) {
+	  O2SCL_ERR2("Range of integration is too large ",
+			 "in mcarlo_miser::miser_minteg_err().",exc_einval);
+	}
+      }
+
+      if (alpha<0) {
+	std::string str="Parameter alpha, "+dtos(alpha)+", must be non-"+
+	"negative in mcarlo_miser::mister_minteg_err().";
+	O2SCL_ERR(str.c_str(),exc_einval);
+      }
+
+      return;
+    }
+
+    /** \brief A region which is integrated by plain Monte Carlo
+	in the parallel sampling mode
+    */
+    class miser_leaf {
+    public:
+      /// Lower limits
+      ubvector xl;
+      /// Upper limits
+      ubvector xu;
+      /// Number of function calls
+      size_t calls;
+      /// Seed for the random number stream
+      unsigned long int seed;
+      /// Result
+      double res;
+      /// Uncertainty
+      double err;
+    };
+
+    /// The leaves in the parallel sampling mode
+    std::vector<miser_leaf> leaves;
+
+    /** \brief Integrate in the parallel sampling mode
+
+	The bisections are computed first, recording each region
+	which is to be integrated by plain Monte Carlo in \ref leaves,
+	and then the leaves are distributed over the threads.
+    */
+    int miser_para(func_t *func, mcarlo_batch_funct *bfunc, size_t ndim,
+		   const vec_t &xl, const vec_t &xu, size_t calls,
+		   double &res, double &err) {
+
+      leaves.clear();
+      unsigned long int seed=this->rng();
+      int ret=miser_tree(func,bfunc,ndim,xl,xu,calls,0,seed);
+      if (ret!=success) return ret;
+
+      size_t nt=1;
+#ifdef O2SCL_OPENMP
+      nt=this->n_threads;
+      if (nt==0) nt=1;
+#endif
+      
+      bool failed=false;
+      std::string err_msg;
+      size_t nl=leaves.size();
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+      for(size_t il=0;il<nl;il++) {
+
+	miser_leaf &lf=leaves[il];
+	size_t np=lf.calls;
+	
+	rng_t r;
+	r.set_seed(this->stream_seed(lf.seed,0));
+
+	double vol=1.0;
+	for (size_t i=0;i<dim;i++) {
+	  vol*=lf.xu[i]-lf.xl[i];
+	}
+	
+	ubvector xb(np*dim), yb(np);
+	vec_t lx(dim);
+	for(size_t n=0;n<np;n++) {
+	  for (size_t i=0;i<dim;i++) {
+	    double rdn=this->random_pos(r);
+	    xb[n*dim+i]=lf.xl[i]+rdn*(lf.xu[i]-lf.xl[i]);
+	  }
+	}
+
+	try {
+	  if (this->eval_block(func,bfunc,np,dim,xb,yb,lx)!=0) {
+	    this->record_failure(failed,err_msg,
+				 "Batch integrand returned non-zero.");
+	  }
+	} catch (std::exception &e) {
+	  this->record_failure(failed,err_msg,e.what());
+	}
+
+	double m=0.0, q=0.0;
+	for(size_t n=0;n<np;n++) {
+	  double d=yb[n]-m;
+	  m+=d/(n+1.0);
+	  q+=d*d*(n/(n+1.0));
+	}
+	
+	lf.res=vol*m;
+	lf.err=vol*sqrt(q/(np*(np-1.0)));
+      }
+
+      this->report_failure(failed,err_msg,
+			   "mcarlo_miser::miser_minteg_err()");
+
+      // Combine the leaves in order
+      double err2=0.0;
+      res=0.0;
+      for(size_t il=0;il<nl;il++) {
+	res+=leaves[il].res;
+	err2+=leaves[il].err*leaves[il].err;
+      }
+      err=sqrt(err2);
+      
+      return success;
+    }
+
+    /** \brief Compute the bisections for the parallel sampling mode
+
+	This function follows \ref miser_minteg_err(), except that the
+	random numbers for the region are taken from streams derived
+	from \c seed and the regions which are to be integrated by
+	plain Monte Carlo are stored in \ref leaves rather than
+	computed.
+    */
+    int miser_tree(func_t *func, mcarlo_batch_funct *bfunc, size_t ndim,
+		   const vec_t &xl, const vec_t &xu, size_t calls,
+		   size_t level, unsigned long int seed) {
+
+      size_t i;
+
+      if (calls<min_calls_per_bisection) {
+	
+	if (calls<2) {
+	  O2SCL_ERR2("Insufficient calls for subvolume ", 
+			 "in mcarlo_miser::miser_minteg_err().",exc_einval);
+	}
+
+	miser_leaf lf;
+	lf.xl.resize(dim);
+	lf.xu.resize(dim);
+	for (i=0;i<dim;i++) {
+	  lf.xl[i]=xl[i];
+	  lf.xu[i]=xu[i];
+	}
+	lf.calls=calls;
+	lf.seed=seed;
+	lf.res=0.0;
+	lf.err=0.0;
+	leaves.push_back(lf);
+	
+	return success;
+      }
+      
+      size_t prod=(size_t)(((double)calls)*estimate_frac);
+      size_t estimate_calls=(min_calls > prod ? min_calls : prod);
+      
+      if (estimate_calls<4*dim) {
+	O2SCL_ERR2("Insufficient calls to sample all halfspaces ", 
+		       "in mcarlo_miser::miser_minteg_err().",exc_esanity);
+      }
+
+      // The stream for the bisection in this region
+      rng_t r;
+      r.set_seed(this->stream_seed(seed,0));
+      
+      // [GSL] Flip coins to bisect the integration region with some fuzz 
+      for (i=0;i<dim;i++) {
+	double s=(this->rng_dist(r)-0.5) >= 0.0 ? dither : -dither;
+	xmid[i]=(0.5+s)*xl[i]+(0.5-s)*xu[i];
+      }
+
+      double res_est=0, err_est=0;
+      estimate_para(func,bfunc,xl,xu,estimate_calls,res_est,err_est,
+		    xmid,sigma_l,sigma_r,seed);
+      
+      calls-=estimate_calls;
+
+      size_t i_bisect, calls_l, calls_r;
+      select_bisection(r,calls,xl,xu,i_bisect,calls_l,calls_r);
+      double xbi_m=xmid[i_bisect];
+      
+      print_level(level,calls_l,calls_r,calls,res_est,err_est,i_bisect,xl,xu);
+
+      int status;
+      {
+	vec_t xu_tmp(dim);
+	for (i=0;i<dim;i++) {
+	  xu_tmp[i]=xu[i];
+	}
+	xu_tmp[i_bisect]=xbi_m;
+	status=miser_tree(func,bfunc,ndim,xl,xu_tmp,calls_l,level+1,
+			  this->stream_seed(seed,1));
+	if (status!=success) return status;
+      }
+      {
+	vec_t xl_tmp(dim);
+	for (i=0;i<dim;i++) {
+	  xl_tmp[i]=xl[i];
+	}
+	xl_tmp[i_bisect]=xbi_m;
+	status=miser_tree(func,bfunc,ndim,xl_tmp,xu,calls_r,level+1,
+			  this->stream_seed(seed,2));
+	if (status!=success) return status;
+      }
+      
+      return success;
+    }
+    
+    /** \brief Estimate the variance in the parallel sampling mode
+
+	This is the same as \ref estimate_corrmc(), except that the
+	points are divided into blocks, each with its own random
+	number stream derived from \c seed, and the blocks are
+	combined in order.
+    */
+    void estimate_para(func_t *func, mcarlo_batch_funct *bfunc,
+		       const vec_t &xl, const vec_t &xu, size_t calls,
+		       double &res, double &err, const ubvector &lxmid,
+		       ubvector &lsigma_l, ubvector &lsigma_r,
+		       unsigned long int seed) {
+      
+      size_t i;
+      double vol=1.0;
+      for (i=0;i<dim;i++) {
+	vol*=xu[i]-xl[i];
+	hits_l[i]=hits_r[i]=0;
+	fsum_l[i]=fsum_r[i]=0.0;
+	fsum2_l[i]=fsum2_r[i]=0.0;
+	lsigma_l[i]=lsigma_r[i]=-1;
+      }
+
+      size_t bs=this->block_size;
+      if (bs==0) bs=1;
+      size_t nblock=(calls+bs-1)/bs;
+
+      // For each block, the number of points, the mean and the sum
+      // of squared deviations, followed by the sums for each
+      // dimension
+      size_t nstat=3+6*dim;
+      std::vector<double> st(nblock*nstat);
+
+      size_t nt=1;
+#ifdef O2SCL_OPENMP
+      nt=this->n_threads;
+      if (nt==0) nt=1;
+#endif
+      
+      bool failed=false;
+      std::string err_msg;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+      for(size_t ib=0;ib<nblock;ib++) {
+
+	size_t n0=ib*bs;
+	size_t n1=n0+bs;
+	if (n1>calls) n1=calls;
+	size_t np=n1-n0;
+
+	rng_t r;
+	r.set_seed(this->stream_seed(seed,ib+3));
+
+	ubvector xb(np*dim), yb(np);
+	vec_t lx(dim);
+	for(size_t n=n0;n<n1;n++) {
+	  unsigned int j=(n/2) % dim;
+	  unsigned int side=(n % 2);
+	  double *lxb=&(xb[(n-n0)*dim]);
+	  for (size_t k=0;k<dim;k++) {
+	    double z=this->random_pos(r);
+	    if (k != j) {
+	      lxb[k]=xl[k]+z*(xu[k]-xl[k]);
+	    } else {
+	      if (side == 0) {
+		lxb[k]=lxmid[k]+z*(xu[k]-lxmid[k]);
+	      } else {
+		lxb[k]=xl[k]+z*(lxmid[k]-xl[k]);
+	      }
+	    }
+	  }
+	}
+	
+	try {
+	  if (this->eval_block(func,bfunc,np,dim,xb,yb,lx)!=0) {
+	    this->record_failure(failed,err_msg,
+				 "Batch integrand returned non-zero.");
+	  }
+	} catch (std::exception &e) {
+	  this->record_failure(failed,err_msg,e.what());
+	}
+
+	double *lst=&(st[ib*nstat]);
+	for(size_t k=0;k<nstat;k++) lst[k]=0.0;
+	lst[0]=np;
+	double m=0.0, q=0.0;
+	for(size_t n=0;n<np;n++) {
+	  double fval=yb[n];
+	  double d=fval-m;
+	  m+=d/(n+1.0);
+	  q+=d*d*(n/(n+1.0));
+	  for (size_t k=0;k<dim;k++) {
+	    double *lk=&(lst[3+6*k]);
+	    if (xb[n*dim+k] <= lxmid[k]) {
+	      lk[0]+=fval;
+	      lk[1]+=fval*fval;
+	      lk[2]+=1.0;
+	    } else {
+	      lk[3]+=fval;
+	      lk[4]+=fval*fval;
+	      lk[5]+=1.0;
+	    }
+	  }
+	}
+	lst[1]=m;
+	lst[2]=q;
+      }
+
+      this->report_failure(failed,err_msg,
+			   "mcarlo_miser::miser_minteg_err()");
+      
+      // Combine the blocks in order, using the pairwise update
+      // for the mean and the sum of squared deviations
+      double m=0.0, q=0.0, nsum=0.0;
+      for(size_t ib=0;ib<nblock;ib++) {
+	double *lst=&(st[ib*nstat]);
+	double nb=lst[0];
+	double ntot=nsum+nb;
+	double d=lst[1]-m;
+	m+=d*nb/ntot;
+	q+=lst[2]+d*d*nsum*nb/ntot;
+	nsum=ntot;
+	for (size_t k=0;k<dim;k++) {
+	  double *lk=&(lst[3+6*k]);
+	  fsum_l[k]+=lk[0];
+	  fsum2_l[k]+=lk[1];
+	  hits_l[k]+=((size_t)lk[2]);
+	  fsum_r[k]+=lk[3];
+	  fsum2_r[k]+=lk[4];
+	  hits_r[k]+=((size_t)lk[5]);
+	}
+      }
+      
+      estimate_sigma(xl,xu,vol,lxmid,lsigma_l,lsigma_r);
       
       res=vol*m;
       
@@ -341,12 +851,8 @@ namespace o2scl {
 	err=vol*sqrt(q/(calls*(calls-1.0)));
       }
       
-      return success;
+      return;
     }
-
-    /// The most recent integration point
-    vec_t x;
-
 #endif
     
     public:
@@ -405,48 +911,30 @@ namespace o2scl {
 	function. The default values if not set are 100 and 3000
 	respectively, which correspond to the GSL default setting
 	for a 6 dimensional problem. 
+
+	If \ref mcarlo::n_threads is larger than one and \c level is
+	zero, then the parallel sampling mode is used.
     */
     virtual int miser_minteg_err(func_t &func, size_t ndim, const vec_t &xl, 
 				 const vec_t &xu, size_t calls, size_t level,
 				 double &res, double &err) {
 
-      if (min_calls==0 || min_calls_per_bisection==0) {
-	O2SCL_ERR2("Variables min_calls or min_calls_per_bisection ",
-		       "are zero in mcarlo_miser::miser_minteg_err().",
-		       exc_einval);
-      }
-      
+      check_args(xl,xu);
+
       size_t n, estimate_calls, calls_l, calls_r;
       size_t i;
       size_t i_bisect;
-      int found_best;
 
       double res_est=0, err_est=0;
       double res_r=0, err_r=0, res_l=0, err_l=0;
-      double xbi_l, xbi_m, xbi_r, s;
+      double xbi_m, s;
 
       double vol;
-      double weight_l, weight_r;
 
-      for (i=0;i<dim;i++) {
-	if (xu[i] <= xl[i]) {
-	  std::string str="Upper limit, "+dtos(xu[i])+", must be greater "+
-	    "than lower limit, "+dtos(xl[i])+", in mcarlo_miser::"+
-	    "miser_minteg_err().";
-	  O2SCL_ERR(str.c_str(),exc_einval);
-	}
-	if (xu[i]-xl[i]>GSL_DBL_MAX) {
-	  O2SCL_ERR2("Range of integration is too large ",
-			 "in mcarlo_miser::miser_minteg_err().",exc_einval);
-	}
+      if (level==0 && this->n_threads>1) {
+	return miser_para(&func,0,ndim,xl,xu,calls,res,err);
       }
-
-      if (alpha<0) {
-	std::string str="Parameter alpha, "+dtos(alpha)+", must be non-"+
-	"negative in mcarlo_miser::mister_minteg_err().";
-	O2SCL_ERR(str.c_str(),exc_einval);
-      }
-
+      
       /* [GSL] Compute volume */
 
       vol=1;
@@ -527,91 +1015,10 @@ namespace o2scl {
 
       calls -= estimate_calls;
 
-      // [GSL] Now find direction with the smallest total "variance"
-
-      {
-	double best_var=GSL_DBL_MAX;
-	double beta=2.0/(1.0+alpha);
-	found_best=0;
-	i_bisect=0;
-	weight_l=weight_r=1.0;
-
-	for (i=0;i<dim;i++) {
-	  if (sigma_l[i] >= 0 && sigma_r[i] >= 0) {
-	    // [GSL] Estimates are okay 
-	    double var=pow (sigma_l[i], beta)+pow (sigma_r[i], beta);
-	    
-	    if (var <= best_var) {
-	      found_best=1;
-	      best_var=var;
-	      i_bisect=i;
-	      weight_l=pow (sigma_l[i], beta);
-	      weight_r=pow (sigma_r[i], beta);
-	      if (weight_l==0 && weight_r==0) {
-		weight_l=1;
-		weight_r=1;
-	      }
-	    }
-	  } else {
-	    if (sigma_l[i]<0) {
-	      O2SCL_ERR2("No points in left-half space ", 
-			     "in mcarlo_miser::miser_minteg_err().",
-			     exc_esanity);
-	    }
-	    if (sigma_r[i]<0) {
-	      O2SCL_ERR2("No points in right-half space ", 
-			     "in mcarlo_miser::miser_minteg_err().",
-			     exc_esanity);
-	    }
-	  }
-	}
-      }
-      
-      if (!found_best) {
-	// [GSL] All estimates were the same, so chose a direction at
-	// random
-	i_bisect=((int)(this->rng_dist(this->rng)*(dim-1.0e-10)));
-	//std::uniform_int_distribution<int> int_dist(0,dim-1);
-	//i_bisect=int_dist(this->rng);
-	//gsl_rnga gr;
-	//i_bisect=gr.random_int(dim);
-      }
-
-      xbi_l=xl[i_bisect];
+      select_bisection(this->rng,calls,xl,xu,i_bisect,calls_l,calls_r);
       xbi_m=xmid[i_bisect];
-      xbi_r=xu[i_bisect];
 
-      // [GSL] Get the actual fractional sizes of the two "halves", and
-      // distribute the remaining calls among them 
-      {
-	double fraction_l=fabs ((xbi_m-xbi_l)/(xbi_r-xbi_l));
-	double fraction_r=1-fraction_l;
-
-	double a=fraction_l*weight_l;
-	double b=fraction_r*weight_r;
-
-	calls_l=(size_t)(min_calls+(calls-2*min_calls)*a/(a+b));
-	calls_r=(size_t)(min_calls+(calls-2*min_calls)*b/(a+b));
-      }
-
-      if (this->verbose>0 && level<n_levels_out) {
-	std::cout << "mcarlo_miser: level,calls_l,calls_r,calls,min_calls_pb: " 
-	<< level << " " << calls_l << " " << calls_r << " " << calls << " "
-	<< min_calls_per_bisection << std::endl;
-	std::cout << "\tres,err: " << res_est << " " << err_est << std::endl;
-	if (this->verbose>1) {
-	  std::cout << "\ti,left,mid,right: " << i_bisect << " "
-		    << xbi_l << " " << xbi_m << " " << xbi_r << std::endl;
-	  for(size_t j=0;j<dim;j++) {
-	    std::cout << "\t\ti,low,high: " << j << " " << xl[j] << " " << xu[j] 
-		      << std::endl;
-	  }
-	}
-	if (this->verbose>2) {
-	  char ch;
-	  std::cin >> ch;
-	}
-      }
+      print_level(level,calls_l,calls_r,calls,res_est,err_est,i_bisect,xl,xu);
 
       /* [GSL] Compute the integral for the left hand side of the
 	 bisection. Due to the recursive nature of the algorithm we must
@@ -664,6 +1071,21 @@ namespace o2scl {
       return 0;
     }
     
+    /** \brief Integrate the batch integrand \c bfunc over the
+	hypercube from \f$ x_i=\mathrm{xl}_i \f$ to 
+	\f$ x_i=\mathrm{xu}_i \f$ using the parallel sampling mode
+
+	The values of \ref min_calls and \ref min_calls_per_bisection
+	should be set as in \ref miser_minteg_err().
+    */
+    virtual int miser_minteg_batch_err(mcarlo_batch_funct &bfunc,
+				       size_t ndim, const vec_t &xl, 
+				       const vec_t &xu, size_t calls,
+				       double &res, double &err) {
+      check_args(xl,xu);
+      return miser_para(0,&bfunc,ndim,xl,xu,calls,res,err);
+    }
+    
     /** \brief Integrate function \c func from x=a to x=b.
 
 	This function is just a wrapper to miser_minteg_err() which
@@ -685,6 +1107,24 @@ namespace o2scl {
       return ret;
     }
     
+    /** \brief Integrate the batch integrand \c bfunc from x=a to x=b
+	using the parallel sampling mode
+
+	This function sets \c min_calls and \c min_calls_per_bisection
+	in the same way as \ref minteg_err().
+    */
+    virtual int minteg_batch_err(mcarlo_batch_funct &bfunc, size_t ndim,
+				 const vec_t &a, const vec_t &b, double &res,
+				 double &err) {
+      if (ndim!=dim) allocate(ndim);
+      min_calls=calls_per_dim*ndim;
+      min_calls_per_bisection=bisection_ratio*min_calls;
+      int ret=miser_minteg_batch_err(bfunc,ndim,a,b,this->n_points,res,err);
+      min_calls=0;
+      min_calls_per_bisection=0;
+      return ret;
+    }
+    
     /** \brief Integrate function \c func over the hypercube from
 	\f$ x_i=a_i \f$ to \f$ x_i=b_i \f$ for
 	\f$ 0<i< \f$ ndim-1
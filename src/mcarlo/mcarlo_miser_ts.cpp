@@ -39,6 +39,14 @@ double test_fun(size_t nv, const ubvector &x) {
   return y;
 }
 
+int test_fun_batch(size_t np, size_t nv, const ubvector &x, ubvector &y) {
+  for(size_t i=0;i<np;i++) {
+    y[i]=1.0/(1.0-cos(x[i*nv])*cos(x[i*nv+1])*cos(x[i*nv+2]))/
+      M_PI/M_PI/M_PI;
+  }
+  return 0;
+}
+
 double g(double *k, size_t dim, void *params) {
   return 1.0/(1.0-cos(k[0])*cos(k[1])*cos(k[2]))/M_PI/M_PI/M_PI;
 }
@@ -109,6 +117,40 @@ int main(void) {
     t.test_rel(res1,res2,1.0e-9,"O2SCL vs. GSL");
   }
 
+  // Parallel sampling mode, for which the results do not depend
+  // on the number of threads and the batch integrand gives the same
+  // result as the ordinary integrand
+  {
+    ubvector a(3), b(3);
+    a[0]=0.0;
+    a[1]=0.0;
+    a[2]=0.0;
+    b[0]=M_PI;
+    b[1]=M_PI;
+    b[2]=M_PI;
+
+    multi_funct tf=test_fun;
+    mcarlo_batch_funct tfb=test_fun_batch;
+
+    double res, err, res2, err2;
+    {
+      mcarlo_miser<> gm;
+      gm.n_points=100000;
+      gm.minteg_batch_err(tfb,3,a,b,res,err);
+      cout << "Batch res,exact,err,rel: " 
+	   << res << " " << exact << " " << err << " " 
+	   << fabs(res-exact)/err << endl;
+      t.test_rel(res,exact,err*10.0,"batch");
+    }
+    {
+      mcarlo_miser<> gm;
+      gm.n_points=100000;
+      gm.n_threads=3;
+      gm.minteg_err(tf,3,a,b,res2,err2);
+      t.test_gen(res==res2 && err==err2,"threads");
+    }
+  }
+
   t.report();
  
   return 0;
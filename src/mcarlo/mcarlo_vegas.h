@@ -301,6 +301,17 @@ namespace o2scl {
     void random_point(vec_t &lx, ubvector_int &lbin, double &bin_vol,
 		      const ubvector_int &lbox, const vec_t &xl, 
 		      const vec_t &xu) {
+      random_point(this->rng,lx,lbin,bin_vol,lbox,xl,xu);
+      return;
+    }
+    
+    /** \brief Generate a random position in a given box using
+	the random number generator \c r
+    */
+    template<class vec2_t, class vec_int_t>
+    void random_point(rng_t &r, vec2_t &lx, vec_int_t &lbin,
+		      double &bin_vol, const ubvector_int &lbox,
+		      const vec_t &xl, const vec_t &xu) {
 
       double lvol=1.0;
 
@@ -311,7 +322,7 @@ namespace o2scl {
 	// The equivalent of gsl_rng_uniform_pos()
 	double rdn;
 	do { 
-	  rdn=this->rng_dist(this->rng);
+	  rdn=this->rng_dist(r);
 	} while (rdn==0);
 	
 	/* lbox[j] + ran gives the position in the box units, while z
@@ -552,65 +563,161 @@ namespace o2scl {
     /// Point for function evaluation
     vec_t x;
 
+    /** \brief Sample all of the boxes for one iteration in the
+	parallel sampling mode
+
+	The distribution \ref d must be reset before calling this
+	function. The integral and the sum of the variances over all
+	boxes are returned in \c intgrl and \c tss. The boxes are
+	divided into blocks of consecutive boxes, each with its own
+	random number stream derived from \c iseed, and the blocks are
+	combined in order.
+    */
+    void sample_para(func_t *func, mcarlo_batch_funct *bfunc,
+		     const vec_t &xl, const vec_t &xu, double jacbin,
+		     unsigned long int iseed, double &intgrl, double &tss) {
+
+      size_t cpb=calls_per_box;
+      size_t nbox=1;
+      for(size_t j=0;j<dim;j++) nbox*=boxes;
+
+      // Number of boxes in each block and the number of blocks
+      size_t bpb=this->block_size/cpb;
+      if (bpb==0) bpb=1;
+      size_t nblock=(nbox+bpb-1)/bpb;
+
+      size_t nt=1;
+#ifdef O2SCL_OPENMP
+      nt=this->n_threads;
+      if (nt==0) nt=1;
 #endif
 
-    public:
+      // The blocks are processed in rounds to limit the storage
+      // for the distributions from each block
+      size_t nround=4*nt;
+      size_t nd=bins*dim;
+      std::vector<double> int_b(nround), tss_b(nround);
+      std::vector<double> d_b(nround*nd);
 
-    mcarlo_vegas() {
-      this->verbose=0;
-      outs=&std::cout;
-      alpha=1.5;
-      iterations=5;
-      mode=mode_importance;
-      chisq=0;
-      bins=bins_max;
-      dim=0;
-    }
-    
-    /// Allocate memory
-    virtual int allocate(size_t ldim) {
+      bool failed=false;
+      std::string err_msg;
+      
+      intgrl=0.0;
+      tss=0.0;
+      
+      for(size_t ib0=0;ib0<nblock && failed==false;ib0+=nround) {
+	
+	size_t ib1=ib0+nround;
+	if (ib1>nblock) ib1=nblock;
+	
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+	for(size_t ib=ib0;ib<ib1;ib++) {
 
-      delx.resize(ldim);
-      d.resize(bins_max*ldim);
-      xi.resize((bins_max+1)*ldim);
-      xin.resize(bins_max+1);
-      weight.resize(bins_max);
-      box.resize(ldim);
-      bin.resize(ldim);
-      x.resize(ldim);
+	  size_t ir=ib-ib0;
+	  size_t b0=ib*bpb;
+	  size_t b1=b0+bpb;
+	  if (b1>nbox) b1=nbox;
+	  size_t np=(b1-b0)*cpb;
 
-      dim=ldim;
+	  rng_t r;
+	  r.set_seed(this->stream_seed(iseed,ib));
+	  
+	  ubvector xb(np*dim), yb(np), vb(np);
+	  std::vector<int> binb(np*dim);
+	  ubvector_int lbox(dim);
+	  vec_t lx(dim);
+
+	  // The coordinates of the first box
+	  size_t rem=b0;
+	  for(size_t j=dim;j>0;j--) {
+	    lbox[j-1]=rem % boxes;
+	    rem/=boxes;
+	  }
 
-      return 0;
-    }
+	  // Generate the points
+	  size_t ip=0;
+	  for(size_t ibox=b0;ibox<b1;ibox++) {
+	    for(size_t k=0;k<cpb;k++) {
+	      int *lbin=&(binb[ip*dim]);
+	      random_point(r,lx,lbin,vb[ip],lbox,xl,xu);
+	      for(size_t j=0;j<dim;j++) xb[ip*dim+j]=lx[j];
+	      ip++;
+	    }
+	    change_box_coord(lbox);
+	  }
 
-    /** \brief Integrate function \c func from x=a to x=b.
+	  // Evaluate the integrand
+	  try {
+	    if (this->eval_block(func,bfunc,np,dim,xb,yb,lx)!=0) {
+	      this->record_failure(failed,err_msg,
+				   "Batch integrand returned non-zero.");
+	    }
+	  } catch (std::exception &e) {
+	    this->record_failure(failed,err_msg,e.what());
+	  }
 
-	Original documentation from GSL:
+	  // Accumulate the results for each box
+	  double *ld=&(d_b[ir*nd]);
+	  for(size_t j=0;j<nd;j++) ld[j]=0.0;
+	  int_b[ir]=0.0;
+	  tss_b[ir]=0.0;
+	  ip=0;
+	  for(size_t ibox=b0;ibox<b1;ibox++) {
+	    volatile double m=0, q=0;
+	    for(size_t k=0;k<cpb;k++) {
+	      double fval=yb[ip]*jacbin*vb[ip];
+	      double dt=fval-m;
+	      m+=dt/(k+1.0);
+	      q+=dt*dt*(k/(k+1.0));
+	      if (mode != mode_stratified) {
+		for(size_t j=0;j<dim;j++) {
+		  ld[binb[ip*dim+j]*dim+j]+=fval*fval;
+		}
+	      }
+	      ip++;
+	    }
+	    int_b[ir]+=m*cpb;
+	    double f_sq_sum=q*cpb;
+	    tss_b[ir]+=f_sq_sum;
+	    if (mode == mode_stratified) {
+	      for(size_t j=0;j<dim;j++) {
+		ld[binb[(ip-1)*dim+j]*dim+j]+=f_sq_sum;
+	      }
+	    }
+	  }
+	}
+
+	// Combine the blocks in order
+	for(size_t ib=ib0;ib<ib1;ib++) {
+	  size_t ir=ib-ib0;
+	  intgrl+=int_b[ir];
+	  tss+=tss_b[ir];
+	  for(size_t j=0;j<nd;j++) d[j]+=d_b[ir*nd+j];
+	}
 	
-	Normally, <tt>stage = 0</tt> which begins with a new uniform
-	grid and empty weighted average. Calling vegas with <tt>stage
-	= 1</tt> retains the grid from the previous run but discards
-	the weighted average, so that one can "tune" the grid using a
-	relatively small number of points and then do a large run with
-	<tt>stage = 1</tt> on the optimized grid. Setting <tt>stage =
-	2</tt> keeps the grid and the weighted average from the
-	previous run, but may increase (or decrease) the number of
-	histogram bins in the grid depending on the number of calls
-	available. Choosing <tt>stage = 3</tt> enters at the main
-	loop, so that nothing is changed, and is equivalent to
-	performing additional iterations in a previous call.
+      }
 
-	\todo Should stage be passed by reference?
-	\todo There was an update between gsl-1.12 and 1.15 which
-	has not been implemented here yet.
+      this->report_failure(failed,err_msg,
+			   "mcarlo_vegas::vegas_minteg_err()");
+      
+      return;
+    }
+
+    /** \brief Integrate \c func or, if \c bfunc is not zero,
+	the batch integrand \c bfunc
     */
-    virtual int vegas_minteg_err(int stage, func_t &func, size_t ndim, 
-				 const vec_t &xl, const vec_t &xu, 
-				 double &res, double &err) {
+    virtual int vegas_impl(int stage, func_t *func,
+			   mcarlo_batch_funct *bfunc, size_t ndim, 
+			   const vec_t &xl, const vec_t &xu, 
+			   double &res, double &err) {
 
       size_t calls=this->n_points;
 
+      // Use the parallel sampling mode
+      bool para=(this->n_threads>1 || bfunc!=0);
+
       double cum_int, cum_sig;
       size_t i, k, it;
 	
@@ -713,45 +820,55 @@ namespace o2scl {
 	it_num=it_start+it;
 
 	reset_grid_values();
-	init_box_coord(box);
 
-	do {
-	  volatile double m=0, q=0;
-	  double f_sq_sum=0.0;
+	if (para) {
+
+	  unsigned long int iseed=this->rng();
+	  sample_para(func,bfunc,xl,xu,jacbin,iseed,intgrl,tss);
+
+	} else {
 
-	  for (k=0;k<lcalls_per_box;k++) {
-	    double fval, bin_vol;
+	  init_box_coord(box);
+
+	  do {
+	    volatile double m=0, q=0;
+	    double f_sq_sum=0.0;
+
+	    for (k=0;k<lcalls_per_box;k++) {
+	      double fval, bin_vol;
 	    
-	    random_point(x,bin,bin_vol,box,xl,xu);
+	      random_point(x,bin,bin_vol,box,xl,xu);
 	    
-	    fval=func(dim,x);
-	    fval*=jacbin*bin_vol;
+	      fval=(*func)(dim,x);
+	      fval*=jacbin*bin_vol;
 
-	    /* recurrence for mean and variance (sum of squares) */
+	      /* recurrence for mean and variance (sum of squares) */
 
-	    {
-	      double dt=fval-m;
-	      m+=dt/(k+1.0);
-	      q+=dt*dt*(k/(k+1.0));
-	    }
+	      {
+		double dt=fval-m;
+		m+=dt/(k+1.0);
+		q+=dt*dt*(k/(k+1.0));
+	      }
 
-	    if (mode != mode_stratified) {
-	      double f_sq=fval*fval;
-	      accumulate_distribution(bin,f_sq);
+	      if (mode != mode_stratified) {
+		double f_sq=fval*fval;
+		accumulate_distribution(bin,f_sq);
+	      }
 	    }
-	  }
 
-	  intgrl+=m*lcalls_per_box;
+	    intgrl+=m*lcalls_per_box;
 
-	  f_sq_sum=q*lcalls_per_box;
+	    f_sq_sum=q*lcalls_per_box;
 
-	  tss+=f_sq_sum;
+	    tss+=f_sq_sum;
 
-	  if (mode == mode_stratified) {
-	    accumulate_distribution (bin, f_sq_sum);
-	  }
+	    if (mode == mode_stratified) {
+	      accumulate_distribution (bin, f_sq_sum);
+	    }
+
+	  } while (change_box_coord(box));
 
-	} while (change_box_coord(box));
+	}
 
 	/* Compute final results for this iteration   */
 	
@@ -838,6 +955,77 @@ namespace o2scl {
 
       return GSL_SUCCESS;
     }
+#endif
+
+    public:
+
+    mcarlo_vegas() {
+      this->verbose=0;
+      outs=&std::cout;
+      alpha=1.5;
+      iterations=5;
+      mode=mode_importance;
+      chisq=0;
+      bins=bins_max;
+      dim=0;
+    }
+    
+    /// Allocate memory
+    virtual int allocate(size_t ldim) {
+
+      delx.resize(ldim);
+      d.resize(bins_max*ldim);
+      xi.resize((bins_max+1)*ldim);
+      xin.resize(bins_max+1);
+      weight.resize(bins_max);
+      box.resize(ldim);
+      bin.resize(ldim);
+      x.resize(ldim);
+
+      dim=ldim;
+
+      return 0;
+    }
+
+    /** \brief Integrate function \c func from x=a to x=b.
+
+	Original documentation from GSL:
+	
+	Normally, <tt>stage = 0</tt> which begins with a new uniform
+	grid and empty weighted average. Calling vegas with <tt>stage
+	= 1</tt> retains the grid from the previous run but discards
+	the weighted average, so that one can "tune" the grid using a
+	relatively small number of points and then do a large run with
+	<tt>stage = 1</tt> on the optimized grid. Setting <tt>stage =
+	2</tt> keeps the grid and the weighted average from the
+	previous run, but may increase (or decrease) the number of
+	histogram bins in the grid depending on the number of calls
+	available. Choosing <tt>stage = 3</tt> enters at the main
+	loop, so that nothing is changed, and is equivalent to
+	performing additional iterations in a previous call.
+
+	\todo Should stage be passed by reference?
+	\todo There was an update between gsl-1.12 and 1.15 which
+	has not been implemented here yet.
+    */
+    virtual int vegas_minteg_err(int stage, func_t &func, size_t ndim, 
+				 const vec_t &xl, const vec_t &xu, 
+				 double &res, double &err) {
+      return vegas_impl(stage,&func,0,ndim,xl,xu,res,err);
+    }
+
+    /** \brief Integrate the batch integrand \c bfunc from x=a to x=b
+	using the parallel sampling mode
+
+	The parameter \c stage has the same meaning as in
+	\ref vegas_minteg_err().
+    */
+    virtual int vegas_minteg_batch_err(int stage, mcarlo_batch_funct &bfunc,
+				       size_t ndim, const vec_t &xl,
+				       const vec_t &xu, double &res,
+				       double &err) {
+      return vegas_impl(stage,0,&bfunc,ndim,xl,xu,res,err);
+    }
 
     virtual ~mcarlo_vegas() {}
   
@@ -851,6 +1039,19 @@ namespace o2scl {
       return ret;
     }
     
+    /** \brief Integrate the batch integrand \c bfunc from x=a to x=b
+	using the parallel sampling mode
+    */
+    virtual int minteg_batch_err(mcarlo_batch_funct &bfunc, size_t ndim,
+				 const vec_t &a, const vec_t &b, double &res,
+				 double &err) {
+      allocate(ndim);
+      chisq=0;
+      bins=bins_max;
+      int ret=vegas_minteg_batch_err(0,bfunc,ndim,a,b,res,err);
+      return ret;
+    }
+    
     /** \brief Integrate function \c func over the hypercube from
 	\f$ x_i=a_i \f$ to \f$ x_i=b_i \f$ for
 	\f$ 0<i< \f$ ndim-1
@@ -40,6 +40,14 @@ double test_fun(size_t nv, const ubvector &x) {
   return y;
 }
 
+int test_fun_batch(size_t np, size_t nv, const ubvector &x, ubvector &y) {
+  for(size_t i=0;i<np;i++) {
+    y[i]=1.0/(1.0-cos(x[i*nv])*cos(x[i*nv+1])*cos(x[i*nv+2]))/
+      M_PI/M_PI/M_PI+0.1;
+  }
+  return 0;
+}
+
 double test_fun_gsl(double *k, size_t dim, void *params) {
   // We make a small shift by 0.1 to avoid integrands which
   // are small everywhere
@@ -161,6 +169,42 @@ int main(void) {
     gm.minteg_err(tf,3,a,b,res,err);
   }
   
+  // Parallel sampling mode, for which the results do not depend
+  // on the number of threads and the batch integrand gives the same
+  // result as the ordinary integrand
+  {
+    ubvector a(3), b(3);
+    a[0]=0.0;
+    a[1]=0.0;
+    a[2]=0.0;
+    b[0]=M_PI;
+    b[1]=M_PI;
+    b[2]=M_PI;
+
+    multi_funct tf=test_fun;
+    mcarlo_batch_funct tfb=test_fun_batch;
+
+    double res, err, res2, err2;
+    {
+      mcarlo_vegas<> gm;
+      gm.n_points=100000;
+      gm.minteg_batch_err(tfb,3,a,b,res,err);
+      res-=0.1*pow(M_PI,3.0);
+      cout << "Batch res,exact,err,rel: " 
+	   << res << " " << exact << " " << err << " " 
+	   << fabs(res-exact)/err << endl;
+      t.test_rel(res,exact,err*10.0,"batch");
+    }
+    {
+      mcarlo_vegas<> gm;
+      gm.n_points=100000;
+      gm.n_threads=3;
+      gm.minteg_err(tf,3,a,b,res2,err2);
+      res2-=0.1*pow(M_PI,3.0);
+      t.test_gen(res==res2 && err==err2,"threads");
+    }
+  }
+
   t.report();
   
   return 0;
@@ -32,6 +32,10 @@
 
 #ifdef O2SCL_OPENMP
 #include <omp.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #endif
 #ifdef O2SCL_MPI
 #include <mpi.h>
@@ -42,6 +46,7 @@
 #include <o2scl/uniform_grid.h>
 #include <o2scl/table3d.h>
 #include <o2scl/hdf_file.h>
+#include <o2scl/hdf_io.h>
 #include <o2scl/exception.h>
 #include <o2scl/prob_dens_func.h>
 #include <o2scl/vector.h>
@@ -1536,12 +1541,15 @@ namespace o2scl {
     }
     
     last_write_iters=0;
+    last_write_row=0;
 #ifdef O2SCL_MPI
     last_write_time=MPI_Wtime();
 #else
     last_write_time=time(0);
 #endif
 
+    async_start();
+
     return parent_t::mcmc_init();
   }
   
@@ -1609,40 +1617,117 @@ namespace o2scl {
       file write() (default 0.0)
   */
   double last_write_time;
-  
-  public:
 
-  /** \brief If true, ensure sure walkers and OpenMP threads are
-      written to the table with equal spacing between rows (default
-      true)
-   */
-  bool table_sequence;
-  
-  /** \brief Iterations between file updates (default 0 for no file updates)
-   */
-  size_t file_update_iters;
-  
-  /** \brief Time between file updates (default 0.0 for no file updates)
-   */
-  double file_update_time;
-  
-  /** \brief The number of tables to combine before I/O (default 1)
-   */
-  int table_io_chunk;
-  
-  /** \brief Write MCMC tables to files
-   */
-  virtual void write_files(bool sync_write=false) {
+  /** \brief The first row of the table which is written in the
+      next call to \ref write_files() when \ref append_output is true
+  */
+  size_t last_write_row;
 
-    if (this->verbose>=2) {
-      this->scr_out << "mcmc: Start write_files(). mpi_rank: "
-		    << this->mpi_rank << " mpi_size: "
-		    << this->mpi_size <<  " table_io_chunk: "
-		    << table_io_chunk << std::endl;
+  /** \brief Return the number of rows at the beginning of the table
+      which can no longer be modified by the sampler
+
+      Each walker only writes to rows after the last row it
+      accepted, and only modifies the multiplier of that row, so
+      all rows before the earliest such row are final.
+  */
+  size_t final_rows() {
+    size_t row=table->get_nlines();
+    for(size_t i=0;i<walker_accept_rows.size();i++) {
+      if (walker_accept_rows[i]<0) {
+	// The first point for this walker is stored in row 'i'
+	if (i<row) row=i;
+      } else if (((size_t)walker_accept_rows[i])<row) {
+	row=walker_accept_rows[i];
+      }
+    }
+    return row;
+  }
+
+  /** \brief Copy the rows beginning with \c row_start from the
+      main table to \c tail
+  */
+  void copy_tail(size_t row_start, o2scl::table_units<> &tail) {
+    tail.clear();
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      std::string col=table->get_column_name(i);
+      tail.new_column(col);
+      tail.set_unit(col,table->get_unit(col));
+    }
+    size_t n_tail=table->get_nlines()-row_start;
+    tail.set_nlines(n_tail);
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      const std::vector<double> &col=table->get_column
+	(table->get_column_name(i));
+      for(size_t j=0;j<n_tail;j++) {
+	tail.set(i,j,col[row_start+j]);
+      }
     }
+    return;
+  }
+
+  /** \brief The data for one call to \ref write_files()
+   */
+  class write_batch {
     
+  public:
+    
+    /// \name Copies of the small objects written to the file
+    //@{
+    std::vector<size_t> n_accept;
+    std::vector<size_t> n_reject;
+    std::vector<std::vector<size_t> > ret_value_counts;
+    std::vector<ubvector> initial_points;
+    //@}
+
+    /// If true, write the tables with \ref o2scl_hdf::hdf_output_append()
+    bool append;
+    
+    /** \brief If true, the main table was sent to another rank
+	and is not written
+    */
+    bool rank_sent;
+    
+    /** \brief The main table, or a copy of its new rows
+     */
+    std::shared_ptr<o2scl::table_units<> > tab;
+    
+    /// The first row of \c tab which is written
+    size_t row_start;
+    
+    /// The row in the file which corresponds to the first row of \c tab
+    size_t file_offset;
+    
+    /// Tables received from the child ranks
     std::vector<o2scl::table_units<> > tab_arr;
-    bool rank_sent=false;
+    
+    /// The row in the file which corresponds to the first row of each table
+    std::vector<size_t> tab_offsets;
+  };
+
+  /** \brief Collect the data to be written to the file in \c wb
+
+      If \c copy is true, then \c wb is filled with copies of the
+      rows to be written, so that the main table may be modified
+      while \c wb is written. Otherwise \c wb refers to the main
+      table.
+  */
+  void prepare_batch(write_batch &wb, bool copy) {
+    
+    wb.n_accept=this->n_accept;
+    wb.n_reject=this->n_reject;
+    wb.ret_value_counts=this->ret_value_counts;
+    wb.initial_points=this->initial_points;
+    wb.append=append_output;
+    wb.rank_sent=false;
+    wb.row_start=0;
+    wb.file_offset=0;
+    
+    // In append mode, the first row which needs to be written
+    size_t row_start=0;
+    if (append_output) {
+      row_start=last_write_row;
+      if (row_start>table->get_nlines()) row_start=table->get_nlines();
+    }
     
 #ifdef O2SCL_MPI
     if (table_io_chunk>1) {
@@ -1651,30 +1736,58 @@ namespace o2scl {
 	for(int i=0;i<table_io_chunk-1;i++) {
 	  int child=this->mpi_rank+i+1;
 	  if (child<this->mpi_size) {
+	    unsigned long child_start=0;
+	    if (append_output) {
+	      MPI_Recv(&child_start,1,MPI_UNSIGNED_LONG,child,0,
+		       MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+	    }
+	    wb.tab_offsets.push_back(child_start);
 	    table_units<> t;
-	    tab_arr.push_back(t);
-	    o2scl_table_mpi_recv(child,tab_arr[tab_arr.size()-1]);
+	    wb.tab_arr.push_back(t);
+	    o2scl_table_mpi_recv(child,wb.tab_arr[wb.tab_arr.size()-1]);
 	  }
 	}
       } else {
 	// Child ranks
 	size_t parent=this->mpi_rank-(this->mpi_rank%table_io_chunk);
-	o2scl_table_mpi_send(*table,parent);
-	rank_sent=true;
+	if (append_output) {
+	  // Send only the rows which need to be written
+	  unsigned long child_start=row_start;
+	  MPI_Send(&child_start,1,MPI_UNSIGNED_LONG,parent,0,
+		   MPI_COMM_WORLD);
+	  table_units<> tail;
+	  copy_tail(row_start,tail);
+	  o2scl_table_mpi_send(tail,parent);
+	  last_write_row=final_rows();
+	} else {
+	  o2scl_table_mpi_send(*table,parent);
+	}
+	wb.rank_sent=true;
       }
     }
 #endif
-    
-#ifdef O2SCL_MPI
-    // Ensure that multiple threads aren't writing to the
-    // filesystem at the same time
-    int tag=0, buffer=0;
-    if (sync_write && this->mpi_size>1 &&
-	this->mpi_rank>=table_io_chunk) {
-      MPI_Recv(&buffer,1,MPI_INT,this->mpi_rank-table_io_chunk,
-	       tag,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+
+    if (wb.rank_sent==false) {
+      if (copy) {
+	// When append_output is false, row_start is zero and
+	// the full table is copied
+	wb.tab=std::shared_ptr<o2scl::table_units<> >
+	  (new o2scl::table_units<>);
+	copy_tail(row_start,*wb.tab);
+	wb.file_offset=row_start;
+      } else {
+	wb.tab=table;
+	wb.row_start=row_start;
+      }
+      if (append_output) last_write_row=final_rows();
     }
-#endif
+    
+    return;
+  }
+
+  /** \brief Write the data in \c wb to the output file
+   */
+  void write_batch_file(write_batch &wb) {
     
     o2scl_hdf::hdf_file hf;
     std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+"_out";
@@ -1705,25 +1818,300 @@ namespace o2scl {
       first_write=true;
     }
     
-    hf.set_szt_vec("n_accept",this->n_accept);
-    hf.set_szt_vec("n_reject",this->n_reject);
-    hf.set_szt_arr2d_copy("ret_value_counts",this->ret_value_counts.size(),
-			  this->ret_value_counts[0].size(),
-			  this->ret_value_counts);
-    hf.setd_arr2d_copy("initial_points",this->initial_points.size(),
-		       this->initial_points[0].size(),
-		       this->initial_points);
-
-    hf.seti("n_tables",tab_arr.size()+1);
-    if (rank_sent==false) {
-      hdf_output(hf,*table,"markov_chain_0");
+    hf.set_szt_vec("n_accept",wb.n_accept);
+    hf.set_szt_vec("n_reject",wb.n_reject);
+    hf.set_szt_arr2d_copy("ret_value_counts",wb.ret_value_counts.size(),
+			  wb.ret_value_counts[0].size(),
+			  wb.ret_value_counts);
+    hf.setd_arr2d_copy("initial_points",wb.initial_points.size(),
+		       wb.initial_points[0].size(),
+		       wb.initial_points);
+
+    hf.seti("n_tables",wb.tab_arr.size()+1);
+    if (wb.rank_sent==false) {
+      if (wb.append) {
+	hdf_output_append(hf,*wb.tab,"markov_chain_0",wb.row_start,
+			  wb.file_offset);
+      } else {
+	hdf_output(hf,*wb.tab,"markov_chain_0");
+      }
     }
-    for(size_t i=0;i<tab_arr.size();i++) {
+    for(size_t i=0;i<wb.tab_arr.size();i++) {
       std::string name=((std::string)"markov_chain_")+szttos(i+1);
-      hdf_output(hf,tab_arr[i],name);
+      if (wb.append) {
+	hdf_output_append(hf,wb.tab_arr[i],name,0,wb.tab_offsets[i]);
+      } else {
+	hdf_output(hf,wb.tab_arr[i],name);
+      }
     }
     
     hf.close();
+
+    return;
+  }
+
+  /** \brief Return true if the I/O thread is running
+   */
+  bool async_running() {
+#ifdef O2SCL_OPENMP
+    return writer_thread.joinable();
+#else
+    return false;
+#endif
+  }
+
+  /** \brief Start the I/O thread if \ref async_write is true
+      and periodic file updates are enabled
+  */
+  void async_start() {
+#ifdef O2SCL_OPENMP
+    async_stop();
+    if (async_write && (file_update_iters>0 || file_update_time>0.0)) {
+      writer_stop=false;
+      writer_error.clear();
+      writer_thread=std::thread(&mcmc_para_table::writer_loop,this);
+    }
+#endif
+    return;
+  }
+
+  /** \brief Write any pending batches and stop the I/O thread
+   */
+  void async_stop() {
+#ifdef O2SCL_OPENMP
+    if (writer_thread.joinable()) {
+      {
+	std::lock_guard<std::mutex> lk(writer_mutex);
+	writer_stop=true;
+      }
+      writer_cv.notify_all();
+      writer_thread.join();
+    }
+#endif
+    return;
+  }
+
+#ifdef O2SCL_OPENMP
+  
+  /// \name I/O thread
+  //@{
+  /// The I/O thread
+  std::thread writer_thread;
+  /// Mutex for the objects shared with the I/O thread
+  std::mutex writer_mutex;
+  /// Condition variable for changes in \ref writer_queue
+  std::condition_variable writer_cv;
+  /** \brief Batches waiting to be written, the first of which
+      is being written by the I/O thread
+  */
+  std::deque<std::shared_ptr<write_batch> > writer_queue;
+  /// If true, the I/O thread exits once the queue is empty
+  bool writer_stop;
+  /// The message from the last error in the I/O thread
+  std::string writer_error;
+  //@}
+
+  /** \brief The main loop for the I/O thread
+   */
+  void writer_loop() {
+    while (true) {
+      std::shared_ptr<write_batch> wb;
+      {
+	std::unique_lock<std::mutex> lk(writer_mutex);
+	writer_cv.wait(lk,[this]{ return writer_stop ||
+	      writer_queue.empty()==false; });
+	if (writer_queue.empty()) return;
+	wb=writer_queue.front();
+      }
+      // Exceptions cannot propagate out of the thread, so they
+      // are stored and reported by the sampler
+      std::string msg;
+      try {
+	write_batch_file(*wb);
+      } catch (std::exception &e) {
+	msg=e.what();
+	if (msg.length()==0) msg="Unknown error.";
+      }
+      {
+	std::lock_guard<std::mutex> lk(writer_mutex);
+	writer_queue.pop_front();
+	if (msg.length()>0) writer_error=msg;
+      }
+      writer_cv.notify_all();
+    }
+    return;
+  }
+
+  /** \brief Hand \c wb to the I/O thread, waiting if there
+      are already \ref async_max_batches pending batches
+
+      When \ref append_output is false, each batch contains the
+      full table, so a batch which has not yet been started is
+      replaced by \c wb instead.
+  */
+  void async_push(std::shared_ptr<write_batch> wb) {
+    size_t max_batches=async_max_batches;
+    if (max_batches==0) max_batches=1;
+    {
+      std::unique_lock<std::mutex> lk(writer_mutex);
+      if (wb->append==false && writer_queue.size()>1) {
+	// A batch which rewrites the full table supersedes the
+	// last batch which has not yet been started
+	writer_queue.back()=wb;
+      } else {
+	writer_cv.wait(lk,[this,max_batches]{
+	    return writer_queue.size()<max_batches; });
+	writer_queue.push_back(wb);
+      }
+    }
+    writer_cv.notify_all();
+    async_check_error();
+    return;
+  }
+
+  /** \brief Call the error handler if the I/O thread failed
+   */
+  void async_check_error() {
+    std::string msg;
+    {
+      std::lock_guard<std::mutex> lk(writer_mutex);
+      std::swap(msg,writer_error);
+    }
+    if (msg.length()>0) {
+      O2SCL_ERR2("I/O thread failed in mcmc_para_table::",
+		 ((std::string)"write_files(): ")+msg,o2scl::exc_efailed);
+    }
+    return;
+  }
+
+#endif
+  
+  public:
+
+  /** \brief If true, ensure sure walkers and OpenMP threads are
+      written to the table with equal spacing between rows (default
+      true)
+   */
+  bool table_sequence;
+  
+  /** \brief Iterations between file updates (default 0 for no file updates)
+   */
+  size_t file_update_iters;
+  
+  /** \brief Time between file updates (default 0.0 for no file updates)
+   */
+  double file_update_time;
+  
+  /** \brief The number of tables to combine before I/O (default 1)
+   */
+  int table_io_chunk;
+
+  /** \brief The number of rows read at a time by
+      \ref initial_points_file_last() (default 10000)
+  */
+  size_t file_read_block;
+
+  /** \brief If true, only write the rows which may have changed
+      since the last call to \ref write_files() (default false)
+
+      When this is false, every call to \ref write_files()
+      rewrites the full table, so periodic file updates become
+      slower as the chain grows. When this is true, the table is
+      written with \ref o2scl_hdf::hdf_output_append() and only the
+      rows beginning with the earliest row which could have been
+      modified since the last write are written, along with the
+      small objects like \c n_accept, \c n_reject, and \c
+      ret_value_counts. The cost of each update is then
+      proportional to the number of new rows (plus the rows
+      belonging to any walkers which have not accepted a step since
+      the last write). The resulting file contains the same data as
+      the one written when this is false. When \ref table_io_chunk is larger
+      than one, only the new rows are sent to the parent rank.
+  */
+  bool append_output;
+  
+  /** \brief If true, perform the periodic file updates in a
+      separate thread (default false)
+
+      When this is true and either \ref file_update_iters or
+      \ref file_update_time is nonzero, \ref mcmc_init() starts a
+      dedicated I/O thread. Each periodic call to \ref write_files()
+      then copies the data to be written (only the new rows when
+      \ref append_output is true) into a batch, hands the batch to
+      the I/O thread, and returns immediately so that the walkers
+      can continue while the HDF5 file is written. If \ref
+      async_max_batches batches are already pending, the sampler
+      waits for the oldest one to finish. The final call to \ref
+      write_files() from \ref mcmc_cleanup() waits for all pending
+      batches and then writes the file synchronously, so the final
+      output file is the same as the one obtained when this is false.
+
+      Any communication between MPI ranks required when \ref
+      table_io_chunk is larger than one is performed by the sampler
+      before the batch is handed off, so MPI is never called from the
+      I/O thread. The HDF5 library is called from the I/O thread,
+      however, so the user-specified functions should not perform
+      HDF5 I/O while the sampler is running unless the HDF5 library
+      was compiled to be thread-safe. The I/O thread requires
+      threading support from the compiler, so this parameter is
+      ignored unless OpenMP support is enabled.
+  */
+  bool async_write;
+
+  /** \brief The maximum number of batches which are being written
+      or waiting to be written by the I/O thread (default 2)
+  */
+  size_t async_max_batches;
+  
+  /** \brief Write MCMC tables to files
+      
+      If \c sync_write is false and the I/O thread is running (see
+      \ref async_write), then the data is handed to the I/O thread
+      and this function returns before the file is written.
+   */
+  virtual void write_files(bool sync_write=false) {
+
+    if (this->verbose>=2) {
+      this->scr_out << "mcmc: Start write_files(). mpi_rank: "
+		    << this->mpi_rank << " mpi_size: "
+		    << this->mpi_size <<  " table_io_chunk: "
+		    << table_io_chunk << std::endl;
+    }
+
+    // The first write includes the header, which is always
+    // written synchronously
+    bool async=(sync_write==false && first_write && async_running());
+    
+    std::shared_ptr<write_batch> wb(new write_batch);
+    prepare_batch(*wb,async);
+
+#ifdef O2SCL_OPENMP
+    if (async) {
+      async_push(wb);
+      if (this->verbose>=2) {
+	this->scr_out << "mcmc: Done write_files() (batch sent to "
+		      << "I/O thread)." << std::endl;
+      }
+      return;
+    }
+#endif
+
+    // Wait for the I/O thread so that the file is not opened twice
+    // and so that this write is not overwritten by an older batch
+    async_flush();
+    
+#ifdef O2SCL_MPI
+    // Ensure that multiple threads aren't writing to the
+    // filesystem at the same time
+    int tag=0, buffer=0;
+    if (sync_write && this->mpi_size>1 &&
+	this->mpi_rank>=table_io_chunk) {
+      MPI_Recv(&buffer,1,MPI_INT,this->mpi_rank-table_io_chunk,
+	       tag,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+    }
+#endif
+
+    write_batch_file(*wb);
     
 #ifdef O2SCL_MPI
     if (sync_write && this->mpi_size>1 &&
@@ -1740,6 +2128,24 @@ namespace o2scl {
     return;
   }
   
+  /** \brief Wait until the I/O thread has written all pending
+      batches
+
+      This function does nothing if the I/O thread is not running.
+      If the I/O thread failed to write a batch, the error handler
+      is called.
+   */
+  void async_flush() {
+#ifdef O2SCL_OPENMP
+    if (writer_thread.joinable()) {
+      std::unique_lock<std::mutex> lk(writer_mutex);
+      writer_cv.wait(lk,[this]{ return writer_queue.empty(); });
+    }
+    async_check_error();
+#endif
+    return;
+  }
+  
   /// If true, allow estimates of the weight (default false)
   bool allow_estimates;
 
@@ -1747,16 +2153,33 @@ namespace o2scl {
    */
   bool store_rejects;
   
+  /** \brief The window parameter for \ref ac_lengths() (default 5.0)
+   */
+  double ac_window;
+  
   mcmc_para_table() {
     allow_estimates=false;
+    ac_window=5.0;
     table_io_chunk=1;
     file_update_iters=0;
     file_update_time=0.0;
     last_write_iters=0;
+    last_write_row=0;
+    append_output=false;
+    file_read_block=10000;
+    async_write=false;
+    async_max_batches=2;
+#ifdef O2SCL_OPENMP
+    writer_stop=false;
+#endif
     store_rejects=false;
     table_sequence=true;
   }
   
+  virtual ~mcmc_para_table() {
+    async_stop();
+  }
+  
   /// \name Basic usage
   //@{
   /** \brief Set the table names and units
@@ -1777,6 +2200,12 @@ namespace o2scl {
       present in \c fname which stores parameters in a block of
       columns and has columns named \c mult, \c thread, 
       \c walker, and \c log_wgt.
+
+      The table is read backwards from the end in blocks of \ref
+      file_read_block rows, and only the \c thread, \c walker, and
+      \c mult columns are read until the last accepted point for
+      each walker has been found. Thus the full table is never
+      stored in memory.
   */
   virtual void initial_points_file_last(std::string fname,
 					size_t n_param_loc,
@@ -1796,16 +2225,19 @@ namespace o2scl {
     
     o2scl_hdf::hdf_file hf;
     hf.open(fname);
+
+    // Find the table and the number of lines
     std::string tname;
-    hdf_input(hf,*table,tname);
-    hf.close();
-    
-#ifdef O2SCL_MPI
-    if (this->mpi_size>1 && this->mpi_rank<this->mpi_size-1) {
-      MPI_Send(&buffer,1,MPI_INT,this->mpi_rank+1,
-	       tag,MPI_COMM_WORLD);
+    hf.find_group_by_type("table",tname);
+    int nlines_int=0;
+    if (tname.length()>0) {
+      hid_t top=hf.get_current_id();
+      hid_t group=hf.open_group(tname);
+      hf.set_current_id(group);
+      hf.geti("nlines",nlines_int);
+      hf.close_group(group);
+      hf.set_current_id(top);
     }
-#endif
 
     // Determine number of points
     size_t n_points=this->n_walk*this->n_threads;
@@ -1817,39 +2249,76 @@ namespace o2scl {
     }
     
     this->initial_points.resize(n_points);
-	
-    for(size_t it=0;it<this->n_threads;it++) {
-      for(size_t iw=0;iw<this->n_walk;iw++) {
-	
-	// The combined walker/thread index 
-	size_t windex=it*this->n_walk+iw;
+    std::vector<bool> found(n_points,false);
+    size_t n_found=0;
 
-	bool found=false;
-	for(int row=table->get_nlines()-1;row>=0 && found==false;row--) {
-	  if (table->get("walker",row)==iw &&
-	      table->get("thread",row)==it &&
-	      table->get("mult",row)>0.5) {
+    std::vector<std::string> cols={"thread","walker","mult"};
+    o2scl::table_units<> tblock, trow;
+    size_t block=file_read_block;
+    if (block==0) block=1;
+    
+    size_t row_end=nlines_int;
+    while (n_found<n_points && row_end>0) {
 
-	    found=true;
+      size_t row_begin=0;
+      if (row_end>block) row_begin=row_end-block;
+      o2scl_hdf::hdf_input(hf,tblock,tname,cols,row_begin,
+			   row_end-row_begin);
+
+      for(size_t j=tblock.get_nlines();j>0 && n_found<n_points;j--) {
+	
+	size_t row=row_begin+j-1;
+	double thread_d=tblock.get("thread",j-1);
+	double walker_d=tblock.get("walker",j-1);
+	
+	if (tblock.get("mult",j-1)>0.5 && thread_d>=0.0 && walker_d>=0.0) {
+	  
+	  size_t it=((size_t)(thread_d+0.5));
+	  size_t iw=((size_t)(walker_d+0.5));
+	  
+	  // The combined walker/thread index 
+	  size_t windex=it*this->n_walk+iw;
+	  
+	  if (it<this->n_threads && iw<this->n_walk &&
+	      found[windex]==false) {
+	    
+	    found[windex]=true;
+	    n_found++;
+	    
+	    // Read only this row of the table
+	    o2scl_hdf::hdf_input(hf,trow,tname,std::vector<std::string>(),
+				 row,1);
 	    
 	    std::cout << "Function initial_point_file_last():\n\tit: "
 		      << it << "," << this->mpi_rank
 		      << " iw: " << iw << " row: "
-		      << row << " log_wgt: " << table->get("log_wgt",row)
+		      << row << " log_wgt: " << trow.get("log_wgt",0)
 		      << std::endl;
 	    
 	    // Copy the entries from this row into the initial_points object
 	    this->initial_points[windex].resize(n_param_loc);
 	    for(size_t ip=0;ip<n_param_loc;ip++) {
-	      this->initial_points[windex][ip]=table->get(ip+offset,row);
+	      this->initial_points[windex][ip]=trow.get(ip+offset,0);
 	    }
 	  }
 	}
-	if (found==false) {
-	  O2SCL_ERR("Function initial_points_file_last() failed.",
-		    o2scl::exc_einval);
-	}
       }
+      
+      row_end=row_begin;
+    }
+    
+    hf.close();
+    
+#ifdef O2SCL_MPI
+    if (this->mpi_size>1 && this->mpi_rank<this->mpi_size-1) {
+      MPI_Send(&buffer,1,MPI_INT,this->mpi_rank+1,
+	       tag,MPI_COMM_WORLD);
+    }
+#endif
+
+    if (n_found<n_points) {
+      O2SCL_ERR("Function initial_points_file_last() failed.",
+		o2scl::exc_einval);
     }
     
     return;
@@ -2344,12 +2813,24 @@ namespace o2scl {
     }
 
     write_files(true);
+    async_stop();
     
     return parent_t::mcmc_cleanup();
   }
 
   /** \brief Compute autocorrelation coefficients
-   */
+
+      This function computes the autocorrelation coefficients for the
+      first \c ncols parameter columns, averaged over all of the
+      chains. The coefficient for lag \c ell is stored in
+      <tt>ac_coeffs(i,ell-1)</tt>. The autocorrelation vector for each
+      chain is computed with \ref o2scl::vector_autocorr_vector_fft(),
+      and the columns are distributed over the OpenMP threads.
+
+      This function assumes that the table has been arranged
+      so that each chain is contiguous, i.e. that \ref
+      reorder_table() has been called.
+  */
   virtual void ac_coeffs(size_t ncols, ubmatrix &ac_coeffs) {
     std::vector<size_t> chain_sizes;
     get_chain_sizes(chain_sizes);
@@ -2359,52 +2840,95 @@ namespace o2scl {
     }
     size_t N_max=min_size/2;
     ac_coeffs.resize(ncols,N_max-1);
-    for(size_t i=0;i<ncols;i++) {
-      for(size_t ell=1;ell<N_max;ell++) {
-	ac_coeffs(i,ell-1)=0.0;
-      }
-    }
     size_t n_tot=this->n_threads*this->n_walk;
+    
+    // The first row of each chain
+    std::vector<size_t> chain_start(n_tot);
     size_t table_row=0;
+    for(size_t tindex=0;tindex<n_tot;tindex++) {
+      chain_start[tindex]=table_row;
+      table_row+=chain_sizes[tindex]+1;
+    }
+    
     size_t cstart=table->lookup_column("log_wgt")+1;
-    for(size_t i=0;i<ncols;i++) {
-      for(size_t j=0;j<this->n_threads;j++) {
-	for(size_t k=0;k<this->n_walk;k++) {
-	  size_t tindex=j*this->n_walk+k;
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared)
+#endif
+    {
+      std::vector<double> ac_vec;
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(size_t i=0;i<ncols;i++) {
+	for(size_t ell=1;ell<N_max;ell++) {
+	  ac_coeffs(i,ell-1)=0.0;
+	}
+	for(size_t tindex=0;tindex<n_tot;tindex++) {
+	  const double &x=(*table)[cstart+i][chain_start[tindex]];
+	  o2scl::vector_autocorr_vector_fft<const double *>
+	    (chain_sizes[tindex]+1,&x,ac_vec);
 	  for(size_t ell=1;ell<N_max;ell++) {
-	    const double &x=(*table)[cstart+i][table_row];
-	    double mean=o2scl::vector_mean<const double *>
-	      (chain_sizes[tindex]+1,&x);
-	    ac_coeffs(i,ell-1)+=o2scl::vector_lagk_autocorr
-	      <const double *>(chain_sizes[tindex]+1,&x,ell,mean);
+	    ac_coeffs(i,ell-1)+=ac_vec[ell];
 	  }
-	  table_row+=chain_sizes[tindex]+1;
 	}
-      }
-      for(size_t ell=1;ell<N_max;ell++) {
-	ac_coeffs(i,ell-1)/=((double)n_tot);
+	for(size_t ell=1;ell<N_max;ell++) {
+	  ac_coeffs(i,ell-1)/=((double)n_tot);
+	}
       }
     }
+    
     return;
   }
 
   /** \brief Compute autocorrelation lengths
-   */
+
+      Given the coefficients computed by \ref ac_coeffs(), this
+      function computes the integrated autocorrelation time for each
+      column using \ref o2scl::vector_autocorr_tau_int() with the
+      window parameter \ref ac_window .
+  */
   virtual void ac_lengths(size_t ncols, ubmatrix &ac_coeffs_cols,
 			  ubvector &ac_lengths) {
     size_t N_max=ac_coeffs_cols.size2();
     ac_lengths.resize(ncols);
+    std::vector<double> rho(N_max+1);
+    rho[0]=1.0;
     for(size_t icol=0;icol<ncols;icol++) {
-      std::vector<double> tau(N_max);
-      for(size_t i=5;i<N_max;i++) {
-	double sum=0.0;
-	for(size_t j=0;j<i;j++) {
-	  sum+=ac_coeffs_cols(icol,j);
-	}
-	tau[i]=1.0+2.0*sum;
-	std::cout << tau[i] << " " << ((double)i)/5.0 << std::endl;
+      for(size_t j=0;j<N_max;j++) {
+	rho[j+1]=ac_coeffs_cols(icol,j);
+      }
+      size_t window;
+      ac_lengths[icol]=o2scl::vector_autocorr_tau_int
+	(N_max+1,rho,window,ac_window);
+      if (this->verbose>0 && window==N_max) {
+	std::cout << "mcmc_para_table::ac_lengths(): Autocorrelation "
+		  << "window not found for column " << icol << "."
+		  << std::endl;
       }
-      std::cout << std::endl;
+    }
+    return;
+  }
+
+  /** \brief Compute autocorrelation lengths and effective
+      sample sizes
+
+      The effective sample size for each column is the total number
+      of points in all of the chains divided by the integrated
+      autocorrelation time computed by \ref ac_lengths().
+  */
+  virtual void ac_lengths(size_t ncols, ubmatrix &ac_coeffs_cols,
+			  ubvector &ac_lengths, ubvector &ess) {
+    this->ac_lengths(ncols,ac_coeffs_cols,ac_lengths);
+    std::vector<size_t> chain_sizes;
+    get_chain_sizes(chain_sizes);
+    double n_samp=0.0;
+    for(size_t i=0;i<chain_sizes.size();i++) {
+      n_samp+=chain_sizes[i]+1;
+    }
+    ess.resize(ncols);
+    for(size_t icol=0;icol<ncols;icol++) {
+      ess[icol]=n_samp/ac_lengths[icol];
     }
     return;
   }
@@ -2504,6 +3028,8 @@ namespace o2scl {
   o2scl::cli::parameter_bool p_aff_inv;
   o2scl::cli::parameter_bool p_table_sequence;
   o2scl::cli::parameter_bool p_store_rejects;
+  o2scl::cli::parameter_bool p_append_output;
+  o2scl::cli::parameter_bool p_async_write;
   o2scl::cli::parameter_double p_max_time;
   o2scl::cli::parameter_size_t p_max_iters;
   //o2scl::cli::parameter_int p_max_chain_size;
@@ -2656,6 +3182,16 @@ namespace o2scl {
       "(default false).";
     cl.par_list.insert(std::make_pair("store_rejects",&p_store_rejects));
     
+    p_append_output.b=&this->append_output;
+    p_append_output.help=((std::string)"If true, then only write new ")+
+      "rows to the output files (default false).";
+    cl.par_list.insert(std::make_pair("append_output",&p_append_output));
+    
+    p_async_write.b=&this->async_write;
+    p_async_write.help=((std::string)"If true, then write the periodic ")+
+      "file updates in a separate thread (default false).";
+    cl.par_list.insert(std::make_pair("async_write",&p_async_write));
+    
     return;
   }
   
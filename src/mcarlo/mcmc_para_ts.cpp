@@ -305,6 +305,93 @@ int main(int argc, char *argv[]) {
   hf.set_szt_vec("n_reject",mpc.mct.n_reject);
   hf.close();
 
+  // ----------------------------------------------------------------
+  // Affine-invariant MCMC with a table and incremental file output
+
+  cout << "Affine-invariant MCMC with incremental file output: " << endl;
+
+  mpc.mct.verbose=1;
+  mpc.mct.max_iters=40;
+  mpc.mct.file_update_iters=3;
+  mpc.mct.append_output=true;
+  mpc.mct.prefix="mcmct_app";
+  mpc.mct.mcmc(1,low,high,vpf,vff);
+  mpc.mct.file_update_iters=0;
+  mpc.mct.append_output=false;
+
+  table=mpc.mct.get_table();
+
+  // The file should contain the full final table
+  table_units<> tab_file;
+  hf.open("mcmct_app_0_out");
+  hdf_input(hf,tab_file,"markov_chain_0");
+  hf.close();
+  tm.test_gen(tab_file.get_nlines()==table->get_nlines(),"append nlines");
+  tm.test_gen(tab_file.get_ncolumns()==table->get_ncolumns(),
+	      "append ncols");
+  bool match=true;
+  for(size_t i=0;i<table->get_ncolumns();i++) {
+    for(size_t j=0;j<table->get_nlines();j++) {
+      if (tab_file.get(i,j)!=table->get(i,j)) match=false;
+    }
+  }
+  tm.test_gen(match,"append data");
+
+  // Read the last points in small blocks and compare with
+  // a direct search of the table
+  std::vector<std::vector<double> > last(mpc.mct.n_walk*n_threads);
+  for(size_t it=0;it<n_threads;it++) {
+    for(size_t iw=0;iw<mpc.mct.n_walk;iw++) {
+      for(int row=table->get_nlines()-1;row>=0;row--) {
+	if (table->get("walker",row)==iw && table->get("thread",row)==it &&
+	    table->get("mult",row)>0.5) {
+	  last[it*mpc.mct.n_walk+iw].push_back(table->get("x",row));
+	  row=-1;
+	}
+      }
+    }
+  }
+  mpc.mct.file_read_block=7;
+  mpc.mct.initial_points_file_last("mcmct_app_0_out",1);
+  match=true;
+  for(size_t k=0;k<last.size();k++) {
+    if (last[k].size()!=1 ||
+	mpc.mct.initial_points[k][0]!=last[k][0]) match=false;
+  }
+  tm.test_gen(match,"initial_points_file_last()");
+
+  // Affine-invariant MCMC with file output from a separate thread,
+  // first rewriting the full table and then in append mode
+
+  cout << "Affine-invariant MCMC with asynchronous file output: " << endl;
+
+  mpc.mct.initial_points.clear();
+  for(size_t k=0;k<2;k++) {
+    mpc.mct.max_iters=40;
+    mpc.mct.file_update_iters=3;
+    mpc.mct.async_write=true;
+    mpc.mct.append_output=(k==1);
+    mpc.mct.prefix="mcmct_async";
+    mpc.mct.mcmc(1,low,high,vpf,vff);
+    mpc.mct.file_update_iters=0;
+    mpc.mct.async_write=false;
+    mpc.mct.append_output=false;
+
+    table=mpc.mct.get_table();
+    
+    hf.open("mcmct_async_0_out");
+    hdf_input(hf,tab_file,"markov_chain_0");
+    hf.close();
+    tm.test_gen(tab_file.get_nlines()==table->get_nlines(),"async nlines");
+    match=true;
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      for(size_t j=0;j<table->get_nlines();j++) {
+	if (tab_file.get(i,j)!=table->get(i,j)) match=false;
+      }
+    }
+    tm.test_gen(match,"async data");
+  }
+
   tm.report();
   
   return 0;
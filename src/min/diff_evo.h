@@ -29,6 +29,11 @@
 
 #include <vector>
 #include <algorithm>
+#include <string>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
 
 #include <o2scl/rng_gsl.h>
 #include <o2scl/mmin.h>
@@ -60,6 +65,32 @@ namespace o2scl {
 
       If the population converges prematurely, then \ref diff_evo::f
       and \ref pop_size should be increased.
+
+      <b>Parallel evaluation</b>
+
+      If \ref n_threads is larger than one, then each generation is
+      computed in three steps. First, the trial agents for the entire
+      population are constructed from the population at the start of
+      the generation. Second, the function is evaluated for all of
+      the trial agents, distributing them over \ref n_threads OpenMP
+      threads (if OpenMP support is enabled). Finally, each agent is
+      replaced by its trial agent if the trial agent is better. The
+      initial population is evaluated in parallel in the same way.
+      This differs slightly from the serial algorithm, in which the
+      improved agents are available to the remaining agents in the
+      same generation. All random numbers are generated outside of
+      the parallel region by the single generator, so for a fixed
+      seed the results do not depend on the number of threads (as
+      long as it is larger than one) or on whether OpenMP is enabled.
+
+      Each thread uses its own function object, either from the list
+      given to \ref set_thread_functions() or a copy of the function
+      given to \ref mmin(). In the latter case, the copies typically
+      refer to the same underlying object, so the function must be
+      safe to call from several threads at once. Exceptions thrown by
+      the function are collected and the error handler is called
+      after all of the agents have been evaluated (see \ref
+      omp_errorhand_subsect).
   */
     template<class func_t=multi_funct, 
       class vec_t=boost::numeric::ublas::vector<double> , 
@@ -98,6 +129,13 @@ namespace o2scl {
     */
     double cr;
 
+    /** \brief Number of threads (default 1)
+
+	If this is larger than one, then the generations are computed
+	as described in the class documentation.
+    */
+    size_t n_threads;
+
     diff_evo() {
       this->ntrial=1000;
       f = 0.75;
@@ -105,6 +143,7 @@ namespace o2scl {
       rand_init_funct = 0;
       pop_size = 0;
       nconv = 25;
+      n_threads = 1;
     }
 
     virtual ~diff_evo() {
@@ -126,6 +165,22 @@ namespace o2scl {
       rand_init_funct = &function;
     }
 
+    /** \brief Set one function for each thread
+
+	When \ref n_threads is larger than one, thread \c i uses the
+	function <tt>fv[i]</tt> rather than the function given to
+	\ref mmin(), and the size of \c fv limits the number of
+	threads. These functions must give the same results as the
+	function given to \ref mmin(). This is useful when the function
+	is a member of an object which is not thread-safe, in which
+	case each function can refer to a separate copy of the object.
+	Calling this function with an empty vector removes the list.
+    */
+    void set_thread_functions(std::vector<func_t> &fv) {
+      func_list=fv;
+      return;
+    }
+
     /** \brief Calculate the minimum \c fmin of \c func w.r.t the 
 	array \c x of size \c nvar.
 
@@ -162,27 +217,44 @@ namespace o2scl {
       
       fmins.resize(pop_size);
 
-      // Set initial fmin
-      for (size_t x = 0; x < pop_size; ++x) {
-	vec_t agent_x;
-	agent_x.resize(nvar);
-	for (size_t i = 0; i < nvar; ++i) {
-	  agent_x[i] = population[x*nvar+i];
+      if (n_threads>1) {
+	
+	// Set initial fmin
+	eval_para(nvar,this->population,func);
+	for (size_t x = 0; x < pop_size; ++x) {
+	  if (x==0 || fmins_y[x]<fmin) {
+	    fmin = fmins_y[x];
+	    for (size_t i = 0; i<nvar; ++i)  
+	      x0[i] = population[x*nvar+i];
+	  }
+	  fmins[x]=fmins_y[x];
 	}
-	double fmin_x = 0;
-	fmin_x=func(nvar,agent_x);
-	fmins[x]=fmin_x;
-	if (x==0) {
-	  fmin = fmin_x;
-	  for (size_t i = 0; i<nvar; ++i)  
-	    x0[i] = agent_x[i];
-	  //x0 = agent_x;
-	} else if (fmin_x<fmin) {
-	  fmin = fmin_x;
-	  for (size_t i = 0; i<nvar; ++i)  
-	    x0[i] = agent_x[i];
-	  //x0 = agent_x;
+	
+      } else {
+	
+	// Set initial fmin
+	for (size_t x = 0; x < pop_size; ++x) {
+	  vec_t agent_x;
+	  agent_x.resize(nvar);
+	  for (size_t i = 0; i < nvar; ++i) {
+	    agent_x[i] = population[x*nvar+i];
+	  }
+	  double fmin_x = 0;
+	  fmin_x=func(nvar,agent_x);
+	  fmins[x]=fmin_x;
+	  if (x==0) {
+	    fmin = fmin_x;
+	    for (size_t i = 0; i<nvar; ++i)  
+	      x0[i] = agent_x[i];
+	    //x0 = agent_x;
+	  } else if (fmin_x<fmin) {
+	    fmin = fmin_x;
+	    for (size_t i = 0; i<nvar; ++i)  
+	      x0[i] = agent_x[i];
+	    //x0 = agent_x;
+	  }
 	}
+
       }
 
       int gen = 0;
@@ -191,63 +263,75 @@ namespace o2scl {
 	++nconverged;
 	++gen;
 
-	// For each agent x in the population do: 
-	for (size_t x = 0; x < pop_size; ++x) {
-
-	  std::vector<int> others;
-
-	  // Create a copy agent_x and agent_y of the current agent
-	  // vector
-	  vec_t agent_x, agent_y;
-	  agent_x.resize(nvar);
-	  agent_y.resize(nvar);
-	  for (size_t i = 0; i < nvar; ++i) {
-	    agent_x[i] = population[x*nvar+i];
-	    agent_y[i] = population[x*nvar+i];
+	if (n_threads>1) {
+	  
+	  // Construct the trial agents from the current population
+	  trials.resize(nvar*pop_size);
+	  f_trial.resize(pop_size);
+	  cr_trial.resize(pop_size);
+	  for (size_t x = 0; x < pop_size; ++x) {
+	    make_trial(nvar,x,trials,x*nvar,f_trial[x],cr_trial[x]);
 	  }
-                            
-	  // Pick three agents a, b, and c from the population at 
-	  // random, they must be distinct from each other as well as
-	  // from agent x
-	  others = pick_unique_agents( 3, x );
 
-	  // Pick a random index R in {1, ..., n}, where the highest 
-	  // possible value n is the dimensionality of the problem 
-	  // to be optimized.
-	  size_t r = floor(gr.random()*nvar);
+	  // Evaluate them 
+	  eval_para(nvar,trials,func);
 
-	  for (size_t i = 0; i < nvar; ++i) {
-	    // Pick ri~U(0,1) uniformly from the open range (0,1)
-	    double ri = gr.random();
-	    // If (i=R) or (ri<CR) let yi = ai + F(bi - ci), otherwise 
-	    // let yi = xi
-	    if (i == r || ri < cr) {
-	      agent_y[i] = population[others[0]*nvar+i] + 
-		f*(population[others[1]*nvar+i]-
-		   population[others[2]*nvar+i]);
+	  // Replace the agents which have improved
+	  for (size_t x = 0; x < pop_size; ++x) {
+	    double fmin_y=fmins_y[x];
+	    if (fmin_y<fmins[x]) {
+	      for (size_t i = 0; i < nvar; ++i) {
+		population[x*nvar+i] = trials[x*nvar+i];
+	      }
+	      fmins[x] = fmin_y;
+	      accept_trial(x,f_trial[x],cr_trial[x]);
+	      if (fmin_y<fmin) {
+		fmin = fmin_y;
+		for (size_t i = 0; i<nvar; ++i) {  
+		  x0[i] = trials[x*nvar+i];
+		}
+		nconverged = 0;
+	      }
 	    }
 	  }
-	  // If (f(y) < f(x)) then replace the agent in the population 
-	  // with the improved candidate solution, that is, set x = y 
-	  // in the population
-	  double fmin_y;
-                            
-	  fmin_y=func(nvar,agent_y);
-	  if (fmin_y<fmins[x]) {
-	    for (size_t i = 0; i < nvar; ++i) {
-	      population[x*nvar+i] = agent_y[i];
+	  
+	} else {
+	  
+	  // For each agent x in the population do: 
+	  for (size_t x = 0; x < pop_size; ++x) {
+
+	    // Create a copy agent_y of the current agent vector
+	    // and modify it to form the trial agent
+	    vec_t agent_y;
+	    agent_y.resize(nvar);
+	    double f_x, cr_x;
+	    make_trial(nvar,x,agent_y,0,f_x,cr_x);
+	    
+	    // If (f(y) < f(x)) then replace the agent in the population 
+	    // with the improved candidate solution, that is, set x = y 
+	    // in the population
+	    double fmin_y;
+	    
+	    fmin_y=func(nvar,agent_y);
+	    if (fmin_y<fmins[x]) {
+	      for (size_t i = 0; i < nvar; ++i) {
+		population[x*nvar+i] = agent_y[i];
+	      }
 	      fmins[x] = fmin_y;
-	    }
-	    if (fmin_y<fmin) {
-	      fmin = fmin_y;
-	      for (size_t i = 0; i<nvar; ++i) {  
-		x0[i] = agent_y[i];
+	      accept_trial(x,f_x,cr_x);
+	      if (fmin_y<fmin) {
+		fmin = fmin_y;
+		for (size_t i = 0; i<nvar; ++i) {  
+		  x0[i] = agent_y[i];
+		}
+		nconverged = 0;
 	      }
-	      nconverged = 0;
 	    }
+	    
 	  }
-
+	  
 	}
+	
 	if (this->verbose > 0)
 	  this->print_iter( nvar, fmin, gen, x0 );
       }
@@ -313,6 +397,140 @@ namespace o2scl {
     /// Random number generator
     rng_gsl gr;
 
+    /// \name Parallel evaluation
+    //@{
+    /// The trial agents for the current generation
+    vec_t trials;
+    /// Function values for \ref trials
+    ubvector fmins_y;
+    /// The differential weight for each trial agent
+    std::vector<double> f_trial;
+    /// The crossover probability for each trial agent
+    std::vector<double> cr_trial;
+    /// User-specified functions, one for each thread
+    std::vector<func_t> func_list;
+    /// Copies of the function for each thread
+    std::vector<func_t> func_th;
+    //@}
+
+    /** \brief Choose the differential weight \c f_x and the
+	crossover probability \c cr_x for agent \c x
+    */
+    virtual void choose_params(size_t x, double &f_x, double &cr_x) {
+      f_x=f;
+      cr_x=cr;
+      return;
+    }
+
+    /** \brief Called when the trial agent for agent \c x,
+	constructed with \c f_x and \c cr_x, has replaced it
+    */
+    virtual void accept_trial(size_t x, double f_x, double cr_x) {
+      return;
+    }
+
+    /** \brief Construct the trial agent for agent \c x and
+	store it in \c y beginning at index \c off
+	
+	The differential weight and crossover probability which were
+	used are stored in \c f_x and \c cr_x.
+    */
+    void make_trial(size_t nvar, size_t x, vec_t &y, size_t off,
+		    double &f_x, double &cr_x) {
+
+      // Start with a copy of the current agent
+      for (size_t i = 0; i < nvar; ++i) {
+	y[off+i] = population[x*nvar+i];
+      }
+
+      // Value of f and cr for this agent
+      choose_params(x,f_x,cr_x);
+      
+      // Pick three agents a, b, and c from the population at 
+      // random, they must be distinct from each other as well as
+      // from agent x
+      std::vector<int> others = pick_unique_agents( 3, x );
+      
+      // Pick a random index R in {1, ..., n}, where the highest 
+      // possible value n is the dimensionality of the problem 
+      // to be optimized.
+      size_t r = floor(gr.random()*nvar);
+      
+      for (size_t i = 0; i < nvar; ++i) {
+	// Pick ri~U(0,1) uniformly from the open range (0,1)
+	double ri = gr.random();
+	// If (i=R) or (ri<CR) let yi = ai + F(bi - ci), otherwise 
+	// let yi = xi
+	if (i == r || ri < cr_x) {
+	  y[off+i] = population[others[0]*nvar+i] + 
+	    f_x*(population[others[1]*nvar+i]-
+		 population[others[2]*nvar+i]);
+	}
+      }
+      
+      return;
+    }
+
+    /** \brief Evaluate the function for the \ref pop_size agents
+	stored in \c agents, storing the results in \ref fmins_y
+    */
+    void eval_para(size_t nvar, const vec_t &agents, func_t &func) {
+
+      fmins_y.resize(pop_size);
+      
+      size_t nt=n_threads;
+      if (func_list.size()>0 && func_list.size()<nt) nt=func_list.size();
+      if (nt>pop_size) nt=pop_size;
+      if (nt==0) nt=1;
+      
+      // Each thread has its own function and agent
+      func_th.resize(nt);
+      std::vector<vec_t> agent(nt);
+      for(size_t it=0;it<nt;it++) {
+	if (func_list.size()>0) func_th[it]=func_list[it];
+	else func_th[it]=func;
+	agent[it].resize(nvar);
+      }
+
+      bool thrown=false;
+      std::string err_msg;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+      for (size_t x = 0; x < pop_size; ++x) {
+	size_t it=0;
+#ifdef O2SCL_OPENMP
+	it=omp_get_thread_num();
+#endif
+	for (size_t i = 0; i < nvar; ++i) {
+	  agent[it][i]=agents[x*nvar+i];
+	}
+	try {
+	  fmins_y[x]=func_th[it](nvar,agent[it]);
+	} catch (std::exception &e) {
+	  fmins_y[x]=0.0;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (diff_evo_error)
+#endif
+	  {
+	    if (thrown==false) {
+	      thrown=true;
+	      err_msg=e.what();
+	    }
+	  }
+	}
+      }
+
+      if (thrown) {
+	err_msg=((std::string)"Function failed in ")+
+	  "diff_evo::eval_para(): "+err_msg;
+	O2SCL_ERR(err_msg.c_str(),exc_efailed);
+      }
+      
+      return;
+    }
+
     /** \brief Initialize a population of random agents
      */
     virtual int initialize_population( size_t nvar, vec_t &x0 ) {
@@ -81,6 +81,34 @@ int main(int argc, char *argv[]) {
   t.test_rel(init[1],-3.0,1.0e-2,"another test - value 2");
   t.test_rel(result,-1.0,1.0e-2,"another test - min");
 
+  // Parallel generations, for which the result is the same
+  // for any number of threads
+  ubvector init2(2), init3(2);
+  double result2, result3;
+  {
+    diff_evo<multi_funct> de2;
+    de2.set_init_function(init_f);
+    de2.n_threads=2;
+    gr.set_seed(10);
+    de2.mmin(2,init2,result2,fx);
+  }
+  {
+    diff_evo<multi_funct> de3;
+    de3.set_init_function(init_f);
+    de3.n_threads=3;
+    std::vector<multi_funct> vf(3,fx);
+    de3.set_thread_functions(vf);
+    gr.set_seed(10);
+    de3.mmin(2,init3,result3,fx);
+  }
+  cout << "x: " << init2[0] << " " << init2[1] 
+       << ", minimum function value: " << result2 << endl;
+  t.test_rel(init2[0],2.0,1.0e-2,"parallel - value");
+  t.test_rel(init2[1],-3.0,1.0e-2,"parallel - value 2");
+  t.test_rel(result2,-1.0,1.0e-2,"parallel - min");
+  t.test_gen(init2[0]==init3[0] && init2[1]==init3[1] &&
+	     result2==result3,"parallel - thread independence");
+
   t.report();
   
   return 0;
@@ -28,6 +28,8 @@
 */
 
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
@@ -48,9 +50,203 @@ namespace o2scl {
     (size_t,double,boost::numeric::ublas::matrix_row
      <boost::numeric::ublas::matrix<double> > &)> ode_it_funct;
   
+  /** \brief Band storage and linear solver for the relaxation
+      equations in \ref ode_it_solve
+
+      The matrix of the linearized finite-difference equations in
+      \ref ode_it_solve has a staircase structure: the \c nb_left rows
+      of left boundary conditions involve only the first grid point,
+      each of the <tt>n_grid-1</tt> blocks of <tt>n_eq</tt> rows for
+      the interior points involves only two neighboring grid points,
+      and the <tt>n_eq-nb_left</tt> rows for the right boundary
+      conditions involve only the last grid point. All of the
+      nonzero entries are thus contained in a band with
+      \f$ k_l = n_{\mathrm{left}}+n_{\mathrm{eq}}-1 \f$ subdiagonals
+      and \f$ k_u = 2 n_{\mathrm{eq}}-n_{\mathrm{left}}-1 \f$
+      superdiagonals.
+
+      This class stores the band row by row in a contiguous array,
+      with \f$ k_l \f$ additional superdiagonals to hold the fill-in
+      created by row interchanges, and solves the linear system
+      with Gaussian elimination using partial pivoting restricted
+      to the band (as in LAPACK's <tt>dgbtrf</tt>). For \f$ N \f$
+      variables, this requires \f$ {\cal O}(N n_{\mathrm{eq}}) \f$
+      memory and \f$ {\cal O}(N n_{\mathrm{eq}}^2) \f$ operations
+      rather than the \f$ {\cal O}(N^2) \f$ memory and \f$ {\cal
+      O}(N^3) \f$ operations required by a dense solver.
+  */
+  class ode_it_band {
+
+  public:
+
+    ode_it_band() {
+      n=0;
+      kl=0;
+      ku=0;
+      ld=0;
+    }
+
+    /** \brief Allocate storage for the system with \c n_grid grid
+	points, \c n_eq equations, and \c nb_left left boundary
+	conditions
+    */
+    void set_size(size_t n_grid, size_t n_eq, size_t nb_left) {
+      if (n_grid<2 || n_eq==0 || nb_left>n_eq) {
+	O2SCL_ERR("Invalid sizes in ode_it_band::set_size().",
+		  o2scl::exc_einval);
+      }
+      n=n_grid*n_eq;
+      kl=nb_left+n_eq-1;
+      ku=2*n_eq-nb_left-1;
+      ld=2*kl+ku+1;
+      ab.resize(n*ld);
+      ipiv.resize(n);
+      return;
+    }
+
+    /// Return the number of rows and columns
+    size_t size() const {
+      return n;
+    }
+
+    /// Set all of the stored entries to zero
+    void zero() {
+      std::fill(ab.begin(),ab.end(),0.0);
+      return;
+    }
+
+    /** \brief Return a reference to the entry in row \c i and 
+	column \c j, which must lie inside the band
+    */
+    double &operator()(size_t i, size_t j) {
+#if !O2SCL_NO_RANGE_CHECK
+      if (i>=n || j>=n || j+kl<i || j>i+ku) {
+	O2SCL_ERR("Entry outside band in ode_it_band::operator().",
+		  o2scl::exc_eindex);
+      }
+#endif
+      return ab[i*ld+j+kl-i];
+    }
+
+    /** \brief Return the entry in row \c i and column \c j, or
+	zero if it lies outside the band
+    */
+    double get(size_t i, size_t j) const {
+      if (j+kl<i || j>i+ku) return 0.0;
+      return ab[i*ld+j+kl-i];
+    }
+
+    /** \brief Solve the linear system with right-hand side \c b,
+	placing the result in \c x
+
+	The stored matrix is overwritten by its LU decomposition.
+	If the matrix is singular, the error handler is called.
+    */
+    template<class vec_t, class vec2_t>
+      void solve(const vec_t &b, vec2_t &x) {
+
+      // The rightmost column of U in each row
+      size_t kw=kl+ku;
+
+      // LU decomposition with partial pivoting
+      for(size_t k=0;k<n;k++) {
+	size_t iend=std::min(n-1,k+kl);
+	size_t jend=std::min(n-1,k+kw);
+
+	// Find the pivot
+	size_t p=k;
+	double amax=fabs(at(k,k));
+	for(size_t i=k+1;i<=iend;i++) {
+	  if (fabs(at(i,k))>amax) {
+	    amax=fabs(at(i,k));
+	    p=i;
+	  }
+	}
+	ipiv[k]=p;
+	if (amax==0.0) {
+	  O2SCL_ERR("Matrix singular in ode_it_band::solve().",
+		    o2scl::exc_esing);
+	  return;
+	}
+	if (p!=k) {
+	  for(size_t j=k;j<=jend;j++) std::swap(at(k,j),at(p,j));
+	}
+
+	// Eliminate the entries below the diagonal
+	double *rowk=&ab[k*ld+kl-k];
+	for(size_t i=k+1;i<=iend;i++) {
+	  double *rowi=&ab[i*ld+kl-i];
+	  double l=rowi[k]/rowk[k];
+	  rowi[k]=l;
+	  if (l!=0.0) {
+	    for(size_t j=k+1;j<=jend;j++) rowi[j]-=l*rowk[j];
+	  }
+	}
+      }
+
+      // Forward substitution
+      std::vector<double> z(n);
+      for(size_t i=0;i<n;i++) z[i]=b[i];
+      for(size_t k=0;k<n;k++) {
+	if (ipiv[k]!=k) std::swap(z[k],z[ipiv[k]]);
+	size_t iend=std::min(n-1,k+kl);
+	for(size_t i=k+1;i<=iend;i++) z[i]-=at(i,k)*z[k];
+      }
+
+      // Back substitution
+      for(size_t k=n;k>0;k--) {
+	size_t i=k-1;
+	const double *rowi=&ab[i*ld+kl-i];
+	size_t jend=std::min(n-1,i+kw);
+	double sum=z[i];
+	for(size_t j=i+1;j<=jend;j++) sum-=rowi[j]*z[j];
+	z[i]=sum/rowi[i];
+      }
+      for(size_t i=0;i<n;i++) x[i]=z[i];
+
+      return;
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The number of rows and columns
+    size_t n;
+    /// The number of subdiagonals
+    size_t kl;
+    /// The number of superdiagonals
+    size_t ku;
+    /// The number of stored entries in each row
+    size_t ld;
+    /// The band entries
+    std::vector<double> ab;
+    /// The row interchanges from the decomposition
+    std::vector<size_t> ipiv;
+
+    /// Unchecked access to the entry in row \c i and column \c j
+    double &at(size_t i, size_t j) {
+      return ab[i*ld+j+kl-i];
+    }
+
+#endif
+
+  };
+
   /** \brief ODE solver using a generic linear solver to solve 
       finite-difference equations
 
+      The functions \ref solve() and \ref solve_derivs() which take
+      a matrix argument construct the full matrix of size
+      <tt>[n_grid*n_eq][n_grid*n_eq]</tt> and solve the linear
+      equations with the generic linear solver specified with \ref
+      set_solver(). The versions without a matrix argument store
+      only the nonzero band of the matrix in \ref band and use the
+      band solver in \ref ode_it_band, which requires memory and
+      time proportional to the number of grid points and is thus
+      much faster for large grids. The dense versions are retained
+      mostly for comparison.
+
       \future Set up convergence error if it goes beyond max iterations
       \future Create a GSL-like set() and iterate() interface
       \future Implement as a child of ode_bv_solve ?
@@ -135,31 +331,23 @@ namespace o2scl {
   int solve(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
 	    mat_t &y, func_t &derivs, func_t &left, func_t &right,
 	    solver_mat_t &mat, solver_vec_t &rhs, solver_vec_t &dy) {
+    return solve_fd(n_grid,n_eq,nb_left,x,y,derivs,left,right,mat,rhs,dy);
+  }
 
-    // Store the functions for simple derivatives
-    fd=&derivs;
-    fl=&left;
-    fr=&right;
-    
-    /// Function derivatives for iterative solving of ODEs
-    typedef std::function<double
-      (size_t,size_t,double,matrix_row_t &)> ode_it_dfunct;
-    
-    ode_it_dfunct d2_derivs=std::bind
-      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
-       (&ode_it_solve::fd_derivs),this,std::placeholders::_1,
-       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
-    ode_it_dfunct d2_left=std::bind
-      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
-       (&ode_it_solve::fd_left),this,std::placeholders::_1,
-       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
-    ode_it_dfunct d2_right=std::bind
-      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
-       (&ode_it_solve::fd_right),this,std::placeholders::_1,
-       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
+  /** \brief Solve \c derivs with boundary conditions \c left and 
+      \c right using the band solver
 
-    return solve_derivs(n_grid,n_eq,nb_left,x,y,derivs,left,right,
-			d2_derivs,d2_left,d2_right,mat,rhs,dy);
+      This function is the same as the version of \ref solve() 
+      above, except that the matrix is stored in \ref band and
+      solved with \ref ode_it_band::solve(), so no dense matrix
+      workspace is required. The vectors \c rhs and \c dy are
+      workspace of size <tt>[n_grid*n_eq]</tt>.
+  */
+  int solve(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
+	    mat_t &y, func_t &derivs, func_t &left, func_t &right,
+	    solver_vec_t &rhs, solver_vec_t &dy) {
+    band.set_size(n_grid,n_eq,nb_left);
+    return solve_fd(n_grid,n_eq,nb_left,x,y,derivs,left,right,band,rhs,dy);
   }
 
   /** \brief Solve \c derivs with boundary conditions \c left and 
@@ -185,6 +373,120 @@ namespace o2scl {
 		   mat_t &y, func_t &derivs, func_t &left, func_t &right,
 		   dfunc_t &d_derivs, dfunc_t &d_left, dfunc_t &d_right,
 		   solver_mat_t &mat, solver_vec_t &rhs, solver_vec_t &dy) {
+    return iterate(n_grid,n_eq,nb_left,x,y,derivs,left,right,
+		   d_derivs,d_left,d_right,mat,rhs,dy);
+  }
+
+  /** \brief Solve \c derivs with boundary conditions \c left and 
+      \c right with the specified derivatives using the band solver
+
+      This function is the same as the version of \ref
+      solve_derivs() above, except that the matrix is stored in
+      \ref band and solved with \ref ode_it_band::solve().
+  */
+  template<class dfunc_t>
+  int solve_derivs(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
+		   mat_t &y, func_t &derivs, func_t &left, func_t &right,
+		   dfunc_t &d_derivs, dfunc_t &d_left, dfunc_t &d_right,
+		   solver_vec_t &rhs, solver_vec_t &dy) {
+    band.set_size(n_grid,n_eq,nb_left);
+    return iterate(n_grid,n_eq,nb_left,x,y,derivs,left,right,
+		   d_derivs,d_left,d_right,band,rhs,dy);
+  }
+  
+  /// Default linear solver
+  o2scl_linalg::linear_solver_HH<solver_vec_t,solver_mat_t> def_solver;
+
+  /// Storage for the band solver
+  ode_it_band band;
+  
+  protected:
+  
+  /** \brief Construct the finite-differenced derivatives and 
+      call \ref iterate() with matrix storage \c mat
+  */
+  template<class smat_t>
+  int solve_fd(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
+	       mat_t &y, func_t &derivs, func_t &left, func_t &right,
+	       smat_t &mat, solver_vec_t &rhs, solver_vec_t &dy) {
+
+    // Store the functions for simple derivatives
+    fd=&derivs;
+    fl=&left;
+    fr=&right;
+    
+    /// Function derivatives for iterative solving of ODEs
+    typedef std::function<double
+      (size_t,size_t,double,matrix_row_t &)> ode_it_dfunct;
+    
+    ode_it_dfunct d2_derivs=std::bind
+      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
+       (&ode_it_solve::fd_derivs),this,std::placeholders::_1,
+       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
+    ode_it_dfunct d2_left=std::bind
+      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
+       (&ode_it_solve::fd_left),this,std::placeholders::_1,
+       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
+    ode_it_dfunct d2_right=std::bind
+      (std::mem_fn<double(size_t,size_t,double,matrix_row_t &)>
+       (&ode_it_solve::fd_right),this,std::placeholders::_1,
+       std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
+
+    return iterate(n_grid,n_eq,nb_left,x,y,derivs,left,right,
+		   d2_derivs,d2_left,d2_right,mat,rhs,dy);
+  }
+
+  /// \name Matrix operations for dense and band storage
+  //@{
+  /// Set the dense matrix to zero
+  void mat_zero(size_t nvars, solver_mat_t &mat) {
+    for(size_t i=0;i<nvars;i++) {
+      for(size_t j=0;j<nvars;j++) {
+	mat(i,j)=0.0;
+      }
+    }
+    return;
+  }
+
+  /// Set the band matrix to zero
+  void mat_zero(size_t nvars, ode_it_band &mat) {
+    mat.zero();
+    return;
+  }
+
+  /// Get an entry of the dense matrix
+  double mat_get(solver_mat_t &mat, size_t i, size_t j) {
+    return mat(i,j);
+  }
+
+  /// Get an entry of the band matrix
+  double mat_get(ode_it_band &mat, size_t i, size_t j) {
+    return mat.get(i,j);
+  }
+
+  /// Solve the dense linear system with the generic linear solver
+  void mat_solve(size_t nvars, solver_mat_t &mat, solver_vec_t &rhs,
+		 solver_vec_t &dy) {
+    solver->solve(nvars,mat,rhs,dy);
+    return;
+  }
+
+  /// Solve the banded linear system
+  void mat_solve(size_t nvars, ode_it_band &mat, solver_vec_t &rhs,
+		 solver_vec_t &dy) {
+    mat.solve(rhs,dy);
+    return;
+  }
+  //@}
+
+  /** \brief Perform the relaxation iterations using matrix
+      storage \c mat
+  */
+  template<class dfunc_t, class smat_t>
+  int iterate(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
+	      mat_t &y, func_t &derivs, func_t &left, func_t &right,
+	      dfunc_t &d_derivs, dfunc_t &d_left, dfunc_t &d_right,
+	      smat_t &mat, solver_vec_t &rhs, solver_vec_t &dy) {
 
     // Variable index
     size_t ix;
@@ -200,11 +502,7 @@ namespace o2scl {
       
       ix=0;
       
-      for(size_t i=0;i<nvars;i++) {
-	for(size_t j=0;j<nvars;j++) {
-	  mat(i,j)=0.0;
-	}
-      }
+      mat_zero(nvars,mat);
 
       // Construct the entries corresponding to the LHS boundary. 
       // This makes the first nb_left rows of the matrix.
@@ -269,7 +567,7 @@ namespace o2scl {
 	std::cout << "Matrix: " << std::endl;
 	for(size_t i=0;i<nvars;i++) {
 	  for(size_t j=0;j<nvars;j++) {
-	    std::cout << mat(i,j) << " ";
+	    std::cout << mat_get(mat,i,j) << " ";
 	  }
 	  std::cout << std::endl;
 	}
@@ -281,7 +579,7 @@ namespace o2scl {
 
       if (make_mats) return 0;
 
-      solver->solve(ix,mat,rhs,dy);
+      mat_solve(ix,mat,rhs,dy);
 
       if (verbose>3) {
 	std::cout << "Corrections:" << std::endl;
@@ -331,11 +629,7 @@ namespace o2scl {
     return 0;
   }
   
-  /// Default linear solver
-  o2scl_linalg::linear_solver_HH<solver_vec_t,solver_mat_t> def_solver;
-  
-  protected:
-  
+
   /// \name Storage for functions
   //@{
   func_t *fl, *fr, *fd;
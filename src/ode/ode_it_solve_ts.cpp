@@ -464,6 +464,125 @@ int main(void) {
   
   }
 
+  // Compare the band solver with the dense solver for systems 3
+  // and 4, which have different numbers of left boundary conditions
+  {
+    fc3 f3;
+    fc4 f4;
+    
+    for(size_t isys=0;isys<2;isys++) {
+      
+      ode_it_funct fd, fl, fr;
+      if (isys==0) {
+	fd=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc3::derivs),&f3,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+	fl=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc3::left),&f3,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+	fr=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc3::right),&f3,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+      } else {
+	fd=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc4::derivs),&f4,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+	fl=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc4::left),&f4,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+	fr=std::bind(std::mem_fn<double(size_t,double,ubmatrix_row &)>
+		     (&fc4::right),&f4,std::placeholders::_1,
+		     std::placeholders::_2,std::placeholders::_3);
+      }
+      size_t nb_left=2-isys;
+
+      size_t ng=41;
+      ubvector x(ng);
+      ubmatrix y(ng,3), y2(ng,3);
+      for(size_t i=0;i<ng;i++) {
+	x[i]=((double)i)/((double)(ng-1));
+	if (isys==0) {
+	  y(i,0)=1.0+x[i]+1.0;
+	  y(i,1)=3.0*x[i];
+	  y(i,2)=-0.1*x[i]-1.4;
+	} else {
+	  y(i,0)=x[i];
+	  y(i,1)=1.5*x[i]+0.5;
+	  y(i,2)=-x[i]-0.6;
+	}
+	for(size_t j=0;j<3;j++) y2(i,j)=y(i,j);
+      }
+      
+      ubmatrix A(ng*3,ng*3);
+      ubvector rhs(ng*3), dy(ng*3);
+
+      ode_it_solve<> oit;
+      oit.solve(ng,3,nb_left,x,y,fd,fl,fr,A,rhs,dy);
+      oit.solve(ng,3,nb_left,x,y2,fd,fl,fr,rhs,dy);
+
+      double max_diff=0.0;
+      for(size_t i=0;i<ng;i++) {
+	for(size_t j=0;j<3;j++) {
+	  double diff=fabs(y(i,j)-y2(i,j));
+	  if (diff>max_diff) max_diff=diff;
+	}
+      }
+      t.test_abs(max_diff,0.0,1.0e-10,"band vs. dense");
+    }
+  }
+
+  // System 1 on a large grid with the band solver
+  {
+    size_t ng=20001;
+    ubvector x(ng);
+    ubmatrix y(ng,2);
+    for(size_t i=0;i<ng;i++) {
+      x[i]=((double)i)/((double)(ng-1));
+      y(i,0)=2.0*x[i];
+      y(i,1)=1.0+x[i]/2;
+    }
+  
+    ubvector rhs(ng*2), dy(ng*2);
+    fc1 f1;
+
+    ode_it_funct f_derivs=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::derivs),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+    ode_it_funct f_left=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::left),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+    ode_it_funct f_right=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::right),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+
+    ode_it_solve<> oit;
+    oit.solve(ng,2,1,x,y,f_derivs,f_left,f_right,rhs,dy);
+
+    // Compare to exact solution
+    double sol1, sol2;
+    for(size_t kk=0;kk<ng;kk+=1000) {
+      double z=x[kk];
+      sol1=2.0*exp(0.5*(z-s5*z))/
+	(5.0*sqrt(exp(1.0))+(5.0+s5)*exp(0.5+s5)-
+	 sqrt(5.0*exp(1.0)))*
+	(-(-5.0+s5)*exp(s5/2.0)-s5*exp(0.5+s5)+
+	 (5.0+s5)*exp(0.5*s5*(1.0+2.0*z))+
+	 s5*exp(0.5+s5*z));
+      sol2=exp(0.5*(z-s5*z))/
+	(5.0*sqrt(exp(1.0))+(5.0+s5)*exp(0.5+s5)-
+	 sqrt(5.0*exp(1.0)))*
+	(-4.0*s5*exp(s5/2.0)+(5.0+s5)*exp(0.5+s5)+
+	 4.0*s5*exp(0.5*s5*(1.0+2.0*z))-
+	 (-5.0+s5)*exp(0.5+s5*z));
+      t.test_rel(y(kk,0),sol1,1.0e-6,"sys1 band 1");
+      t.test_rel(y(kk,1),sol2,1.0e-6,"sys1 band 2");
+    }
+  
+  }
+
 #ifdef O2SCL_NEVER_DEFINED
 
 #ifdef O2SCL_ARMA
@@ -40,6 +40,7 @@
 #include <o2scl/vec_stats.h>
 #include <o2scl/linear_solver.h>
 #include <o2scl/columnify.h>
+#include <o2scl/kd_tree.h>
 
 #ifndef DOXYGEN_NO_O2NS
 namespace o2scl {
@@ -88,6 +89,19 @@ namespace o2scl {
       of data points) without a new call to \ref set_data(). Also, the
       automatically-determined length scales may need to be recomputed
       by calling \ref auto_scale().
+
+      By default, each interpolation computes the distance to every
+      point. For large data sets, a \ref kd_tree of the rescaled
+      points can be used instead by calling \ref set_use_tree()
+      (either before or after \ref set_data() ). The tree gives
+      exactly the same nearest points, is rebuilt whenever the data
+      or the length scales are changed through the member functions,
+      and allows new points to be added with \ref add_point(). If
+      the data is modified externally while the tree is in use,
+      \ref build_tree() must be called. The function \ref
+      eval_batch() interpolates several points at once, and uses
+      OpenMP to distribute them over threads if \c O2SCL_OPENMP is
+      defined.
   */
   template<class vec_t> class interpm_idw {
 
@@ -105,6 +119,7 @@ namespace o2scl {
       scales[0]=1.0;
       order=3;
       verbose=0;
+      use_tree=false;
     }
 
     /** \brief Verbosity parameter (default 0)
@@ -141,6 +156,39 @@ namespace o2scl {
       }
       scales.resize(n);
       o2scl::vector_copy(n,v,scales);
+      if (use_tree && data_set) build_tree();
+      return;
+    }
+
+    /** \brief If true, use a \ref kd_tree for the nearest-neighbor
+	searches (default false)
+    */
+    void set_use_tree(bool flag) {
+      use_tree=flag;
+      if (use_tree && data_set) {
+	build_tree();
+      } else {
+	tree.clear();
+      }
+      return;
+    }
+
+    /** \brief Rebuild the \ref kd_tree from the current data
+	and length scales
+    */
+    void build_tree() {
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interpm_idw::build_tree().",
+		  exc_einval);
+      }
+      size_t nscales=scales.size();
+      std::vector<double> coords(np*nd_in);
+      for(size_t i=0;i<np;i++) {
+	for(size_t j=0;j<nd_in;j++) {
+	  coords[i*nd_in+j]=ptrs[j][i]/scales[j%nscales];
+	}
+      }
+      tree.set_points(np,nd_in,coords);
       return;
     }
     
@@ -178,11 +226,45 @@ namespace o2scl {
 
       if (auto_scale_flag) {
 	auto_scale();
+      } else if (use_tree) {
+	build_tree();
       }
 
       return;
     }
 
+    /** \brief Add a point to the data
+
+	The vector \c p must contain the \c n_in input coordinates
+	followed by the \c n_out output values. The length scales
+	are not recomputed. This function requires that \c vec_t has
+	a <tt>resize()</tt> method which preserves the existing
+	entries.
+    */
+    template<class vec2_t> void add_point(const vec2_t &p) {
+      
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interpm_idw::add_point().",
+		  exc_einval);
+      }
+      for(size_t i=0;i<nd_in+nd_out;i++) {
+	ptrs[i].resize(np+1);
+	ptrs[i][np]=p[i];
+      }
+      np++;
+      
+      if (use_tree) {
+	size_t nscales=scales.size();
+	std::vector<double> sp(nd_in);
+	for(size_t j=0;j<nd_in;j++) {
+	  sp[j]=p[j]/scales[j%nscales];
+	}
+	tree.insert(sp);
+      }
+      
+      return;
+    }
+
     /** \brief Get the data used for interpolation
      */
     template<class vec_vec_t>
@@ -200,6 +282,7 @@ namespace o2scl {
       n_in=0;
       n_out=0;
       ptrs.clear();
+      tree.clear();
       return;
     }
     
@@ -212,6 +295,7 @@ namespace o2scl {
 	scales[i]=fabs(o2scl::vector_max_value<vec_t,double>(np,ptrs[i])-
 		       o2scl::vector_min_value<vec_t,double>(np,ptrs[i]));
       }
+      if (use_tree) build_tree();
       return;
     }
     
@@ -245,32 +329,26 @@ namespace o2scl {
 		  exc_einval);
       }
     
-      // Compute distances
-      std::vector<double> dists(np);
-      for(size_t i=0;i<np;i++) {
-	dists[i]=dist(i,x);
-      }
-
-      // Find closest points
+      // Find closest points and their distances
       std::vector<size_t> index;
-      o2scl::vector_smallest_index<std::vector<double>,double,
-	std::vector<size_t> >(dists,order,index);
+      std::vector<double> dists;
+      nearest_points(x,order,index,dists);
 
       // Check if the closest distance is zero
-      if (dists[index[0]]<=0.0) {
+      if (dists[0]<=0.0) {
 	return ptrs[nd_in][index[0]];
       }
 
       // Compute normalization
       double norm=0.0;
       for(size_t i=0;i<order;i++) {
-	norm+=1.0/dists[index[i]];
+	norm+=1.0/dists[i];
       }
 
       // Compute the inverse-distance weighted average
       double ret=0.0;
       for(size_t i=0;i<order;i++) {
-	ret+=ptrs[nd_in][index[i]]/dists[index[i]];
+	ret+=ptrs[nd_in][index[i]]/dists[i];
       }
       ret/=norm;
 
@@ -289,18 +367,12 @@ namespace o2scl {
 		  exc_einval);
       }
       
-      // Compute distances
-      std::vector<double> dists(np);
-      for(size_t i=0;i<np;i++) {
-	dists[i]=dist(i,x);
-      }
-
-      // Find closest points
+      // Find closest points and their distances
       std::vector<size_t> index;
-      o2scl::vector_smallest_index<std::vector<double>,double,
-	std::vector<size_t> >(dists,order+1,index);
+      std::vector<double> dists;
+      nearest_points(x,order+1,index,dists);
 
-      if (dists[index[0]]<=0.0) {
+      if (dists[0]<=0.0) {
 
 	// If the closest distance is zero, just set the value
 	val=ptrs[nd_in][index[0]];
@@ -316,14 +388,14 @@ namespace o2scl {
 	  // Compute normalization
 	  double norm=0.0;
 	  for(size_t i=0;i<order+1;i++) {
-	    if (i!=j) norm+=1.0/dists[index[i]];
+	    if (i!=j) norm+=1.0/dists[i];
 	  }
 	  
 	  // Compute the inverse-distance weighted average
 	  vals[j]=0.0;
 	  for(size_t i=0;i<order+1;i++) {
 	    if (i!=j) {
-	      vals[j]+=ptrs[nd_in][index[i]]/dists[index[i]];
+	      vals[j]+=ptrs[nd_in][index[i]]/dists[i];
 	    }
 	  }
 	  vals[j]/=norm;
@@ -357,16 +429,10 @@ namespace o2scl {
 	std::cout << std::endl;
       }
       
-      // Compute distances
-      std::vector<double> dists(np);
-      for(size_t i=0;i<np;i++) {
-	dists[i]=dist(i,x);
-      }
-
-      // Find closest points
+      // Find closest points and their distances
       std::vector<size_t> index;
-      o2scl::vector_smallest_index<std::vector<double>,double,
-	std::vector<size_t> >(dists,order,index);
+      std::vector<double> dists;
+      nearest_points(x,order,index,dists);
       if (verbose>0) {
 	for(size_t i=0;i<order;i++) {
 	  std::cout << "interpm_idw: closest point: ";
@@ -379,7 +445,7 @@ namespace o2scl {
       
       // Check if the closest distance is zero, if so, just
       // return the value
-      if (dists[index[0]]<=0.0) {
+      if (dists[0]<=0.0) {
 	for(size_t i=0;i<nd_out;i++) {
 	  y[i]=ptrs[nd_in+i][index[0]];
 	}
@@ -395,7 +461,7 @@ namespace o2scl {
       // Compute normalization
       double norm=0.0;
       for(size_t i=0;i<order;i++) {
-	norm+=1.0/dists[index[i]];
+	norm+=1.0/dists[i];
       }
       if (verbose>0) {
 	std::cout << "interpm_idw: norm is " << norm << std::endl;
@@ -412,12 +478,12 @@ namespace o2scl {
 	    }
 	    std::cout << std::endl;
 	  }
-	  y[j]+=ptrs[nd_in+j][index[i]]/dists[index[i]];
+	  y[j]+=ptrs[nd_in+j][index[i]]/dists[i];
 	  if (verbose>0) {
 	    std::cout << "interpm_idw: j,order,value,1/dist: "
 		      << j << " " << i << " "
 		      << ptrs[nd_in+j][index[i]] << " "
-		      << 1.0/dists[index[i]] << std::endl;
+		      << 1.0/dists[i] << std::endl;
 	  }
 	}
 	y[j]/=norm;
@@ -444,17 +510,11 @@ namespace o2scl {
 		  exc_einval);
       }
       
-      // Compute distances
-      std::vector<double> dists(np);
-      for(size_t i=0;i<np;i++) {
-	dists[i]=dist(i,x);
-      }
-
-      // Find closest points
-      o2scl::vector_smallest_index<std::vector<double>,double,
-	std::vector<size_t> >(dists,order+1,index);
+      // Find closest points and their distances
+      std::vector<double> dists;
+      nearest_points(x,order+1,index,dists);
 
-      if (dists[index[0]]<=0.0) {
+      if (dists[0]<=0.0) {
 
 	// If the closest distance is zero, just set the values and
 	// errors
@@ -475,14 +535,14 @@ namespace o2scl {
 	    // Compute normalization
 	    double norm=0.0;
 	    for(size_t i=0;i<order+1;i++) {
-	      if (i!=j) norm+=1.0/dists[index[i]];
+	      if (i!=j) norm+=1.0/dists[i];
 	    }
 	    
 	    // Compute the inverse-distance weighted average
 	    vals[j]=0.0;
 	    for(size_t i=0;i<order+1;i++) {
 	      if (i!=j) {
-		vals[j]+=ptrs[nd_in+k][index[i]]/dists[index[i]];
+		vals[j]+=ptrs[nd_in+k][index[i]]/dists[i];
 	      }
 	    }
 	    vals[j]/=norm;
@@ -503,6 +563,37 @@ namespace o2scl {
       return;
     }
     
+    /** \brief Perform the interpolation over all the functions
+	for \c n points 
+
+	The input points are taken from the rows of \c x, which
+	must have \c n rows and (at least) \c n_in columns, and the
+	results are stored in the rows of \c y, which must have
+	\c n rows and \c n_out columns. If \c O2SCL_OPENMP is
+	defined, the points are distributed over the available
+	threads.
+    */
+    template<class mat_t, class mat2_t>
+      void eval_batch(size_t n, const mat_t &x, mat2_t &y) const {
+      
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interpm_idw::eval_batch().",
+		  exc_einval);
+      }
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(int i=0;i<((int)n);i++) {
+	ubvector xi(nd_in), yi(nd_out);
+	for(size_t j=0;j<nd_in;j++) xi[j]=x(i,j);
+	eval(xi,yi);
+	for(size_t j=0;j<nd_out;j++) y(i,j)=yi[j];
+      }
+      
+      return;
+    }
+    
     /** \brief Perform the interpolation over all the functions
 	with uncertainties
     */
@@ -544,15 +635,10 @@ namespace o2scl {
       // The linear solver
       o2scl_linalg::linear_solver_HH<> lshh;
     
-      // Compute distances
-      std::vector<double> dists(np);
-      for(size_t i=0;i<np;i++) {
-	dists[i]=dist(i,x);
-      }
-  
       // Find closest (but not identical) points
 
       std::vector<size_t> index;
+      std::vector<double> dists;
       size_t max_smallest=(nd_in+2)*2;
       if (max_smallest>np) max_smallest=np;
       if (max_smallest<nd_in+1) {
@@ -563,20 +649,21 @@ namespace o2scl {
 	std::cout << "max_smallest: " << max_smallest << std::endl;
       }
       
-      o2scl::vector_smallest_index<std::vector<double>,double,
-	std::vector<size_t> >(dists,max_smallest,index);
+      nearest_points(x,max_smallest,index,dists);
 
       if (verbose>0) {
 	for(size_t i=0;i<index.size();i++) {
 	  std::cout << "index[" << i << "] = " << index[i] << " "
-		    << dists[index[i]] << std::endl;
+		    << dists[i] << std::endl;
 	}
       }
       
       std::vector<size_t> index2;
+      std::vector<double> dists2;
       for(size_t i=0;i<max_smallest;i++) {
-	if (dists[index[i]]>0.0) {
+	if (dists[i]>0.0) {
 	  index2.push_back(index[i]);
+	  dists2.push_back(dists[i]);
 	  if (index2.size()==nd_in+1) i=max_smallest;
 	}
       }
@@ -588,7 +675,7 @@ namespace o2scl {
       if (verbose>0) {
 	for(size_t i=0;i<index2.size();i++) {
 	  std::cout << "index2[" << i << "] = " << index2[i] << " "
-		    << dists[index2[i]] << std::endl;
+		    << dists2[i] << std::endl;
 	}
       }
       
@@ -716,6 +803,62 @@ namespace o2scl {
     bool data_set;
     /// Number of points to include in each interpolation (default 3)
     size_t order;
+    /// If true, use \ref tree to find the nearest points
+    bool use_tree;
+    /// The tree of rescaled points
+    kd_tree<double> tree;
+
+    /** \brief Find the \c k points closest to \c x, storing
+	their indices in \c index and their distances in \c dists
+	in order of increasing distance
+    */
+    template<class vec2_t>
+      void nearest_points(const vec2_t &x, size_t k,
+			  std::vector<size_t> &index,
+			  std::vector<double> &dists) const {
+
+      if (use_tree==false) {
+
+	// Compute all of the distances
+	std::vector<double> all(np);
+	for(size_t i=0;i<np;i++) {
+	  all[i]=dist(i,x);
+	}
+	o2scl::vector_smallest_index<std::vector<double>,double,
+	  std::vector<size_t> >(all,k,index);
+	dists.resize(k);
+	for(size_t i=0;i<k;i++) {
+	  dists[i]=all[index[i]];
+	}
+	return;
+      }
+
+      if (k>np) {
+	O2SCL_ERR2("Number of points requested greater than size in ",
+		   "interpm_idw::nearest_points().",exc_einval);
+      }
+
+      // Search the tree using the rescaled point
+      size_t nscales=scales.size();
+      std::vector<double> sx(nd_in), d2;
+      for(size_t j=0;j<nd_in;j++) {
+	sx[j]=x[j]/scales[j%nscales];
+      }
+      tree.nearest(sx,k,index,d2);
+
+      // Recompute the distances exactly as in the brute-force
+      // search and reorder in case round-off changed the order
+      dists.resize(index.size());
+      for(size_t i=0;i<index.size();i++) {
+	dists[i]=dist(index[i],x);
+	for(size_t j=i;j>0 && dists[j]<dists[j-1];j--) {
+	  std::swap(dists[j],dists[j-1]);
+	  std::swap(index[j],index[j-1]);
+	}
+      }
+      
+      return;
+    }
     
     /// Compute the distance between \c x and the point at index \c index
     template<class vec2_t> double dist(size_t index,
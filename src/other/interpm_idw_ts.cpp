@@ -32,6 +32,7 @@ using namespace std;
 using namespace o2scl;
 
 typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
 
 double ft(double x, double y, double z) {
   return 3.0-2.0*x*x+7.0*y*z-5.0*z*x;
@@ -192,6 +193,66 @@ int main(void) {
     cout << endl;
   }
 
+  cout << "Compare brute-force and tree searches." << endl;
+  {
+    size_t N=10000;
+    std::vector<double> x3, y3, z3, f3;
+    for(size_t i=0;i<N;i++) {
+      x3.push_back(rg.random());
+      y3.push_back(2.0*rg.random());
+      z3.push_back(rg.random());
+      f3.push_back(ft(x3[i],y3[i],z3[i]));
+    }
+    std::vector<std::vector<double> > dat3(4), dat4(4);
+    dat3[0]=x3;
+    dat3[1]=y3;
+    dat3[2]=z3;
+    dat3[3]=f3;
+    dat4=dat3;
+    interpm_idw<std::vector<double> > imi_bf, imi_tree;
+    imi_tree.set_use_tree(true);
+    // Use fewer points initially and add the rest afterwards
+    imi_bf.set_data(3,1,N,dat3);
+    imi_tree.set_data(3,1,N-100,dat4);
+    std::vector<double> scales(3);
+    scales[0]=1.0;
+    scales[1]=2.0;
+    scales[2]=1.0;
+    imi_bf.set_scales(3,scales);
+    imi_tree.set_scales(3,scales);
+    for(size_t i=N-100;i<N;i++) {
+      std::vector<double> pt={x3[i],y3[i],z3[i],f3[i]};
+      imi_tree.add_point(pt);
+    }
+
+    ubmatrix pts(20,3), res(20,1);
+    bool match=true;
+    for(size_t k=0;k<20;k++) {
+      std::vector<double> p3={rg.random(),2.0*rg.random(),rg.random()};
+      double val2, err2;
+      imi_bf.eval_err(p3,val,err);
+      imi_tree.eval_err(p3,val2,err2);
+      if (fabs(val-val2)>1.0e-12*fabs(val) ||
+	  fabs(err-err2)>1.0e-10*fabs(err)) {
+	match=false;
+      }
+      for(size_t j=0;j<3;j++) pts(k,j)=p3[j];
+    }
+    t.test_gen(match,"tree vs. brute force");
+
+    // Test the batch interpolation
+    imi_tree.eval_batch(20,pts,res);
+    match=true;
+    for(size_t k=0;k<20;k++) {
+      std::vector<double> p3={pts(k,0),pts(k,1),pts(k,2)};
+      if (fabs(res(k,0)-imi_bf.eval(p3))>1.0e-12*fabs(res(k,0))) {
+	match=false;
+      }
+    }
+    t.test_gen(match,"eval_batch");
+  }
+  cout << endl;
+
   t.report();
   return 0;
 }
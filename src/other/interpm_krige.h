@@ -41,6 +41,7 @@
 #include <o2scl/vector.h>
 #include <o2scl/vec_stats.h>
 #include <o2scl/linear_solver.h>
+#include <o2scl/cholesky.h>
 #include <o2scl/columnify.h>
 
 #ifndef DOXYGEN_NO_O2NS
@@ -49,9 +50,32 @@ namespace o2scl {
 
   /** \brief Multi-dimensional interpolation by kriging
 
+      The weights are obtained by solving the linear system
+      \f$ K_{XX} w = f \f$ for each output function. By default,
+      the covariance matrix is assumed to be symmetric and
+      positive-definite and is factored with \ref
+      o2scl_linalg::cholesky_decomp(). If the Cholesky
+      decomposition fails (e.g. because two points are so close that
+      the matrix is numerically singular), or if Cholesky
+      decomposition has been disabled with \ref set_cholesky(),
+      then an LU decomposition is used instead. In either case, the
+      weights are computed by back-substitution and the inverse of
+      the covariance matrix is never formed.
+
+      If the same covariance function is used for all of the
+      outputs, then the version of \ref set_data() which takes a
+      single covariance function computes and stores only one
+      factorization which is shared by all of the outputs.
+
+      Points can be added after the data is set with \ref
+      add_point(). When the covariance matrix has a Cholesky
+      factorization, the factor is extended by one row, which
+      requires \f$ {\cal O}(N^2) \f$ rather than \f$ {\cal O}(N^3)
+      \f$ operations.
+
       \note This class assumes that the function specified in the
       call to set_data() is the same as that passed to the
-      eval() functions. If this is not the case, the
+      eval() and add_point() functions. If this is not the case, the
       behavior of this class is undefined.
 
       \note Experimental.
@@ -79,94 +103,128 @@ namespace o2scl {
   interpm_krige() {
     data_set=false;
     verbose=0;
+    use_chol=true;
   }
 
   /** \brief Verbosity parameter (default 0)
    */
   int verbose;
 
+  /** \brief If true, try a Cholesky decomposition before 
+      falling back to LU (default true)
+  */
+  void set_cholesky(bool chol) {
+    use_chol=chol;
+    return;
+  }
+
   /** \brief Initialize the data for the interpolation
    */
   template<class vec_vec_t, class vec_vec2_t>
   void set_data(size_t n_in, size_t n_out, size_t n_points,
 		vec_vec_t &x, vec_vec2_t &y, 
 		std::vector<covar_func_t> &fcovar) {
+    set_data_int(n_in,n_out,n_points,x,y,fcovar,false);
+    return;
+  }
+  
+  /** \brief Initialize the data for the interpolation using the
+      same covariance function for all outputs
+  */
+  template<class vec_vec_t, class vec_vec2_t>
+  void set_data(size_t n_in, size_t n_out, size_t n_points,
+		vec_vec_t &x, vec_vec2_t &y, covar_func_t &fcovar) {
+    std::vector<covar_func_t> fv(1,fcovar);
+    set_data_int(n_in,n_out,n_points,x,y,fv,true);
+    return;
+  }
 
-    if (n_points<3) {
-      O2SCL_ERR2("Must provide at least three points in ",
-		 "interpm_krige::set_data()",exc_efailed);
-    }
-    if (n_in<1) {
-      O2SCL_ERR2("Must provide at least one input column in ",
-		 "interpm_krige::set_data()",exc_efailed);
-    }
-    if (n_out<1) {
-      O2SCL_ERR2("Must provide at least one output column in ",
-		 "interpm_krige::set_data()",exc_efailed);
+  /** \brief Add a point to the data
+
+      The vector \c x must have size equal to the number of inputs
+      and the vector \c y must have size equal to the number of
+      outputs.
+  */
+  template<class vec2_t, class vec3_t>
+  void add_point(const vec2_t &x, const vec3_t &y,
+		 std::vector<covar_func_t> &fcovar) {
+    
+    if (data_set==false) {
+      O2SCL_ERR("Data not set in interpm_krige::add_point().",
+		exc_einval);
     }
-    np=n_points;
-    nd_in=n_in;
-    nd_out=n_out;
-    ptrs_x.resize(n_points);
-    for(size_t i=0;i<n_points;i++) {
-      if (x[i].size()!=n_in) {
-	O2SCL_ERR2("Size of x not correct in ",
-		   "interpm_krige::set_data().",o2scl::exc_efailed);
-      }
-      std::swap(ptrs_x[i],x[i]);
+    if (x.size()<nd_in || y.size()<nd_out) {
+      O2SCL_ERR("Vector sizes not correct in interpm_krige::add_point().",
+		exc_einval);
     }
-    data_set=true;
     
-    if (verbose>0) {
-      std::cout << "interpm_krige::set_data() : Using " << n_points
-		<< " points with " << nd_in << " input variables and\n\t"
-		<< nd_out << " output variables." << std::endl;
+    vec_t xnew(nd_in);
+    for(size_t j=0;j<nd_in;j++) xnew[j]=x[j];
+    ptrs_x.push_back(xnew);
+    for(size_t iout=0;iout<nd_out;iout++) {
+      ptrs_y[iout].resize(np+1,true);
+      ptrs_y[iout][np]=y[iout];
     }
 
-    Kinvf.resize(n_out);
-
-    // Loop over all output functions
-    for(size_t iout=0;iout<n_out;iout++) {
+    for(size_t ifact=0;ifact<fact.size();ifact++) {
+      
+      covar_func_t &f=fcovar[fact_out[ifact]];
+      bool updated=false;
+      
+      if (fact_chol[ifact]) {
 	
-      // Construct the KXX matrix
-      ubmatrix KXX(n_points,n_points);
-      for(size_t irow=0;irow<n_points;irow++) {
-	for(size_t icol=0;icol<n_points;icol++) {
-	  if (irow>icol) {
-	    KXX(irow,icol)=KXX(icol,irow);
-	  } else {
-	    KXX(irow,icol)=fcovar[iout](ptrs_x[irow],ptrs_x[icol]);
-	  }
+	// Solve L l = k for the new row of the Cholesky factor
+	ubvector row(np+1);
+	for(size_t i=0;i<np;i++) {
+	  row[i]=f(ptrs_x[np],ptrs_x[i]);
 	}
-      }
+	o2scl_cblas::dtrsv(o2scl_cblas::o2cblas_RowMajor,
+			   o2scl_cblas::o2cblas_Lower, 
+			   o2scl_cblas::o2cblas_NoTrans,
+			   o2scl_cblas::o2cblas_NonUnit,np,np,fact[ifact],row);
+	double diag=f(ptrs_x[np],ptrs_x[np]);
+	for(size_t i=0;i<np;i++) diag-=row[i]*row[i];
 	
-      // Construct the inverse of KXX
-      ubmatrix inv_KXX(n_points,n_points);
-      o2scl::permutation p(n_points);
-      int signum;
-      if (verbose>0) {
-	std::cout << "interpm_krige::set_data() : "
-		  << "LU decompose and invert " << iout+1 << " of " << n_out
-		  << std::endl;
-      }
-      o2scl_linalg::LU_decomp(n_points,KXX,p,signum);
-      if (o2scl_linalg::diagonal_has_zero(n_points,KXX)) {
-	O2SCL_ERR2("KXX matrix is singular in ",
-		   "interpm_krige::set_data().",
-		   o2scl::exc_efailed);
+	if (diag>0.0) {
+	  ubmatrix &L=fact[ifact];
+	  L.resize(np+1,np+1,true);
+	  for(size_t i=0;i<np;i++) {
+	    L(np,i)=row[i];
+	    L(i,np)=row[i];
+	  }
+	  L(np,np)=sqrt(diag);
+	  updated=true;
+	}
       }
-      o2scl_linalg::LU_invert<ubmatrix,ubmatrix,mat_col_t>
-	(n_points,KXX,p,inv_KXX);
 
-      // Inverse covariance matrix times function vector
-      Kinvf[iout].resize(n_points);
-      boost::numeric::ublas::axpy_prod(inv_KXX,y[iout],Kinvf[iout],true);
-	
+      if (updated==false) {
+	// Refactor the full matrix, which is also required for 
+	// an LU decomposition or if the extended matrix is not 
+	// positive-definite
+	factor(ifact,np+1,f);
+      }
     }
-      
+    
+    np++;
+    
+    for(size_t iout=0;iout<nd_out;iout++) {
+      solve_weights(iout);
+    }
+    
     return;
   }
-
+    
+  /** \brief Add a point to the data using the same covariance 
+      function for all outputs
+  */
+  template<class vec2_t, class vec3_t>
+  void add_point(const vec2_t &x, const vec3_t &y,
+		 covar_func_t &fcovar) {
+    std::vector<covar_func_t> fv(nd_out,fcovar);
+    add_point(x,y,fv);
+    return;
+  }
+  
   /** \brief Perform the interpolation
    */
   template<class vec2_t, class vec3_t>
@@ -190,6 +248,34 @@ namespace o2scl {
       
   }
     
+  /** \brief Perform the interpolation using the same covariance
+      function for all outputs
+  */
+  template<class vec2_t, class vec3_t>
+  void eval(const vec2_t &x, vec3_t &y, covar_func_t &fcovar) const {
+    
+    if (data_set==false) {
+      O2SCL_ERR("Data not set in interpm_krige::eval().",
+		exc_einval);
+    }
+
+    // Compute the covariances only once
+    ubvector kx(np);
+    for(size_t ipoints=0;ipoints<np;ipoints++) {
+      kx[ipoints]=fcovar(x,ptrs_x[ipoints]);
+    }
+    
+    y.resize(nd_out);
+    for(size_t iout=0;iout<nd_out;iout++) {
+      y[iout]=0.0;
+      for(size_t ipoints=0;ipoints<np;ipoints++) {
+	y[iout]+=kx[ipoints]*Kinvf[iout][ipoints];
+      }
+    }
+
+    return;
+  }
+  
 #ifndef DOXYGEN_INTERNAL
     
   protected:
@@ -202,11 +288,173 @@ namespace o2scl {
   size_t nd_out;
   /// A vector of pointers holding the data
   std::vector<vec_t> ptrs_x;
+  /// The output data
+  std::vector<ubvector> ptrs_y;
   /// True if the data has been specified
   bool data_set;
   /// Number of points to include in each interpolation (default 3)
   size_t order;
+  /// If true, try a Cholesky decomposition first
+  bool use_chol;
+
+  /// \name Factorizations of the covariance matrices
+  //@{
+  /// The factored covariance matrices
+  std::vector<ubmatrix> fact;
+  /// True if the corresponding factorization is a Cholesky decomposition
+  std::vector<bool> fact_chol;
+  /// The permutations for LU decompositions
+  std::vector<o2scl::permutation> fact_perm;
+  /// The index of the first output which uses each factorization
+  std::vector<size_t> fact_out;
+  /// The factorization used by each output
+  std::vector<size_t> out_fact;
+  //@}
+
+  /** \brief Initialize the data, sharing one factorization
+      among all outputs if \c shared is true
+  */
+  template<class vec_vec_t, class vec_vec2_t>
+  void set_data_int(size_t n_in, size_t n_out, size_t n_points,
+		    vec_vec_t &x, vec_vec2_t &y, 
+		    std::vector<covar_func_t> &fcovar, bool shared) {
+    
+    if (n_points<3) {
+      O2SCL_ERR2("Must provide at least three points in ",
+		 "interpm_krige::set_data()",exc_efailed);
+    }
+    if (n_in<1) {
+      O2SCL_ERR2("Must provide at least one input column in ",
+		 "interpm_krige::set_data()",exc_efailed);
+    }
+    if (n_out<1) {
+      O2SCL_ERR2("Must provide at least one output column in ",
+		 "interpm_krige::set_data()",exc_efailed);
+    }
+    np=n_points;
+    nd_in=n_in;
+    nd_out=n_out;
+    ptrs_x.resize(n_points);
+    for(size_t i=0;i<n_points;i++) {
+      if (x[i].size()!=n_in) {
+	O2SCL_ERR2("Size of x not correct in ",
+		   "interpm_krige::set_data().",o2scl::exc_efailed);
+      }
+      std::swap(ptrs_x[i],x[i]);
+    }
+    ptrs_y.resize(n_out);
+    for(size_t iout=0;iout<n_out;iout++) {
+      if (y[iout].size()!=n_points) {
+	O2SCL_ERR2("Size of y not correct in ",
+		   "interpm_krige::set_data().",o2scl::exc_efailed);
+      }
+      ptrs_y[iout].resize(n_points);
+      for(size_t i=0;i<n_points;i++) {
+	ptrs_y[iout][i]=y[iout][i];
+      }
+    }
+    data_set=true;
     
+    if (verbose>0) {
+      std::cout << "interpm_krige::set_data() : Using " << n_points
+		<< " points with " << nd_in << " input variables and\n\t"
+		<< nd_out << " output variables." << std::endl;
+    }
+
+    size_t n_fact=n_out;
+    if (shared) n_fact=1;
+    fact.resize(n_fact);
+    fact_chol.resize(n_fact);
+    fact_perm.resize(n_fact);
+    fact_out.resize(n_fact);
+    out_fact.resize(n_out);
+    for(size_t iout=0;iout<n_out;iout++) {
+      if (shared) out_fact[iout]=0;
+      else out_fact[iout]=iout;
+    }
+    
+    // Factor each distinct covariance matrix
+    for(size_t ifact=0;ifact<n_fact;ifact++) {
+      fact_out[ifact]=ifact;
+      if (verbose>0) {
+	std::cout << "interpm_krige::set_data() : "
+		  << "Factor " << ifact+1 << " of " << n_fact
+		  << std::endl;
+      }
+      factor(ifact,np,fcovar[ifact]);
+    }
+
+    Kinvf.resize(n_out);
+    for(size_t iout=0;iout<n_out;iout++) {
+      solve_weights(iout);
+    }
+    
+    return;
+  }
+
+  /** \brief Construct and factor the covariance matrix for
+      the first \c n points and store it in factorization \c ifact
+  */
+  void factor(size_t ifact, size_t n, covar_func_t &f) {
+    
+    ubmatrix &KXX=fact[ifact];
+    
+    // Construct the KXX matrix
+    KXX.resize(n,n,false);
+    for(size_t irow=0;irow<n;irow++) {
+      for(size_t icol=0;icol<n;icol++) {
+	if (irow>icol) {
+	  KXX(irow,icol)=KXX(icol,irow);
+	} else {
+	  KXX(irow,icol)=f(ptrs_x[irow],ptrs_x[icol]);
+	}
+      }
+    }
+
+    if (use_chol) {
+      // Try the Cholesky decomposition on a copy, so that the
+      // original matrix is available for LU if it fails
+      ubmatrix LLT=KXX;
+      if (o2scl_linalg::cholesky_decomp(n,LLT,false)==o2scl::success) {
+	std::swap(KXX,LLT);
+	fact_chol[ifact]=true;
+	return;
+      }
+      if (verbose>0) {
+	std::cout << "interpm_krige::factor() : Covariance matrix "
+		  << "not positive definite, using LU." << std::endl;
+      }
+    }
+      
+    fact_chol[ifact]=false;
+    fact_perm[ifact].resize(n);
+    int signum;
+    o2scl_linalg::LU_decomp(n,KXX,fact_perm[ifact],signum);
+    if (o2scl_linalg::diagonal_has_zero(n,KXX)) {
+      O2SCL_ERR2("KXX matrix is singular in ",
+		 "interpm_krige::factor().",
+		 o2scl::exc_efailed);
+    }
+    
+    return;
+  }
+
+  /** \brief Compute the weights for output \c iout from
+      its factorization
+  */
+  void solve_weights(size_t iout) {
+    size_t ifact=out_fact[iout];
+    Kinvf[iout].resize(np);
+    if (fact_chol[ifact]) {
+      o2scl::vector_copy(np,ptrs_y[iout],Kinvf[iout]);
+      o2scl_linalg::cholesky_svx(np,fact[ifact],Kinvf[iout]);
+    } else {
+      o2scl_linalg::LU_solve(np,fact[ifact],fact_perm[ifact],
+			     ptrs_y[iout],Kinvf[iout]);
+    }
+    return;
+  }
+  
 #endif
     
   };
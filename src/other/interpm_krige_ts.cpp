@@ -141,6 +141,69 @@ int main(void) {
 
   }
 
+  {
+    // Compare the Cholesky and LU results, the shared factorization,
+    // and the addition of points
+    vector<ubvector> x, x2, x3, x4;
+    vector<ubvector> y(2), y2(2), y3(2), y4(2);
+    for(size_t k=0;k<2;k++) {
+      y[k].resize(12);
+    }
+    ubvector tmp(2);
+    for(size_t i=0;i<12;i++) {
+      tmp[0]=0.1+0.83*((double)((i*7)%12))/12.0;
+      tmp[1]=0.05+0.9*((double)i)/12.0;
+      x.push_back(tmp);
+      y[0][i]=ft(tmp[0],tmp[1]);
+      y[1][i]=tmp[0]*tmp[1];
+    }
+    x2=x;
+    x3=x;
+    y2=y;
+    y3=y;
+    
+    // The first 9 points, used for the addition of points below
+    for(size_t i=0;i<9;i++) x4.push_back(x[i]);
+    for(size_t k=0;k<2;k++) {
+      y4[k].resize(9);
+      for(size_t i=0;i<9;i++) y4[k][i]=y[k][i];
+    }
+    vector<ubvector> xadd(x.begin()+9,x.end());
+    
+    function<double(const ubvector &,const ubvector &)> fc=covar;
+    vector<function<double(const ubvector &,const ubvector &)> >
+      fa={covar,covar};
+
+    interpm_krige<ubvector,ubmatrix_column> ik_chol, ik_lu, ik_shared,
+      ik_add;
+    ik_lu.set_cholesky(false);
+    ik_chol.set_data(2,2,12,x,y,fa);
+    ik_lu.set_data(2,2,12,x2,y2,fa);
+    ik_shared.set_data(2,2,12,x3,y3,fc);
+    ik_add.set_data(2,2,9,x4,y4,fc);
+    ubvector yadd(2);
+    for(size_t i=9;i<12;i++) {
+      yadd[0]=y[0][i];
+      yadd[1]=y[1][i];
+      ik_add.add_point(xadd[i-9],yadd,fc);
+    }
+
+    ubvector point(2), out1(2), out2(2), out3(2), out4(2);
+    point[0]=0.4;
+    point[1]=0.5;
+    ik_chol.eval(point,out1,fa);
+    ik_lu.eval(point,out2,fa);
+    ik_shared.eval(point,out3,fc);
+    ik_add.eval(point,out4,fa);
+    for(size_t k=0;k<2;k++) {
+      t.test_rel(out1[k],out2[k],1.0e-8,"chol vs. LU");
+      t.test_rel(out1[k],out3[k],1.0e-12,"shared");
+      t.test_rel(out1[k],out4[k],1.0e-8,"add_point");
+    }
+    t.test_rel(out1[0],ft(point[0],point[1]),5.0e-2,"chol accuracy");
+    
+  }
+
   t.report();
   return 0;
 }
@@ -0,0 +1,411 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2018, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_KD_TREE_H
+#define O2SCL_KD_TREE_H
+
+/** \file kd_tree.h
+    \brief File defining \ref o2scl::kd_tree
+*/
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <utility>
+
+#include <o2scl/err_hnd.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief A k-d tree for exact nearest-neighbor searches
+
+      This class stores a set of points in \c d dimensions and finds
+      the \c k points closest to a specified point using the
+      Euclidean distance. The tree stores its own contiguous copy of
+      the point coordinates, so the user should rescale the
+      coordinates beforehand if a distance metric with different
+      length scales in each direction is required (as is done in
+      \ref interpm_idw).
+
+      The tree is constructed by recursively splitting the points at
+      the median of the coordinate with the largest spread until
+      there are at most \ref bucket_size points in each leaf. Points
+      can be added after the tree is constructed with \ref insert(),
+      in which case full leaves are split in the same way.
+
+      The searches are exact: the points returned by \ref nearest()
+      are always the same (up to the ordering of points with
+      identical distances) as those which would be obtained by
+      computing the distance to every point. A search requires
+      \f$ {\cal O}(\log N) \f$ work for a well-balanced tree
+      with a small number of dimensions, though the performance
+      degrades toward that of a brute-force search as the
+      number of dimensions grows.
+
+      The function \ref nearest() is const and uses only local
+      storage, so it may be called simultaneously from several
+      threads as long as no points are being inserted.
+  */
+  template<class fp_t=double> class kd_tree {
+
+  public:
+
+    kd_tree() {
+      bucket_size=16;
+      nd=0;
+      np=0;
+    }
+
+    /** \brief The maximum number of points in a leaf (default 16)
+     */
+    size_t bucket_size;
+
+    /** \brief Remove all points
+     */
+    void clear() {
+      nodes.clear();
+      coords.clear();
+      np=0;
+      nd=0;
+      return;
+    }
+
+    /** \brief Construct the tree from \c n_points points in \c n_dim
+	dimensions
+
+	The vector \c x must hold the coordinates of the points
+	in row-major order, i.e. coordinate \c j of point \c i
+	is stored in <tt>x[i*n_dim+j]</tt>. The contents of \c x
+	are swapped into the tree, so \c x is empty on exit.
+    */
+    void set_points(size_t n_points, size_t n_dim, std::vector<fp_t> &x) {
+
+      if (n_dim==0) {
+	O2SCL_ERR("Number of dimensions zero in kd_tree::set_points().",
+		  o2scl::exc_einval);
+      }
+      if (x.size()<n_points*n_dim) {
+	O2SCL_ERR("Coordinate vector too small in kd_tree::set_points().",
+		  o2scl::exc_einval);
+      }
+
+      clear();
+      np=n_points;
+      nd=n_dim;
+      std::swap(coords,x);
+      coords.resize(np*nd);
+
+      // Start with all points in the root and split recursively
+      node root;
+      root.index.resize(np);
+      for(size_t i=0;i<np;i++) root.index[i]=i;
+      nodes.push_back(root);
+      split(0);
+
+      return;
+    }
+
+    /** \brief Add the point \c x (an array of size
+	\ref get_dim()) to the tree and return its index
+    */
+    template<class vec_t> size_t insert(const vec_t &x) {
+
+      if (nd==0) {
+	O2SCL_ERR("Tree not initialized in kd_tree::insert().",
+		  o2scl::exc_einval);
+      }
+
+      for(size_t j=0;j<nd;j++) coords.push_back(x[j]);
+      size_t ix=np;
+      np++;
+
+      // Find the leaf containing the new point
+      size_t in=0;
+      while (!nodes[in].leaf) {
+	if (coords[ix*nd+nodes[in].dim]<nodes[in].val) {
+	  in=nodes[in].left;
+	} else {
+	  in=nodes[in].right;
+	}
+      }
+      nodes[in].index.push_back(ix);
+      if (nodes[in].index.size()>bucket_size) split(in);
+
+      return ix;
+    }
+
+    /** \brief Find the \c k points closest to \c x
+
+	On exit, \c index contains the indices of the closest points
+	ordered by increasing distance and \c dist2 contains the
+	corresponding squared distances. If \c k is larger than
+	the number of points, then all points are returned.
+    */
+    template<class vec_t>
+      void nearest(const vec_t &x, size_t k, std::vector<size_t> &index,
+		   std::vector<fp_t> &dist2) const {
+
+      index.clear();
+      dist2.clear();
+      if (np==0 || k==0) return;
+      if (k>np) k=np;
+
+      // Copy the point to contiguous storage
+      std::vector<fp_t> xc(nd);
+      for(size_t j=0;j<nd;j++) xc[j]=x[j];
+
+      // A max-heap holding the k closest points found so far
+      std::priority_queue<std::pair<fp_t,size_t> > heap;
+      search(0,&xc[0],k,heap);
+
+      index.resize(heap.size());
+      dist2.resize(heap.size());
+      for(size_t i=heap.size();i>0;i--) {
+	dist2[i-1]=heap.top().first;
+	index[i-1]=heap.top().second;
+	heap.pop();
+      }
+
+      return;
+    }
+
+    /** \brief Return the number of points
+     */
+    size_t get_npoints() const {
+      return np;
+    }
+
+    /** \brief Return the number of dimensions
+     */
+    size_t get_dim() const {
+      return nd;
+    }
+
+    /** \brief Return coordinate \c j of point \c i
+     */
+    fp_t get_coord(size_t i, size_t j) const {
+      return coords[i*nd+j];
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief A node in the tree
+     */
+    class node {
+
+    public:
+
+      node() {
+	leaf=true;
+	dim=0;
+	val=0.0;
+	left=0;
+	right=0;
+      }
+
+      /// True if the node is a leaf
+      bool leaf;
+      /// The splitting dimension
+      size_t dim;
+      /// The splitting value
+      fp_t val;
+      /// The node with coordinates less than \c val
+      size_t left;
+      /// The node with coordinates greater than or equal to \c val
+      size_t right;
+      /// For leaves, the indices of the points
+      std::vector<size_t> index;
+    };
+
+    /// The number of points
+    size_t np;
+
+    /// The number of dimensions
+    size_t nd;
+
+    /// The coordinates, stored in row-major order
+    std::vector<fp_t> coords;
+
+    /// The nodes, the root is at index 0
+    std::vector<node> nodes;
+
+    /** \brief Split the leaf at index \c in recursively until
+	each leaf has at most \ref bucket_size points
+    */
+    void split(size_t in) {
+
+      if (nodes[in].index.size()<=bucket_size) return;
+
+      std::vector<size_t> &ix=nodes[in].index;
+      size_t n=ix.size();
+
+      // Choose the dimension with the largest spread
+      size_t best_dim=0;
+      fp_t best_spread=-1.0;
+      for(size_t j=0;j<nd;j++) {
+	fp_t lo=coords[ix[0]*nd+j], hi=lo;
+	for(size_t i=1;i<n;i++) {
+	  fp_t c=coords[ix[i]*nd+j];
+	  if (c<lo) lo=c;
+	  if (c>hi) hi=c;
+	}
+	if (hi-lo>best_spread) {
+	  best_spread=hi-lo;
+	  best_dim=j;
+	}
+      }
+
+      // If all the points are identical, leave the node as a leaf
+      if (best_spread<=0.0) return;
+
+      // Partition at the median
+      size_t mid=n/2;
+      std::nth_element(ix.begin(),ix.begin()+mid,ix.end(),
+		       coord_less(coords,nd,best_dim));
+      fp_t sval=coords[ix[mid]*nd+best_dim];
+
+      // Move all points with coordinates equal to the splitting value
+      // to the right so that the insertion and search rule (left
+      // if less than the splitting value) holds
+      std::vector<size_t> lix, rix;
+      for(size_t i=0;i<n;i++) {
+	if (coords[ix[i]*nd+best_dim]<sval) lix.push_back(ix[i]);
+	else rix.push_back(ix[i]);
+      }
+
+      // If all of the points are on the right, split just above
+      // the minimum instead
+      if (lix.size()==0) {
+	fp_t next=0.0;
+	bool found=false;
+	for(size_t i=0;i<n;i++) {
+	  fp_t c=coords[ix[i]*nd+best_dim];
+	  if (c>sval && (!found || c<next)) {
+	    next=c;
+	    found=true;
+	  }
+	}
+	if (!found) return;
+	sval=next;
+	rix.clear();
+	for(size_t i=0;i<n;i++) {
+	  if (coords[ix[i]*nd+best_dim]<sval) lix.push_back(ix[i]);
+	  else rix.push_back(ix[i]);
+	}
+      }
+
+      node left, right;
+      std::swap(left.index,lix);
+      std::swap(right.index,rix);
+      size_t il=nodes.size();
+      nodes.push_back(left);
+      nodes.push_back(right);
+
+      // Note that nodes may have been reallocated, so we cannot use
+      // the reference 'ix' after this point
+      nodes[in].leaf=false;
+      nodes[in].dim=best_dim;
+      nodes[in].val=sval;
+      nodes[in].left=il;
+      nodes[in].right=il+1;
+      nodes[in].index.clear();
+
+      split(il);
+      split(il+1);
+
+      return;
+    }
+
+    /// Compare points by one coordinate
+    class coord_less {
+    public:
+      coord_less(const std::vector<fp_t> &c, size_t n_dim, size_t d) :
+	cp(c), ndim(n_dim), dim(d) {
+      }
+      bool operator()(size_t a, size_t b) const {
+	return cp[a*ndim+dim]<cp[b*ndim+dim];
+      }
+    protected:
+      const std::vector<fp_t> &cp;
+      size_t ndim;
+      size_t dim;
+    };
+
+    /** \brief Recursively search node \c in for the points
+	closest to \c x
+    */
+    void search(size_t in, const fp_t *x, size_t k,
+		std::priority_queue<std::pair<fp_t,size_t> > &heap) const {
+
+      const node &nod=nodes[in];
+
+      if (nod.leaf) {
+	for(size_t i=0;i<nod.index.size();i++) {
+	  size_t ip=nod.index[i];
+	  const fp_t *p=&coords[ip*nd];
+	  fp_t d2=0.0;
+	  for(size_t j=0;j<nd;j++) {
+	    fp_t dx=x[j]-p[j];
+	    d2+=dx*dx;
+	  }
+	  if (heap.size()<k) {
+	    heap.push(std::make_pair(d2,ip));
+	  } else if (d2<heap.top().first) {
+	    heap.pop();
+	    heap.push(std::make_pair(d2,ip));
+	  }
+	}
+	return;
+      }
+
+      // Search the side containing the point first, and then the
+      // other side only if it could contain a closer point
+      fp_t diff=x[nod.dim]-nod.val;
+      size_t first, second;
+      if (diff<0.0) {
+	first=nod.left;
+	second=nod.right;
+      } else {
+	first=nod.right;
+	second=nod.left;
+      }
+      search(first,x,k,heap);
+      if (heap.size()<k || diff*diff<=heap.top().first) {
+	search(second,x,k,heap);
+      }
+
+      return;
+    }
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
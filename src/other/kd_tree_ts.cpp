@@ -0,0 +1,92 @@
+/*
+  -------------------------------------------------------------------
+  
+  Copyright (C) 2018, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/test_mgr.h>
+#include <o2scl/kd_tree.h>
+#include <o2scl/vector.h>
+#include <o2scl/rng_gsl.h>
+
+using namespace std;
+using namespace o2scl;
+
+int main(void) {
+  test_mgr t;
+  t.set_output_level(1);
+
+  cout.setf(ios::scientific);
+
+  rng_gsl rg;
+
+  for(size_t nd=1;nd<=6;nd+=5) {
+
+    // Create a random set of points, including some duplicates
+    size_t N=2000;
+    std::vector<double> x(N*nd), x2;
+    for(size_t i=0;i<N;i++) {
+      for(size_t j=0;j<nd;j++) {
+	if (i%100==99) x[i*nd+j]=x[(i-1)*nd+j];
+	else x[i*nd+j]=rg.random();
+      }
+    }
+    x2=x;
+    
+    kd_tree<> kt;
+    kt.set_points(N/2,nd,x);
+    t.test_gen(kt.get_npoints()==N/2,"npoints");
+
+    // Insert the remaining points one at a time
+    for(size_t i=N/2;i<N;i++) {
+      std::vector<double> p(nd);
+      for(size_t j=0;j<nd;j++) p[j]=x2[i*nd+j];
+      kt.insert(p);
+    }
+    t.test_gen(kt.get_npoints()==N,"npoints 2");
+
+    // Compare nearest neighbors with a brute-force search
+    bool match=true;
+    for(size_t k=0;k<50;k++) {
+      std::vector<double> q(nd);
+      for(size_t j=0;j<nd;j++) q[j]=rg.random();
+
+      std::vector<double> d2(N);
+      for(size_t i=0;i<N;i++) {
+	d2[i]=0.0;
+	for(size_t j=0;j<nd;j++) {
+	  d2[i]+=pow(q[j]-x2[i*nd+j],2.0);
+	}
+      }
+      std::vector<size_t> index, index2;
+      std::vector<double> dt;
+      vector_smallest_index<std::vector<double>,double,
+			    std::vector<size_t> >(d2,5,index);
+      kt.nearest(q,5,index2,dt);
+      for(size_t i=0;i<5;i++) {
+	if (d2[index[i]]!=dt[i]) match=false;
+      }
+    }
+    t.test_gen(match,"nearest");
+
+  }
+  
+  t.report();
+  return 0;
+}
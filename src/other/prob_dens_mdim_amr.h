@@ -27,6 +27,9 @@
 #ifndef O2SCL_PROB_DENS_MDIM_AMR_H
 #define O2SCL_PROB_DENS_MDIM_AMR_H
 
+#include <vector>
+#include <algorithm>
+
 #include <o2scl/table.h>
 #include <o2scl/err_hnd.h>
 #include <o2scl/prob_dens_func.h>
@@ -140,6 +143,65 @@ namespace o2scl {
   
   };
 
+  /** \brief A node in the tree which records how the hypercubes
+      were divided
+
+      Each call to \ref insert() replaces a leaf of the tree with
+      an internal node which has the lower half of the old
+      hypercube on the left and the upper half on the right.
+   */
+  class split_node {
+
+  public:
+
+    split_node() {
+      leaf=true;
+      dim=0;
+      val=0.0;
+      left=0;
+      right=0;
+      cube=0;
+    }
+    
+    /// True if the node is a leaf
+    bool leaf;
+    /// The coordinate which was divided
+    size_t dim;
+    /// The location of the division
+    double val;
+    /// The node with coordinates less than \c val
+    size_t left;
+    /// The node with coordinates greater than or equal to \c val
+    size_t right;
+    /// For leaves, the index of the hypercube in \ref mesh
+    size_t cube;
+  };
+
+  /** \brief A subtree to be constructed by \ref bulk_parse()
+   */
+  class bulk_task {
+
+  public:
+
+    /// The root node of the subtree
+    size_t node;
+    /// The index of the hypercube for the root node
+    size_t cube;
+    /// The first row index
+    size_t begin;
+    /// One past the last row index
+    size_t end;
+  };
+
+  /** \brief The tree used to locate points in the mesh
+      
+      The tree has <tt>2*mesh.size()-1</tt> nodes. The two
+      children of the node which was divided by the row which
+      created hypercube \c j are at indices <tt>2*j-1</tt>
+      and <tt>2*j</tt>. 
+   */
+  std::vector<split_node> tree;
+
   public:
 
   /// \name Dimension choice setting
@@ -176,15 +238,22 @@ namespace o2scl {
    */
   int verbose;
 
+  /** \brief The number of OpenMP threads used in 
+      \ref bulk_parse() (default 1)
+  */
+  size_t n_threads;
+
   prob_dens_mdim_amr() {
     ndim=0;
     dim_choice=max_variance;
+    n_threads=1;
   }
   
   /** \brief Initialize a probability distribution from the corners
    */
   prob_dens_mdim_amr(vec_t &l, vec_t &h) {
     dim_choice=max_variance;
+    n_threads=1;
     set(l,h);
   }
 
@@ -194,6 +263,7 @@ namespace o2scl {
    */
   void set(vec_t &l, vec_t &h) {
     mesh.clear();
+    tree.clear();
     if (h.size()<l.size()) {
       O2SCL_ERR2("Vector sizes not correct in ",
 		"prob_dens_mdim_amr::set().",o2scl::exc_einval);
@@ -220,6 +290,10 @@ namespace o2scl {
  
   /** \brief Insert point at row \c ir, creating a new hypercube 
       for the new point
+
+      The hypercube containing the new point is found using the
+      split tree, which requires \f$ {\cal O}(\log N) \f$
+      operations for a reasonably balanced mesh.
    */
   void insert(size_t ir, mat_t &m) {
     if (ndim==0) {
@@ -239,6 +313,8 @@ namespace o2scl {
       // Initialize the mesh with the first point
       mesh.resize(1);
       mesh[0].set(low,high,0,1.0,m(0,ndim));
+      tree.resize(1);
+      tree[0]=split_node();
       return;
     }
    
@@ -256,25 +332,276 @@ namespace o2scl {
     }
    
     // Find the right hypercube
-    bool found=false;
-    size_t jm=0;
-    for(size_t j=0;j<mesh.size() && found==false;j++) {
-      if (mesh[j].is_inside(v)) {
-	found=true;
-	jm=j;
-      }
-    }
-    if (found==false) {
+    size_t jm, in;
+    if (find_cube(v,jm,in)==false) {
       O2SCL_ERR2("Couldn't find point inside mesh in ",
 		 "prob_dens_mdim_amr::insert().",o2scl::exc_efailed);
     }
-    hypercube &h=mesh[jm];
     if (verbose>1) {
       std::cout << "Found cube " << jm << std::endl;
     }
+
+    // Add the new hypercube and, if the tree is being used, the two
+    // new leaves. This must be done before the call to split()
+    // because it may reallocate the mesh.
+    size_t j_new=mesh.size();
+    bool use_tree=tree_ok();
+    mesh.resize(j_new+1);
+    if (use_tree) tree.resize(2*j_new+1);
+
+    size_t max_ip;
+    double loc;
+    split(jm,j_new,ir,m,max_ip,loc);
+    if (use_tree) set_leaves(in,j_new,jm,max_ip,loc);
+    
+    return;
+  }
+ 
+  /** \brief Parse the matrix \c m, creating a new hypercube
+      for every point 
+   */
+  void initial_parse(mat_t &m) {
+   
+    for(size_t ir=0;ir<m.size1();ir++) {
+      insert(ir,m);
+    }
+   
+    return;
+  }
+
+  /** \brief Construct the mesh from all of the rows in
+      matrix \c m at once
+
+      This function clears the current mesh and creates the same
+      mesh as would be created by \ref initial_parse() (unless
+      \ref dim_choice is equal to \ref random). Once the first two
+      points have been used to divide the full region, the points in
+      each of the two halves affect only the hypercubes in that half,
+      so the two subtrees can be constructed separately. The points
+      are partitioned breadth-first until there are several subtrees
+      for each thread, and then the subtrees are constructed
+      simultaneously using OpenMP if \ref n_threads is larger than
+      one. Because the random number generator is not thread-safe,
+      the subtrees are constructed serially if \ref dim_choice is
+      equal to \ref random or if \ref verbose is greater than one.
+   */
+  void bulk_parse(mat_t &m) {
+    
+    if (ndim==0) {
+      O2SCL_ERR2("Region limits and scales not set in ",
+		 "prob_dens_mdim_amr::bulk_parse().",o2scl::exc_einval);
+    }
+    if (dim_choice==user_scale && scale.size()==0) {
+      O2SCL_ERR2("Scales not set in ",
+		 "prob_dens_mdim_amr::bulk_parse().",o2scl::exc_einval);
+    }
+    
+    mesh.clear();
+    tree.clear();
+    size_t nr=m.size1();
+    if (nr==0) return;
+
+    mesh.resize(nr);
+    mesh[0].set(low,high,0,1.0,m(0,ndim));
+    tree.resize(2*nr-1);
+
+    // The list of row indices. The subtree with root node
+    // tasks[i].node covers the indices between tasks[i].begin
+    // and tasks[i].end, and the first of these is the row
+    // associated with the hypercube for that node.
+    std::vector<size_t> ix(nr);
+    for(size_t i=0;i<nr;i++) ix[i]=i;
+    std::vector<bulk_task> tasks(1), next;
+    tasks[0].node=0;
+    tasks[0].begin=0;
+    tasks[0].end=nr;
+
+    size_t nt=1;
+#ifdef O2SCL_OPENMP
+    if (dim_choice!=random && verbose<=1) nt=n_threads;
+#endif
+    
+    // Divide breadth-first until there are enough subtrees
+    // to keep all of the threads busy
+    while (nt>1 && tasks.size()>0 && tasks.size()<4*nt) {
+      next.clear();
+      for(size_t i=0;i<tasks.size();i++) {
+	bulk_task lo, hi;
+	if (bulk_step(tasks[i],ix,m,lo,hi)) {
+	  next.push_back(lo);
+	  next.push_back(hi);
+	}
+      }
+      std::swap(tasks,next);
+    }
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+    for(size_t i=0;i<tasks.size();i++) {
+      // Construct this subtree depth-first using a local stack
+      std::vector<bulk_task> stack(1,tasks[i]);
+      while (stack.size()>0) {
+	bulk_task t=stack.back(), lo, hi;
+	stack.pop_back();
+	if (bulk_step(t,ix,m,lo,hi)) {
+	  stack.push_back(hi);
+	  stack.push_back(lo);
+	}
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Check the total volume by adding up the fractional
+      part of the volume in each hypercube
+   */
+  double total_volume() {
+    if (mesh.size()==0) {
+      O2SCL_ERR2("Mesh empty in ",
+		 "prob_dens_mdim_amr::total_volume().",o2scl::exc_einval);
+    }
+    double ret=0.0;
+    for(size_t i=0;i<mesh.size();i++) {
+      ret+=mesh[i].frac_vol;
+    }
+    return ret;
+  }
+ 
+  /// The normalized density 
+  virtual double pdf(const vec_t &x) const {
+
+    if (mesh.size()==0) {
+      O2SCL_ERR2("Mesh empty in ",
+		 "prob_dens_mdim_amr::pdf().",o2scl::exc_einval);
+    }
+
+    // Find the right hypercube
+    size_t jm, in;
+    if (find_cube(x,jm,in)==false) {
+      O2SCL_ERR2("Point not inside mesh in ",
+		 "prob_dens_mdim_amr::pdf().",o2scl::exc_einval);
+    }
+    return mesh[jm].weight;
+  }
+
+  /// Select a random point in the largest weighted box
+  virtual void select_in_largest(vec_t &x) const {
+   
+    if (mesh.size()==0) {
+      O2SCL_ERR2("Mesh empty in ",
+		 "prob_dens_mdim_amr::operator()().",o2scl::exc_einval);
+    }
+
+    size_t im=0;
+    double wgt=mesh[0].frac_vol*mesh[0].weight;
+    for(size_t i=1;i<mesh.size();i++) {
+      if (mesh[i].frac_vol*mesh[i].weight>wgt) {
+	im=i;
+	wgt=mesh[i].frac_vol*mesh[i].weight;
+      }
+    }
+    for(size_t j=0;j<ndim;j++) {
+      x[j]=rg.random()*(mesh[im].high[j]-mesh[im].low[j])+mesh[im].low[j];
+    }
+
+    return;
+  }
+
+  /// Sample the distribution
+  virtual void operator()(vec_t &x) const {
+   
+    if (mesh.size()==0) {
+      O2SCL_ERR2("Mesh empty in ",
+		 "prob_dens_mdim_amr::operator()().",o2scl::exc_einval);
+    }
+
+    double total_weight=0.0;
+    for(size_t i=0;i<mesh.size();i++) {
+      total_weight+=mesh[i].weight*mesh[i].frac_vol;
+    }
+   
+    double this_weight=rg.random()*total_weight;
+    double cml_wgt=0.0;
+    for(size_t j=0;j<mesh.size();j++) {
+      cml_wgt+=mesh[j].frac_vol*mesh[j].weight;
+      if (this_weight<cml_wgt || j==mesh.size()-1) {
+	for(size_t i=0;i<ndim;i++) {
+	  x[i]=mesh[j].low[i]+rg.random()*
+	    (mesh[j].high[i]-mesh[j].low[i]);
+	}
+	return;
+      }
+    }
+
+    return;
+  }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /** \brief Return true if \ref tree corresponds to \ref mesh
+
+      If the mesh was modified directly (rather than through 
+      \ref insert(), \ref initial_parse(), or \ref bulk_parse()),
+      then the hypercubes are located with a linear search instead.
+   */
+  bool tree_ok() const {
+    return mesh.size()>0 && tree.size()+1==2*mesh.size();
+  }
+
+  /** \brief Find the index \c jm of the hypercube which contains
+      point \c v and the index \c in of the associated leaf in the
+      tree, returning false if the point is not in the mesh
+   */
+  template<class vec2_t>
+  bool find_cube(const vec2_t &v, size_t &jm, size_t &in) const {
+    
+    if (tree_ok()) {
+      in=0;
+      while (!tree[in].leaf) {
+	if (v[tree[in].dim]<tree[in].val) {
+	  in=tree[in].left;
+	} else {
+	  in=tree[in].right;
+	}
+      }
+      jm=tree[in].cube;
+      return mesh[jm].is_inside(v);
+    }
+    
+    in=0;
+    for(size_t j=0;j<mesh.size();j++) {
+      if (mesh[j].is_inside(v)) {
+	jm=j;
+	return true;
+      }
+    }
+    return false;
+  }
+
+  /** \brief Divide hypercube \c jm using the point in row \c ir,
+      storing the lower half in hypercube \c j_new
+
+      The coordinate which was divided and the location of the
+      division are returned in \c max_ip and \c loc. This function
+      does not modify the tree and the vector \ref mesh must
+      already have space for hypercube \c j_new.
+   */
+  void split(size_t jm, size_t j_new, size_t ir, mat_t &m,
+	     size_t &max_ip, double &loc) {
+
+    std::vector<double> v(ndim);
+    for(size_t k=0;k<ndim;k++) {
+      v[k]=m(ir,k);
+    }
+    
+    hypercube &h=mesh[jm];
    
     // Find coordinate to separate
-    size_t max_ip=0;
+    max_ip=0;
     if (dim_choice==random) {
       std::cout << "X: " << ndim << std::endl;
       max_ip=rg.random_int() % ndim;
@@ -315,7 +642,7 @@ namespace o2scl {
     }
    
     // Slice the mesh in coordinate max_ip
-    double loc=(v[max_ip]+m(h.inside[0],max_ip))/2.0;
+    loc=(v[max_ip]+m(h.inside[0],max_ip))/2.0;
     double old_vol=h.frac_vol;
     double old_low=h.low[max_ip];
     double old_high=h.high[max_ip];
@@ -335,7 +662,7 @@ namespace o2scl {
     h.frac_vol=old_vol*(old_high-loc)/(old_high-old_low);
    
     // Set values for new hypercube
-    hypercube h_new;
+    hypercube &h_new=mesh[j_new];
     std::vector<double> low_new, high_new;
     o2scl::vector_copy(h.low,low_new);
     o2scl::vector_copy(h.high,high_new);
@@ -364,119 +691,94 @@ namespace o2scl {
       for(size_t i=0;i<ndim;i++) {
 	std::cout << h.low[i] << " " << h.high[i] << std::endl;
       }
-      std::cout << "New cube " << mesh.size() << std::endl;
+      std::cout << "New cube " << j_new << std::endl;
       for(size_t i=0;i<ndim;i++) {
 	std::cout << h_new.low[i] << " " << h_new.high[i] << std::endl;
       }
     }
 
-    // Add new hypercube to mesh
-    mesh.push_back(h_new);
-   
     return;
   }
- 
-  /** \brief Parse the matrix \c m, creating a new hypercube
-      for every point 
+
+  /** \brief Replace the leaf at node \c in with an internal node
+      and the leaves for hypercubes \c j_new and \c jm
    */
-  void initial_parse(mat_t &m) {
-   
-    for(size_t ir=0;ir<m.size1();ir++) {
-      insert(ir,m);
-    }
-   
+  void set_leaves(size_t in, size_t j_new, size_t jm, size_t max_ip,
+		  double loc) {
+    split_node &nd=tree[in];
+    nd.leaf=false;
+    nd.dim=max_ip;
+    nd.val=loc;
+    nd.left=2*j_new-1;
+    nd.right=2*j_new;
+    tree[nd.left]=split_node();
+    tree[nd.left].cube=j_new;
+    tree[nd.right]=split_node();
+    tree[nd.right].cube=jm;
     return;
   }
+  
+  /** \brief Divide the hypercube at the root of the subtree
+      \c t using the next row, returning false if the subtree 
+      is a single leaf
 
-  /** \brief Check the total volume by adding up the fractional
-      part of the volume in each hypercube
+      The row indices in \c t are stably partitioned into those
+      in the lower and upper half of the divided hypercube, which
+      are returned in \c lo and \c hi.
    */
-  double total_volume() {
-    if (mesh.size()==0) {
-      O2SCL_ERR2("Mesh empty in ",
-		 "prob_dens_mdim_amr::total_volume().",o2scl::exc_einval);
-    }
-    double ret=0.0;
-    for(size_t i=0;i<mesh.size();i++) {
-      ret+=mesh[i].frac_vol;
-    }
-    return ret;
-  }
- 
-  /// The normalized density 
-  virtual double pdf(const vec_t &x) const {
-
-    if (mesh.size()==0) {
-      O2SCL_ERR2("Mesh empty in ",
-		 "prob_dens_mdim_amr::pdf().",o2scl::exc_einval);
-    }
-
-    // Find the right hypercube
-    bool found=false;
-    size_t jm=0;
-    for(size_t j=0;j<mesh.size() && found==false;j++) {
-      if (mesh[j].is_inside(x)) {
-	found=true;
-	jm=j;
-      }
-    }
-    if (found==false) {
-      O2SCL_ERR("Error 2.",o2scl::exc_esanity);
-    }
-    return mesh[jm].weight;
-  }
-
-  /// Select a random point in the largest weighted box
-  virtual void select_in_largest(vec_t &x) const {
-   
-    if (mesh.size()==0) {
-      O2SCL_ERR2("Mesh empty in ",
-		 "prob_dens_mdim_amr::operator()().",o2scl::exc_einval);
-    }
-
-    size_t im=0;
-    double wgt=mesh[0].frac_vol*mesh[0].weight;
-    for(size_t i=1;i<mesh.size();i++) {
-      if (mesh[i].frac_vol*mesh[i].weight>wgt) {
-	im=i;
-	wgt=mesh[i].frac_vol*mesh[i].weight;
-      }
-    }
-    for(size_t j=0;j<ndim;j++) {
-      x[j]=rg.random()*(mesh[im].high[j]-mesh[im].low[j])+mesh[im].low[j];
-    }
-
-    return;
+  bool bulk_step(const bulk_task &t, std::vector<size_t> &ix, mat_t &m,
+		 bulk_task &lo, bulk_task &hi) {
+    
+    if (t.end-t.begin<2) return false;
+
+    // The next row divides the hypercube and creates the hypercube
+    // with the same index
+    size_t k=ix[t.begin+1];
+    size_t max_ip;
+    double loc;
+    split(t.cube,k,k,m,max_ip,loc);
+    set_leaves(t.node,k,t.cube,max_ip,loc);
+
+    // Partition the remaining rows, keeping them in order, and
+    // then place the rows associated with the two hypercubes
+    // at the beginning of each half
+    std::vector<size_t>::iterator it=std::stable_partition
+      (ix.begin()+t.begin+2,ix.begin()+t.end,
+       row_less(m,max_ip,loc));
+    size_t mid=it-ix.begin();
+    std::rotate(ix.begin()+t.begin+1,ix.begin()+t.begin+2,
+		ix.begin()+mid);
+    ix[t.begin]=mesh[k].inside[0];
+    ix[mid-1]=mesh[t.cube].inside[0];
+
+    lo.node=2*k-1;
+    lo.cube=k;
+    lo.begin=t.begin;
+    lo.end=mid-1;
+    hi.node=2*k;
+    hi.cube=t.cube;
+    hi.begin=mid-1;
+    hi.end=t.end;
+    
+    return true;
   }
 
-  /// Sample the distribution
-  virtual void operator()(vec_t &x) const {
-   
-    if (mesh.size()==0) {
-      O2SCL_ERR2("Mesh empty in ",
-		 "prob_dens_mdim_amr::operator()().",o2scl::exc_einval);
+  /** \brief Return true if a row is below a division
+   */
+  class row_less {
+  public:
+    row_less(mat_t &mat, size_t d, double v) : m(mat), dim(d), val(v) {
     }
-
-    double total_weight=0.0;
-    for(size_t i=0;i<mesh.size();i++) {
-      total_weight+=mesh[i].weight*mesh[i].frac_vol;
-    }
-   
-    double this_weight=rg.random()*total_weight;
-    double cml_wgt=0.0;
-    for(size_t j=0;j<mesh.size();j++) {
-      cml_wgt+=mesh[j].frac_vol*mesh[j].weight;
-      if (this_weight<cml_wgt || j==mesh.size()-1) {
-	for(size_t i=0;i<ndim;i++) {
-	  x[i]=mesh[j].low[i]+rg.random()*
-	    (mesh[j].high[i]-mesh[j].low[i]);
-	}
-	return;
-      }
+    bool operator()(size_t ir) const {
+      return m(ir,dim)<val;
     }
+  protected:
+    mat_t &m;
+    size_t dim;
+    double val;
+  };
 
-    return;
-  }
+#endif
  
   };
  
@@ -119,6 +119,60 @@ int main(void) {
   }
   fout << "-show" << endl;
   fout.close();
+
+  // Compare the mesh from insert() and bulk_parse() with a larger
+  // set of points and compare the tree lookup with a linear search
+  {
+    static const size_t N2=2000;
+    
+    table<> t4;
+    t4.line_of_names("x y z w");
+    for(size_t i=0;i<N2;i++) {
+      double line[4]={r.random(),r.random(),r.random(),r.random()};
+      t4.line_of_data(4,line);
+    }
+    matrix_view_table<std::vector<double> > mvt4(t4,{"x","y","z","w"});
+    
+    std::vector<double> low3={0.0,0.0,0.0};
+    std::vector<double> high3={1.0,1.0,1.0};
+    
+    prob_dens_mdim_amr<std::vector<double>,
+		       matrix_view_table<std::vector<double> > >
+      amr3(low3,high3), amr4(low3,high3);
+    amr3.initial_parse(mvt4);
+    amr4.n_threads=4;
+    amr4.bulk_parse(mvt4);
+    tm.test_rel(amr3.total_volume(),1.0,1.0e-8,"total volume 3");
+    tm.test_rel(amr4.total_volume(),1.0,1.0e-8,"total volume 4");
+    
+    bool same=(amr3.mesh.size()==amr4.mesh.size());
+    for(size_t i=0;same && i<amr3.mesh.size();i++) {
+      if (amr3.mesh[i].inside[0]!=amr4.mesh[i].inside[0] ||
+	  amr3.mesh[i].frac_vol!=amr4.mesh[i].frac_vol ||
+	  amr3.mesh[i].weight!=amr4.mesh[i].weight) same=false;
+      for(size_t k=0;k<3;k++) {
+	if (amr3.mesh[i].low[k]!=amr4.mesh[i].low[k] ||
+	    amr3.mesh[i].high[k]!=amr4.mesh[i].high[k]) same=false;
+      }
+    }
+    tm.test_gen(same,"bulk_parse() mesh");
+
+    size_t n_wrong=0;
+    vector<double> v3(3);
+    for(size_t i=0;i<1000;i++) {
+      for(size_t k=0;k<3;k++) v3[k]=r.random();
+      size_t jm=0;
+      for(size_t j=0;j<amr3.mesh.size();j++) {
+	if (amr3.mesh[j].is_inside(v3)) {
+	  jm=j;
+	  break;
+	}
+      }
+      if (amr3.pdf(v3)!=amr3.mesh[jm].weight) n_wrong++;
+      if (amr4.pdf(v3)!=amr3.mesh[jm].weight) n_wrong++;
+    }
+    tm.test_gen(n_wrong==0,"pdf() lookup");
+  }
   
   tm.report();
   
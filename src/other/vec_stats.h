@@ -36,6 +36,9 @@
     \future Consider generalizing to other data types.
 */
 
+#include <vector>
+#include <complex>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/vector.h>
 
@@ -712,8 +715,8 @@ namespace o2scl {
 
     long double q=0.0, v=0.0;
     for(size_t i=0;i<k;i++) {
-      q+=0.0;
-      v+=(data[i]-mean)*(data[i]-mean)/(i+1);
+      q+=(0.0-q)/(i+1);
+      v+=((data[i]-mean)*(data[i]-mean)-v)/(i+1);
     }
     for(size_t i=k;i<n;i++) {
       long double delta0=data[i-k]-mean;
@@ -842,6 +845,156 @@ namespace o2scl {
     return len;
   }
   
+  /** \brief In-place radix-2 complex fast Fourier transform
+
+      This function computes the discrete Fourier transform
+      \f[
+      a_k \rightarrow \sum_{j=0}^{n-1} a_j e^{\mp 2 \pi i j k/n}
+      \f]
+      where the minus sign is used for the forward transform and the
+      plus sign is used when \c inverse is true. The inverse transform
+      is not normalized, so a forward transform followed by an
+      inverse transform multiplies the data by \c n. 
+
+      If the size of \c a is not a power of two, this function will
+      call the error handler.
+  */
+  template<class fp_t>
+    void vector_fft_radix2(std::vector<std::complex<fp_t> > &a,
+			   bool inverse=false) {
+    
+    size_t n=a.size();
+    if (n<2) return;
+    if ((n & (n-1))!=0) {
+      O2SCL_ERR2("Size not a power of two in ",
+		 "vector_fft_radix2().",exc_einval);
+    }
+
+    // Bit-reversal permutation
+    for(size_t i=1,j=0;i<n;i++) {
+      size_t bit=n>>1;
+      for(;j & bit;bit>>=1) j^=bit;
+      j^=bit;
+      if (i<j) std::swap(a[i],a[j]);
+    }
+
+    // Danielson-Lanczos butterflies
+    const fp_t pi=acos(-1.0);
+    for(size_t len=2;len<=n;len<<=1) {
+      fp_t ang=2*pi/((fp_t)len);
+      if (!inverse) ang=-ang;
+      std::complex<fp_t> wlen(cos(ang),sin(ang));
+      for(size_t i=0;i<n;i+=len) {
+	std::complex<fp_t> w(1);
+	for(size_t k=0;k<len/2;k++) {
+	  std::complex<fp_t> u=a[i+k];
+	  std::complex<fp_t> v=a[i+k+len/2]*w;
+	  a[i+k]=u+v;
+	  a[i+k+len/2]=u-v;
+	  w*=wlen;
+	}
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Construct an autocorrelation vector using a fast
+      Fourier transform
+
+      This constructs a vector \c ac_vec of size <tt>n/2</tt> for
+      which the kth entry stores the lag-k autocorrelation 
+      \f[
+      \left[
+      \sum_{i=k}^{n-1} \left(x_i - \mu\right) \left(x_{i-k} - \mu \right)
+      \right] \left[ 
+      \sum_{i=0}^{n-1} \left(x_i - \mu\right)^2 
+      \right]^{-1}
+      \f]
+      for all values of k simultaneously. The data is zero-padded to
+      a power of two larger than <tt>2n</tt> and the autocorrelation
+      is computed from the power spectrum, so that this function
+      requires \f$ {\cal O}(n \log n) \f$ operations rather than the
+      \f$ {\cal O}(n^2) \f$ operations required by \ref
+      vector_autocorr_vector() .
+
+      If \c n is less than 2, this function will call the error handler.
+  */
+  template<class vec_t, class resize_vec_t> void vector_autocorr_vector_fft
+    (size_t n, const vec_t &data, resize_vec_t &ac_vec) {
+
+    if (n<2) {
+      O2SCL_ERR2("Not enough elements ",
+		 " in vector_autocorr_vector_fft().",exc_einval);
+    }
+    
+    double mean=vector_mean<vec_t>(n,data);
+    
+    size_t nfft=1;
+    while (nfft<2*n) nfft*=2;
+    std::vector<std::complex<double> > work(nfft);
+    for(size_t i=0;i<n;i++) work[i]=data[i]-mean;
+    
+    vector_fft_radix2(work);
+    for(size_t i=0;i<nfft;i++) work[i]=std::norm(work[i]);
+    vector_fft_radix2(work,true);
+
+    size_t kmax=n/2;
+    ac_vec.resize(kmax);
+    double c0=work[0].real();
+    if (c0==0.0) {
+      for(size_t k=0;k<kmax;k++) ac_vec[k]=0.0;
+      if (kmax>0) ac_vec[0]=1.0;
+      return;
+    }
+    for(size_t k=0;k<kmax;k++) {
+      ac_vec[k]=work[k].real()/c0;
+    }
+    
+    return;
+  }
+
+  /** \brief Construct an autocorrelation vector using a fast
+      Fourier transform
+  */
+  template<class vec_t, class resize_vec_t> void vector_autocorr_vector_fft
+    (const vec_t &data, resize_vec_t &ac_vec) {
+    vector_autocorr_vector_fft(data.size(),data,ac_vec);
+    return;
+  }
+
+  /** \brief Compute the integrated autocorrelation time with
+      an automatic window
+
+      Given the autocorrelation coefficients \f$ \hat{\rho}(s) \f$
+      (with \f$ \hat{\rho}(0)=1 \f$) in the first \c n entries of 
+      \c ac_vec, this function computes
+      \f[
+      \hat{\tau}(M) = 1 + 2 \sum_{s=1}^{M} \hat{\rho}(s)
+      \f]
+      and returns \f$ \hat{\tau}(M) \f$ for the smallest window
+      \f$ M \f$ for which \f$ M \geq c\, \hat{\tau}(M) \f$
+      (the Sokal windowing procedure). The value of \f$ M \f$ is
+      returned in \c window. If there is no such window, then
+      \c window is set to <tt>n-1</tt>, which is a sign that the
+      autocorrelation time is too long to accurately resolve. The
+      effective sample size of a chain of length \f$ N \f$ is then
+      \f$ N/\hat{\tau} \f$.
+  */
+  template<class vec_t> double vector_autocorr_tau_int
+    (size_t n, const vec_t &ac_vec, size_t &window, double c=5.0) {
+    
+    double tau=1.0;
+    window=0;
+    for(size_t M=1;M<n;M++) {
+      tau+=2.0*ac_vec[M];
+      window=M;
+      if (((double)M)>=c*tau) break;
+    }
+    
+    return tau;
+  }
+  
   /** \brief Compute the covariance of two vectors
       
       This function computes
@@ -166,6 +166,29 @@ int main(void) {
   cout << vector_max_value<vector<double>,double>(btest) << endl;
   cout << vector_bin_size_scott(btest) << endl;
   cout << vector_bin_size_freedman(btest) << endl;
+
+  // Compare the FFT-based autocorrelation vector with the direct
+  // computation for an AR(1) process, for which the integrated
+  // autocorrelation time is (1+phi)/(1-phi)
+  {
+    double phi=0.8;
+    std::vector<double> ar(20000), ac1, ac2;
+    ar[0]=pdg();
+    for(size_t i=1;i<ar.size();i++) ar[i]=phi*ar[i-1]+pdg();
+    vector_autocorr_vector(ar,ac1);
+    vector_autocorr_vector_fft(ar,ac2);
+    t.test_gen(ac1.size()==ac2.size(),"ac fft size");
+    t.test_rel(ac2[0],1.0,1.0e-12,"ac fft 0");
+    t.test_rel(ac2[1],ac1[1],1.0e-10,"ac fft 1");
+    for(size_t k=2;k<40;k++) {
+      t.test_abs(ac2[k],ac1[k],1.0e-10,"ac fft k");
+    }
+    size_t window;
+    double tau=vector_autocorr_tau_int(ac2.size(),ac2,window);
+    cout << "tau_int: " << tau << " window: " << window << endl;
+    t.test_rel(tau,(1.0+phi)/(1.0-phi),0.25,"tau_int");
+    t.test_gen(((double)window)>=5.0*tau,"tau_int window");
+  }
   
   t.report();
   
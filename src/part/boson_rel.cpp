@@ -26,6 +26,10 @@
 
 #include <o2scl/boson_rel.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -37,6 +41,7 @@ boson_rel::boson_rel() {
   density_root=&def_density_root;
   nit=&def_nit;
   dit=&def_dit;
+  n_threads=1;
 }
 
 boson_rel::~boson_rel() {
@@ -211,3 +216,83 @@ void boson_rel::pair_mu(boson &b, double temper) {
   return;
 }
 
+
+void boson_rel::calc_mu_batch(double m, double g,
+			      const std::vector<double> &mu,
+			      const std::vector<double> &T,
+			      std::vector<double> &n, std::vector<double> &ed,
+			      std::vector<double> &pr,
+			      std::vector<double> &en) {
+
+  size_t ns=mu.size();
+  if (T.size()!=ns) {
+    O2SCL_ERR2("Temperature and chemical potential vectors have ",
+	       "different sizes in boson_rel::calc_mu_batch().",
+	       exc_einval);
+  }
+  n.resize(ns);
+  ed.resize(ns);
+  pr.resize(ns);
+  en.resize(ns);
+
+  // Set up the objects for the additional threads
+  size_t nt=1;
+#ifdef O2SCL_OPENMP
+  if (n_threads>1 && ns>1) nt=n_threads;
+#endif
+  if (batch_clones.size()<nt-1) batch_clones.resize(nt-1);
+  for(size_t i=0;i<nt-1;i++) {
+    if (!batch_clones[i]) batch_clones[i].reset(new boson_rel);
+    batch_clones[i]->def_dit.tol_rel=dit->tol_rel;
+    batch_clones[i]->def_dit.tol_abs=dit->tol_abs;
+  }
+
+  // Set when calc_mu() throws for any chemical potential, with the
+  // first exception message saved in err_msg
+  bool failed=false;
+  std::string err_msg;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic,16) num_threads(nt)
+#endif
+  for(size_t i=0;i<ns;i++) {
+    size_t it=0;
+#ifdef O2SCL_OPENMP
+    it=omp_get_thread_num();
+#endif
+    boson_rel *br=this;
+    if (it>0) br=batch_clones[it-1].get();
+    boson b(m,g);
+    b.non_interacting=true;
+    b.mu=mu[i];
+    try {
+      br->calc_mu(b,T[i]);
+      n[i]=b.n;
+      ed[i]=b.ed;
+      pr[i]=b.pr;
+      en[i]=b.en;
+    } catch (std::exception &e) {
+      n[i]=0.0;
+      ed[i]=0.0;
+      pr[i]=0.0;
+      en[i]=0.0;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (boson_rel_batch)
+#endif
+      {
+	if (!failed) {
+	  failed=true;
+	  err_msg=e.what();
+	}
+      }
+    }
+  }
+
+  if (failed) {
+    err_msg=((std::string)"Function calc_mu() failed in ")+
+      "boson_rel::calc_mu_batch(): "+err_msg;
+    O2SCL_ERR(err_msg.c_str(),exc_efailed);
+  }
+  
+  return;
+}
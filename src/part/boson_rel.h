@@ -31,6 +31,8 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <vector>
+#include <memory>
 #include <o2scl/constants.h>
 #include <o2scl/root.h>
 #include <o2scl/mroot.h>
@@ -104,6 +106,40 @@ namespace o2scl {
     /// Return string denoting type ("boson_rel")
     virtual const char *type() { return "boson_rel"; }
 
+    /// \name Batch interface
+    //@{
+    /** \brief Number of OpenMP threads for \ref calc_mu_batch() 
+	(default 1)
+    */
+    size_t n_threads;
+
+    /** \brief Compute the thermodynamics of a non-interacting
+	boson with mass \c m and degeneracy \c g for many chemical
+	potentials and temperatures
+
+	For each index \c i, this computes the density, energy
+	density, pressure and entropy for chemical potential
+	<tt>mu[i]</tt> (including the rest mass) and temperature
+	<tt>T[i]</tt> and stores the results in <tt>n[i]</tt>,
+	<tt>ed[i]</tt>, <tt>pr[i]</tt>, and <tt>en[i]</tt>, which are
+	resized if necessary. The results are the same as those from
+	\ref calc_mu().
+
+	If OpenMP support is enabled, the states are distributed over
+	\ref n_threads threads. The additional threads use separate
+	objects with the default integrators and the same tolerances
+	as the degenerate integrator of this object. Errors in
+	individual states are collected and reported by calling the
+	error handler after all states have been computed (see \ref
+	omp_errorhand_subsect).
+    */
+    virtual void calc_mu_batch(double m, double g,
+			       const std::vector<double> &mu,
+			       const std::vector<double> &T,
+			       std::vector<double> &n, std::vector<double> &ed,
+			       std::vector<double> &pr, std::vector<double> &en);
+    //@}
+
   protected:
 
 #ifndef DOXYGEN_NO_O2NS
@@ -130,6 +166,9 @@ namespace o2scl {
     /// Solve for the density in calc_density()
     double solve_fun(double x, boson &b, double T);
 
+    /// Objects for the additional threads in \ref calc_mu_batch()
+    std::vector<std::shared_ptr<boson_rel> > batch_clones;
+
 #endif
 
   };
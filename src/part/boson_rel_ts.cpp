@@ -171,6 +171,31 @@ int main(void) {
     cout << endl;
   */
   
+  // Batch interface
+  {
+    std::vector<double> mu, Tv, bn, bed, bpr, ben;
+    for(size_t i=0;i<20;i++) {
+      Tv.push_back(0.1+0.05*i);
+      mu.push_back(0.2+0.03*i);
+    }
+    rb.calc_mu_batch(1.0,2.0,mu,Tv,bn,bed,bpr,ben);
+    for(size_t i=0;i<mu.size();i++) {
+      boson bx(1.0,2.0);
+      bx.mu=mu[i];
+      rb.calc_mu(bx,Tv[i]);
+      t.test_gen(bn[i]==bx.n && bed[i]==bx.ed && bpr[i]==bx.pr &&
+		 ben[i]==bx.en,"batch");
+    }
+#ifdef O2SCL_OPENMP
+    std::vector<double> bn2, bed2, bpr2, ben2;
+    rb.n_threads=3;
+    rb.calc_mu_batch(1.0,2.0,mu,Tv,bn2,bed2,bpr2,ben2);
+    t.test_gen(bn2==bn && bed2==bed && bpr2==bpr && ben2==ben,
+	       "batch threads");
+    rb.n_threads=1;
+#endif
+  }
+
   t.report();
   return 0;
 
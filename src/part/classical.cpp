@@ -79,6 +79,59 @@ void classical::calc_mu(part &p, double temper) {
   return;
 }
 
+void classical::calc_mu_batch(double m, double g,
+			      const std::vector<double> &mu,
+			      const std::vector<double> &T,
+			      std::vector<double> &n, std::vector<double> &ed,
+			      std::vector<double> &pr, std::vector<double> &en,
+			      bool inc_rest_mass) {
+
+  size_t ns=mu.size();
+  if (T.size()!=ns) {
+    O2SCL_ERR2("Temperature and chemical potential vectors have ",
+	       "different sizes in classical::calc_mu_batch().",
+	       exc_einval);
+  }
+  for(size_t i=0;i<ns;i++) {
+    if (T[i]<0.0) {
+      O2SCL_ERR2("Temperature less than zero in ",
+		 "classical::calc_mu_batch().",exc_einval);
+    }
+  }
+  n.resize(ns);
+  ed.resize(ns);
+  pr.resize(ns);
+  en.resize(ns);
+  if (ns==0) return;
+
+  // Use plain pointers so that the compiler can vectorize the loop
+  const double *mup=&mu[0], *Tp=&T[0];
+  double *np=&n[0], *edp=&ed[0], *prp=&pr[0], *enp=&en[0];
+  double mrest=0.0;
+  if (inc_rest_mass) mrest=m;
+  double gfac=g*pow(m/pi/2.0,1.5);
+
+#ifdef O2SCL_OPENMP
+#pragma omp simd
+#endif
+  for(size_t i=0;i<ns;i++) {
+    double Ti=Tp[i];
+    // Avoid division by zero for T=0, where all quantities vanish
+    double Ts=(Ti>0.0) ? Ti : 1.0;
+    double psi=(mup[i]-mrest)/Ts;
+    double ni=gfac*exp(psi)*Ts*sqrt(Ts);
+    ni=(Ti>0.0 && psi>=-500.0) ? ni : 0.0;
+    double pri=ni*Ti;
+    double edi=1.5*pri+ni*mrest;
+    np[i]=ni;
+    edp[i]=edi;
+    prp[i]=pri;
+    enp[i]=(Ti>0.0) ? (edi+pri-ni*mup[i])/Ts : 0.0;
+  }
+  
+  return;
+}
+
 void classical::calc_density(part &p, double temper) {
 
   if (p.n<0.0 || temper<0.0) {
@@ -31,6 +31,7 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <vector>
 #include <o2scl/constants.h>
 #include <o2scl/mroot.h>
 #include <o2scl/inte.h>
@@ -79,6 +80,31 @@ namespace o2scl {
      */
     virtual void calc_density(part &p, double temper);
 
+    /** \brief Compute the thermodynamics of a non-interacting
+	particle with mass \c m and degeneracy \c g for many chemical
+	potentials and temperatures
+
+	For each index \c i, this computes the density, energy
+	density, pressure and entropy for chemical potential
+	<tt>mu[i]</tt> and temperature <tt>T[i]</tt> and stores the
+	results in <tt>n[i]</tt>, <tt>ed[i]</tt>, <tt>pr[i]</tt>, and
+	<tt>en[i]</tt>, which are resized if necessary. The chemical
+	potentials and energy densities include the rest mass if \c
+	inc_rest_mass is true. The results are the same as those from
+	\ref calc_mu().
+
+	The loop over the states has no function calls other than to
+	<tt>exp()</tt> and <tt>pow()</tt> and no data dependencies, so 
+	it can be vectorized by the compiler (the loop is marked with
+	<tt>omp simd</tt> when OpenMP is enabled).
+    */
+    virtual void calc_mu_batch(double m, double g,
+			       const std::vector<double> &mu,
+			       const std::vector<double> &T,
+			       std::vector<double> &n, std::vector<double> &ed,
+			       std::vector<double> &pr, std::vector<double> &en,
+			       bool inc_rest_mass=true);
+
     /// Return string denoting type ("classical")
     virtual const char *type() { return "classical"; }
     
@@ -47,6 +47,35 @@ int main(void) {
   cl.calc_mu(n,temper);
   t.test_rel(n.n,0.1,1.0e-8,"calc_mu(calc_density)");
 
+  // Batch interface
+  {
+    std::vector<double> mu, T, bn, bed, bpr, ben;
+    for(size_t i=0;i<40;i++) {
+      for(size_t rm=0;rm<2;rm++) {
+	T.push_back(0.01*(i+1));
+	mu.push_back(4.0+0.025*i);
+      }
+    }
+    T[3]=0.0;
+    for(size_t rm=0;rm<2;rm++) {
+      part p(5.0,2.0);
+      p.inc_rest_mass=(rm==0);
+      double mshift=0.0;
+      if (rm==1) mshift=-5.0;
+      std::vector<double> mu2(mu);
+      for(size_t i=0;i<mu2.size();i++) mu2[i]+=mshift;
+      cl.calc_mu_batch(5.0,2.0,mu2,T,bn,bed,bpr,ben,p.inc_rest_mass);
+      for(size_t i=0;i<mu2.size();i++) {
+	p.mu=mu2[i];
+	cl.calc_mu(p,T[i]);
+	t.test_rel(bn[i],p.n,1.0e-13,"batch n");
+	t.test_rel(bed[i],p.ed,1.0e-13,"batch ed");
+	t.test_rel(bpr[i],p.pr,1.0e-13,"batch pr");
+	t.test_rel(ben[i],p.en,1.0e-13,"batch en");
+      }
+    }
+  }
+
   t.report();
   return 0;
 }
@@ -34,6 +34,10 @@
 #include <o2scl/hdf_io.h>
 #include <o2scl/lib_settings.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_hdf;
@@ -85,6 +89,79 @@ void fermion_zerot::pressure_zerot(fermion &f) {
 
 fermion_eval_thermo::fermion_eval_thermo() {
   massless_root=&def_massless_root;
+  n_threads=1;
+}
+
+void fermion_eval_thermo::calc_mu_batch
+(double m, double g, const std::vector<double> &mu,
+ const std::vector<double> &T, std::vector<double> &n,
+ std::vector<double> &ed, std::vector<double> &pr,
+ std::vector<double> &en, bool inc_rest_mass) {
+
+  size_t ns=mu.size();
+  if (T.size()!=ns) {
+    O2SCL_ERR2("Temperature and chemical potential vectors have ",
+	       "different sizes in fermion_eval_thermo::calc_mu_batch().",
+	       exc_einval);
+  }
+  n.resize(ns);
+  ed.resize(ns);
+  pr.resize(ns);
+  en.resize(ns);
+
+  size_t nt=1;
+#ifdef O2SCL_OPENMP
+  if (n_threads>1 && ns>1) nt=batch_prepare(n_threads);
+#endif
+
+  // If batch_solver() throws for a point, its thermodynamic
+  // quantities are set to zero and the message from the first such
+  // point is kept in err_msg (see \ref omp_errorhand_subsect)
+  bool failed=false;
+  std::string err_msg;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic,16) num_threads(nt)
+#endif
+  for(size_t i=0;i<ns;i++) {
+    size_t it=0;
+#ifdef O2SCL_OPENMP
+    it=omp_get_thread_num();
+#endif
+    fermion f(m,g);
+    f.inc_rest_mass=inc_rest_mass;
+    f.non_interacting=true;
+    f.mu=mu[i];
+    try {
+      batch_solver(it)->calc_mu(f,T[i]);
+      n[i]=f.n;
+      ed[i]=f.ed;
+      pr[i]=f.pr;
+      en[i]=f.en;
+    } catch (std::exception &e) {
+      n[i]=0.0;
+      ed[i]=0.0;
+      pr[i]=0.0;
+      en[i]=0.0;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (fermion_eval_thermo_batch)
+#endif
+      {
+	if (!failed) {
+	  failed=true;
+	  err_msg=e.what();
+	}
+      }
+    }
+  }
+
+  if (failed) {
+    err_msg=((std::string)"Function calc_mu() failed in ")+
+      "fermion_eval_thermo::calc_mu_batch(): "+err_msg;
+    O2SCL_ERR(err_msg.c_str(),exc_efailed);
+  }
+  
+  return;
 }
 
 void fermion_zerot::calc_mu_zerot(fermion &f) {
@@ -30,6 +30,7 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <vector>
 
 // For gsl_sf_fermi_dirac_int()
 #include <gsl/gsl_specfunc.h>
@@ -421,9 +422,63 @@ namespace o2scl {
     virtual double calibrate(fermion &f, int verbose=0, bool test_pair=false,
 			     std::string fname="");
 
+    /// \name Batch interface
+    //@{
+    /** \brief Number of OpenMP threads for \ref calc_mu_batch() 
+	(default 1)
+    */
+    size_t n_threads;
+
+    /** \brief Compute the thermodynamics of a non-interacting
+	fermion with mass \c m and degeneracy \c g for many chemical
+	potentials and temperatures
+
+	For each index \c i, this computes the density, energy
+	density, pressure and entropy for chemical potential
+	<tt>mu[i]</tt> and temperature <tt>T[i]</tt> and stores the
+	results in <tt>n[i]</tt>, <tt>ed[i]</tt>, <tt>pr[i]</tt>, and
+	<tt>en[i]</tt>, which are resized if necessary. The chemical
+	potentials and energy densities include the rest mass if \c
+	inc_rest_mass is true. The results are the same as those from
+	\ref calc_mu().
+
+	If OpenMP support is enabled and the class supports it
+	(see \ref batch_prepare()), the states are distributed over
+	\ref n_threads threads. Errors in individual states are
+	collected and reported by calling the error handler after all
+	states have been computed (see \ref omp_errorhand_subsect),
+	and the results for the states which failed are set to zero.
+    */
+    virtual void calc_mu_batch(double m, double g,
+			       const std::vector<double> &mu,
+			       const std::vector<double> &T,
+			       std::vector<double> &n, std::vector<double> &ed,
+			       std::vector<double> &pr, std::vector<double> &en,
+			       bool inc_rest_mass=true);
+    //@}
+
 #ifndef DOXYGEN_NO_O2NS
 
   protected:
+
+    /** \brief Prepare for a batch computation with \c nt threads
+	and return the number of threads which can be used
+
+	The default implementation returns 1, because \ref calc_mu()
+	is not generally safe to call from several threads at once.
+	Children which override this function must also override
+	\ref batch_solver().
+    */
+    virtual size_t batch_prepare(size_t nt) {
+      return 1;
+    }
+
+    /** \brief Return the object used by thread \c ithread in 
+	\ref calc_mu_batch()
+    */
+    virtual fermion_eval_thermo *batch_solver(size_t ithread) {
+      return this;
+    }
     
     /// A pointer to the solver for massless fermions
     root<> *massless_root;
@@ -156,6 +156,15 @@ namespace o2scl {
      */
     double solve_fun(double x, double nog, double msT);
 
+    /** \brief Prepare for a batch computation with \c nt threads
+
+	The function \ref calc_mu() does not modify any class
+	members, so all threads can use this object.
+    */
+    virtual size_t batch_prepare(size_t nt) {
+      return nt;
+    }
+
   private:
 
     fermion_nonrel(const fermion_nonrel &);
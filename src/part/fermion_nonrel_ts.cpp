@@ -308,6 +308,31 @@ int main(void) {
   t.test_rel(e2.en,t4,5.0e-9,"entropy");
   cout << endl;
 
+  // Batch interface
+  {
+    std::vector<double> mu, Tv, bn, bed, bpr, ben;
+    for(size_t i=0;i<50;i++) {
+      Tv.push_back(0.02+0.01*i);
+      mu.push_back(4.8+0.01*i);
+    }
+    nrf.calc_mu_batch(5.0,2.0,mu,Tv,bn,bed,bpr,ben);
+    for(size_t i=0;i<mu.size();i++) {
+      fermion fx(5.0,2.0);
+      fx.mu=mu[i];
+      nrf.calc_mu(fx,Tv[i]);
+      t.test_gen(bn[i]==fx.n && bed[i]==fx.ed && bpr[i]==fx.pr &&
+		 ben[i]==fx.en,"batch");
+    }
+#ifdef O2SCL_OPENMP
+    std::vector<double> bn2, bed2, bpr2, ben2;
+    nrf.n_threads=3;
+    nrf.calc_mu_batch(5.0,2.0,mu,Tv,bn2,bed2,bpr2,ben2);
+    t.test_gen(bn2==bn && bed2==bed && bpr2==bpr && ben2==ben,
+	       "batch threads");
+    nrf.n_threads=1;
+#endif
+  }
+
   t.set_output_level(2);
   t.report();
 
@@ -46,6 +46,19 @@ fermion_rel::fermion_rel() : nit(new inte_qagiu_gsl<>),
   min_psi=-4.0;
   err_nonconv=true;
   use_expansions=true;
+
+  use_table=false;
+  tab_tol=1.0e-9;
+  tab_psi_min=-5.0;
+  tab_psi_max=25.0;
+  tab_eta_min=1.0e-3;
+  tab_eta_max=1.0e3;
+  tab_max_depth=4;
+  tab_npsi=0;
+  tab_gen=0;
+  tab_neta=0;
+  tab_leta_min=0.0;
+  tab_leta_max=0.0;
 }
 
 fermion_rel::~fermion_rel() {
@@ -102,6 +115,9 @@ void fermion_rel::calc_mu(fermion &f, double temper) {
     }
   }
 
+  // Try the table
+  if (use_table && calc_mu_table(f,temper,psi)) return;
+
   if (!deg) {
     
     // If the temperature is large enough, perform the full integral
@@ -386,7 +402,18 @@ int fermion_rel::calc_density(fermion &f, double temper) {
     }
   }
 
-  if (!deg) {
+  // Try the table
+  double tfn, tfe, tfs, terr;
+  if (use_table && table_eval(psi,f.ms/temper,tfn,tfe,tfs,terr)) {
+
+    double prefac=f.g*pow(temper,3.0)/2.0/pi2;
+    f.ed=tfe*prefac*temper;
+    if (!f.inc_rest_mass) f.ed-=density_temp*f.m;
+    unc.ed=fabs(f.ed)*terr;
+    f.en=tfs*prefac;
+    unc.en=f.en*terr;
+    
+  } else if (!deg) {
     
     funct mfe=std::bind(std::mem_fn<double(double,fermion &,double)>
 			  (&fermion_rel::energy_fun),
@@ -643,6 +670,14 @@ double fermion_rel::solve_fun(double x, fermion &f, double T) {
     f.n=ntemp;
   }
 
+  // Try the table
+  double tfn, tfe, tfs, terr;
+  if (use_table && table_eval(psi,f.ms/T,tfn,tfe,tfs,terr)) {
+    nden=tfn*f.g*pow(T,3.0)/2.0/pi2;
+    unc.n=nden*terr;
+    return (f.n-nden)/f.n;
+  }
+
   // Otherwise, directly perform the integration
   if (!deg) {
 
@@ -918,6 +953,14 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
     }
   }
 
+  // Try the table
+  double tfn, tfe, tfs, terr;
+  if (use_table && particles_done==false &&
+      table_eval(psi,f.ms/T,tfn,tfe,tfs,terr)) {
+    particles_done=true;
+    yy=tfn*f.g*pow(T,3.0)/2.0/pi2;
+  }
+
   // If neither expansion worked, use direct integration
   if (particles_done==false) {
     
@@ -1016,6 +1059,13 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
     }
   }
 
+  // Try the table
+  if (use_table && antiparticles_done==false &&
+      table_eval(psi,f.ms/T,tfn,tfe,tfs,terr)) {
+    antiparticles_done=true;
+    yy-=tfn*f.g*pow(T,3.0)/2.0/pi2;
+  }
+
   // If neither expansion worked, use direct integration
   if (antiparticles_done==false) {
     
@@ -1081,3 +1131,376 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
   return yy;
 }
 
+
+bool fermion_rel::calc_mu_table(fermion &f, double temper, double psi) {
+
+  double fn, fe, fs, err;
+  if (!table_eval(psi,f.ms/temper,fn,fe,fs,err)) return false;
+
+  double prefac=f.g*pow(temper,3.0)/2.0/pi2;
+  
+  f.n=fn*prefac;
+  f.ed=fe*prefac*temper;
+  if (!f.inc_rest_mass) f.ed-=f.n*f.m;
+  f.en=fs*prefac;
+  f.pr=-f.ed+temper*f.en+f.nu*f.n;
+  
+  unc.n=f.n*err;
+  unc.ed=fabs(f.ed)*err;
+  unc.en=f.en*err;
+  unc.pr=fabs(f.pr)*err;
+  
+  return true;
+}
+
+void fermion_rel::table_integ(double psi, double leta, double lf[3],
+			      double &rel_unc) {
+
+  // With T=1 and g=2 pi^2, the density, energy density, and entropy
+  // are equal to the dimensionless integrals
+  double eta=exp(leta);
+  fermion ft(eta,2.0*pi2);
+  ft.inc_rest_mass=true;
+  ft.non_interacting=true;
+  ft.mu=psi+eta;
+  calc_mu(ft,1.0);
+
+  if (ft.n<=0.0 || ft.ed<=0.0 || ft.en<=0.0 || !std::isfinite(ft.n) ||
+      !std::isfinite(ft.ed) || !std::isfinite(ft.en)) {
+    O2SCL_ERR2("Integrals not positive and finite in ",
+	       "fermion_rel::table_integ().",exc_efailed);
+  }
+  
+  lf[0]=log(ft.n);
+  lf[1]=log(ft.ed);
+  lf[2]=log(ft.en);
+  rel_unc=unc.n/ft.n;
+  if (unc.ed/ft.ed>rel_unc) rel_unc=unc.ed/ft.ed;
+  if (unc.en/ft.en>rel_unc) rel_unc=unc.en/ft.en;
+  
+  return;
+}
+
+void fermion_rel::table_cheb(const tab_patch &tp, double psi, double leta,
+			     double lf[3]) const {
+
+  const size_t nc=tab_nodes;
+  
+  // Map to [-1,1] and compute the Chebyshev polynomials
+  double x=(2.0*psi-tp.psi_lo-tp.psi_hi)/(tp.psi_hi-tp.psi_lo);
+  double y=(2.0*leta-tp.leta_lo-tp.leta_hi)/(tp.leta_hi-tp.leta_lo);
+  double tx[nc], ty[nc];
+  tx[0]=1.0;
+  tx[1]=x;
+  ty[0]=1.0;
+  ty[1]=y;
+  for(size_t j=2;j<nc;j++) {
+    tx[j]=2.0*x*tx[j-1]-tx[j-2];
+    ty[j]=2.0*y*ty[j-1]-ty[j-2];
+  }
+
+  for(size_t q=0;q<3;q++) {
+    const double *c=&tp.coeff[q*nc*nc];
+    double sum=0.0;
+    for(size_t j=0;j<nc;j++) {
+      double row=0.0;
+      for(size_t k=0;k<nc;k++) row+=c[j*nc+k]*ty[k];
+      sum+=tx[j]*row;
+    }
+    lf[q]=sum;
+  }
+  
+  return;
+}
+
+void fermion_rel::table_patch(size_t ip, size_t depth) {
+
+  const size_t nc=tab_nodes;
+  
+  double psi_lo=tab_patches[ip].psi_lo;
+  double psi_hi=tab_patches[ip].psi_hi;
+  double leta_lo=tab_patches[ip].leta_lo;
+  double leta_hi=tab_patches[ip].leta_hi;
+
+  // The Chebyshev nodes and the polynomials evaluated there
+  std::vector<double> node(nc), tn(nc*nc);
+  for(size_t i=0;i<nc;i++) {
+    node[i]=cos(pi*(i+0.5)/nc);
+    for(size_t j=0;j<nc;j++) {
+      tn[j*nc+i]=cos(pi*j*(i+0.5)/nc);
+    }
+  }
+
+  // Compute the integrals at the nodes
+  std::vector<double> vals(3*nc*nc);
+  double max_unc=0.0;
+  for(size_t i=0;i<nc;i++) {
+    double psi=(psi_lo+psi_hi)/2.0+node[i]*(psi_hi-psi_lo)/2.0;
+    for(size_t l=0;l<nc;l++) {
+      double leta=(leta_lo+leta_hi)/2.0+node[l]*(leta_hi-leta_lo)/2.0;
+      double lf[3], ru;
+      table_integ(psi,leta,lf,ru);
+      for(size_t q=0;q<3;q++) vals[q*nc*nc+i*nc+l]=lf[q];
+      if (ru>max_unc) max_unc=ru;
+    }
+  }
+
+  // Compute the coefficients from the discrete orthogonality
+  // relations
+  std::vector<double> coeff(3*nc*nc,0.0);
+  for(size_t q=0;q<3;q++) {
+    for(size_t j=0;j<nc;j++) {
+      for(size_t k=0;k<nc;k++) {
+	double sum=0.0;
+	for(size_t i=0;i<nc;i++) {
+	  for(size_t l=0;l<nc;l++) {
+	    sum+=vals[q*nc*nc+i*nc+l]*tn[j*nc+i]*tn[k*nc+l];
+	  }
+	}
+	sum*=4.0/nc/nc;
+	if (j==0) sum/=2.0;
+	if (k==0) sum/=2.0;
+	coeff[q*nc*nc+j*nc+k]=sum;
+      }
+    }
+  }
+  tab_patches[ip].coeff=coeff;
+
+  // Estimate the error from the two highest-order coefficients in
+  // each direction
+  double err=0.0;
+  for(size_t q=0;q<3;q++) {
+    double sum=0.0;
+    for(size_t j=0;j<nc;j++) {
+      for(size_t k=0;k<nc;k++) {
+	if (j>=nc-2 || k>=nc-2) sum+=fabs(coeff[q*nc*nc+j*nc+k]);
+      }
+    }
+    if (sum>err) err=sum;
+  }
+
+  // Compare with the integrals at the center, which is not one 
+  // of the nodes
+  double lf[3], lf2[3], ru;
+  double psi_c=(psi_lo+psi_hi)/2.0, leta_c=(leta_lo+leta_hi)/2.0;
+  table_integ(psi_c,leta_c,lf,ru);
+  if (ru>max_unc) max_unc=ru;
+  table_cheb(tab_patches[ip],psi_c,leta_c,lf2);
+  for(size_t q=0;q<3;q++) {
+    if (fabs(lf[q]-lf2[q])>err) err=fabs(lf[q]-lf2[q]);
+  }
+
+  tab_patches[ip].err=err+max_unc;
+  tab_patches[ip].split=false;
+  
+  if (err<=tab_tol+max_unc) {
+    tab_patches[ip].valid=true;
+    return;
+  }
+
+  if (depth>=tab_max_depth) {
+    tab_patches[ip].valid=false;
+    return;
+  }
+
+  // Subdivide into four children
+  tab_patches[ip].split=true;
+  tab_patches[ip].valid=false;
+  tab_patches[ip].coeff.clear();
+  size_t ic=tab_patches.size();
+  tab_patches[ip].child=ic;
+  for(size_t k=0;k<4;k++) {
+    tab_patch tp;
+    if (k%2==0) {
+      tp.psi_lo=psi_lo;
+      tp.psi_hi=psi_c;
+    } else {
+      tp.psi_lo=psi_c;
+      tp.psi_hi=psi_hi;
+    }
+    if (k/2==0) {
+      tp.leta_lo=leta_lo;
+      tp.leta_hi=leta_c;
+    } else {
+      tp.leta_lo=leta_c;
+      tp.leta_hi=leta_hi;
+    }
+    tp.split=false;
+    tp.valid=false;
+    tp.child=0;
+    tp.err=0.0;
+    tab_patches.push_back(tp);
+  }
+  for(size_t k=0;k<4;k++) {
+    table_patch(ic+k,depth+1);
+  }
+  
+  return;
+}
+
+int fermion_rel::build_table() {
+
+  if (tab_psi_max<=tab_psi_min || tab_eta_min<=0.0 ||
+      tab_eta_max<=tab_eta_min) {
+    O2SCL_ERR("Invalid table limits in fermion_rel::build_table().",
+	      exc_einval);
+  }
+
+  clear_table();
+
+  // The coarse grid uses patches which are approximately 2.5 wide
+  // in both psi and log(eta). The integrals are computed with a
+  // different method on either side of deg_limit, so a patch
+  // boundary is placed there.
+  tab_leta_min=log(tab_eta_min);
+  tab_leta_max=log(tab_eta_max);
+  std::vector<double> psi_grid;
+  psi_grid.push_back(tab_psi_min);
+  if (deg_limit>tab_psi_min && deg_limit<tab_psi_max) {
+    size_t n1=((size_t)ceil((deg_limit-tab_psi_min)/2.5));
+    for(size_t i=1;i<=n1;i++) {
+      psi_grid.push_back(tab_psi_min+(deg_limit-tab_psi_min)*i/n1);
+    }
+  }
+  double psi_start=psi_grid[psi_grid.size()-1];
+  size_t n2=((size_t)ceil((tab_psi_max-psi_start)/2.5));
+  for(size_t i=1;i<=n2;i++) {
+    psi_grid.push_back(psi_start+(tab_psi_max-psi_start)*i/n2);
+  }
+  tab_psi_grid=psi_grid;
+  tab_npsi=psi_grid.size()-1;
+  tab_neta=((size_t)ceil((tab_leta_max-tab_leta_min)/2.5));
+  double dleta=(tab_leta_max-tab_leta_min)/tab_neta;
+  
+  for(size_t i=0;i<tab_npsi;i++) {
+    for(size_t j=0;j<tab_neta;j++) {
+      tab_patch tp;
+      tp.psi_lo=psi_grid[i];
+      tp.psi_hi=psi_grid[i+1];
+      tp.leta_lo=tab_leta_min+j*dleta;
+      tp.leta_hi=tab_leta_min+(j+1)*dleta;
+      tp.split=false;
+      tp.valid=false;
+      tp.child=0;
+      tp.err=0.0;
+      tab_patches.push_back(tp);
+    }
+  }
+
+  // The table is constructed from the integrals only, since the
+  // expansions would give small discontinuities
+  bool ue_temp=use_expansions;
+  use_expansions=false;
+  
+  for(size_t ip=0;ip<tab_npsi*tab_neta;ip++) {
+    table_patch(ip,0);
+  }
+  use_expansions=ue_temp;
+
+  // Count the invalid patches
+  int n_invalid=0;
+  for(size_t ip=0;ip<tab_patches.size();ip++) {
+    if (!tab_patches[ip].split && !tab_patches[ip].valid) n_invalid++;
+  }
+
+  use_table=true;
+  tab_gen++;
+  
+  return n_invalid;
+}
+
+void fermion_rel::clear_table() {
+  tab_patches.clear();
+  tab_psi_grid.clear();
+  tab_npsi=0;
+  tab_neta=0;
+  use_table=false;
+  tab_gen++;
+  return;
+}
+
+bool fermion_rel::table_eval(double psi, double eta, double &fn,
+			     double &fe, double &fs, double &err) const {
+
+  if (tab_patches.size()==0 || !(eta>0.0)) return false;
+  double leta=log(eta);
+  if (!(psi>=tab_psi_min && psi<=tab_psi_max &&
+	leta>=tab_leta_min && leta<=tab_leta_max)) {
+    return false;
+  }
+
+  // Find the coarse patch
+  size_t i=std::upper_bound(tab_psi_grid.begin(),tab_psi_grid.end(),psi)-
+    tab_psi_grid.begin();
+  if (i>0) i--;
+  size_t j=((size_t)((leta-tab_leta_min)/(tab_leta_max-tab_leta_min)*
+		     tab_neta));
+  if (i>=tab_npsi) i=tab_npsi-1;
+  if (j>=tab_neta) j=tab_neta-1;
+  size_t ip=i*tab_neta+j;
+
+  // Descend to the leaf containing the point
+  while (tab_patches[ip].split) {
+    const tab_patch &tp=tab_patches[ip];
+    size_t k=0;
+    if (psi>=(tp.psi_lo+tp.psi_hi)/2.0) k+=1;
+    if (leta>=(tp.leta_lo+tp.leta_hi)/2.0) k+=2;
+    ip=tp.child+k;
+  }
+  if (!tab_patches[ip].valid) return false;
+
+  double lf[3];
+  table_cheb(tab_patches[ip],psi,leta,lf);
+  fn=exp(lf[0]);
+  fe=exp(lf[1]);
+  fs=exp(lf[2]);
+  err=tab_patches[ip].err;
+  
+  return true;
+}
+
+size_t fermion_rel::batch_prepare(size_t nt) {
+
+  if (batch_clones.size()<nt-1) batch_clones.resize(nt-1);
+  
+  for(size_t i=0;i<nt-1;i++) {
+    if (!batch_clones[i]) batch_clones[i].reset(new fermion_rel);
+    fermion_rel &fr=*batch_clones[i];
+    
+    fr.err_nonconv=err_nonconv;
+    fr.min_psi=min_psi;
+    fr.deg_limit=deg_limit;
+    fr.exp_limit=exp_limit;
+    fr.upper_limit_fac=upper_limit_fac;
+    fr.deg_entropy_fac=deg_entropy_fac;
+    fr.use_expansions=use_expansions;
+    fr.nit->tol_rel=nit->tol_rel;
+    fr.nit->tol_abs=nit->tol_abs;
+    fr.dit->tol_rel=dit->tol_rel;
+    fr.dit->tol_abs=dit->tol_abs;
+    fr.density_root->tol_rel=density_root->tol_rel;
+    fr.density_root->tol_abs=density_root->tol_abs;
+
+    fr.use_table=use_table;
+    fr.tab_tol=tab_tol;
+    fr.tab_psi_min=tab_psi_min;
+    fr.tab_psi_max=tab_psi_max;
+    fr.tab_eta_min=tab_eta_min;
+    fr.tab_eta_max=tab_eta_max;
+    fr.tab_max_depth=tab_max_depth;
+
+    // The table can be large, so it is only copied if it has
+    // been rebuilt or cleared since the last batch
+    if (fr.tab_gen!=tab_gen) {
+      fr.tab_patches=tab_patches;
+      fr.tab_psi_grid=tab_psi_grid;
+      fr.tab_npsi=tab_npsi;
+      fr.tab_neta=tab_neta;
+      fr.tab_leta_min=tab_leta_min;
+      fr.tab_leta_max=tab_leta_max;
+      fr.tab_gen=tab_gen;
+    }
+  }
+  
+  return nt;
+}
@@ -31,6 +31,8 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include <o2scl/constants.h>
 #include <o2scl/mroot.h>
 #include <o2scl/inte.h>
@@ -193,6 +195,35 @@ namespace o2scl {
       chemical potential from the density. Of course if these
       tolerances are too small, the calculation may fail.
 
+      \hline 
+      <b>Tabulated thermodynamics:</b>
+
+      For a fixed value of \f$ \psi \f$ and \f$ \eta \equiv m^{*}/T
+      \f$, the density, energy density, and entropy are proportional
+      to dimensionless integrals which depend only on \f$ \psi \f$
+      and \f$ \eta \f$. The function \ref build_table() computes
+      these integrals once over the domain \f$ \psi_{\mathrm{min}}
+      \leq \psi \leq \psi_{\mathrm{max}} \f$ and \f$
+      \eta_{\mathrm{min}} \leq \eta \leq \eta_{\mathrm{max}} \f$
+      (set in \ref tab_psi_min, \ref tab_psi_max, \ref tab_eta_min,
+      and \ref tab_eta_max) and stores their logarithms as
+      two-dimensional Chebyshev expansions in \f$ \psi \f$ and \f$
+      \log \eta \f$ on rectangular patches. Each patch is
+      subdivided until the estimated relative error (the size of the
+      highest-order Chebyshev coefficients and the difference from
+      the integrals at the center of the patch) is smaller than
+      \ref tab_tol plus the relative uncertainty of the integrals
+      reported in \ref unc. Patches which do not converge after
+      \ref tab_max_depth subdivisions are marked invalid.
+
+      When \ref use_table is true (it is set to true by \ref
+      build_table()), the functions calc_mu(), calc_density(),
+      pair_mu() and pair_density() use the table instead of direct
+      integration whenever the expansions are not applicable and the
+      point lies in a valid patch, and the uncertainty in \ref unc
+      is set using the error estimate for the patch. Otherwise
+      direct integration is used as before.
+
       \hline 
       <b>Todos:</b>
 
@@ -298,6 +329,70 @@ namespace o2scl {
     /// The solver for calc_density()
     std::shared_ptr<root<> > density_root;
 
+    /// \name Tabulated thermodynamics
+    //@{
+    /** \brief If true, use the table when it is available
+	(default false)
+    */
+    bool use_table;
+    
+    /** \brief The relative tolerance for the table (default 
+	\f$ 10^{-9} \f$)
+    */
+    double tab_tol;
+
+    /// The smallest value of \f$ \psi \f$ in the table (default -5)
+    double tab_psi_min;
+
+    /// The largest value of \f$ \psi \f$ in the table (default 25)
+    double tab_psi_max;
+
+    /** \brief The smallest value of \f$ m^{*}/T \f$ in the table 
+	(default \f$ 10^{-3} \f$)
+    */
+    double tab_eta_min;
+
+    /** \brief The largest value of \f$ m^{*}/T \f$ in the table
+	(default \f$ 10^{3} \f$)
+    */
+    double tab_eta_max;
+
+    /// The maximum number of patch subdivisions (default 4)
+    size_t tab_max_depth;
+
+    /** \brief Construct the table of integrals and set 
+	\ref use_table to true
+
+	This function returns the number of patches which could not
+	be computed to within the requested tolerance. Points inside
+	these patches are computed with direct integration.
+    */
+    int build_table();
+
+    /// Remove the table and set \ref use_table to false
+    void clear_table();
+
+    /// Return the number of patches in the table
+    size_t get_table_npatches() const {
+      return tab_patches.size();
+    }
+
+    /** \brief Compute the dimensionless density, energy density,
+	and entropy integrals from the table
+
+	If the point at \f$ \psi \f$ and \f$ \eta=m^{*}/T \f$ is
+	inside a valid patch of the table, this function sets \c fn,
+	\c fe, and \c fs and the estimated relative error \c err
+	and returns true. Otherwise, it returns false. The
+	density, energy density and entropy are
+	\f$ g T^3 f_n/(2 \pi^2) \f$, \f$ g T^4 f_e/(2 \pi^2) \f$, 
+	and \f$ g T^3 f_s/(2 \pi^2) \f$, respectively, where the 
+	energy density includes the rest mass \f$ m^{*} \f$.
+    */
+    bool table_eval(double psi, double eta, double &fn, double &fe,
+		    double &fs, double &err) const;
+    //@}
+
     /// Return string denoting type ("fermion_rel")
     virtual const char *type() { return "fermion_rel"; }
 
@@ -336,6 +431,106 @@ namespace o2scl {
 	antiparticles.
     */
     double pair_fun(double x, fermion &f, double T, bool log_mode);
+
+    /// \name Table storage
+    //@{
+    /// The number of Chebyshev nodes in each direction in each patch
+    static const size_t tab_nodes=12;
+
+    /** \brief A rectangular patch in \f$ \psi \f$ and
+	\f$ \log \eta \f$
+    */
+    class tab_patch {
+    public:
+      /// Lower limit in \f$ \psi \f$
+      double psi_lo;
+      /// Upper limit in \f$ \psi \f$
+      double psi_hi;
+      /// Lower limit in \f$ \log \eta \f$
+      double leta_lo;
+      /// Upper limit in \f$ \log \eta \f$
+      double leta_hi;
+      /// If true, the patch has been subdivided
+      bool split;
+      /// If true, the patch satisfies the tolerance
+      bool valid;
+      /// The index of the first of the four children
+      size_t child;
+      /// The estimated relative error
+      double err;
+      /** \brief The Chebyshev coefficients for \f$ \log f_n \f$,
+	  \f$ \log f_e \f$, and \f$ \log f_s \f$
+      */
+      std::vector<double> coeff;
+    };
+
+    /// The patches, beginning with the coarse grid
+    std::vector<tab_patch> tab_patches;
+
+    /// The boundaries of the coarse patches in \f$ \psi \f$
+    std::vector<double> tab_psi_grid;
+
+    /// The number of coarse patches in \f$ \psi \f$
+    size_t tab_npsi;
+
+    /// The number of coarse patches in \f$ \log \eta \f$
+    size_t tab_neta;
+
+    /// The limits of the table in \f$ \log \eta \f$
+    double tab_leta_min, tab_leta_max;
+
+    /** \brief Incremented whenever the table is built or cleared,
+	so that \ref batch_prepare() only copies a modified table
+    */
+    size_t tab_gen;
+    //@}
+
+    /** \brief Compute the logarithms of the dimensionless integrals
+	and their relative uncertainty with direct integration
+    */
+    void table_integ(double psi, double leta, double lf[3],
+		     double &rel_unc);
+
+    /** \brief Compute the Chebyshev coefficients for patch \c ip and
+	subdivide it if necessary
+    */
+    void table_patch(size_t ip, size_t depth);
+
+    /** \brief Evaluate the Chebyshev expansions in patch \c tp
+     */
+    void table_cheb(const tab_patch &tp, double psi, double leta,
+		    double lf[3]) const;
+
+    /** \brief If the table is in use and the point is inside
+	a valid patch, compute the thermodynamics of \c f from
+	the table and return true
+    */
+    bool calc_mu_table(fermion &f, double temper, double psi);
+
+    /// \name Batch computations
+    //@{
+    /** \brief Objects for the additional threads in
+	\ref calc_mu_batch()
+    */
+    std::vector<std::shared_ptr<fermion_rel> > batch_clones;
+
+    /** \brief Create \c nt-1 objects for the additional threads
+	with the same settings and table as this object
+
+	The additional objects use the default integrators and
+	solver types with the same tolerances as \ref nit, \ref dit,
+	and \ref density_root.
+    */
+    virtual size_t batch_prepare(size_t nt);
+
+    /** \brief Return the object used by thread \c ithread in 
+	\ref calc_mu_batch()
+    */
+    virtual fermion_eval_thermo *batch_solver(size_t ithread) {
+      if (ithread==0) return this;
+      return batch_clones[ithread-1].get();
+    }
+    //@}
     
 #endif
 
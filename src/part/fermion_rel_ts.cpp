@@ -784,6 +784,129 @@ int main(void) {
   double v2=rf.calibrate(e,1,0,"../../data/o2scl/fermion_cal2.o2");
   t.test_rel(v2,0.0,1.0e-10,"calibrate 2");
 
+  // -----------------------------------------------------------------
+
+  cout << "----------------------------------------------------" << endl;
+  cout << "Tabulated thermodynamics." << endl;
+  cout << "----------------------------------------------------" << endl;
+  cout << endl;
+
+  {
+    fermion_rel rt, ri;
+    int n_invalid=rt.build_table();
+    cout << "Patches: " << rt.get_table_npatches() << " invalid: "
+	 << n_invalid << endl;
+    t.test_gen(n_invalid==0,"table invalid patches");
+    t.test_gen(rt.use_table,"table use_table");
+
+    // Compare with direct integration on both sides of deg_limit
+    // and with and without the rest mass
+    rt.use_expansions=false;
+    ri.use_expansions=false;
+    fermion f1(1.0,2.0), f2(1.0,2.0);
+    double psis[4]={-3.5,0.5,2.5,15.0};
+    double temps[3]={0.01,0.3,8.0};
+    for(size_t irm=0;irm<2;irm++) {
+      f1.inc_rest_mass=(irm==0);
+      f2.inc_rest_mass=(irm==0);
+      for(size_t ip=0;ip<4;ip++) {
+	for(size_t it=0;it<3;it++) {
+	  f1.mu=psis[ip]*temps[it];
+	  if (f1.inc_rest_mass) f1.mu+=f1.m;
+	  f2.mu=f1.mu;
+	  rt.calc_mu(f1,temps[it]);
+	  ri.calc_mu(f2,temps[it]);
+	  t.test_rel(f1.n,f2.n,1.0e-7,"table n");
+	  t.test_rel(f1.ed,f2.ed,1.0e-7,"table ed");
+	  t.test_rel(f1.pr,f2.pr,1.0e-7,"table pr");
+	  t.test_rel(f1.en,f2.en,1.0e-7,"table en");
+	  t.test_gen(rt.unc.n<f1.n*1.0e-6,"table unc");
+	}
+      }
+    }
+
+    // Outside the table, the integrals are used
+    f1.inc_rest_mass=true;
+    f2.inc_rest_mass=true;
+    f1.mu=1.0+2.0e-4;
+    f2.mu=f1.mu;
+    rt.calc_mu(f1,1.0e-4);
+    ri.calc_mu(f2,1.0e-4);
+    t.test_gen(f1.n==f2.n && f1.en==f2.en,"table fallback");
+
+    // Density solver with and without antiparticles
+    f1.n=0.2;
+    f2.n=0.2;
+    f1.mu=1.1;
+    f2.mu=1.1;
+    rt.calc_density(f1,0.3);
+    ri.calc_density(f2,0.3);
+    t.test_rel(f1.mu,f2.mu,1.0e-7,"table calc_density mu");
+    t.test_rel(f1.pr,f2.pr,1.0e-7,"table calc_density pr");
+    rt.pair_density(f1,0.3);
+    ri.pair_density(f2,0.3);
+    t.test_rel(f1.mu,f2.mu,1.0e-7,"table pair_density mu");
+    t.test_rel(f1.pr,f2.pr,1.0e-7,"table pair_density pr");
+
+    // The calibration with the default settings
+    rt.use_expansions=true;
+    double v3=rt.calibrate(e,1,0,"../../data/o2scl/fermion_cal2.o2");
+    t.test_rel(v3,0.0,1.0e-6,"calibrate table");
+  }
+
+  // -----------------------------------------------------------------
+
+  cout << "----------------------------------------------------" << endl;
+  cout << "Batch interface." << endl;
+  cout << "----------------------------------------------------" << endl;
+  cout << endl;
+
+  {
+    // States on both sides of deg_limit and in the regions
+    // where the expansions are used
+    fermion_rel rb;
+    std::vector<double> mu, Tv, bn, bed, bpr, ben;
+    for(size_t i=0;i<60;i++) {
+      double Tx=0.01*pow(10.0,((double)(i%6))/2.0);
+      double psi=-30.0+1.0*i;
+      Tv.push_back(Tx);
+      mu.push_back(1.0+psi*Tx);
+    }
+    for(size_t rm=0;rm<2;rm++) {
+      std::vector<double> mu2(mu);
+      if (rm==1) {
+	for(size_t i=0;i<mu2.size();i++) mu2[i]-=1.0;
+      }
+      rb.calc_mu_batch(1.0,2.0,mu2,Tv,bn,bed,bpr,ben,rm==0);
+      for(size_t i=0;i<mu2.size();i++) {
+	fermion fx(1.0,2.0);
+	fx.inc_rest_mass=(rm==0);
+	fx.mu=mu2[i];
+	rb.calc_mu(fx,Tv[i]);
+	t.test_gen(bn[i]==fx.n && bed[i]==fx.ed && bpr[i]==fx.pr &&
+		   ben[i]==fx.en,"batch");
+      }
+#ifdef O2SCL_OPENMP
+      // The results do not depend on the number of threads, also
+      // when the table is used
+      std::vector<double> bn2, bed2, bpr2, ben2;
+      rb.n_threads=3;
+      rb.calc_mu_batch(1.0,2.0,mu2,Tv,bn2,bed2,bpr2,ben2,rm==0);
+      t.test_gen(bn2==bn && bed2==bed && bpr2==bpr && ben2==ben,
+		 "batch threads");
+      rb.n_threads=1;
+      rb.build_table();
+      rb.calc_mu_batch(1.0,2.0,mu2,Tv,bn,bed,bpr,ben,rm==0);
+      rb.n_threads=3;
+      rb.calc_mu_batch(1.0,2.0,mu2,Tv,bn2,bed2,bpr2,ben2,rm==0);
+      t.test_gen(bn2==bn && bed2==bed && bpr2==bpr && ben2==ben,
+		 "batch threads table");
+      rb.n_threads=1;
+      rb.clear_table();
+#endif
+    }
+  }
+
   // -----------------------------------------------------------------
   // Downcast the shared_ptr to the default integration type 
 
@@ -28,6 +28,13 @@
 */
 
 #include <string>
+#include <vector>
+#include <algorithm>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 #include <o2scl/mm_funct.h>
 #include <o2scl/deriv_gsl.h>
 #include <o2scl/columnify.h>
@@ -133,6 +140,35 @@ namespace o2scl {
       This class does not separately check the vector and matrix sizes
       to ensure they are commensurate. 
 
+      <b>Sparse Jacobians</b>
+
+      If the structure of the Jacobian is known, it can be specified
+      with \ref set_sparsity(). The columns are then divided into
+      groups of structurally orthogonal columns (columns which have
+      no non-zero entries in the same row) using the greedy method
+      of Curtis, Powell, and Reid (largest columns first). All of the
+      columns in a group are stepped simultaneously, so the number of
+      function evaluations is the number of groups (see \ref
+      get_ngroups()) rather than the number of columns. Entries
+      outside of the sparsity pattern are set to zero. When a step
+      fails, the step sizes for all of the columns in the group are
+      flipped or shrunk together.
+
+      <b>Parallel evaluation</b>
+
+      If OpenMP support is enabled and \ref n_threads is larger than
+      one, the columns (or groups of columns) are distributed over
+      \ref n_threads threads, each with its own copy of the point and
+      the function values. Each thread uses its own function object,
+      either from the list given to \ref set_thread_functions() or a copy of
+      the function given to \ref set_function(). In the latter case,
+      the copies typically refer to the same underlying object, so
+      the function must be safe to call from several threads at once.
+      The resulting Jacobian does not depend on the number of
+      threads. Exceptions thrown by the function are collected and
+      the error handler is called afterwards (see \ref
+      omp_errorhand_subsect).
+
       Default template arguments
       - \c func_t - \ref mm_funct
       - \c vec_t - boost::numeric::ublas::vector<double>
@@ -172,6 +208,135 @@ namespace o2scl {
   /// Factor to shrink stepsize by
   double shrink_fact;
 
+  /// Step sizes for the serial evaluation
+  std::vector<double> hv;
+
+  /// \name Sparsity pattern
+  //@{
+  /// If true, a sparsity pattern has been specified
+  bool sparse;
+  /// Number of rows in the sparsity pattern
+  size_t sp_ny;
+  /// Number of columns in the sparsity pattern
+  size_t sp_nx;
+  /// For each column, the rows with structurally non-zero entries
+  std::vector<std::vector<size_t> > col_rows;
+  /// The groups of structurally orthogonal columns
+  std::vector<std::vector<size_t> > groups;
+  //@}
+
+  /// \name Parallel evaluation
+  //@{
+  /// User-specified functions, one for each thread
+  std::vector<func_t> func_list;
+  /// Function values for each thread
+  std::vector<vec_t> f_th;
+  /// Function arguments for each thread
+  std::vector<vec_t> xx_th;
+  /// Step sizes for each thread
+  std::vector<std::vector<double> > h_th;
+  /// Copies of the function for each thread
+  std::vector<func_t> func_th;
+  //@}
+
+  /** \brief Compute the columns of the Jacobian in \c cols
+      using function \c fn and temporary storage \c xl, \c fl, and
+      \c hl
+
+      The vector \c xl must be equal to \c x on entry, and it is
+      restored on exit. If the function could not be evaluated, the
+      value returned by the function is returned. Otherwise, zero is
+      returned and \c zero_col is set to true if any of the columns
+      were all zero.
+  */
+  int eval_cols(const size_t *cols, size_t ncols, func_t &fn,
+		size_t nx, vec_t &x, size_t ny, vec_t &y, vec_t &xl,
+		vec_t &fl, std::vector<double> &hl, mat_t &jac,
+		bool &zero_col) {
+
+    zero_col=false;
+    
+    for(size_t k=0;k<ncols;k++) {
+      size_t j=cols[k];
+      // Thanks to suggestion from Conrad Curry.
+      double h=epsrel*fabs(x[j]);
+      if (h<epsmin) h=epsmin;
+      if (h==0.0) h=epsrel;
+      hl[k]=h;
+    }
+
+    for(size_t k=0;k<ncols;k++) xl[cols[k]]=x[cols[k]]+hl[k];
+    int ret=fn(nx,xl,fl);
+    for(size_t k=0;k<ncols;k++) xl[cols[k]]=x[cols[k]];
+
+    // The function returned a non-zero value, so try a different step
+    size_t it=0;
+    while (ret!=0 && steps_above_min(ncols,hl) && it<max_shrink_iters) {
+      
+      // First try flipping the sign
+      for(size_t k=0;k<ncols;k++) {
+	hl[k]=-hl[k];
+	xl[cols[k]]=x[cols[k]]+hl[k];
+      }
+      ret=fn(nx,xl,fl);
+      for(size_t k=0;k<ncols;k++) xl[cols[k]]=x[cols[k]];
+      
+      if (ret!=0) {
+	
+	// If that didn't work, flip to positive and try a smaller
+	// stepsize
+	for(size_t k=0;k<ncols;k++) hl[k]/=-shrink_fact;
+	if (steps_above_min(ncols,hl)) {
+	  for(size_t k=0;k<ncols;k++) xl[cols[k]]=x[cols[k]]+hl[k];
+	  ret=fn(nx,xl,fl);
+	  for(size_t k=0;k<ncols;k++) xl[cols[k]]=x[cols[k]];
+	}
+	
+      }
+      
+      it++;
+    }
+
+    if (ret!=0) return ret;
+
+    // This is the equivalent of GSL's test of
+    // gsl_vector_isnull(&col.vector)
+    
+    for(size_t k=0;k<ncols;k++) {
+      size_t j=cols[k];
+      bool nonzero=false;
+      if (sparse) {
+	for(size_t i=0;i<ny;i++) jac(i,j)=0.0;
+	const std::vector<size_t> &rows=col_rows[j];
+	for(size_t ir=0;ir<rows.size();ir++) {
+	  size_t i=rows[ir];
+	  double temp=(fl[i]-y[i])/hl[k];
+	  if (temp!=0.0) nonzero=true;
+	  jac(i,j)=temp;
+	}
+      } else {
+	for(size_t i=0;i<ny;i++) {
+	  double temp=(fl[i]-y[i])/hl[k];
+	  if (temp!=0.0) nonzero=true;
+	  jac(i,j)=temp;
+	}
+      }
+      if (nonzero==false) zero_col=true;
+    }
+
+    return 0;
+  }
+
+  /** \brief Return true if all of the first \c n step sizes
+      in \c hl are at least \ref epsmin
+  */
+  bool steps_above_min(size_t n, const std::vector<double> &hl) {
+    for(size_t k=0;k<n;k++) {
+      if (hl[k]<epsmin) return false;
+    }
+    return true;
+  }
+  
 #endif
 
   public:
@@ -183,6 +348,118 @@ namespace o2scl {
     mem_size_y=0;
     max_shrink_iters=10;
     shrink_fact=1.0e2;
+    n_threads=1;
+    sparse=false;
+    sp_ny=0;
+    sp_nx=0;
+  }
+
+  /** \brief Number of OpenMP threads (default 1)
+   */
+  size_t n_threads;
+
+  /** \brief Set one function for each thread
+
+      When OpenMP support is enabled, thread \c i uses the function
+      <tt>fv[i]</tt> and the size of \c fv limits the number of
+      threads. These functions must give the same results as the
+      function specified in \ref set_function(), which is still used
+      when only one thread is used. This is useful when the function
+      is a member of an object which is not thread-safe, in which
+      case each function can refer to a separate copy of the object.
+      This list is not modified by \ref set_function(), so it is
+      preserved when the Jacobian object is used by a solver. Calling
+      this function with an empty vector removes the list.
+  */
+  void set_thread_functions(std::vector<func_t> &fv) {
+    func_list=fv;
+    return;
+  }
+
+  /** \brief Specify the sparsity pattern of the Jacobian
+
+      The entry <tt>pattern(i,j)</tt> should be non-zero if the
+      derivative of function \c i with respect to variable \c j can be
+      non-zero. This function computes the groups of columns which
+      are evaluated together, and the pattern is used for all
+      subsequent evaluations until \ref clear_sparsity() is called.
+  */
+  template<class mat_int_t>
+  void set_sparsity(size_t ny, size_t nx, const mat_int_t &pattern) {
+
+    col_rows.clear();
+    groups.clear();
+    col_rows.resize(nx);
+    for(size_t j=0;j<nx;j++) {
+      for(size_t i=0;i<ny;i++) {
+	if (pattern(i,j)!=0) col_rows[j].push_back(i);
+      }
+    }
+
+    // Order the columns by decreasing number of non-zero entries
+    std::vector<size_t> order(nx);
+    for(size_t j=0;j<nx;j++) order[j]=j;
+    std::stable_sort(order.begin(),order.end(),
+		     [this](size_t a, size_t b) {
+		       return col_rows[a].size()>col_rows[b].size();
+		     });
+
+    // Add each column to the first group which has no entries in the
+    // same rows, creating a new group if necessary
+    std::vector<std::vector<bool> > used;
+    for(size_t k=0;k<nx;k++) {
+      size_t j=order[k];
+      const std::vector<size_t> &rows=col_rows[j];
+      size_t ig=0;
+      for(;ig<groups.size();ig++) {
+	bool overlap=false;
+	for(size_t ir=0;ir<rows.size() && overlap==false;ir++) {
+	  if (used[ig][rows[ir]]) overlap=true;
+	}
+	if (overlap==false) break;
+      }
+      if (ig==groups.size()) {
+	groups.push_back(std::vector<size_t>());
+	used.push_back(std::vector<bool>(ny,false));
+      }
+      groups[ig].push_back(j);
+      for(size_t ir=0;ir<rows.size();ir++) used[ig][rows[ir]]=true;
+    }
+
+    // Sort the columns in each group
+    for(size_t ig=0;ig<groups.size();ig++) {
+      std::sort(groups[ig].begin(),groups[ig].end());
+    }
+    
+    sp_ny=ny;
+    sp_nx=nx;
+    sparse=true;
+    
+    return;
+  }
+
+  /** \brief Remove the sparsity pattern, so that the full
+      Jacobian is computed
+  */
+  void clear_sparsity() {
+    col_rows.clear();
+    groups.clear();
+    sp_ny=0;
+    sp_nx=0;
+    sparse=false;
+    return;
+  }
+
+  /** \brief Return the number of function evaluations required
+      for each Jacobian (excluding additional evaluations when
+      a step fails)
+
+      If no sparsity pattern has been specified, this returns
+      the number of columns from the last call to operator().
+  */
+  size_t get_ngroups() {
+    if (sparse) return groups.size();
+    return mem_size_x;
   }
 
   virtual ~jacobian_gsl() {
@@ -241,73 +518,130 @@ namespace o2scl {
   virtual int operator()(size_t nx, vec_t &x, size_t ny, vec_t &y, 
 			 mat_t &jac) {
       
-    size_t i,j;
-    double h,temp;
-    bool success=true;
-
+    if (sparse && (sp_nx!=nx || sp_ny!=ny)) {
+      O2SCL_ERR2("Sizes do not match sparsity pattern in ",
+		 "jacobian_gsl::operator().",exc_einval);
+    }
+    
     if (mem_size_x!=nx || mem_size_y!=ny) {
       f.resize(ny);
       xx.resize(nx);
       mem_size_x=nx;
       mem_size_y=ny;
     }
-      
-    vector_copy(nx,x,xx);
 
-    for (j=0;j<nx;j++) {
+    // The number of function evaluations (without retries)
+    size_t ng=nx;
+    if (sparse) ng=groups.size();
+    
+    size_t nt=1;
+#ifdef O2SCL_OPENMP
+    nt=n_threads;
+    if (func_list.size()>0 && func_list.size()<nt) nt=func_list.size();
+    if (nt>ng) nt=ng;
+    if (nt==0) nt=1;
+#endif
 
-      // Thanks to suggestion from Conrad Curry.
-      h=epsrel*fabs(x[j]);
-      if (h<epsmin) h=epsmin;
-      if (h==0.0) h=epsrel;
+    bool success=true;
 
-      xx[j]=x[j]+h;
-      int ret=(this->func)(nx,xx,f);
-      xx[j]=x[j];
+    if (nt==1) {
       
-      // The function returned a non-zero value, so try a different step
-      size_t it=0;
-      while (ret!=0 && h>=epsmin && it<max_shrink_iters) {
-
-	// First try flipping the sign
-	h=-h;
-	xx[j]=x[j]+h;
-	ret=(this->func)(nx,xx,f);
-	xx[j]=x[j];
-
+      vector_copy(nx,x,xx);
+      if (hv.size()<nx) hv.resize(nx);
+      
+      for(size_t ig=0;ig<ng;ig++) {
+	
+	const size_t *cols=&ig;
+	size_t ncols=1;
+	if (sparse) {
+	  cols=&(groups[ig][0]);
+	  ncols=groups[ig].size();
+	}
+	
+	bool zero_col;
+	int ret=eval_cols(cols,ncols,this->func,nx,x,ny,y,xx,f,hv,
+			  jac,zero_col);
 	if (ret!=0) {
-
-	  // If that didn't work, flip to positive and try a smaller
-	  // stepsize
-	  h/=-shrink_fact;
-	  if (h>=epsmin) {
-	    xx[j]=x[j]+h;
-	    ret=(this->func)(nx,xx,f);
-	    xx[j]=x[j];
-	  }
-	  
+	  O2SCL_CONV2_RET("Jacobian failed to find valid step in ",
+			  "jacobian_gsl::operator().",exc_ebadfunc,
+			  this->err_nonconv);
 	}
-
-	it++;
+	if (zero_col) success=false;
       }
 
-      if (ret!=0) {
-	O2SCL_CONV2_RET("Jacobian failed to find valid step in ",
-			"jacobian_gsl::operator().",exc_ebadfunc,
-			this->err_nonconv);
+    } else {
+
+      // Allocate storage for each thread
+      f_th.resize(nt);
+      xx_th.resize(nt);
+      h_th.resize(nt);
+      func_th.resize(nt);
+      for(size_t it=0;it<nt;it++) {
+	f_th[it].resize(ny);
+	xx_th[it].resize(nx);
+	vector_copy(nx,x,xx_th[it]);
+	if (h_th[it].size()<nx) h_th[it].resize(nx);
+	if (func_list.size()>0) func_th[it]=func_list[it];
+	else func_th[it]=this->func;
       }
 
-      // This is the equivalent of GSL's test of
-      // gsl_vector_isnull(&col.vector)
+      std::vector<int> ret_g(ng,0);
+      std::vector<char> zero_g(ng,0);
+      bool thrown=false;
+      std::string err_msg;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+      for(size_t ig=0;ig<ng;ig++) {
+	
+	size_t it=0;
+#ifdef O2SCL_OPENMP
+	it=omp_get_thread_num();
+#endif
+	
+	const size_t *cols=&ig;
+	size_t ncols=1;
+	if (sparse) {
+	  cols=&(groups[ig][0]);
+	  ncols=groups[ig].size();
+	}
 
-      bool nonzero=false;
-      for (i=0;i<ny;i++) {
-	temp=(f[i]-y[i])/h;
-	if (temp!=0.0) nonzero=true;
-	jac(i,j)=temp;
+	try {
+	  bool zero_col;
+	  ret_g[ig]=eval_cols(cols,ncols,func_th[it],nx,x,ny,y,xx_th[it],
+			      f_th[it],h_th[it],jac,zero_col);
+	  if (zero_col) zero_g[ig]=1;
+	} catch (std::exception &e) {
+	  ret_g[ig]=exc_efailed;
+	  // Restore the point for the next group on this thread
+	  vector_copy(nx,x,xx_th[it]);
+#ifdef O2SCL_OPENMP
+#pragma omp critical (jacobian_gsl_error)
+#endif
+	  {
+	    if (thrown==false) {
+	      thrown=true;
+	      err_msg=e.what();
+	    }
+	  }
+	}
       }
-      if (nonzero==false) success=false;
 
+      if (thrown) {
+	err_msg=((std::string)"Function failed in ")+
+	  "jacobian_gsl::operator(): "+err_msg;
+	O2SCL_ERR(err_msg.c_str(),exc_efailed);
+      }
+      
+      for(size_t ig=0;ig<ng;ig++) {
+	if (ret_g[ig]!=0) {
+	  O2SCL_CONV2_RET("Jacobian failed to find valid step in ",
+			  "jacobian_gsl::operator().",exc_ebadfunc,
+			  this->err_nonconv);
+	}
+	if (zero_g[ig]) success=false;
+      }
     }
     
     if (success==false) {
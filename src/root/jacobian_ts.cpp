@@ -20,6 +20,8 @@
 
   -------------------------------------------------------------------
 */
+#include <atomic>
+
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 
@@ -38,6 +40,22 @@ int tfun(size_t nv, const ubvector &x, ubvector &y) {
   return 0;
 }
 
+/** \brief Number of calls to tridiag(), which is also called
+    from several threads below
+*/
+static std::atomic<size_t> tridiag_calls(0);
+
+/// A function with a tridiagonal Jacobian
+int tridiag(size_t nv, const ubvector &x, ubvector &y) {
+  tridiag_calls++;
+  for(size_t i=0;i<nv;i++) {
+    y[i]=(3.0+i)*x[i]*x[i]-1.0;
+    if (i>0) y[i]+=sin(x[i-1]);
+    if (i+1<nv) y[i]+=exp(x[i+1]/4.0);
+  }
+  return 0;
+}
+
 int main(void) {
 
   jacobian_exact<mm_funct> ej;
@@ -98,6 +116,62 @@ int main(void) {
        << 3.0*x[1]*x[1] << endl;
   cout << endl;
 
+  // A sparse Jacobian
+  {
+    size_t n=12;
+    mm_funct mft=tridiag;
+    jacobian_gsl<mm_funct> dj, cj;
+    dj.set_function(mft);
+    cj.set_function(mft);
+
+    ubvector x2(n), y2(n);
+    ubmatrix jd(n,n), jc(n,n);
+    for(size_t i=0;i<n;i++) x2[i]=1.0+0.1*i;
+    tridiag(n,x2,y2);
+
+    boost::numeric::ublas::matrix<int> pat(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	if (i==j || i==j+1 || j==i+1) pat(i,j)=1;
+	else pat(i,j)=0;
+      }
+    }
+    cj.set_sparsity(n,n,pat);
+    t.test_gen(cj.get_ngroups()==3,"number of groups");
+
+    tridiag_calls=0;
+    dj(n,x2,n,y2,jd);
+    t.test_gen(tridiag_calls==n,"dense calls");
+    tridiag_calls=0;
+    cj(n,x2,n,y2,jc);
+    t.test_gen(tridiag_calls==3,"sparse calls");
+
+    // The entries agree exactly since each function value depends
+    // on only one of the variables stepped in each group
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	t.test_gen(jc(i,j)==jd(i,j),"sparse vs. dense");
+      }
+      t.test_rel(jc(i,i),2.0*(3.0+i)*x2[i],1.0e-6,"sparse diagonal");
+    }
+
+    // The result should not depend on the number of threads
+    ubmatrix jt(n,n);
+    cj.n_threads=3;
+    cj(n,x2,n,y2,jt);
+    t.test_abs_mat(n,n,jt,jc,1.0e-12,"sparse threaded");
+    dj.n_threads=3;
+    std::vector<mm_funct> vf(3,mft);
+    dj.set_thread_functions(vf);
+    dj(n,x2,n,y2,jt);
+    t.test_abs_mat(n,n,jt,jd,1.0e-12,"dense threaded");
+
+    cj.clear_sparsity();
+    cj(n,x2,n,y2,jt);
+    t.test_abs_mat(n,n,jt,jd,1.0e-12,"clear_sparsity");
+    t.test_gen(cj.get_ngroups()==n,"number of groups (dense)");
+  }
+
   t.report();
   return 0;
 }
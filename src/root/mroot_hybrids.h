@@ -483,7 +483,11 @@ namespace o2scl {
       from \ref jacobian_gsl. This default is identical to the GSL
       approach, except that the default value of \ref
       jacobian_gsl::epsmin is non-zero. See \ref jacobian_gsl
-      for more details.
+      for more details. When the function is expensive, the number of
+      function evaluations per Jacobian can be reduced by specifying
+      the sparsity pattern with \ref jacobian_gsl::set_sparsity() and
+      the columns can be computed in parallel by setting \ref
+      jacobian_gsl::n_threads in \ref def_jac.
 
       By default convergence failures result in calling the exception
       handler, but this can be turned off by setting \ref